@@ -0,0 +1,137 @@
+#!/bin/sh
+# Operateurs indexes en 64 bits sur des images de plus de 2^31 pixels.
+#
+# Un bloc aleatoire est place dans le coin de l'image ou les indices
+# depassent 2^31 ; chaque operateur est applique a l'image entiere et a un
+# extrait contenant le bloc et une marge nulle, et les deux resultats
+# doivent coincider sur l'extrait. Les operateurs 3D (dynamique, wshedtopo,
+# label) sont testes sur un volume de 1292^3 voxels, les operateurs 2D
+# (meanfilter, convol, hthinpar, skelpar) sur une image de 47000^2 pixels.
+#
+# Test facultatif, desactive sauf si PINK_LARGE_TESTS est positionne :
+# il faut plusieurs dizaines de Go de memoire et de disque.
+# PINK_LARGE_SIZE3D (defaut 1292) et PINK_LARGE_SIZE2D (defaut 47000)
+# permettent de reduire les tailles pour verifier le script lui-meme.
+USAGE="Usage: PINK_LARGE_TESTS=1 $0 [tmpdir]"
+if [ $# -gt 1 ]
+then
+	echo $USAGE
+        exit 1
+fi
+
+if [ -z "$PINK_LARGE_TESTS" ]
+  then
+    echo "$0: PINK_LARGE_TESTS not set, skipped"
+    exit 0
+fi
+
+D3=${PINK_LARGE_SIZE3D:-1292}
+D2=${PINK_LARGE_SIZE2D:-47000}
+B=24
+M=8
+E=2
+DIR=${1:-${TMPDIR:-/tmp}}/_largevolume$$
+mkdir $DIR || exit 1
+trap 'rm -rf $DIR' 0
+FAILED=0
+
+# verifie qu'un resultat existe et que son en-tete annonce la taille
+# attendue ($2) pour un fichier complet (taille d'en-tete positive)
+checkfile ()
+{
+    [ -f $1 ] || return 1
+    showheader $1 > $DIR/header 2>&1 || return 1
+    grep -x "size: $2" $DIR/header > /dev/null || return 1
+    HS=`sed -n 's/^header size = //p' $DIR/header`
+    [ -n "$HS" ] && [ "$HS" -gt 0 ]
+}
+
+# compare crop(gros resultat) et le resultat sur l'extrait ($2 : taille
+# attendue). equal retourne 1 si les images sont egales, mais aussi quand
+# readimage echoue : dans ce cas il ecrit un message sur stderr, qu'on
+# exige vide.
+check ()
+{
+    if checkfile $DIR/$1_big "$2" && checkfile $DIR/$1_small "$2"
+      then
+        equal $DIR/$1_big $DIR/$1_small 2> $DIR/err
+        RET=$?
+      else
+        echo "$0: $1: missing or truncated result"
+        RET=2
+    fi
+    if [ $RET -eq 1 ] && [ ! -s $DIR/err ]
+      then
+        echo "$0: $1 ok"
+      else
+        [ -s $DIR/err ] && cat $DIR/err
+        echo "$0: $1 FAILED"
+        FAILED=1
+    fi
+    rm -f $DIR/res $DIR/err $DIR/header $DIR/$1_big $DIR/$1_small
+}
+
+# ---------------------------------------------------------------
+# 3D : D3^3 voxels, bloc B^3 a E voxels du bord au fond de l'image,
+# extrait (M+B+E)^3 allant jusqu'au bord
+# ---------------------------------------------------------------
+P=`expr $D3 - $B - $E`
+S=`expr $P - $M`
+C=`expr $M + $B + $E`
+randimage $B $B $B 255 1 $DIR/bloc
+genimage  $D3 $D3 $D3 0 $DIR/im
+insert    $DIR/bloc $DIR/im $P $P $P $DIR/im
+crop      $DIR/im $S $S $S $C $C $C $DIR/sub
+
+dynamique $DIR/im 6 $DIR/res
+crop      $DIR/res $S $S $S $C $C $C $DIR/dynamique_big
+dynamique $DIR/sub 6 $DIR/dynamique_small
+check dynamique "rowsize = $C ; colsize = $C ; depth = $C"
+
+wshedtopo $DIR/im 6 $DIR/res
+crop      $DIR/res $S $S $S $C $C $C $DIR/wshedtopo_big
+wshedtopo $DIR/sub 6 $DIR/wshedtopo_small
+check wshedtopo "rowsize = $C ; colsize = $C ; depth = $C"
+
+label $DIR/im 6 max $DIR/res
+crop  $DIR/res $S $S $S $C $C $C $DIR/label_big
+label $DIR/sub 6 max $DIR/label_small
+check label "rowsize = $C ; colsize = $C ; depth = $C"
+
+# ---------------------------------------------------------------
+# 2D : D2^2 pixels, meme disposition
+# ---------------------------------------------------------------
+P=`expr $D2 - $B - $E`
+S=`expr $P - $M`
+randimage $B $B 1 255 2 $DIR/bloc
+genimage  $D2 $D2 1 0 $DIR/im
+insert    $DIR/bloc $DIR/im $P $P 0 $DIR/im
+crop      $DIR/im $S $S $C $C $DIR/sub
+
+genimage   $D2 $D2 1 1 $DIR/roi
+genimage   $C $C 1 1 $DIR/subroi
+meanfilter $DIR/im $DIR/roi 3 $DIR/res
+crop       $DIR/res $S $S $C $C $DIR/meanfilter_big
+meanfilter $DIR/sub $DIR/subroi 3 $DIR/meanfilter_small
+check meanfilter "rowsize = $C ; colsize = $C"
+rm -f $DIR/roi
+
+genimage 3 3 1 1 $DIR/noyau
+convol   $DIR/im $DIR/noyau 0 $DIR/res
+crop     $DIR/res $S $S $C $C $DIR/convol_big
+convol   $DIR/sub $DIR/noyau 0 $DIR/convol_small
+check convol "rowsize = $C ; colsize = $C"
+
+hthinpar $DIR/im null 2 $DIR/res
+crop     $DIR/res $S $S $C $C $DIR/hthinpar_big
+hthinpar $DIR/sub null 2 $DIR/hthinpar_small
+check hthinpar "rowsize = $C ; colsize = $C"
+
+seuil   $DIR/im 128 $DIR/im
+seuil   $DIR/sub 128 $DIR/sub
+skelpar $DIR/im 35 -1 $DIR/res
+crop    $DIR/res $S $S $C $C $DIR/skelpar_big
+skelpar $DIR/sub 35 -1 $DIR/skelpar_small
+check skelpar "rowsize = $C ; colsize = $C"
+
+exit $FAILED
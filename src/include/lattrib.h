@@ -73,6 +73,11 @@ typedef uint32_t indexcomp_t;
 typedef uint8_t level_t;
 #define NBLEVELS 256
 
+/* nombre de pixels a partir duquel les numeros de composantes (24 bits par
+   niveau) ou les attributs (int32_t) peuvent deborder : les operateurs
+   utilisent alors mcmaxtree */
+#define LATTRIB_NMAX ((index_t)1 << 23)
+
 #define NBMAXCOMP (indexcomp_t)(((uint64_t)1 << 8 * sizeof(indexcomp_t)) - 1)
 static const indexcomp_t NOT_ANALYZED = NBMAXCOMP - 1;
 static const indexcomp_t IN_THE_QUEUE = NBMAXCOMP;
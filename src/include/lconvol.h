@@ -46,6 +46,9 @@ extern "C" {
 extern int32_t lconvol(struct xvimage *image, struct xvimage *mask,
                        int32_t mode);
 
+extern int32_t lconvolsep(struct xvimage *f, struct xvimage *m,
+                          int32_t bord, double tol);
+
 extern int32_t ldirectionalfilter(struct xvimage *f, double width,
                                   double length, int32_t ndir);
 
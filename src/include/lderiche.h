@@ -48,6 +48,17 @@ extern void derichegen(double *x, int32_t M, int32_t N, double *y1, double *y2,
                        double a5, double a6, double a7, double a8, double b1,
                        double b2, double b3, double b4);
 
+extern int32_t derichegenf(float *x, index_t M, index_t N, float *y,
+                           double a1, double a2, double a3, double a4,
+                           double a5, double a6, double a7, double a8,
+                           double b1, double b2, double b3, double b4);
+
+extern int32_t deriche3dgenf(float *f, index_t rs, index_t cs, index_t ds,
+                             float *t, float *g,
+                             double a1, double a2, double a3, double a4, double b1, double b2,
+                             double a5, double a6, double a7, double a8, double b3, double b4,
+                             double a9, double a10, double a11, double a12, double b5, double b6);
+
 extern int32_t lderiche(struct xvimage *image1, double alpha, int32_t function,
                         double l);
 
@@ -39,6 +39,15 @@ knowledge of the CeCILL license and that you accept its terms.
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+#define HOUGH_TOLANGLE 0.2618 /* demi-ouverture (radians) du vote oriente par le gradient */
+
+typedef struct {
+  int32_t x, y;  /* centre */
+  int32_t rayon;
+  double score;  /* somme des votes / nombre de points du cercle */
+} houghcercle;
+
 extern int32_t
 lhoughcercles(struct xvimage *f, /* image de depart - en niveaux de gris */
               int32_t rayonmin,  /* premier rayon */
@@ -47,6 +56,10 @@ lhoughcercles(struct xvimage *f, /* image de depart - en niveaux de gris */
               struct xvimage
                   *h /* accumulateur - doit etre alloue aux bonnes dimensions */
 );
+extern houghcercle *lhoughcercles_pics(struct xvimage *f, struct xvimage *g,
+                                       int32_t rayonmin, int32_t pasrayon,
+                                       int32_t nbpas, double seuil,
+                                       int32_t *nbcercles);
 #ifdef __cplusplus
 }
 #endif
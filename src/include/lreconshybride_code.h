@@ -0,0 +1,206 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Corps des passes de lreconshybride.c, pour un type de pixel.
+   A inclure apres avoir defini :
+     RH_TYPE    : type des pixels (uint8_t, int16_t, int32_t, float)
+     RH_NOM(f)  : nom de la fonction f pour ce type
+     RH_COMPL(v): complement de v (bijection decroissante exacte)
+   Ce fichier est inclus une fois par type ; il ne contient que des
+   fonctions statiques.
+*/
+
+/* ==================================== */
+static void RH_NOM(rh_avant)(rh_job *J, index_t s, index_t e)
+/* ==================================== */
+/* balayage raster de [s, e[ : G = min(max(G sur les voisins anterieurs), F) */
+{
+    RH_TYPE *G = (RH_TYPE *)J->G, *F = (RH_TYPE *)J->F, v;
+    index_t i, j, x, y, z;
+    int32_t k;
+
+    rh_coords(J, s, &x, &y, &z);
+    for (i = s; i < e; i++) {
+        v = G[i];
+        if (rh_interieur(J, i, x, y, z, s, e)) {
+            for (k = 0; k < J->nv; k++) {
+                j = i + J->off[k];
+                if (G[j] > v) {
+                    v = G[j];
+                }
+            }
+        } else {
+            for (k = 0; k < J->nv; k++) {
+                if (rh_valide(J, k, 1, i, x, y, z, s, e, &j) && (G[j] > v)) {
+                    v = G[j];
+                }
+            }
+        }
+        if (v > F[i]) {
+            v = F[i];
+        }
+        G[i] = v;
+        if (++x == J->rs) {
+            x = 0;
+            if (++y == J->cs) {
+                y = 0;
+                z++;
+            }
+        }
+    }
+} // rh_avant()
+
+/* ==================================== */
+static void RH_NOM(rh_arriere)(rh_job *J, index_t s, index_t e, int32_t detecte)
+/* ==================================== */
+/* balayage anti-raster de [s, e[ (voisins posterieurs) ; si detecte, met
+   en file les points qui peuvent encore faire monter un voisin posterieur */
+{
+    RH_TYPE *G = (RH_TYPE *)J->G, *F = (RH_TYPE *)J->F, v;
+    index_t i, j, x, y, z;
+    int32_t k;
+
+    if (e <= s) {
+        return;
+    }
+    rh_coords(J, e - 1, &x, &y, &z);
+    for (i = e - 1; i >= s; i--) {
+        v = G[i];
+        if (rh_interieur(J, i, x, y, z, s, e)) {
+            for (k = 0; k < J->nv; k++) {
+                j = i - J->off[k];
+                if (G[j] > v) {
+                    v = G[j];
+                }
+            }
+        } else {
+            for (k = 0; k < J->nv; k++) {
+                if (rh_valide(J, k, -1, i, x, y, z, s, e, &j) && (G[j] > v)) {
+                    v = G[j];
+                }
+            }
+        }
+        if (v > F[i]) {
+            v = F[i];
+        }
+        G[i] = v;
+        if (detecte) {
+            for (k = 0; k < J->nv; k++) {
+                if (rh_valide(J, k, -1, i, x, y, z, s, e, &j) && (G[j] < v) && (G[j] < F[j])) {
+                    FifoPush(J->FIFO, i);
+                    J->M[i] = 1;
+                    break;
+                }
+            }
+        }
+        if (x-- == 0) {
+            x = J->rs - 1;
+            if (y-- == 0) {
+                y = J->cs - 1;
+                z--;
+            }
+        }
+    }
+} // rh_arriere()
+
+/* ==================================== */
+static void RH_NOM(rh_detecte)(rh_job *J, index_t s, index_t e)
+/* ==================================== */
+/* marque les points de [s, e[ qui peuvent encore faire monter un voisin */
+{
+    RH_TYPE *G = (RH_TYPE *)J->G, *F = (RH_TYPE *)J->F, v;
+    index_t i, j, x, y, z;
+    int32_t k, sens;
+
+    rh_coords(J, s, &x, &y, &z);
+    for (i = s; i < e; i++) {
+        v = G[i];
+        for (sens = -1; (sens <= 1) && !J->M[i]; sens += 2) {
+            for (k = 0; k < J->nv; k++) {
+                if (rh_valide(J, k, sens, i, x, y, z, 0, J->N, &j) && (G[j] < v) && (G[j] < F[j])) {
+                    J->M[i] = 1;
+                    break;
+                }
+            }
+        }
+        if (++x == J->rs) {
+            x = 0;
+            if (++y == J->cs) {
+                y = 0;
+                z++;
+            }
+        }
+    }
+} // rh_detecte()
+
+/* ==================================== */
+static void RH_NOM(rh_propage)(rh_job *J)
+/* ==================================== */
+/* propagation par file des points encore instables */
+{
+    RH_TYPE *G = (RH_TYPE *)J->G, *F = (RH_TYPE *)J->F, v;
+    index_t p, j, x, y, z;
+    int32_t k, sens;
+
+    while (!FifoVide(J->FIFO)) {
+        p = FifoPop(J->FIFO);
+        J->M[p] = 0;
+        v = G[p];
+        rh_coords(J, p, &x, &y, &z);
+        for (sens = -1; sens <= 1; sens += 2) {
+            for (k = 0; k < J->nv; k++) {
+                if (rh_valide(J, k, sens, p, x, y, z, 0, J->N, &j) && (G[j] < v) && (G[j] < F[j])) {
+                    G[j] = (v < F[j]) ? v : F[j];
+                    if (!J->M[j]) {
+                        FifoPush(J->FIFO, j);
+                        J->M[j] = 1;
+                    }
+                }
+            }
+        }
+    }
+} // rh_propage()
+
+/* ==================================== */
+static void RH_NOM(rh_complemente)(void *I, index_t N)
+/* ==================================== */
+/* bijection decroissante, involutive et exacte des valeurs */
+{
+    RH_TYPE *V = (RH_TYPE *)I;
+    index_t i;
+    for (i = 0; i < N; i++) {
+        V[i] = RH_COMPL(V[i]);
+    }
+} // rh_complemente()
@@ -0,0 +1,86 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef MCBITIMAGE__H__
+#define MCBITIMAGE__H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef _MCIMAGE_H
+#include <mcimage.h>
+#endif
+
+/*
+  Image binaire compactee : un bit par pixel, 64 pixels par mot.
+  Chaque ligne (y,z) occupe wpr mots consecutifs, a partir du mot
+  (z * cs + y) * wpr ; le pixel x est le bit (x % 64) du mot x / 64.
+  Les bits de remplissage (x >= rs) sont toujours nuls.
+*/
+typedef struct {
+    index_t rs, cs, ds;            /* dimensions de l'image */
+    index_t wpr;                   /* nombre de mots par ligne */
+    uint64_t *data;                /* wpr * cs * ds mots */
+} mcbitimage;
+
+#define MCBIT_WORD(b,x,y,z) ((b)->data[((z) * (b)->cs + (y)) * (b)->wpr + ((x) >> 6)])
+#define MCBIT_GET(b,x,y,z) ((MCBIT_WORD(b,x,y,z) >> ((x) & 63)) & 1)
+#define MCBIT_SET(b,x,y,z) (MCBIT_WORD(b,x,y,z) |= ((uint64_t)1 << ((x) & 63)))
+#define MCBIT_CLR(b,x,y,z) (MCBIT_WORD(b,x,y,z) &= ~((uint64_t)1 << ((x) & 63)))
+
+/* ============== */
+/* prototypes     */
+/* ============== */
+extern mcbitimage * mcbit_allocimage(index_t rs, index_t cs, index_t ds);
+extern void mcbit_freeimage(mcbitimage *b);
+extern mcbitimage * mcbit_pack(struct xvimage *f);
+extern int32_t mcbit_unpack(mcbitimage *b, struct xvimage *f);
+extern int32_t mcbit_unpackmin(mcbitimage *b, struct xvimage *f);
+extern int32_t mcbit_isbinary(struct xvimage *f);
+extern void mcbit_inverse(mcbitimage *b);
+extern void mcbit_and(mcbitimage *b, mcbitimage *c);
+extern int32_t mcbit_dilat(mcbitimage *b, int32_t nptb, int32_t *tab_es_x, int32_t *tab_es_y,
+                           int32_t *tab_es_z, int32_t xc, int32_t yc, int32_t zc);
+extern int32_t mcbit_eros(mcbitimage *b, int32_t nptb, int32_t *tab_es_x, int32_t *tab_es_y,
+                          int32_t *tab_es_z, int32_t xc, int32_t yc, int32_t zc);
+extern int32_t mcbit_hitormiss(mcbitimage *b, struct xvimage *m1, int32_t x1, int32_t y1, int32_t z1,
+                               struct xvimage *m2, int32_t x2, int32_t y2, int32_t z2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCBITIMAGE__H__ */
@@ -205,36 +205,36 @@ typedef struct xvimage xvimage; // LuM
 /* prototypes     */
 /* ============== */
 
-extern int32_t voisin(index_t i, int32_t k, index_t rs, index_t nb);
-extern int32_t voisin2(index_t i, int32_t k, index_t rs, index_t nb);
-extern int32_t voisin6(index_t i, int32_t k, index_t rs, index_t n, index_t nb);
+extern index_t voisin(index_t i, int32_t k, index_t rs, index_t nb);
+extern index_t voisin2(index_t i, int32_t k, index_t rs, index_t nb);
+extern index_t voisin6(index_t i, int32_t k, index_t rs, index_t n, index_t nb);
 extern int32_t bord(index_t i, index_t rs, index_t nb);
 extern int32_t bord3d(index_t i, index_t rs, index_t ps, index_t nb);
-extern int32_t voisin26(index_t i, int32_t k, index_t rs, index_t n,
+extern index_t voisin26(index_t i, int32_t k, index_t rs, index_t n,
                         index_t nb);
-extern int32_t voisin18(index_t i, int32_t k, index_t rs, index_t n,
+extern index_t voisin18(index_t i, int32_t k, index_t rs, index_t n,
                         index_t nb);
-extern int32_t voisin12(index_t i, int32_t k, index_t rs, index_t ps,
+extern index_t voisin12(index_t i, int32_t k, index_t rs, index_t ps,
                         index_t N);
 extern int32_t voisins4(index_t i, index_t j, index_t rs);
 extern int32_t voisins8(index_t i, index_t j, index_t rs);
 extern int32_t voisins6(index_t i, index_t j, index_t rs, index_t ps);
 extern int32_t voisins18(index_t i, index_t j, index_t rs, index_t ps);
 extern int32_t voisins26(index_t i, index_t j, index_t rs, index_t ps);
-extern int32_t voisin5(index_t i, int32_t k, index_t rs, index_t nb);
-extern int32_t voisin6b(index_t i, int32_t k, index_t rs, index_t nb,
+extern index_t voisin5(index_t i, int32_t k, index_t rs, index_t nb);
+extern index_t voisin6b(index_t i, int32_t k, index_t rs, index_t nb,
                         index_t par);
-extern int32_t voisinNESO(index_t i, int32_t k, index_t rs, index_t nb);
-extern int32_t voisinNOSE(index_t i, int32_t k, index_t rs, index_t nb);
-extern int32_t voisin14b(index_t i, int32_t k, index_t rs, index_t ps,
+extern index_t voisinNESO(index_t i, int32_t k, index_t rs, index_t nb);
+extern index_t voisinNOSE(index_t i, int32_t k, index_t rs, index_t nb);
+extern index_t voisin14b(index_t i, int32_t k, index_t rs, index_t ps,
                          index_t N);
-extern int32_t voisinONAV(index_t i, int32_t k, index_t rs, index_t ps,
+extern index_t voisinONAV(index_t i, int32_t k, index_t rs, index_t ps,
                           index_t N);
-extern int32_t voisinENAR(index_t i, int32_t k, index_t rs, index_t ps,
+extern index_t voisinENAR(index_t i, int32_t k, index_t rs, index_t ps,
                           index_t N);
-extern int32_t voisinENAV(index_t i, int32_t k, index_t rs, index_t ps,
+extern index_t voisinENAV(index_t i, int32_t k, index_t rs, index_t ps,
                           index_t N);
-extern int32_t voisinONAR(index_t i, int32_t k, index_t rs, index_t ps,
+extern index_t voisinONAR(index_t i, int32_t k, index_t rs, index_t ps,
                           index_t N);
 extern uint32_t maskvois26(uint8_t *F, uint32_t bitmask, index_t i, index_t rs,
                            index_t ps, index_t N);
@@ -244,7 +244,7 @@ extern int32_t sont6voisins(index_t p, index_t q, index_t rs, index_t ps);
 extern int32_t sont18voisins(index_t p, index_t q, index_t rs, index_t ps);
 extern int32_t sont26voisins(index_t p, index_t q, index_t rs, index_t ps);
 
-extern int32_t voisin125(index_t i, int32_t k, index_t rs, index_t ps,
+extern index_t voisin125(index_t i, int32_t k, index_t rs, index_t ps,
                          index_t N);
 
 #define ACCEPTED_TYPES1(I, T0)                                                 \
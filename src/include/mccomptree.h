@@ -59,20 +59,20 @@ extern "C" {
 
 typedef struct soncell // cell structure for the lists of sons
 {
-  int32_t son;          // index of the son in table tabnodes [struct ctree]
+  index_t son;          // index of the son in table tabnodes [struct ctree]
   struct soncell *next; // points to next cell
 } soncell;
 
 typedef struct // structure for one node in the component tree
 {
   uint8_t data;   // node's level
-  int32_t father; // index of the father node. value -1 indicates the root
-  int32_t nbsons; // number or sons. value -1 indicates a deleted node
+  index_t father; // index of the father node. value -1 indicates the root
+  index_t nbsons; // number or sons. value -1 indicates a deleted node
 #ifdef ATTRIB_AREA
-  int32_t area; // number of pixels in the component
+  index_t area; // number of pixels in the component
 #endif
 #ifdef ATTRIB_VOL
-  int32_t vol; // volume of the component
+  index_t vol; // volume of the component
 #endif
   soncell *sonlist; // list of sons (points to the first son cell)
   soncell *lastson; // direct pointer to the last son cell
@@ -80,10 +80,10 @@ typedef struct // structure for one node in the component tree
 
 typedef struct // structure for a component tree
 {
-  int32_t nbnodes;      // total number of nodes
-  int32_t nbleafs;      // total number of leafs
-  int32_t nbsoncells;   // number of avaliable son cells
-  int32_t root;         // index of the root node in table tabnodes
+  index_t nbnodes;      // total number of nodes
+  index_t nbleafs;      // total number of leafs
+  index_t nbsoncells;   // number of avaliable son cells
+  index_t root;         // index of the root node in table tabnodes
   ctreenode *tabnodes;  // table which contains all the nodes
   soncell *tabsoncells; // table which contains all the son cells
   uint8_t *flags; // each flag is associated to the node with the same index
@@ -101,25 +101,25 @@ typedef struct // structure for a component tree
 #define MAXGREY 65536
 #endif
 
-extern ctree *ComponentTreeAlloc(int32_t N);
+extern ctree *ComponentTreeAlloc(index_t N);
 extern void ComponentTreeFree(ctree *CT);
 #ifdef IMGCHAR
-extern int32_t ComponentTree( uint8_t *F, int32_t rs, int32_t N, int32_t connex, // inputs
+extern int32_t ComponentTree( uint8_t *F, index_t rs, index_t N, int32_t connex, // inputs
 #endif
 #ifdef IMGLONG
-extern int32_t ComponentTree( uint32_t *F, int32_t rs, int32_t N, int32_t connex, // inputs
+extern int32_t ComponentTree( uint32_t *F, index_t rs, index_t N, int32_t connex, // inputs
 #endif
                            ctree **CompTree, // output
-                           int32_t **CompMap     // output
+                           index_t **CompMap     // output
 			 );
 #ifdef IMGCHAR
-extern int32_t ComponentTree3d( uint8_t *F, int32_t rs, int32_t ps, int32_t N, int32_t connex, // inputs
+extern int32_t ComponentTree3d( uint8_t *F, index_t rs, index_t ps, index_t N, int32_t connex, // inputs
 #endif
 #ifdef IMGLONG
-extern int32_t ComponentTree3d( uint32_t *F, int32_t rs, int32_t ps, int32_t N, int32_t connex, // inputs
+extern int32_t ComponentTree3d( uint32_t *F, index_t rs, index_t ps, index_t N, int32_t connex, // inputs
 #endif
                            ctree **CompTree, // output
-                           int32_t **CompMap     // output
+                           index_t **CompMap     // output
 			 );
 #ifdef __cplusplus
 }
@@ -44,26 +44,37 @@ extern "C" {
 #include <mcimage.h>
 #endif
 
-typedef struct FAHELT {
-  index_t Point;
-  struct FAHELT *Next;
-} FahElt;
+/*
+  File d'attente hierarchique : chaque niveau est une file FIFO stockee dans
+  un bloc contigu (tampon circulaire dont la taille double a la demande).
+  Les niveaux sont des entiers non signes sur 32 bits : les 16 bits de poids
+  faible indexent directement les blocs de niveaux (FahBas), les 16 bits de
+  poids fort indexent des blocs de second rang (FahHaut) dont le contenu est
+  redistribue dans les blocs de niveaux quand la file les atteint (tri par
+  base en deux passes). Pour des niveaux < 65536 seuls les blocs de niveaux
+  sont utilises.
+*/
 
-#ifndef NPRIO
-#define NPRIO 512
-#endif
+typedef struct {
+  index_t *T;          /* elements (tampon circulaire) */
+  index_t Cap;         /* capacite (puissance de 2, ou 0) */
+  index_t Out;         /* indice du premier element */
+  index_t Nb;          /* nombre d'elements */
+} FahBloc;
 
 typedef struct {
   index_t Max;         /* taille max de la fah (en nombre de points) */
-  int32_t Niv;         /* niveau a partir duquel des listes existent */
+  uint32_t Niv;        /* niveau courant (le plus bas present) */
   index_t Util;        /* nombre de points courant dans la fah */
   index_t Maxutil;     /* nombre de points utilises max (au cours du temps) */
-  FahElt *Tete[NPRIO]; /* tableau des tetes de liste */
-  FahElt *Queue;       /* queue de liste (la ou l'on preleve) */
-  FahElt *QueueUrg;    /* queue de liste d'urgence (la ou l'on preleve) */
-  FahElt *TeteUrg;     /* tete de liste d'urgence (la ou l'on insere) */
-  FahElt *Libre;       /* pile des cellules libres */
-  FahElt Elts[1];      /* tableau des elements physiques */
+  FahBloc Urg;         /* file d'urgence (niveaux depasses) */
+  uint32_t Haut;       /* poids fort des niveaux ranges dans FahBas */
+  FahBloc *FahBas;     /* blocs des niveaux (Haut << 16) + i */
+  uint32_t NbBas;      /* nombre de blocs alloues dans FahBas */
+  index_t UtilBas;     /* nombre de points dans FahBas */
+  FahBloc *FahHaut;    /* blocs de second rang (couples point, niveau) */
+  uint32_t NbHaut;     /* nombre de blocs alloues dans FahHaut */
+  index_t UtilHaut;    /* nombre de points dans FahHaut */
 } Fah;
 
 /* ============== */
@@ -82,12 +93,16 @@ extern int32_t FahVideNiveau(Fah *L, int32_t niv);
 
 extern int32_t FahNiveau(Fah *L);
 
+extern uint32_t FahNiveauU32(Fah *L);
+
 extern index_t FahPop(Fah *L);
 
 extern index_t FahFirst(Fah *L);
 
 extern void FahPush(Fah *L, index_t Po, int32_t Ni);
 
+extern void FahPushU32(Fah *L, index_t Po, uint32_t Ni);
+
 extern void FahTermine(Fah *L);
 
 extern void FahPrint(Fah *L);
@@ -0,0 +1,94 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef MCFFT__H__
+#define MCFFT__H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef _MCIMAGE_H
+#include <mcimage.h>
+#endif
+
+#define MCFFT_MAXFACT 32   /* nombre max de facteurs de la taille */
+#define MCFFT_MAXRADIX 61  /* au-dela : algorithme de Bluestein */
+
+/* sens de la transformee : memes valeurs que FFT_FORWARD et FFT_INVERSE (lfft.h) */
+#define MCFFT_FORWARD 0
+#define MCFFT_INVERSE 1
+
+/*
+  Plan de transformee de Fourier discrete 1D de taille n quelconque.
+  Un plan n'est plus modifie apres sa creation : il peut etre partage
+  entre plusieurs threads, chacun fournissant son propre tableau de
+  travail (mcfft_worksize(plan) elements de type dcomplex).
+*/
+typedef struct mcfft_plan {
+    int32_t n;                     /* taille de la transformee */
+    int32_t fact[2 * MCFFT_MAXFACT]; /* couples (radix, taille restante) */
+    dcomplex *tw;                  /* exp(-2 i pi k / n), 0 <= k < n */
+    /* algorithme de Bluestein (facteur premier > MCFFT_MAXRADIX) */
+    int32_t m;                     /* taille de la convolution, 0 si non utilise */
+    dcomplex *bw;                  /* exp(-i pi k^2 / n), 0 <= k < n */
+    dcomplex *bB;                  /* TF du noyau conj(bw), divisee par m */
+    struct mcfft_plan *sub;        /* plan de taille m */
+    /* transformee d'un signal reel */
+    int32_t real;                  /* 1 si plan reel -> complexe */
+    struct mcfft_plan *half;       /* plan complexe de taille n/2 (n pair) ou n (n impair) */
+    dcomplex *rtw;                 /* exp(-2 i pi k / n), 0 <= k <= n/2 (n pair) */
+} mcfft_plan;
+
+/* ============== */
+/* prototypes     */
+/* ============== */
+extern mcfft_plan * mcfft_creeplan(int32_t n);
+extern mcfft_plan * mcfft_creeplanreel(int32_t n);
+extern void mcfft_termineplan(mcfft_plan *p);
+extern index_t mcfft_worksize(mcfft_plan *p);
+extern int32_t mcfft_goodsize(int32_t n);
+extern int32_t mcfft(mcfft_plan *p, dcomplex *x, int32_t dir, dcomplex *work);
+extern int32_t mcfft_r2c(mcfft_plan *p, double *x, dcomplex *X, dcomplex *work);
+extern int32_t mcfft_c2r(mcfft_plan *p, dcomplex *X, double *x, dcomplex *work);
+extern int32_t mcfft2d(dcomplex *a, int32_t rs, int32_t cs, int32_t dir);
+extern int32_t mcfft2d_r2c(float *in, int32_t rs, int32_t cs, dcomplex *out);
+extern int32_t mcfft2d_c2r(dcomplex *in, int32_t rs, int32_t cs, float *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCFFT__H__ */
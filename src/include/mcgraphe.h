@@ -146,6 +146,28 @@ typedef struct graphe {
   char **nomsommet;
 } graphe;
 
+/*! \struct graphecsr
+    \brief représentation compacte (compressed sparse row) d'un graphe :
+    les successeurs du sommet s sont succ[deb[s]] ... succ[deb[s+1]-1],
+    les valeurs des arcs correspondants v_arcs[deb[s]] ... v_arcs[deb[s+1]-1].
+*/
+typedef struct graphecsr {
+  //!  nombre de sommets
+  int32_t nsom;
+  //!  nombre d'arcs
+  index_t narc;
+  //!  début de la liste des successeurs de chaque sommet (nsom+1 éléments)
+  index_t *deb;
+  //!  successeurs
+  int32_t *succ;
+  //!  valeurs associées aux arcs
+  TYP_VARC *v_arcs;
+  //!  valeurs associées aux sommets
+  TYP_VSOM *v_sommets;
+  //!  prédécesseur dans l'arbre des plus courts chemins (-1 : aucun)
+  int32_t *pred;
+} graphecsr;
+
 /* ================================================ */
 /* prototypes */
 /* ================================================ */
@@ -264,6 +286,21 @@ extern void LeeNO(graphe *g, graphe *g_1, int32_t i);
 extern graphe *PCC(graphe *g, int32_t d, int32_t a);
 extern graphe *PCCna(graphe *g, int32_t d, int32_t a);
 
+/* ====================================================================== */
+/* ====================================================================== */
+/* GRAPHES COMPACTS (CSR) */
+/* ====================================================================== */
+/* ====================================================================== */
+
+extern graphecsr *InitGrapheCSR(int32_t nsom, index_t narc);
+extern void TermineGrapheCSR(graphecsr *g);
+extern graphecsr *Graphe2CSR(graphe *g);
+extern graphecsr *Image2GrapheCSR(struct xvimage *image, int32_t mode,
+                                  int32_t connex);
+extern void DijkstraCSR(graphecsr *g, int32_t i);
+extern void LeeCSR(graphecsr *g, int32_t i);
+extern int32_t *PCCCSR(graphecsr *g, int32_t d, int32_t a, int32_t *n);
+
 /* ====================================================================== */
 /* ====================================================================== */
 /* GRAPHES SANS CIRCUIT (GSC) */
@@ -175,6 +175,26 @@ extern void writergbascimage(struct xvimage *redimage,
 */
 extern struct xvimage *readimage(const char *filename);
 
+/**
+\brief Reads an image from a file, mapping the raw data in memory when possible
+
+Raw files whose on-disk layout matches the in-memory one (byte, int32_t,
+float, double, complex, aligned data) are memory-mapped copy-on-write
+instead of being read: pages are loaded on demand and the file is never
+modified. Other files are read as with readimage. The image must be
+released with freeimage. readimage behaves like readimagemap when the
+environment variable PINK_MMAP is set.
+
+\param filename The name of the image file.
+\return A Pointer to a newly allocated image.
+*/
+extern struct xvimage *readimagemap(const char *filename);
+
+/**
+\brief Tests whether the data of an image is a memory mapping (see readimagemap)
+*/
+extern int32_t ismappedimage(struct xvimage *image);
+
 extern struct xvimage *readheader(char *filename);
 
 extern struct xvimage *readse(char *filename, index_t *x, index_t *y,
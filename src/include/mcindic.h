@@ -58,6 +58,30 @@ extern Indicstype *Indics; /* en global pour etre efficace */
 #define UnSet1(x) Indics[x / 8] &= ~(1 << (x % 8))
 #define IsSet1(x) (Indics[x / 8] & (1 << (x % 8)))
 
+/* ============================================================ */
+/* variante reentrante : les indicateurs sont portes par un     */
+/* contexte alloue par l'appelant (un par appel d'operateur),   */
+/* ce qui permet d'executer plusieurs operateurs en parallele.  */
+/* Deux dispositions : 8 indicateurs par point (CreeIndics) ou  */
+/* un indicateur par bit (CreeIndics1bit).                      */
+/* ============================================================ */
+
+typedef struct {
+  index_t Size;        /* nombre de points */
+  int32_t Onebit;      /* 1 : disposition compacte (1 bit par point) */
+  Indicstype *Tab;     /* les indicateurs */
+} IndicsCtx;
+
+#define IndSet(I, x, INDIC) (I)->Tab[x] |= (1 << INDIC)
+#define IndUnSet(I, x, INDIC) (I)->Tab[x] &= ~(1 << INDIC)
+#define IndUnSetAll(I, x) (I)->Tab[x] = 0
+#define IndIsSet(I, x, INDIC) ((I)->Tab[x] & (1 << INDIC))
+#define IndIsSetAny(I, x) ((I)->Tab[x])
+
+#define IndSet1(I, x) (I)->Tab[(x) / 8] |= (1 << ((x) % 8))
+#define IndUnSet1(I, x) (I)->Tab[(x) / 8] &= ~(1 << ((x) % 8))
+#define IndIsSet1(I, x) ((I)->Tab[(x) / 8] & (1 << ((x) % 8)))
+
 /* ============== */
 /* prototypes     */
 /* ============== */
@@ -68,6 +92,11 @@ extern void Indics1bitInit(index_t Size);
 extern void Indics1bitReInit(index_t Size);
 extern void IndicsTermine();
 
+extern IndicsCtx * CreeIndics(index_t Size);
+extern IndicsCtx * CreeIndics1bit(index_t Size);
+extern void IndicsCtxReInit(IndicsCtx * I);
+extern void IndicsCtxTermine(IndicsCtx * I);
+
 #ifdef __cplusplus
 }
 #endif
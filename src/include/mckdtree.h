@@ -0,0 +1,81 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+#ifndef MCKDTREE__H__
+#define MCKDTREE__H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KD_MAXDIM 3  /* dimension max de l'espace */
+#define KD_FEUILLE 8 /* taille max d'un sous-arbre parcouru exhaustivement */
+
+/*
+  Arbre k-d statique sur un ensemble de m points de R^dim.
+  Les points sont recopies dans l'ordre de l'arbre (Pts) : le sous-arbre
+  couvrant les rangs [lo, hi[ a pour racine le rang median
+  (lo + hi) / 2, separe selon l'axe Axe[(lo + hi) / 2] ; les rangs
+  inferieurs (resp. superieurs) ont une coordonnee <= (resp. >=) a celle
+  de la racine sur cet axe.
+  Un arbre n'est plus modifie apres sa creation : les requetes peuvent
+  etre faites en parallele.
+*/
+typedef struct KdArbre {
+    int32_t dim;  /* dimension de l'espace */
+    int32_t m;    /* nombre de points */
+    double *Pts;  /* coordonnees, dans l'ordre de l'arbre (m * dim) */
+    uint8_t *Axe; /* axe de separation de chaque noeud interne */
+    int32_t *Ind; /* indice d'origine du point de rang r */
+    int32_t *Rang;/* rang dans l'arbre du point d'indice d'origine i */
+} KdArbre;
+
+/* ============== */
+/* prototypes     */
+/* ============== */
+
+extern KdArbre *KdCree(double *P, int32_t m, int32_t dim);
+extern void KdTermine(KdArbre *A);
+extern KdArbre *KdCreeVoisins(double *Y, int32_t m, int32_t dim, int32_t n,
+                              int32_t **proche);
+extern void KdTermineVoisins(KdArbre *A, int32_t *proche);
+extern double KdPlusProche(KdArbre *A, double *x, int32_t *j);
+extern double KdSommeDistances(KdArbre *A, double *X, int32_t n,
+                               int32_t *proche);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MCKDTREE__H__
@@ -0,0 +1,60 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+#ifndef MCLABEL__H__
+#define MCLABEL__H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* modes d'etiquetage */
+#define MCLABEL_BIN 0 /* composantes connexes des points non nuls (fond : 0) */
+#define MCLABEL_PLA 1 /* plateaux : composantes connexes d'altitude constante */
+#define MCLABEL_MIN 2 /* minima regionaux (autres points : 0) */
+#define MCLABEL_MAX 3 /* maxima regionaux (autres points : 0) */
+
+/* ============== */
+/* prototypes     */
+/* ============== */
+
+extern int32_t mclabel_possible(struct xvimage *img, int32_t connex);
+extern int32_t mclabel(struct xvimage *img, int32_t connex, int32_t mode,
+                       struct xvimage *lab, int32_t *nlabels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MCLABEL__H__
@@ -0,0 +1,86 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+
+#ifndef MCMAXTREE__H__
+#define MCMAXTREE__H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef _MCIMAGE_H
+#include <mcimage.h>
+#endif
+
+/*
+  Arbre des composantes (max-tree ou min-tree) represente par un tableau
+  de peres indexe par les pixels :
+  - S contient les N pixels tries par niveaux croissants (decroissants
+    pour un min-tree) ; S[0] est la racine ;
+  - parent[p] est le pixel canonique de la composante qui contient p
+    si p n'est pas canonique, et le pixel canonique de la composante
+    mere sinon ; parent[S[0]] = S[0].
+  Un pixel p est canonique (represente une composante) ssi p est la
+  racine ou F[parent[p]] != F[p].
+*/
+typedef struct {
+    index_t N;                     /* nombre de pixels */
+    int32_t maxtree;               /* 1 : max-tree, 0 : min-tree */
+    index_t *S;                    /* pixels dans l'ordre de traitement */
+    index_t *parent;               /* pere de chaque pixel */
+} mcmaxtree;
+
+#define MCMAXTREE_AREA   0
+#define MCMAXTREE_HEIGHT 1
+#define MCMAXTREE_VOL    2
+
+/* ============== */
+/* prototypes     */
+/* ============== */
+extern mcmaxtree * mcmaxtree_build(struct xvimage *image, int32_t connex, int32_t maxtree);
+extern void mcmaxtree_free(mcmaxtree *T);
+extern double * mcmaxtree_attribute(mcmaxtree *T, struct xvimage *image, int32_t attribute);
+extern int32_t mcmaxtree_filter(mcmaxtree *T, struct xvimage *image, double *attr, double seuil);
+extern int32_t mcmaxtree_segment(mcmaxtree *T, struct xvimage *image, double *attr, double seuil,
+                                 int32_t maximise);
+extern int32_t mcmaxtree_selnb(mcmaxtree *T, struct xvimage *image, double *attr, index_t nb);
+extern int32_t mcmaxtree_attributefilter(struct xvimage *image, int32_t connex, int32_t maxtree,
+                                         int32_t attribute, double seuil);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MCMAXTREE__H__ */
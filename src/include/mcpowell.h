@@ -44,6 +44,8 @@ typedef struct ensemble {
   double *Y;
   int32_t m;
   double *Tmp;
+  struct KdArbre *Kd; /* arbre k-d sur Y (mckdtree), ou NULL */
+  int32_t *Proche;    /* dernier plus proche voisin dans Y de chaque point de X */
 } ensemble;
 
 #define SQRT_DBL_EPSILON 1e-8 /* should be >=< sqrt(DBL_EPSILON) */
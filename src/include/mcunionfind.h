@@ -44,8 +44,8 @@ extern "C" {
 /* ============== */
 
 typedef struct {
-  int32_t Size;
-  int32_t *Fth;
+  index_t Size;
+  index_t *Fth;
   int32_t *Rank;
 } Tarjan;
 
@@ -53,14 +53,14 @@ typedef struct {
 /* prototypes     */
 /* ============== */
 
-extern Tarjan *CreeTarjan(int32_t taille);
+extern Tarjan *CreeTarjan(index_t taille);
 extern void TarjanTermine(Tarjan *T);
 extern void TarjanInit(Tarjan *T);
 extern void TarjanPrint(Tarjan *T);
-extern void TarjanMakeSet(Tarjan *T, int32_t x);
-extern int32_t TarjanFind(Tarjan *T, int32_t x);
-extern int32_t TarjanLink(Tarjan *T, int32_t x, int32_t y);
-extern int32_t TarjanLinkSafe(Tarjan *T, int32_t x, int32_t y);
+extern void TarjanMakeSet(Tarjan *T, index_t x);
+extern index_t TarjanFind(Tarjan *T, index_t x);
+extern index_t TarjanLink(Tarjan *T, index_t x, index_t y);
+extern index_t TarjanLinkSafe(Tarjan *T, index_t x, index_t y);
 
 #ifdef __cplusplus
 }
@@ -50,8 +50,8 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <sys/types.h>
 #include <sys/types.h>
 #include <stdlib.h>
-#include <mcunionfind.h>
 #include <mcimage.h>
+#include <mcunionfind.h>
 #include <jcgraphes.h>
 #include <jccomptree.h>
 #include <assert.h>
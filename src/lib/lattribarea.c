@@ -45,6 +45,7 @@ knowledge of the CeCILL license and that you accept its terms.
    Michel Couprie - 1999-2002
 
    update MC 2009 : fix bug param > surface image
+   update 2026 : images int16, int32, float et grandes images (mcmaxtree)
 */
 
 #include <stdio.h>
@@ -59,6 +60,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcfahsalembier.h>
 #include <mcutil.h>
 #include <mcindic.h>
+#include <mcmaxtree.h>
 #include <lattribarea.h>
 
 #define PARANO
@@ -255,6 +257,10 @@ int32_t lareaopening(struct xvimage *image, int32_t connex, int32_t param)
     CompTree * TREE;              /* resultat : l'arbre des composantes */
     CompactTree * CTREE;          /* resultat : l'arbre des composantes compacte' */
 
+    if ((datatype(image) != VFF_TYP_1_BYTE) || (N >= LATTRIB_NMAX)) {
+        return mcmaxtree_attributefilter(image, connex, 1, MCMAXTREE_AREA, (double)param);
+    }
+
     if (param >= N) {
         memset(F, 0, N);
         return 1;
@@ -387,6 +393,10 @@ int32_t lareaclosing(struct xvimage *image, int32_t connex, int32_t param)
     index_t N = rowsize(image) * colsize(image) * depth(image);
     uint8_t *F = UCHARDATA(image);
 
+    if ((datatype(image) != VFF_TYP_1_BYTE) || (N >= LATTRIB_NMAX)) {
+        return mcmaxtree_attributefilter(image, connex, 0, MCMAXTREE_AREA, (double)param);
+    }
+
     if (param >= N) {
         memset(F, NDG_MAX, N);
         return 1;
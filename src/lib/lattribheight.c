@@ -43,6 +43,9 @@ knowledge of the CeCILL license and that you accept its terms.
       lheightselnb   (selection d'un nombre donne de composantes)
 
    Michel Couprie - 1999-2002
+
+   update 2026 : lheightmaxima, lheightminima : images int16, int32,
+   float et grandes images (mcmaxtree)
 */
 
 #include <stdio.h>
@@ -56,6 +59,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcfahsalembier.h>
 #include <mcutil.h>
 #include <mcindic.h>
+#include <mcmaxtree.h>
 #include <lattribheight.h>
 
 #define PARANO
@@ -305,6 +309,10 @@ int32_t lheightminima(struct xvimage *image, int32_t connex, int32_t param)
 /* ==================================== */
 {
     int res;
+    index_t N = rowsize(image) * colsize(image) * depth(image);
+    if ((datatype(image) != VFF_TYP_1_BYTE) || (N >= LATTRIB_NMAX)) {
+        return mcmaxtree_attributefilter(image, connex, 0, MCMAXTREE_HEIGHT, (double)param);
+    }
     lattribheight_inverse(image);
     res = lheightmaxima(image, connex, param);
     lattribheight_inverse(image);
@@ -334,6 +342,10 @@ int32_t lheightmaxima(struct xvimage *image, int32_t connex, int32_t param)
     CompTree * TREE;              /* resultat : l'arbre des composantes */
     CompactTree * CTREE;          /* resultat : l'arbre des composantes compacte' */
 
+    if ((datatype(image) != VFF_TYP_1_BYTE) || (N >= LATTRIB_NMAX)) {
+        return mcmaxtree_attributefilter(image, connex, 1, MCMAXTREE_HEIGHT, (double)param);
+    }
+
     switch (connex) {
     case 4:
         incr_vois = 2;
@@ -43,6 +43,9 @@ knowledge of the CeCILL license and that you accept its terms.
       lvolselnb   (selection d'un nombre donne de composantes)
 
    Michel Couprie - 1999-2002
+
+   update 2026 : lvolmaxima, lsegmentvol, lvolselnb : images int16, int32,
+   float et grandes images (mcmaxtree)
 */
 
 #include <stdio.h>
@@ -56,6 +59,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcfahsalembier.h>
 #include <mcutil.h>
 #include <mcindic.h>
+#include <mcmaxtree.h>
 #include <lattribvol.h>
 
 #define PARANO
@@ -77,16 +81,48 @@ knowledge of the CeCILL license and that you accept its terms.
 /* ======================================================================== */
 /* ======================================================================== */
 
+/* ==================================== */
+static int32_t lvolsegment_mcmaxtree(struct xvimage *image, int32_t connex, int32_t param,
+                                     int32_t maximise, int32_t selnb)
+/* ==================================== */
+/* lsegmentvol (selnb = 0) ou lvolselnb (selnb = 1) par mcmaxtree */
+#undef F_NAME
+#define F_NAME "lvolsegment_mcmaxtree"
+{
+    mcmaxtree *T;
+    double *A;
+    int32_t ret;
+
+    T = mcmaxtree_build(image, connex, 1);
+    if (T == NULL) {
+        fprintf(stderr, "%s: mcmaxtree_build failed\n", F_NAME);
+        return 0;
+    }
+    A = mcmaxtree_attribute(T, image, MCMAXTREE_VOL);
+    if (A == NULL) {
+        mcmaxtree_free(T);
+        return 0;
+    }
+    if (selnb) {
+        ret = mcmaxtree_selnb(T, image, A, (index_t)param);
+    } else {
+        ret = mcmaxtree_segment(T, image, A, (double)param, maximise);
+    }
+    free(A);
+    mcmaxtree_free(T);
+    return ret;
+} /* lvolsegment_mcmaxtree() */
+
 /* ==================================== */
 int32_t lsegmentvol(struct xvimage *image, int32_t connex, int32_t param, int32_t maximise)
 /* ==================================== */
 {
-    register int32_t i, k;         /* index muet */
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    register index_t i, k;         /* index muet */
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     Fahs * FAHS;                    /* la file d'attente hierarchique */
     int32_t incr_vois;                /* 1 pour la 8-connexite,  2 pour la 4-connexite */
@@ -99,6 +135,10 @@ int32_t lsegmentvol(struct xvimage *image, int32_t connex, int32_t param, int32_
     CompactTree * CTREE;          /* resultat : l'arbre des composantes compacte' */
     int32_t nbcomp;
 
+    if ((datatype(image) != VFF_TYP_1_BYTE) || (N >= LATTRIB_NMAX)) {
+        return lvolsegment_mcmaxtree(image, connex, param, maximise, 0);
+    }
+
     switch (connex) {
     case 4:
         incr_vois = 2;
@@ -230,12 +270,12 @@ int32_t lsegmentvol(struct xvimage *image, int32_t connex, int32_t param, int32_
 int32_t lvolmaxima(struct xvimage *image, int32_t connex, int32_t param)
 /* ==================================== */
 {
-    register int32_t i, k;         /* index muet */
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    register index_t i, k;         /* index muet */
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     Fahs * FAHS;                    /* la file d'attente hierarchique */
     int32_t incr_vois;                /* 1 pour la 8-connexite,  2 pour la 4-connexite */
@@ -247,6 +287,10 @@ int32_t lvolmaxima(struct xvimage *image, int32_t connex, int32_t param)
     CompTree * TREE;              /* resultat : l'arbre des composantes */
     CompactTree * CTREE;          /* resultat : l'arbre des composantes compacte' */
 
+    if ((datatype(image) != VFF_TYP_1_BYTE) || (N >= LATTRIB_NMAX)) {
+        return mcmaxtree_attributefilter(image, connex, 1, MCMAXTREE_VOL, (double)param);
+    }
+
     switch (connex) {
     case 4:
         incr_vois = 2;
@@ -367,12 +411,12 @@ int32_t lvolmaxima(struct xvimage *image, int32_t connex, int32_t param)
 int32_t lvolselnb(struct xvimage *image, int32_t connex, int32_t param)
 /* ==================================== */
 {
-    register int32_t i, k;         /* index muet */
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    register index_t i, k;         /* index muet */
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     Fahs * FAHS;                    /* la file d'attente hierarchique */
     int32_t incr_vois;                /* 1 pour la 8-connexite,  2 pour la 4-connexite */
@@ -386,6 +430,10 @@ int32_t lvolselnb(struct xvimage *image, int32_t connex, int32_t param)
     int32_t nbcomp, nbfeuilles;
     int32_t *A;                       /* tableau pour le tri des composantes par hauteurs croissantes */
 
+    if ((datatype(image) != VFF_TYP_1_BYTE) || (N >= LATTRIB_NMAX)) {
+        return lvolsegment_mcmaxtree(image, connex, param, 0, 1);
+    }
+
     switch (connex) {
     case 4:
         incr_vois = 2;
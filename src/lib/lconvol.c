@@ -40,6 +40,9 @@ knowledge of the CeCILL license and that you accept its terms.
 /* ldirectionalfilter: supremum  de filtres linéaires utilisant un jeu de masques */
 /* Michel Couprie - avril 2003 */
 
+/* Update 2026 : modes 4 a 9 (masque separable ou de rang faible,
+   FFT par blocs, choix automatique) pour les grands masques */
+
 #include <stdio.h>
 #include <stdint.h>
 #include <sys/types.h>
@@ -49,8 +52,11 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcimage.h>
 #include <mccodimage.h>
 #include <mcutil.h>
-#include <lfft.h>
+#include <mcfft.h>
+#include <mcthreads.h>
+#include <mclin.h>
 #include <lcrop.h>
+#include <lconvol.h>
 
 #define EPSILON 1E-50
 #define BIGNUMBER 1E30
@@ -59,23 +65,533 @@ knowledge of the CeCILL license and that you accept its terms.
 
 #define TRAITEBORDS
 
+#define LCONVOL_SEPTOL 1E-6  /* erreur relative admise pour un masque "separable" */
+#define LCONVOL_BLOC   2048  /* largeur des blocs de colonnes (passe verticale) */
+#define LCONVOL_CFFT   2.0   /* cout d'une FFT complexe de taille n : CFFT * n * log2(n) */
+
+/* ==================================== */
+static int32_t lconvol_decompose(float *M, int32_t rsm, int32_t csm, double tol,
+                                 float **colk, float **rowk)
+/* ==================================== */
+/*
+  Decomposition en valeurs singulieres du masque M (csm lignes de rsm
+  elements) : M = somme_r colk[r] * rowk[r]^t (colk[r] : csm coefficients,
+  rowk[r] : rsm coefficients). Les valeurs propres de M^t M (ou de M M^t,
+  selon la plus petite dimension) sont calculees par lin_jacobi ; on garde
+  le plus petit rang r tel que l'erreur d'approximation (norme de Frobenius)
+  soit au plus tol fois la norme de M.
+  Retourne le rang (0 pour un masque nul), -1 en cas d'erreur.
+*/
+#undef F_NAME
+#define F_NAME "lconvol_decompose"
+{
+    int32_t n = mcmin(rsm, csm), i, j, k, r, rank, *ord, t;
+    double *A, *D, *V, total, reste, s;
+    float *C, *R;
+
+    A = (double *)malloc(n * n * sizeof(double));
+    D = (double *)malloc(n * sizeof(double));
+    V = (double *)malloc(n * n * sizeof(double));
+    ord = (int32_t *)malloc(n * sizeof(int32_t));
+    if ((A == NULL) || (D == NULL) || (V == NULL) || (ord == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(A);
+        free(D);
+        free(V);
+        free(ord);
+        return -1;
+    }
+    for (i = 0; i < n; i++) {
+        for (j = i; j < n; j++) {
+            s = 0.0;
+            if (n == rsm) { // A = M^t M
+                for (k = 0; k < csm; k++) {
+                    s += (double)M[k * rsm + i] * M[k * rsm + j];
+                }
+            } else {        // A = M M^t
+                for (k = 0; k < rsm; k++) {
+                    s += (double)M[i * rsm + k] * M[j * rsm + k];
+                }
+            }
+            A[i * n + j] = A[j * n + i] = s;
+        }
+    }
+    if (!lin_jacobi(A, n, D, V, 0)) {
+        fprintf(stderr, "%s: lin_jacobi failed\n", F_NAME);
+        free(A);
+        free(D);
+        free(V);
+        free(ord);
+        return -1;
+    }
+
+    // tri des valeurs propres par ordre decroissant
+    total = 0.0;
+    for (i = 0; i < n; i++) {
+        if (D[i] < 0.0) {
+            D[i] = 0.0;
+        }
+        total += D[i];
+        ord[i] = i;
+    }
+    for (i = 1; i < n; i++) {
+        t = ord[i];
+        for (j = i; (j > 0) && (D[ord[j - 1]] < D[t]); j--) {
+            ord[j] = ord[j - 1];
+        }
+        ord[j] = t;
+    }
+    reste = total;
+    for (rank = 0; (rank < n) && (reste > tol * tol * total); rank++) {
+        reste -= D[ord[rank]];
+    }
+
+    *colk = C = (float *)malloc((mcmax(rank, 1) * csm) * sizeof(float));
+    *rowk = R = (float *)malloc((mcmax(rank, 1) * rsm) * sizeof(float));
+    if ((C == NULL) || (R == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(C);
+        free(R);
+        rank = -1;
+    } else {
+        // vecteur singulier unitaire (colonne de V) et sa projection ponderee
+        for (r = 0; r < rank; r++) {
+            k = ord[r];
+            if (n == rsm) {
+                for (i = 0; i < rsm; i++) {
+                    R[r * rsm + i] = (float)V[i * n + k];
+                }
+                for (j = 0; j < csm; j++) {
+                    for (s = 0.0, i = 0; i < rsm; i++) {
+                        s += (double)M[j * rsm + i] * V[i * n + k];
+                    }
+                    C[r * csm + j] = (float)s;
+                }
+            } else {
+                for (j = 0; j < csm; j++) {
+                    C[r * csm + j] = (float)V[j * n + k];
+                }
+                for (i = 0; i < rsm; i++) {
+                    for (s = 0.0, j = 0; j < csm; j++) {
+                        s += (double)M[j * rsm + i] * V[j * n + k];
+                    }
+                    R[r * rsm + i] = (float)s;
+                }
+            }
+        }
+    }
+    free(A);
+    free(D);
+    free(V);
+    free(ord);
+    return rank;
+} // lconvol_decompose()
+
+typedef struct {
+    float *src;          /* image lue */
+    float *dst;          /* image ecrite (passe verticale : accumulee) */
+    index_t rs, cs;
+    float *k;            /* noyau 1D */
+    int32_t nk, kc;      /* taille et centre du noyau */
+    int32_t bord;        /* 0 : image nulle hors support ; 1 : extension du bord */
+    int32_t nbands;
+    int32_t err;
+} lconvol_sepjob;
+
+/* ==================================== */
+static void lconvol_lignes(void *arg, int32_t band)
+/* ==================================== */
+/*
+  passe horizontale : dst[y,x] = somme_i k[i] * src[y,x+i-kc].
+  Chaque ligne est recopiee (avec son prolongement) dans un tampon, ce
+  qui laisse des boucles internes sans test, vectorisables.
+*/
+{
+    lconvol_sepjob *J = (lconvol_sepjob *)arg;
+    index_t first, last, y, x, rs = J->rs;
+    int32_t i, nk = J->nk, kc = J->kc;
+    float *buf, *s, *d, *b, kv;
+
+    mcthreads_band(J->cs, J->nbands, band, &first, &last);
+    buf = (float *)malloc((rs + nk - 1) * sizeof(float));
+    if (buf == NULL) {
+        J->err = 1;
+        return;
+    }
+    for (y = first; y < last; y++) {
+        s = J->src + y * rs;
+        d = J->dst + y * rs;
+        for (x = 0; x < kc; x++) {
+            buf[x] = J->bord ? s[0] : 0.0f;
+        }
+        memcpy(buf + kc, s, rs * sizeof(float));
+        for (x = rs + kc; x < rs + nk - 1; x++) {
+            buf[x] = J->bord ? s[rs - 1] : 0.0f;
+        }
+        for (x = 0; x < rs; x++) {
+            d[x] = 0.0f;
+        }
+        for (i = 0; i < nk; i++) {
+            kv = J->k[i];
+            if (kv == 0.0f) {
+                continue;
+            }
+            b = buf + i;
+            for (x = 0; x < rs; x++) {
+                d[x] += kv * b[x];
+            }
+        }
+    }
+    free(buf);
+} /* lconvol_lignes() */
+
+/* ==================================== */
+static void lconvol_colonnes(void *arg, int32_t band)
+/* ==================================== */
+/*
+  passe verticale : dst[y,x] += somme_j k[j] * src[y+j-kc,x], par blocs
+  de LCONVOL_BLOC colonnes pour que les nk lignes lues restent en cache.
+*/
+{
+    lconvol_sepjob *J = (lconvol_sepjob *)arg;
+    index_t first, last, y, yy, x, x0, x1, rs = J->rs, cs = J->cs;
+    int32_t j, nk = J->nk, kc = J->kc;
+    float *s, *d, kv;
+
+    mcthreads_band(cs, J->nbands, band, &first, &last);
+    for (y = first; y < last; y++) {
+        d = J->dst + y * rs;
+        for (x0 = 0; x0 < rs; x0 += LCONVOL_BLOC) {
+            x1 = mcmin(rs, x0 + LCONVOL_BLOC);
+            for (j = 0; j < nk; j++) {
+                kv = J->k[j];
+                yy = y + j - kc;
+                if ((kv == 0.0f) || ((!J->bord) && ((yy < 0) || (yy >= cs)))) {
+                    continue;
+                }
+                yy = mcmax(0, mcmin(cs - 1, yy));
+                s = J->src + yy * rs;
+                for (x = x0; x < x1; x++) {
+                    d[x] += kv * s[x];
+                }
+            }
+        }
+    }
+} /* lconvol_colonnes() */
+
+/* ==================================== */
+int32_t lconvolsep(struct xvimage *f, struct xvimage *m, int32_t bord, double tol)
+/* ==================================== */
+/*! \fn int32_t lconvolsep(struct xvimage *f, struct xvimage *m, int32_t bord, double tol)
+    \param f (entrée/sortie) : image float 2D
+    \param m (entrée) : masque float 2D
+    \param bord (entrée) : 0 : image nulle hors support ; 1 : extension des valeurs du bord
+    \param tol (entrée) : erreur relative admise (norme de Frobenius) pour l'approximation du masque
+    \return code erreur : 0 si échec, 1 sinon
+    \brief convolution par un masque approche par une somme de masques separables
+    (decomposition en valeurs singulieres) : chaque terme est applique par une
+    passe horizontale puis une passe verticale, en O(|f|*(rsm+csm)) par terme.
+    Avec tol = LCONVOL_SEPTOL, le resultat est celui des modes 0 et 1 (aux
+    arrondis pres) ; une valeur plus grande donne une approximation de rang
+    faible pour les masques presque separables.
+*/
+#undef F_NAME
+#define F_NAME "lconvolsep"
+{
+    index_t rs = rowsize(f), cs = colsize(f), N = rs * cs, x;
+    int32_t rsm = rowsize(m), csm = colsize(m), rank, r;
+    float *F = FLOATDATA(f), *H, *T, *colk, *rowk;
+    lconvol_sepjob J;
+
+    if ((depth(f) != 1) || (depth(m) != 1)) {
+        fprintf(stderr, "%s: cette version ne traite pas les images volumiques\n", F_NAME);
+        return(0);
+    }
+    if ((datatype(f) != VFF_TYP_FLOAT) || (datatype(m) != VFF_TYP_FLOAT)) {
+        fprintf(stderr, "%s: image and mask type must be float\n", F_NAME);
+        return(0);
+    }
+    rank = lconvol_decompose(FLOATDATA(m), rsm, csm, tol, &colk, &rowk);
+    if (rank < 0) {
+        return 0;
+    }
+#ifdef DEBUG
+    printf("%s: rank = %d\n", F_NAME, rank);
+#endif
+    H = (float *)malloc(N * sizeof(float));
+    T = (float *)malloc(N * sizeof(float));
+    if ((H == NULL) || (T == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(H);
+        free(T);
+        free(colk);
+        free(rowk);
+        return 0;
+    }
+    memcpy(H, F, N * sizeof(float));
+    for (x = 0; x < N; x++) {
+        F[x] = 0.0f;
+    }
+    J.rs = rs;
+    J.cs = cs;
+    J.bord = bord;
+    J.err = 0;
+    J.nbands = mcthreads_nbands(cs);
+    for (r = 0; r < rank; r++) {
+        J.src = H;
+        J.dst = T;
+        J.k = rowk + r * rsm;
+        J.nk = rsm;
+        J.kc = rsm / 2;
+        mcthreads_run(J.nbands, lconvol_lignes, &J);
+        J.src = T;
+        J.dst = F;
+        J.k = colk + r * csm;
+        J.nk = csm;
+        J.kc = csm / 2;
+        mcthreads_run(J.nbands, lconvol_colonnes, &J);
+    }
+    free(H);
+    free(T);
+    free(colk);
+    free(rowk);
+    if (J.err) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    return 1;
+} // lconvolsep()
+
+/* ==================================== */
+static int32_t lconvol_taillebloc(int32_t n, int32_t nm)
+/* ==================================== */
+/*
+  taille de FFT pour le decoupage en blocs d'un axe de n points avec un
+  masque de nm points : minimise le cout par point utile
+  L * log2(L) / (L - nm + 1), sans depasser la taille d'une FFT globale.
+*/
+{
+    int32_t L, Lmax = mcfft_goodsize(n + nm - 1), best = Lmax;
+    double c, cbest = (double)Lmax * log((double)Lmax) / (Lmax - nm + 1);
+    for (L = mcfft_goodsize(2 * nm); L < Lmax; L = mcfft_goodsize(L + L / 4 + 1)) {
+        c = (double)L * log((double)L) / (L - nm + 1);
+        if (c < cbest) {
+            cbest = c;
+            best = L;
+        }
+    }
+    return best;
+} // lconvol_taillebloc()
+
+/* ==================================== */
+static int32_t lconvol_ola(struct xvimage *f, struct xvimage *m)
+/* ==================================== */
+/*
+  correlation par FFT sur des blocs de l'image (methode overlap-add),
+  image nulle hors support : meme resultat que le mode 2, avec des
+  transformees de taille liee a celle du masque et non a celle de l'image.
+*/
+#undef F_NAME
+#define F_NAME "lconvol_ola"
+{
+    index_t rs = rowsize(f), cs = colsize(f), N = rs * cs;
+    int32_t rsm = rowsize(m), csm = colsize(m), xc = rsm / 2, yc = csm / 2;
+    int32_t Lx = lconvol_taillebloc(rs, rsm), Ly = lconvol_taillebloc(cs, csm);
+    index_t Bx = mcmin(rs, Lx - rsm + 1), By = mcmin(cs, Ly - csm + 1);
+    index_t nf = (index_t)Ly * (Lx / 2 + 1), x, y, tx, ty, bx, by, X, Y, k;
+    float *F = FLOATDATA(f), *M = FLOATDATA(m), *H, *IP, *MP;
+    dcomplex *IF, *MF, t;
+    int32_t ret = 0;
+
+#ifdef DEBUG
+    printf("%s: Lx = %d Ly = %d Bx = %d By = %d\n", F_NAME, Lx, Ly, (int32_t)Bx, (int32_t)By);
+#endif
+    H = (float *)malloc(N * sizeof(float));
+    IP = (float *)malloc((index_t)Lx * Ly * sizeof(float));
+    MP = (float *)calloc((index_t)Lx * Ly, sizeof(float));
+    IF = (dcomplex *)malloc(nf * sizeof(dcomplex));
+    MF = (dcomplex *)malloc(nf * sizeof(dcomplex));
+    if ((H == NULL) || (IP == NULL) || (MP == NULL) || (IF == NULL) || (MF == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        goto fin;
+    }
+    for (y = 0; y < csm; y++) {
+        for (x = 0; x < rsm; x++) {
+            MP[((y-yc+Ly)%Ly)*Lx + (x-xc+Lx)%Lx] = M[y*rsm + x];
+        }
+    }
+    if (! mcfft2d_r2c(MP, Lx, Ly, MF)) {
+        fprintf(stderr, "%s: function mcfft2d_r2c failed\n", F_NAME);
+        goto fin;
+    }
+    memcpy(H, F, N * sizeof(float));
+    for (x = 0; x < N; x++) {
+        F[x] = 0.0f;
+    }
+
+    for (ty = 0; ty < cs; ty += By) {
+        by = mcmin(By, cs - ty);
+        for (tx = 0; tx < rs; tx += Bx) {
+            bx = mcmin(Bx, rs - tx);
+            for (x = 0; x < (index_t)Lx * Ly; x++) {
+                IP[x] = 0.0f;
+            }
+            for (y = 0; y < by; y++) {
+                memcpy(IP + y * Lx, H + (ty + y) * rs + tx, bx * sizeof(float));
+            }
+            if (! mcfft2d_r2c(IP, Lx, Ly, IF)) {
+                fprintf(stderr, "%s: function mcfft2d_r2c failed\n", F_NAME);
+                goto fin;
+            }
+            for (k = 0; k < nf; k++) {
+                t.re = IF[k].re * MF[k].re + IF[k].im * MF[k].im;
+                t.im = IF[k].im * MF[k].re - IF[k].re * MF[k].im;
+                IF[k] = t;
+            }
+            if (! mcfft2d_c2r(IF, Lx, Ly, IP)) {
+                fprintf(stderr, "%s: function mcfft2d_c2r failed\n", F_NAME);
+                goto fin;
+            }
+            // le bloc contribue aux points situes a moins d'une demi-largeur
+            // de masque de son support
+            for (y = -(csm - 1 - yc); y < by + yc; y++) {
+                Y = ty + y;
+                if ((Y < 0) || (Y >= cs)) {
+                    continue;
+                }
+                for (x = -(rsm - 1 - xc); x < bx + xc; x++) {
+                    X = tx + x;
+                    if ((X >= 0) && (X < rs)) {
+                        F[Y * rs + X] += IP[((y + Ly) % Ly) * Lx + (x + Lx) % Lx];
+                    }
+                }
+            }
+        }
+    }
+    ret = 1;
+fin:
+    free(H);
+    free(IP);
+    free(MP);
+    free(IF);
+    free(MF);
+    return ret;
+} // lconvol_ola()
+
+/* ==================================== */
+static int32_t lconvol_etendu(struct xvimage *f, struct xvimage *m, int32_t mode)
+/* ==================================== */
+/*
+  extension des valeurs du bord : convolution (mode "image nulle hors
+  support") d'une copie de f entouree d'un cadre, puis recopie du centre
+  dans f
+*/
+#undef F_NAME
+#define F_NAME "lconvol_etendu"
+{
+    index_t rs = rowsize(f), cs = colsize(f), y;
+    int32_t n = (mcmax(rowsize(m),colsize(m)) + 1) / 2;
+    struct xvimage *tmp = lexpandframe(f, n);
+    index_t rst;
+    if (tmp == NULL) {
+        fprintf(stderr, "%s: function lexpandframe failed\n", F_NAME);
+        return 0;
+    }
+    rst = rowsize(tmp);
+    if (! lconvol(tmp, m, mode)) {
+        fprintf(stderr, "%s: function lconvol failed\n", F_NAME);
+        freeimage(tmp);
+        return 0;
+    }
+    for (y = 0; y < cs; y++) {
+        memcpy(FLOATDATA(f) + y * rs, FLOATDATA(tmp) + (y + n) * rst + n, rs * sizeof(float));
+    }
+    freeimage(tmp);
+    return 1;
+} // lconvol_etendu()
+
+/* ==================================== */
+static int32_t lconvol_choix(struct xvimage *f, struct xvimage *m, int32_t bord)
+/* ==================================== */
+/*
+  choix de l'algorithme de moindre cout estime : direct (modes 0/1),
+  separable de rang r (modes 4/5), FFT globale (modes 2/3) ou par blocs
+  (modes 6/7). Le cout unite est une multiplication-addition.
+*/
+#undef F_NAME
+#define F_NAME "lconvol_choix"
+{
+    index_t rs = rowsize(f), cs = colsize(f), N = rs * cs, i;
+    int32_t rsm = rowsize(m), csm = colsize(m), rank, Lx, Ly, mode;
+    float *M = FLOATDATA(m), *colk, *rowk;
+    double nptb = 0, n2, cdirect, csep, cfft, cola, cmin;
+
+    for (i = 0; i < (index_t)rsm * csm; i++) {
+        if (mcabs(M[i]) > EPSILON) {
+            nptb += 1;
+        }
+    }
+    rank = lconvol_decompose(M, rsm, csm, LCONVOL_SEPTOL, &colk, &rowk);
+    if (rank < 0) {
+        return 0;
+    }
+    free(colk);
+    free(rowk);
+
+    cdirect = (double)N * nptb;
+    csep = (double)N * rank * (rsm + csm + 2);
+    // 3 transformees reelles (image, masque, inverse) ~ 1.5 transformee complexe
+    n2 = (double)mcfft_goodsize(rs + rsm - 1) * mcfft_goodsize(cs + csm - 1);
+    cfft = 1.5 * LCONVOL_CFFT * n2 * log2(n2) + 2.0 * n2;
+    Lx = lconvol_taillebloc(rs, rsm);
+    Ly = lconvol_taillebloc(cs, csm);
+    n2 = (double)Lx * Ly;
+    cola = ((double)((rs + Lx - rsm) / (Lx - rsm + 1)) * ((cs + Ly - csm) / (Ly - csm + 1)) + 0.5)
+           * (LCONVOL_CFFT * n2 * log2(n2) + 3.0 * n2);
+
+    mode = 0;
+    cmin = cdirect;
+    if (csep < cmin) {
+        mode = 4;
+        cmin = csep;
+    }
+    if (cola < cmin) {
+        mode = 6;
+        cmin = cola;
+    }
+    if (cfft < cmin) {
+        mode = 2;
+        cmin = cfft;
+    }
+#ifdef DEBUG
+    printf("%s: direct %g sep(%d) %g fft %g ola %g -> mode %d\n", F_NAME, cdirect, rank, csep, cfft, cola, mode + bord);
+#endif
+    return lconvol(f, m, mode + bord);
+} // lconvol_choix()
+
 /* ==================================== */
 int32_t lconvol(struct xvimage *f, struct xvimage *m, int32_t mode)
 /* mode = 0: algo naif - image nulle en dehors du support */
 /* mode = 1: algo naif - extension des valeurs du bord en dehors du support */
 /* mode = 2: convolution par FFT - image nulle en dehors du support */
 /* mode = 3: convolution par FFT - extension des valeurs du bord en dehors du support */
+/* mode = 4: masque separable (ou somme de masques separables) - image nulle en dehors du support */
+/* mode = 5: masque separable (ou somme de masques separables) - extension des valeurs du bord */
+/* mode = 6: FFT par blocs (overlap-add) - image nulle en dehors du support */
+/* mode = 7: FFT par blocs (overlap-add) - extension des valeurs du bord */
+/* mode = 8: choix automatique (cout estime) - image nulle en dehors du support */
+/* mode = 9: choix automatique (cout estime) - extension des valeurs du bord */
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "lconvol"
 {
-    int32_t x;                       /* index muet de pixel */
-    int32_t y;                       /* index muet (generalement un voisin de x) */
+    index_t x;                       /* index muet de pixel */
+    index_t y;                       /* index muet (generalement un voisin de x) */
     register int32_t i, j;           /* index muet */
-    register int32_t k, l;           /* index muet */
-    int32_t rs = rowsize(f);         /* taille ligne */
-    int32_t cs = colsize(f);         /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    register index_t k, l;           /* index muet */
+    index_t rs = rowsize(f);         /* taille ligne */
+    index_t cs = colsize(f);         /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     int32_t rsm = rowsize(m);        /* taille ligne masque */
     int32_t csm = colsize(m);        /* taille colonne masque */
     int32_t Nm = rsm * csm;
@@ -194,140 +710,88 @@ int32_t lconvol(struct xvimage *f, struct xvimage *m, int32_t mode)
         free(tab_m_val);
     } // if ((mode == 0) || (mode == 1))
     else if (mode == 2) {
-        struct xvimage *if1;  // FFT de imagepad (partie reelle)
-        struct xvimage *if2;  // FFT de imagepad (partie imaginaire)
-        struct xvimage *mf1;  // FFT de maskpad (partie reelle)
-        struct xvimage *mf2;  // FFT de maskpad (partie imaginaire)
-        float *IF1, *IF2, *MF1, *MF2;
-
-        rs2 = mcmax(rs+rs,cs+cs);
-        cs2 = 1;
-        while (cs2 < rs2) {
-            cs2 = cs2 << 1;
-        }
-        rs2 = cs2;
+        /* correlation par FFT (meme resultat que mode 0) : les tailles
+           rs2 >= rs + rsm - 1, cs2 >= cs + csm - 1 evitent le
+           repliement ; transformees d'images reelles (mcfft2d_r2c) */
+        float *IP, *MP;       // image et masque completes par des zeros
+        dcomplex *IF, *MF;    // leurs transformees (cs2 lignes de rs2/2+1 coefficients)
+        dcomplex t;
+        index_t k2, n2;
+
+        rs2 = mcfft_goodsize(rs + rsm - 1);
+        cs2 = mcfft_goodsize(cs + csm - 1);
+        n2 = (index_t)cs2 * (rs2 / 2 + 1);
 
 #ifdef DEBUG
-        printf("%s: rs2 = %d\n", F_NAME, rs2);
+        printf("%s: rs2 = %d cs2 = %d\n", F_NAME, rs2, cs2);
 #endif
 
-        if1 = allocimage(NULL, rs2, cs2, 1, VFF_TYP_FLOAT);
-        if2 = allocimage(NULL, rs2, cs2, 1, VFF_TYP_FLOAT);
-        mf1 = allocimage(NULL, rs2, cs2, 1, VFF_TYP_FLOAT);
-        mf2 = allocimage(NULL, rs2, cs2, 1, VFF_TYP_FLOAT);
-        if ((if1 == NULL) || (if2 == NULL) || (mf1 == NULL) || (mf2 == NULL)) {
-            fprintf(stderr, "%s: allocimage failed\n", F_NAME);
+        IP = (float *)calloc((index_t)rs2 * cs2, sizeof(float));
+        MP = (float *)calloc((index_t)rs2 * cs2, sizeof(float));
+        IF = (dcomplex *)malloc(n2 * sizeof(dcomplex));
+        MF = (dcomplex *)malloc(n2 * sizeof(dcomplex));
+        if ((IP == NULL) || (MP == NULL) || (IF == NULL) || (MF == NULL)) {
+            fprintf(stderr, "%s: malloc failed\n", F_NAME);
+            free(IP);
+            free(MP);
+            free(IF);
+            free(MF);
             return 0;
         }
-        IF1 = FLOATDATA(if1);
-        IF2 = FLOATDATA(if2);
-        MF1 = FLOATDATA(mf1);
-        MF2 = FLOATDATA(mf2);
-        for (x = 0; x < rs2 * cs2; x++) {
-            MF1[x] = MF2[x] = 0.0;
-        }
         for (y = 0; y < csm; y++) {
             for (x = 0; x < rsm; x++) {
-                MF1[((y-yc+cs2)%cs2)*rs2 + (x-xc+rs2)%rs2] = M[y*rsm + x];
+                MP[((y-yc+cs2)%cs2)*rs2 + (x-xc+rs2)%rs2] = M[y*rsm + x];
             }
         }
-#ifdef DEBUG
-        writeimage(mf1, "_maskpad");
-#endif
-        if (! lfft2(mf1, mf2, 0)) {
-            fprintf(stderr, "%s: function lfft failed\n", F_NAME);
-            return 0;
-        }
-#ifdef DEBUG
-        printf("%s: fft mask done\n", F_NAME);
-        writeimage(mf1, "_mf1");
-        writeimage(mf2, "_mf2");
-        printf("%s: xc = %d yc = %d\n", F_NAME, xc, yc);
-#endif
-
-        for (x = 0; x < rs2 * cs2; x++) {
-            IF1[x] = IF2[x] = 0.0;
-        }
         for (y = 0; y < cs; y++) {
             for (x = 0; x < rs; x++) {
-                IF1[y*rs2 + x] = F[y*rs + x];
+                IP[y*rs2 + x] = F[y*rs + x];
             }
         }
-#ifdef DEBUG
-        writeimage(if1, "_imagepad");
-#endif
-        if (! lfft2(if1, if2, 0)) {
-            fprintf(stderr, "%s: function lfft failed\n", F_NAME);
+        if (! mcfft2d_r2c(MP, rs2, cs2, MF) || ! mcfft2d_r2c(IP, rs2, cs2, IF)) {
+            fprintf(stderr, "%s: function mcfft2d_r2c failed\n", F_NAME);
+            free(IP);
+            free(MP);
+            free(IF);
+            free(MF);
             return 0;
         }
-#ifdef DEBUG
-        printf("%s: fft image done\n", F_NAME);
-        writeimage(if1, "_if1");
-        writeimage(if2, "_if2");
-#endif
-        // multiplication point a point
-        for (y = 0; y < cs2; y++) {
-            for (x = 0; x < rs2; x++) {
-                IF1[y*rs2 + x] = IF1[y*rs2 + x] * MF1[y*rs2 + x];
-                IF2[y*rs2 + x] = IF2[y*rs2 + x] * MF2[y*rs2 + x];
-            }
+
+        // produit point a point par le conjugue (correlation)
+        for (k2 = 0; k2 < n2; k2++) {
+            t.re = IF[k2].re * MF[k2].re + IF[k2].im * MF[k2].im;
+            t.im = IF[k2].im * MF[k2].re - IF[k2].re * MF[k2].im;
+            IF[k2] = t;
         }
-#ifdef DEBUG
-        printf("%s: pointwise product done\n", F_NAME);
-        writeimage(if1, "_pf1");
-        writeimage(if2, "_pf2");
-#endif
 
         // FFT inverse
-        if (! lfft2(if1, if2, 1)) {
-            fprintf(stderr, "%s: function lfft failed\n", F_NAME);
+        if (! mcfft2d_c2r(IF, rs2, cs2, IP)) {
+            fprintf(stderr, "%s: function mcfft2d_c2r failed\n", F_NAME);
+            free(IP);
+            free(MP);
+            free(IF);
+            free(MF);
             return 0;
         }
-#ifdef DEBUG
-        printf("%s: inverse fft done\n", F_NAME);
-        writeimage(if1, "_c1");
-        writeimage(if2, "_c2");
-#endif
 
         for (y = 0; y < cs; y++) {
             for (x = 0; x < rs; x++) {
-                F[y*rs + x] = IF1[y*rs2 + x];
+                F[y*rs + x] = IP[y*rs2 + x];
             }
         }
 
-        freeimage(if1);
-        freeimage(if2);
-        freeimage(mf1);
-        freeimage(mf2);
-    } else if (mode == 3) {
-        int32_t n = (mcmax(rsm,csm) + 1) / 2;
-        struct xvimage *tmp = lexpandframe(f, n);
-        if (tmp == NULL) {
-            fprintf(stderr, "%s: function lexpandframe failed\n", F_NAME);
-            return 0;
-        }
-#ifdef DEBUG
-        printf("%s: expandframe done\n", F_NAME);
-        writeimage(tmp, "_tmp");
-#endif
-
-
-        if (! lconvol(tmp, m, 2)) {
-            fprintf(stderr, "%s: function lfft failed\n", F_NAME);
-            return 0;
-        }
-#ifdef DEBUG
-        printf("%s: lconvol mode 2 done\n", F_NAME);
-        writeimage(tmp, "_tmpconvol");
-#endif
-
-        freeimage(f);
-        f = lcrop(tmp, n, n, rs, cs);
-        if (f == NULL) {
-            fprintf(stderr, "%s: function lcrop failed\n", F_NAME);
-            return 0;
-        }
-        freeimage(tmp);
+        free(IP);
+        free(MP);
+        free(IF);
+        free(MF);
+    } else if ((mode == 3) || (mode == 7)) {
+        return lconvol_etendu(f, m, mode - 1);
+    } else if ((mode == 4) || (mode == 5)) {
+        return lconvolsep(f, m, mode - 4, LCONVOL_SEPTOL);
+    } else if (mode == 6) {
+        return lconvol_ola(f, m);
+    } else if ((mode == 8) || (mode == 9)) {
+        return lconvol_choix(f, m, mode - 8);
     } else {
         fprintf(stderr,"%s : bad value for mode : %d\n", F_NAME, mode);
         return(0);
@@ -345,13 +809,14 @@ int32_t ldirectionalfilter(
 #define F_NAME "ldirectionalfilter"
 {
     double sigma, lambda, theta;
-    int32_t rs = rowsize(image);
-    int32_t cs = colsize(image);
-    int32_t N = rs * cs;
+    index_t rs = rowsize(image);
+    index_t cs = colsize(image);
+    index_t N = rs * cs;
     struct xvimage *kernel;
     int32_t rsk, csk;
     float *K;
-    int32_t n, i, j, x, y, xr, yr, x0, y0;
+    index_t i;
+    int32_t n, j, x, y, xr, yr, x0, y0;
     struct xvimage *result;
     float *R;
     struct xvimage *temp;
@@ -451,7 +916,7 @@ int32_t ldirectionalfilter(
 #endif
 
         copy2image(temp, image);
-        lconvol(temp, kernel, 3);
+        lconvol(temp, kernel, 9);
 
 #ifdef DEBUG
         strcpy(buf1, "_convol_");
@@ -45,6 +45,8 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mccodimage.h>
 #include <mcutil.h>
 #include <ldilateros.h>
+#include <ldilaterosrect.h>
+#include <mcbitimage.h>
 
 //#define VERBOSE
 
@@ -217,31 +219,25 @@ int32_t lerosnum( struct xvimage *f,
 /* ==================================== */
 int32_t ldilateros_ldilatbin(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc)
 /* operateur de dilatation binaire par un element structurant de taille quelconque */
-/* ATTENTION: l'element structurant doit etre CONNEXE et REFLEXIF */
+/* ATTENTION: l'element structurant doit etre REFLEXIF */
 /* Michel Couprie - avril 1998 */
+/* update 2026: calcul sur l'image compactee (mcbitimage) */
 /* m : masque representant l'element structurant */
 /* xc, yc : coordonnees de l'origine de l'element structurant */
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "ldilateros_ldilatbin"
 {
-    index_t x, y, z, w;              /* index muet de pixel */
-    register index_t i, j;           /* index muet */
-    register index_t k, l;           /* index muet */
-    index_t rs = rowsize(f);         /* taille ligne */
-    index_t cs = colsize(f);         /* taille colonne */
-    index_t N = rs * cs;             /* taille image */
+    register index_t i, j, k;        /* index muet */
     index_t rsm = rowsize(m);        /* taille ligne masque */
     index_t csm = colsize(m);        /* taille colonne masque */
     index_t Nm = rsm * csm;
     uint8_t *M = UCHARDATA(m);
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H = NULL;                    /* image de travail */
+    mcbitimage *b;                   /* image compactee */
     int32_t nptb;                    /* nombre de points de l'e.s. */
     int32_t *tab_es_x = NULL;               /* liste des coord. x des points de l'e.s. */
     int32_t *tab_es_y = NULL;               /* liste des coord. y des points de l'e.s. */
-    int32_t c;
-    int32_t frontiere;
+    int32_t ret;
 
     ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
     ONLY_2D(f);
@@ -251,14 +247,6 @@ int32_t ldilateros_ldilatbin(struct xvimage *f, struct xvimage *m, int32_t xc, i
         return 0;
     }
 
-    H = (uint8_t *)calloc(1,N*sizeof(char));
-    if (H == NULL) {
-        fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
-        return(0);
-    }
-
-    memcpy(H, F, N);
-
     nptb = 0;
     for (i = 0; i < Nm; i += 1) {
         if (M[i]) {
@@ -284,69 +272,41 @@ int32_t ldilateros_ldilatbin(struct xvimage *f, struct xvimage *m, int32_t xc, i
         }
     }
 
-    for (y = 0; y < cs; y++) {
-        for (x = 0; x < rs; x++) {
-            /* verifie si (x,y) est un point de la frontiere de l'objet */
-            w = y * rs + x;
-            if (H[w]) {
-                frontiere = 0;
-                for (k = 0; k < 8; k += 2) { /* on cherche une frontiere 8-connexe */
-                    z = voisin(w, k, rs, N);
-                    if ((z != -1) && (!H[z])) {
-                        frontiere = 1;
-                        break;
-                    }
-                } /* for k... */
-
-                if (!frontiere) {
-                    F[w] = NDG_MAX;
-                } else {
-                    for (c = 0; c < nptb; c += 1) {
-                        l = y + tab_es_y[c] - yc;
-                        k = x + tab_es_x[c] - xc;
-                        if ((l >= 0) && (l < cs) && (k >= 0) && (k < rs)) {
-                            F[l * rs + k] = NDG_MAX;
-                        }
-                    }
-                }
-            }
-        }
+    /* calcul sur l'image compactee (64 pixels par mot) */
+    b = mcbit_pack(f);
+    ret = (b != NULL) && mcbit_dilat(b, nptb, tab_es_x, tab_es_y, NULL, xc, yc, 0) && mcbit_unpack(b, f);
+    if (!ret) {
+        fprintf(stderr,"%s() : mcbit_dilat failed\n", F_NAME);
     }
 
-    free(H);
+    mcbit_freeimage(b);
     free(tab_es_x);
     free(tab_es_y);
-    return 1;
+    return ret;
 } /* ldilateros_ldilatbin() */
 
 /* ==================================== */
 int32_t ldilateros_lerosbin(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc)
 /* operateur d'erosion binaire par un element structurant de taille quelconque */
-/* ATTENTION: l'element structurant doit etre CONNEXE et REFLEXIF */
+/* ATTENTION: l'element structurant doit etre REFLEXIF */
 /* Michel Couprie - avril 1998 */
+/* update 2026: calcul sur l'image compactee (mcbitimage) */
 /* m : masque representant l'element structurant */
 /* xc, yc : coordonnees de l'origine de l'element structurant */
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "ldilateros_lerosbin"
 {
-    index_t x, y, z, w;              /* index muet de pixel */
-    register index_t i, j;           /* index muet */
-    register index_t k, l;           /* index muet */
-    index_t rs = rowsize(f);         /* taille ligne */
-    index_t cs = colsize(f);         /* taille colonne */
-    index_t N = rs * cs;             /* taille image */
+    register index_t i, j, k;        /* index muet */
     index_t rsm = rowsize(m);        /* taille ligne masque */
     index_t csm = colsize(m);        /* taille colonne masque */
     index_t Nm = rsm * csm;
     uint8_t *M = UCHARDATA(m);
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H = NULL;                    /* image de travail */
+    mcbitimage *b;                   /* image compactee */
     int32_t nptb;                    /* nombre de points de l'e.s. */
     int32_t *tab_es_x = NULL;               /* liste des coord. x des points de l'e.s. */
     int32_t *tab_es_y = NULL;               /* liste des coord. y des points de l'e.s. */
-    int32_t c;
-    int32_t frontiere;
+    int32_t ret;
 
     ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
     ONLY_2D(f);
@@ -356,14 +316,6 @@ int32_t ldilateros_lerosbin(struct xvimage *f, struct xvimage *m, int32_t xc, in
         return 0;
     }
 
-    H = (uint8_t *)calloc(1,N*sizeof(char));
-    if (H == NULL) {
-        fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
-        return(0);
-    }
-
-    memcpy(H, F, N);
-
     nptb = 0;
     for (i = 0; i < Nm; i += 1) {
         if (M[i]) {
@@ -389,39 +341,17 @@ int32_t ldilateros_lerosbin(struct xvimage *f, struct xvimage *m, int32_t xc, in
         }
     }
 
-    for (y = 0; y < cs; y++) {
-        for (x = 0; x < rs; x++) {
-            /* verifie si (x,y) est un point de la frontiere du fond */
-            w = y * rs + x;
-            if (!H[w]) {
-                frontiere = 0;
-                for (k = 0; k < 8; k += 2) { /* on cherche une frontiere 8-connexe */
-                    z = voisin(w, k, rs, N);
-                    if ((z != -1) && (H[z])) {
-                        frontiere = 1;
-                        break;
-                    }
-                } /* for k... */
-
-                if (!frontiere) {
-                    F[w] = NDG_MIN;
-                } else {
-                    for (c = 0; c < nptb; c += 1) {
-                        l = y + tab_es_y[c] - yc;
-                        k = x + tab_es_x[c] - xc;
-                        if ((l >= 0) && (l < cs) && (k >= 0) && (k < rs)) {
-                            F[l * rs + k] = NDG_MIN;
-                        }
-                    }
-                }
-            }
-        }
+    /* calcul sur l'image compactee ; les points conserves gardent leur valeur */
+    b = mcbit_pack(f);
+    ret = (b != NULL) && mcbit_eros(b, nptb, tab_es_x, tab_es_y, NULL, xc, yc, 0) && mcbit_unpackmin(b, f);
+    if (!ret) {
+        fprintf(stderr,"%s() : mcbit_eros failed\n", F_NAME);
     }
 
-    free(H);
+    mcbit_freeimage(b);
     free(tab_es_x);
     free(tab_es_y);
-    return 1;
+    return ret;
 } /* ldilateros_lerosbin() */
 
 /* ==================================== */
@@ -541,6 +471,7 @@ int32_t ldilatbyte(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc)
 #undef F_NAME
 #define F_NAME "ldilatbyte"
 {
+    int32_t ret;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
     register index_t i, j;                    /* index muet */
@@ -563,6 +494,9 @@ int32_t ldilatbyte(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc)
     ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
     ONLY_2D(f);
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, 0, 1)) != 0) return (ret > 0);
+
     H = (uint8_t *)calloc(1,N*sizeof(char));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -629,6 +563,7 @@ int32_t ldilatlong(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc)
 #undef F_NAME
 #define F_NAME "ldilatlong"
 {
+    int32_t ret;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
     register index_t i, j;                    /* index muet */
@@ -651,6 +586,9 @@ int32_t ldilatlong(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc)
 
 //ACCEPTED_TYPES1(f, VFF_TYP_4_BYTE);  ONLY_2D(f);
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, 0, 1)) != 0) return (ret > 0);
+
     H = (int32_t *)calloc(1,N*sizeof(int32_t));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -717,6 +655,7 @@ int32_t ldilatfloat(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
 #undef F_NAME
 #define F_NAME "ldilatfloat"
 {
+    int32_t ret;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
     register index_t i, j;                    /* index muet */
@@ -739,6 +678,9 @@ int32_t ldilatfloat(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
     ACCEPTED_TYPES1(f, VFF_TYP_FLOAT);
     ONLY_2D(f);
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, 0, 1)) != 0) return (ret > 0);
+
     H = (float *)calloc(1,N*sizeof(float));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -918,6 +860,7 @@ int32_t lerosbyte(
 #undef F_NAME
 #define F_NAME "lerosbyte"
 {
+    int32_t ret;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
     register index_t i, j;                    /* index muet */
@@ -940,6 +883,9 @@ int32_t lerosbyte(
     ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
     ONLY_2D(f);
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, 0, 0)) != 0) return (ret > 0);
+
     H = (uint8_t *)calloc(1,N*sizeof(char));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -1010,6 +956,7 @@ int32_t leroslong(
 #undef F_NAME
 #define F_NAME "leroslong"
 {
+    int32_t ret;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
     register index_t i, j;                    /* index muet */
@@ -1033,6 +980,9 @@ int32_t leroslong(
 
     ONLY_2D(f);
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, 0, 0)) != 0) return (ret > 0);
+
     H = (int32_t *)calloc(1,N*sizeof(int32_t));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -1103,6 +1053,7 @@ int32_t lerosfloat(
 #undef F_NAME
 #define F_NAME "lerosfloat"
 {
+    int32_t ret;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
     register index_t i, j;                    /* index muet */
@@ -1125,6 +1076,9 @@ int32_t lerosfloat(
     ACCEPTED_TYPES1(f, VFF_TYP_FLOAT);
     ONLY_2D(f);
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, 0, 0)) != 0) return (ret > 0);
+
     H = (float *)calloc(1,N*sizeof(float));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -1305,6 +1259,13 @@ int32_t ldilateros_ldilat(struct xvimage *f, struct xvimage *m, int32_t xc, int3
         return ldilatlong(f, m, xc, yc);
     } else if (datatype(f) == VFF_TYP_FLOAT) {
         return ldilatfloat(f, m, xc, yc);
+    } else if (datatype(f) == VFF_TYP_2_BYTE) {
+        /* pas d'algorithme general pour ce type */
+        int32_t ret = ldilaterosrect(f, m, xc, yc, 0, 1);
+        if (ret == 0) {
+            fprintf(stderr, "%s: 2-byte images: rectangle or line structuring element required\n", F_NAME);
+        }
+        return (ret > 0);
     } else {
         fprintf(stderr, "%s: bad datatype\n", F_NAME);
         return 0;
@@ -1327,6 +1288,13 @@ int32_t ldilateros_leros(struct xvimage *f, struct xvimage *m, int32_t xc, int32
         return leroslong(f, m, xc, yc);
     } else if (datatype(f) == VFF_TYP_FLOAT) {
         return lerosfloat(f, m, xc, yc);
+    } else if (datatype(f) == VFF_TYP_2_BYTE) {
+        /* pas d'algorithme general pour ce type */
+        int32_t ret = ldilaterosrect(f, m, xc, yc, 0, 0);
+        if (ret == 0) {
+            fprintf(stderr, "%s: 2-byte images: rectangle or line structuring element required\n", F_NAME);
+        }
+        return (ret > 0);
     } else {
         fprintf(stderr, "%s: bad datatype\n", F_NAME);
         return 0;
@@ -43,6 +43,8 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mccodimage.h>
 #include <mcutil.h>
 #include <ldilateros3d.h>
+#include <ldilaterosrect.h>
+#include <mcbitimage.h>
 
 /* ==================================== */
 int32_t ldilatbin3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc, int32_t zc)
@@ -50,7 +52,7 @@ int32_t ldilatbin3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
    Operateur de dilatation binaire 3D par un element structurant
    de taille quelconque
 
-   ATTENTION: l'element structurant doit etre CONNEXE et REFLEXIF
+   ATTENTION: l'element structurant doit etre REFLEXIF
 
    Michel Couprie - decembre 1999
 */
@@ -123,69 +125,28 @@ int32_t ldilatbin3d2(struct xvimage *f, int32_t nptb, int32_t *tab_es_x, int32_t
 /*
    Operateur de dilatation binaire 3D par un element structurant
    de taille quelconque
-   ATTENTION: l'element structurant doit etre CONNEXE et REFLEXIF
+   ATTENTION: l'element structurant doit etre REFLEXIF
    Michel Couprie - decembre 1999
+   update 2026: calcul sur l'image compactee (mcbitimage)
 */
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "ldilatbin3d2"
 {
-    index_t x, y, z, v, w;           /* index muet */
-    register index_t l, n, o;        /* index muet */
-    index_t rs = rowsize(f);         /* taille ligne */
-    index_t cs = colsize(f);         /* taille colonne */
-    index_t ds = depth(f);           /* nb plans */
-    index_t ps = rs * cs;            /* taille plan */
-    index_t N = ps * ds;             /* taille image */
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H;                    /* image de travail */
-    int32_t c;
-    int32_t frontiere;
+    mcbitimage *b;                   /* image compactee */
+    int32_t ret;
 
-    H = (uint8_t *)calloc(1,N*sizeof(char));
-    if (H == NULL) {
-        fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
-        return(0);
-    }
-
-    memcpy(H, F, N);
+    ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
 
-    for (z = 0; z < ds; z++) {
-        for (y = 0; y < cs; y++) {
-            for (x = 0; x < rs; x++) {
-                /* verifie si (x,y,z) est un point de la frontiere de l'objet */
-                w = z * ps + y * rs + x;
-                if (H[w]) {
-                    frontiere = 0;
-                    for (l = 0; l <= 10; l += 2) { /* parcourt les 6 voisins */
-                        v = voisin6(w, l, rs, ps, N);
-                        if ((v != -1) && (!H[v])) {
-                            frontiere = 1;
-                            break;
-                        }
-                    } /* for l... */
-
-                    if (!frontiere) {
-                        F[w] = NDG_MAX;
-                    } else {
-                        for (c = 0; c < nptb; c += 1) {
-                            o = z + tab_es_z[c] - zc;
-                            n = y + tab_es_y[c] - yc;
-                            l = x + tab_es_x[c] - xc;
-                            if ((o >= 0) && (o < ds) && (n >= 0) && (n < cs) && (l >= 0) &&
-                                    (l < rs)) {
-                                F[o * ps + n * rs + l] = NDG_MAX;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    /* calcul sur l'image compactee (64 pixels par mot) */
+    b = mcbit_pack(f);
+    ret = (b != NULL) && mcbit_dilat(b, nptb, tab_es_x, tab_es_y, tab_es_z, xc, yc, zc) && mcbit_unpack(b, f);
+    if (!ret) {
+        fprintf(stderr,"%s() : mcbit_dilat failed\n", F_NAME);
     }
 
-    free(H);
-
-    return 1;
+    mcbit_freeimage(b);
+    return ret;
 } /* ldilatbin3d2() */
 
 /* ==================================== */
@@ -194,7 +155,7 @@ int32_t ldilateros3d_lerosbin3d(struct xvimage *f, struct xvimage *m, int32_t xc
    Operateur d'erosion binaire 3D par un element structurant
    de taille quelconque
 
-   ATTENTION: l'element structurant doit etre CONNEXE et REFLEXIF
+   ATTENTION: l'element structurant doit etre REFLEXIF
 
    Michel Couprie - decembre 1999
 */
@@ -268,70 +229,29 @@ int32_t ldilateros3d_lerosbin3d2(struct xvimage *f, int32_t nptb, int32_t *tab_e
    Operateur d'erosion binaire 3D par un element structurant
    de taille quelconque
 
-   ATTENTION: l'element structurant doit etre CONNEXE et REFLEXIF
+   ATTENTION: l'element structurant doit etre REFLEXIF
 
    Michel Couprie - decembre 1999
+   update 2026: calcul sur l'image compactee (mcbitimage)
 */
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "ldilateros3d_lerosbin3d2"
 {
-    index_t x, y, z, v, w;           /* index muet */
-    register index_t l, n, o;        /* index muet */
-    index_t rs = rowsize(f);         /* taille ligne */
-    index_t cs = colsize(f);         /* taille colonne */
-    index_t ds = depth(f);           /* nb plans */
-    index_t ps = rs * cs;            /* taille plan */
-    index_t N = ps * ds;             /* taille image */
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H;                    /* image de travail */
-    int32_t c;
-    int32_t frontiere;
+    mcbitimage *b;                   /* image compactee */
+    int32_t ret;
 
-    H = (uint8_t *)calloc(1,N*sizeof(char));
-    if (H == NULL) {
-        fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
-        return(0);
-    }
-
-    memcpy(H, F, N);
+    ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
 
-    for (z = 0; z < ds; z++) {
-        for (y = 0; y < cs; y++) {
-            for (x = 0; x < rs; x++) {
-                /* verifie si (x,y,z) est un point de la frontiere du fond */
-                w = z * ps + y * rs + x;
-                if (!H[w]) {
-                    frontiere = 0;
-                    for (l = 0; l <= 10; l += 2) { /* parcourt les 6 voisins */
-                        v = voisin6(w, l, rs, ps, N);
-                        if ((v != -1) && (H[v])) {
-                            frontiere = 1;
-                            break;
-                        }
-                    } /* for l... */
-
-                    if (!frontiere) {
-                        F[w] = NDG_MIN;
-                    } else {
-                        for (c = 0; c < nptb; c += 1) {
-                            o = z + tab_es_z[c] - zc;
-                            n = y + tab_es_y[c] - yc;
-                            l = x + tab_es_x[c] - xc;
-                            if ((o >= 0) && (o < ds) && (n >= 0) && (n < cs) && (l >= 0) &&
-                                    (l < rs)) {
-                                F[o * ps + n * rs + l] = NDG_MIN;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    /* calcul sur l'image compactee ; les points conserves gardent leur valeur */
+    b = mcbit_pack(f);
+    ret = (b != NULL) && mcbit_eros(b, nptb, tab_es_x, tab_es_y, tab_es_z, xc, yc, zc) && mcbit_unpackmin(b, f);
+    if (!ret) {
+        fprintf(stderr,"%s() : mcbit_eros failed\n", F_NAME);
     }
 
-    free(H);
-
-    return 1;
+    mcbit_freeimage(b);
+    return ret;
 } /* ldilateros3d_lerosbin3d2() */
 
 /* ==================================== */
@@ -434,6 +354,7 @@ int32_t ldilatlong3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
 #undef F_NAME
 #define F_NAME "ldilatlong3d"
 {
+    int32_t ret;
     register index_t x, y, z;        /* index muet */
     register index_t i, j, k, h;     /* index muet */
     index_t rs = rowsize(f);         /* taille ligne */
@@ -456,6 +377,9 @@ int32_t ldilatlong3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
     int32_t *tab_es_z;               /* liste des coord. z des points de l'e.s. */
     int32_t c;
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, zc, 1)) != 0) return (ret > 0);
+
     H = (int32_t *)calloc(1,N*sizeof(int32_t));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -531,6 +455,7 @@ int32_t leroslong3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
 #undef F_NAME
 #define F_NAME "leroslong3d"
 {
+    int32_t ret;
     register index_t x, y, z;        /* index muet */
     register index_t i, j, k, h;     /* index muet */
     index_t rs = rowsize(f);         /* taille ligne */
@@ -553,6 +478,9 @@ int32_t leroslong3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
     int32_t *tab_es_z;               /* liste des coord. z des points de l'e.s. */
     int32_t c;
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, zc, 0)) != 0) return (ret > 0);
+
     H = (int32_t *)calloc(1,N*sizeof(int32_t));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -628,6 +556,7 @@ int32_t ldilatfloat3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t
 #undef F_NAME
 #define F_NAME "ldilatfloat3d"
 {
+    int32_t ret;
     register index_t x, y, z;        /* index muet */
     register index_t i, j, k, h;     /* index muet */
     index_t rs = rowsize(f);         /* taille ligne */
@@ -650,6 +579,9 @@ int32_t ldilatfloat3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t
     int32_t *tab_es_z;               /* liste des coord. z des points de l'e.s. */
     int32_t c;
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, zc, 1)) != 0) return (ret > 0);
+
     H = (float *)calloc(1,N*sizeof(float));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -725,6 +657,7 @@ int32_t lerosfloat3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
 #undef F_NAME
 #define F_NAME "lerosfloat3d"
 {
+    int32_t ret;
     register index_t x, y, z;        /* index muet */
     register index_t i, j, k, h;     /* index muet */
     index_t rs = rowsize(f);         /* taille ligne */
@@ -747,6 +680,9 @@ int32_t lerosfloat3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
     int32_t *tab_es_z;               /* liste des coord. z des points de l'e.s. */
     int32_t c;
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, zc, 0)) != 0) return (ret > 0);
+
     H = (float *)calloc(1,N*sizeof(float));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -822,6 +758,7 @@ int32_t ldilatbyte3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
 #undef F_NAME
 #define F_NAME "ldilatbyte3d"
 {
+    int32_t ret;
     register index_t x, y, z;        /* index muet */
     register index_t i, j, k, h;     /* index muet */
     index_t rs = rowsize(f);         /* taille ligne */
@@ -844,6 +781,9 @@ int32_t ldilatbyte3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
     int32_t *tab_es_z;               /* liste des coord. z des points de l'e.s. */
     int32_t c;
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, zc, 1)) != 0) return (ret > 0);
+
     H = (uint8_t *)calloc(1,N*sizeof(char));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -919,6 +859,7 @@ int32_t lerosbyte3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
 #undef F_NAME
 #define F_NAME "lerosbyte3d"
 {
+    int32_t ret;
     register index_t x, y, z;        /* index muet */
     register index_t i, j, k, h;     /* index muet */
     index_t rs = rowsize(f);         /* taille ligne */
@@ -941,6 +882,9 @@ int32_t lerosbyte3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
     int32_t *tab_es_z;               /* liste des coord. z des points de l'e.s. */
     int32_t c;
 
+    /* element structurant rectangulaire ou segment : algorithme rapide */
+    if ((ret = ldilaterosrect(f, m, xc, yc, zc, 0)) != 0) return (ret > 0);
+
     H = (uint8_t *)calloc(1,N*sizeof(char));
     if (H == NULL) {
         fprintf(stderr,"%s() : malloc failed for H\n", F_NAME);
@@ -1022,6 +966,13 @@ int32_t ldilat3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc, i
         return ldilatlong3d(f, m, xc, yc, zc);
     } else if (datatype(f) == VFF_TYP_FLOAT) {
         return ldilatfloat3d(f, m, xc, yc, zc);
+    } else if (datatype(f) == VFF_TYP_2_BYTE) {
+        /* pas d'algorithme general pour ce type */
+        int32_t ret = ldilaterosrect(f, m, xc, yc, zc, 1);
+        if (ret == 0) {
+            fprintf(stderr, "%s: 2-byte images: rectangle or line structuring element required\n", F_NAME);
+        }
+        return (ret > 0);
     } else {
         fprintf(stderr, "%s: bad datatype\n", F_NAME);
         return 0;
@@ -1044,6 +995,13 @@ int32_t leros3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc, in
         return leroslong3d(f, m, xc, yc, zc);
     } else if (datatype(f) == VFF_TYP_FLOAT) {
         return lerosfloat3d(f, m, xc, yc, zc);
+    } else if (datatype(f) == VFF_TYP_2_BYTE) {
+        /* pas d'algorithme general pour ce type */
+        int32_t ret = ldilaterosrect(f, m, xc, yc, zc, 0);
+        if (ret == 0) {
+            fprintf(stderr, "%s: 2-byte images: rectangle or line structuring element required\n", F_NAME);
+        }
+        return (ret > 0);
     } else {
         fprintf(stderr, "%s: bad datatype\n", F_NAME);
         return 0;
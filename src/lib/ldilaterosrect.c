@@ -0,0 +1,365 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Dilatation et erosion numeriques par des elements structurants plans
+   decomposables en segments : rectangles et paralleplipedes (produits de
+   segments paralleles aux axes), segments paralleles aux axes ou
+   diagonaux (directions a 45 degres).
+
+   Chaque segment est traite ligne par ligne par l'algorithme de van Herk /
+   Gil-Werman : maxima (minima) cumules par blocs de la taille du segment,
+   vers l'avant et vers l'arriere, soit 3 comparaisons par point quelle
+   que soit la taille de l'element structurant.
+
+   Les conventions sont celles de ldilatbyte, lerosbyte, ldilat3d, ...
+   (element structurant symetrise, points hors de l'image ignores), et
+   les resultats sont identiques.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <pinktypes.h>
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <mcutil.h>
+#include <mcthreads.h>
+#include <ldilaterosrect.h>
+
+/* un segment : direction (dx,dy,dz) et fenetre [a,b] le long de la ligne */
+typedef struct {
+    int32_t dx, dy, dz;
+    index_t a, b;
+} rect_seg;
+
+typedef struct {
+    struct xvimage *f;
+    index_t rs, cs, ds, ps;
+    rect_seg s;
+    int32_t dilat;
+    double init;              /* valeur initiale (points hors de l'image) */
+    index_t *starts;          /* premiers points des lignes */
+    index_t nstarts;
+    int32_t nbands;
+    int32_t err;
+} rect_job;
+
+/* ==================================== */
+static void rect_max(double *E, index_t M, index_t w, double *g, double *h)
+/* ==================================== */
+/* g : max cumules depuis le debut de chaque bloc de taille w ;
+   h : max cumules depuis la fin de chaque bloc */
+{
+    index_t s, e, k;
+    for (s = 0; s < M; s += w) {
+        e = mcmin(s + w, M);
+        g[s] = E[s];
+        for (k = s + 1; k < e; k++) g[k] = mcmax(g[k - 1], E[k]);
+        h[e - 1] = E[e - 1];
+        for (k = e - 2; k >= s; k--) h[k] = mcmax(h[k + 1], E[k]);
+    }
+}
+
+/* ==================================== */
+static void rect_min(double *E, index_t M, index_t w, double *g, double *h)
+/* ==================================== */
+{
+    index_t s, e, k;
+    for (s = 0; s < M; s += w) {
+        e = mcmin(s + w, M);
+        g[s] = E[s];
+        for (k = s + 1; k < e; k++) g[k] = mcmin(g[k - 1], E[k]);
+        h[e - 1] = E[e - 1];
+        for (k = e - 2; k >= s; k--) h[k] = mcmin(h[k + 1], E[k]);
+    }
+}
+
+/* ==================================== */
+static void rect_band(void *arg, int32_t band)
+/* ==================================== */
+{
+    rect_job *J = (rect_job *)arg;
+    index_t rs = J->rs, cs = J->cs, ds = J->ds, ps = J->ps;
+    int32_t dx = J->s.dx, dy = J->s.dy, dz = J->s.dz;
+    index_t a = J->s.a, w = J->s.b - J->s.a + 1;
+    index_t step = dx + dy * rs + dz * ps;
+    index_t Lmax = mcmax(rs, mcmax(cs, ds));
+    index_t first, last, n, p, x, y, z, L, M, t, k;
+    double *E, *g, *h, *V, init = J->init;
+    void *F = J->f->image_data;
+    int32_t type = datatype(J->f);
+
+    mcthreads_band(J->nstarts, J->nbands, band, &first, &last);
+    if (first == last) return;
+    E = (double *)malloc((4 * (Lmax + w)) * sizeof(double));
+    if (E == NULL) {
+        J->err = 1;
+        return;
+    }
+    g = E + Lmax + w;
+    h = g + Lmax + w;
+    V = h + Lmax + w;
+
+    for (n = first; n < last; n++) {
+        p = J->starts[n];
+        x = p % rs;
+        y = (p % ps) / rs;
+        z = p / ps;
+        /* longueur de la ligne */
+        L = Lmax;
+        if (dx > 0) L = mcmin(L, rs - x); else if (dx < 0) L = mcmin(L, x + 1);
+        if (dy > 0) L = mcmin(L, cs - y); else if (dy < 0) L = mcmin(L, y + 1);
+        if (dz > 0) L = mcmin(L, ds - z); else if (dz < 0) L = mcmin(L, z + 1);
+
+        /* lecture de la ligne */
+        switch (type) {
+        case VFF_TYP_1_BYTE:
+            for (t = 0; t < L; t++) V[t] = (double)((uint8_t *)F)[p + t * step];
+            break;
+        case VFF_TYP_2_BYTE:
+            for (t = 0; t < L; t++) V[t] = (double)((int16_t *)F)[p + t * step];
+            break;
+        case VFF_TYP_4_BYTE:
+            for (t = 0; t < L; t++) V[t] = (double)((int32_t *)F)[p + t * step];
+            break;
+        default:
+            for (t = 0; t < L; t++) V[t] = (double)((float *)F)[p + t * step];
+        }
+
+        /* E[k] : point d'indice a + k de la ligne */
+        M = L + w - 1;
+        for (k = 0; k < M; k++) {
+            t = a + k;
+            E[k] = ((t >= 0) && (t < L)) ? V[t] : init;
+        }
+        if (J->dilat) {
+            rect_max(E, M, w, g, h);
+            for (t = 0; t < L; t++) {
+                V[t] = mcmax(h[t], g[t + w - 1]);
+                if (V[t] < init) V[t] = init;
+            }
+        } else {
+            rect_min(E, M, w, g, h);
+            for (t = 0; t < L; t++) {
+                V[t] = mcmin(h[t], g[t + w - 1]);
+                if (V[t] > init) V[t] = init;
+            }
+        }
+
+        /* ecriture de la ligne */
+        switch (type) {
+        case VFF_TYP_1_BYTE:
+            for (t = 0; t < L; t++) ((uint8_t *)F)[p + t * step] = (uint8_t)V[t];
+            break;
+        case VFF_TYP_2_BYTE:
+            for (t = 0; t < L; t++) ((int16_t *)F)[p + t * step] = (int16_t)V[t];
+            break;
+        case VFF_TYP_4_BYTE:
+            for (t = 0; t < L; t++) ((int32_t *)F)[p + t * step] = (int32_t)V[t];
+            break;
+        default:
+            for (t = 0; t < L; t++) ((float *)F)[p + t * step] = (float)V[t];
+        }
+    } /* for n */
+    free(E);
+} /* rect_band() */
+
+/* ==================================== */
+int32_t ldilaterosrect_line(
+    struct xvimage *f,
+    int32_t dx, int32_t dy, int32_t dz,
+    index_t a, index_t b,
+    int32_t dilat)
+/* ==================================== */
+/* dilatation (dilat != 0) ou erosion de f, en place, par un segment de
+   direction (dx,dy,dz) (composantes dans {-1,0,1}) :
+   f'(p) = max (ou min) des f(p + t*(dx,dy,dz)), a <= t <= b,
+   les points hors de l'image etant ignores (meme valeur initiale que
+   ldilatbyte, ldilatlong, ... lorsque tous sont hors de l'image).
+   Types : byte, short, long, float. */
+#undef F_NAME
+#define F_NAME "ldilaterosrect_line"
+{
+    rect_job J;
+    index_t rs = rowsize(f), cs = colsize(f), ds = depth(f), ps = rs * cs;
+    index_t x, y, z, n;
+
+    if ((dx < -1) || (dx > 1) || (dy < -1) || (dy > 1) || (dz < -1) || (dz > 1) ||
+        ((dx == 0) && (dy == 0) && (dz == 0)) || (a > b)) {
+        fprintf(stderr, "%s: bad segment\n", F_NAME);
+        return 0;
+    }
+    switch (datatype(f)) {
+    case VFF_TYP_1_BYTE: J.init = dilat ? NDG_MIN : NDG_MAX; break;
+    case VFF_TYP_2_BYTE: J.init = dilat ? INT16_MIN : INT16_MAX; break;
+    case VFF_TYP_4_BYTE: J.init = dilat ? INT32_MIN : INT32_MAX; break;
+    case VFF_TYP_FLOAT: J.init = dilat ? FLOAT_MIN : FLOAT_MAX; break;
+    default:
+        fprintf(stderr, "%s: bad datatype\n", F_NAME);
+        return 0;
+    }
+    if ((a == 0) && (b == 0)) return 1;
+
+    J.f = f;
+    J.rs = rs; J.cs = cs; J.ds = ds; J.ps = ps;
+    J.s.dx = dx; J.s.dy = dy; J.s.dz = dz; J.s.a = a; J.s.b = b;
+    J.dilat = dilat;
+    J.err = 0;
+
+    /* premiers points des lignes : p tel que p - d est hors de l'image */
+    n = 0;
+    if (dx) n += cs * ds;
+    if (dy) n += rs * ds;
+    if (dz) n += ps;
+    J.starts = (index_t *)malloc(n * sizeof(index_t));
+    if (J.starts == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    n = 0;
+    for (z = 0; z < ds; z++)
+        for (y = 0; y < cs; y++)
+            for (x = 0; x < rs; x++)
+                if ((x - dx < 0) || (x - dx >= rs) || (y - dy < 0) || (y - dy >= cs) ||
+                    (z - dz < 0) || (z - dz >= ds))
+                    J.starts[n++] = z * ps + y * rs + x;
+    J.nstarts = n;
+
+    J.nbands = mcthreads_nbands(n);
+    mcthreads_run(J.nbands, rect_band, &J);
+    free(J.starts);
+    if (J.err) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    return 1;
+} /* ldilaterosrect_line() */
+
+/* ==================================== */
+static int32_t rect_decompose(struct xvimage *m, index_t xc, index_t yc, index_t zc,
+                              rect_seg *seg, int32_t *nseg)
+/* ==================================== */
+/* decompose l'element structurant m, d'origine (xc,yc,zc), en segments ;
+   retourne 0 si m n'est ni un parallelepipede ni un segment diagonal
+   contenant son origine */
+{
+    index_t rsm = rowsize(m), csm = colsize(m), dsm = depth(m), psm = rsm * csm;
+    uint8_t *M = UCHARDATA(m);
+    index_t x, y, z, n = 0;
+    index_t x0 = rsm, x1 = -1, y0 = csm, y1 = -1, z0 = dsm, z1 = -1;
+    index_t wx, wy, wz, u, t;
+    int32_t sy, sz;
+
+    if (datatype(m) != VFF_TYP_1_BYTE) return 0;
+    for (z = 0; z < dsm; z++)
+        for (y = 0; y < csm; y++)
+            for (x = 0; x < rsm; x++)
+                if (M[z * psm + y * rsm + x]) {
+                    n++;
+                    x0 = mcmin(x0, x); x1 = mcmax(x1, x);
+                    y0 = mcmin(y0, y); y1 = mcmax(y1, y);
+                    z0 = mcmin(z0, z); z1 = mcmax(z1, z);
+                }
+    if (n == 0) return 0;
+    wx = x1 - x0 + 1;
+    wy = y1 - y0 + 1;
+    wz = z1 - z0 + 1;
+
+    *nseg = 0;
+    if (n == wx * wy * wz) { /* parallelepipede (ou segment parallele a un axe) */
+        /* f'(p) = max f(p + c - q), q dans [x0,x1]x[y0,y1]x[z0,z1] */
+        seg[*nseg].dx = 1; seg[*nseg].dy = 0; seg[*nseg].dz = 0;
+        seg[*nseg].a = xc - x1; seg[*nseg].b = xc - x0; (*nseg)++;
+        seg[*nseg].dx = 0; seg[*nseg].dy = 1; seg[*nseg].dz = 0;
+        seg[*nseg].a = yc - y1; seg[*nseg].b = yc - y0; (*nseg)++;
+        seg[*nseg].dx = 0; seg[*nseg].dy = 0; seg[*nseg].dz = 1;
+        seg[*nseg].a = zc - z1; seg[*nseg].b = zc - z0; (*nseg)++;
+        return 1;
+    }
+
+    /* segment diagonal de n points : chaque etendue vaut 1 ou n */
+    if (((wx != 1) && (wx != n)) || ((wy != 1) && (wy != n)) || ((wz != 1) && (wz != n)))
+        return 0;
+    for (sy = -1; sy <= 1; sy += 2)
+        for (sz = -1; sz <= 1; sz += 2) {
+            /* direction d : la premiere composante non nulle est positive */
+            int32_t dx = (wx == n) ? 1 : 0;
+            int32_t dy = (wy == n) ? ((dx == 0) ? 1 : sy) : 0;
+            int32_t dz = (wz == n) ? (((dx == 0) && (dy == 0)) ? 1 : sz) : 0;
+            index_t px = x0, py = (dy < 0) ? y1 : y0, pz = (dz < 0) ? z1 : z0;
+            for (t = 0; t < n; t++)
+                if (!M[(pz + t * dz) * psm + (py + t * dy) * rsm + (px + t * dx)]) break;
+            if (t < n) continue;
+            /* l'origine doit etre sur la droite : c = p + u*d */
+            u = (dx != 0) ? (xc - px) : (dy != 0) ? (yc - py) * dy : (zc - pz) * dz;
+            if ((xc != px + u * dx) || (yc != py + u * dy) || (zc != pz + u * dz))
+                return 0;
+            /* f'(p) = max f(p + (u - t)*d), 0 <= t < n */
+            seg[0].dx = dx; seg[0].dy = dy; seg[0].dz = dz;
+            seg[0].a = u - n + 1; seg[0].b = u;
+            *nseg = 1;
+            return 1;
+        }
+    return 0;
+} /* rect_decompose() */
+
+/* ==================================== */
+int32_t ldilaterosrect(
+    struct xvimage *f,
+    struct xvimage *m,
+    index_t xc, index_t yc, index_t zc,
+    int32_t dilat)
+/* ==================================== */
+/* dilatation (dilat != 0) ou erosion de f, en place, par l'element
+   structurant plan m d'origine (xc,yc,zc), lorsque m est decomposable
+   en segments (voir rect_decompose).
+   Retourne 1 si l'operation a ete faite, 0 si m n'est pas decomposable
+   ou si le type n'est pas traite (l'appelant utilise alors l'algorithme
+   general), -1 en cas d'echec. */
+{
+    rect_seg seg[3];
+    int32_t nseg, i;
+
+    if ((datatype(f) != VFF_TYP_1_BYTE) && (datatype(f) != VFF_TYP_2_BYTE) &&
+        (datatype(f) != VFF_TYP_4_BYTE) && (datatype(f) != VFF_TYP_FLOAT))
+        return 0;
+    if ((depth(f) == 1) && (depth(m) != 1)) return 0;
+    if (!rect_decompose(m, xc, yc, zc, seg, &nseg)) return 0;
+    for (i = 0; i < nseg; i++)
+        if (!ldilaterosrect_line(f, seg[i].dx, seg[i].dy, seg[i].dz, seg[i].a, seg[i].b, dilat))
+            return -1;
+    return 1;
+} /* ldilaterosrect() */
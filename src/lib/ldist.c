@@ -67,6 +67,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mclifo.h>
 #include <mcutil.h>
 #include <mcgeo.h>
+#include <mcthreads.h>
 #include <ldist.h>
 
 //#define VERBOSE
@@ -1009,200 +1010,223 @@ int32_t lchamfrein(struct xvimage *img,   /* donnee: image binaire */
 /*************************              */
 /* date: 16/05/2002                     */
 /*************************              */
-/* comments:                            */
-/*  attention, risques de pbs           */
-/*  (manque de memoire)                 */
-/*  dans cette version?                 */
-/*  [risque faible; mais eviter les     */
-/*  images d'arrete superieur a 256     */
-/*  (en fait tout depend du centrage... */
-/*  il serait bon néanmoins de faire    */
-/*  varier DC_SZ selon la distance      */
-/*  (pour une valeur elevee de distance */
-/*  les Dcols devraient etre            */
-/*  de plus en plus vides)]             */
+/* 2026 : file d'attente a niveaux en   */
+/*  blocs preallouees                   */
 /****************************************/
 
-/********************************************************************/
-/*                               MACROS                             */
-/********************************************************************/
-
-#define _Drun( cl, et, com)   { \
-   Dcol* __col=cl; int32_t __it;Dcell* et; \
-   while(__col!=NULL) \
-   { for(__it=0;__it<__col->nb;__it++) \
-   { et=(__col->tab)+__it; \
-   com ; } __col=__col->next; } }
-#define DC_SZ 1<<12
+/*
+  Propagation de vecteurs (Danielsson, Ragnemalm) : chaque point du front
+  porte le vecteur (dx,dy,dz) qui le separe du point objet dont il recoit
+  la distance. Les points en attente sont ranges par valeur de distance
+  quadratique (file a niveaux), chaque niveau etant une liste de blocs de
+  DQ_BLOC cellules pris dans une reserve contigue et recycles des que le
+  niveau est traite : pas d'allocation par point ni par niveau.
+  Un point de niveau d ne cree que des points de niveau au plus
+  d + 2*max(rs,cs,ds) : les niveaux sont ranges dans un tableau circulaire
+  de cette taille, et la propagation s'arrete des que la file est vide.
+  L'ordre de traitement (niveaux croissants, ordre d'insertion dans un
+  niveau) est celui de la version precedente, d'ou les memes distances.
+*/
+
+#define DQ_BLOC 128
 #define MAXD 1<<20
 #define IsSet2(i,x,y,z) UCHARDATA(i)[((z)*(colsize(i))+(y))*(rowsize(i))+(x)]
 
-/********************************************************************/
-/*                               TYPES                              */
-/********************************************************************/
-
-typedef struct _Doc {
+typedef struct {
     int16_t x;
     int16_t y;
     int16_t z;
     int16_t dx;
     int16_t dy;
     int16_t dz;
-} Dcell; //sert pour les cellules libres ET occupees!
-
-typedef struct _Dcol {
-    int32_t nb;//nombre de cellules occupees
-    Dcell tab[DC_SZ];
-    struct _Dcol* next;
-} Dcol;
-
-typedef struct _Dbase {
-    int32_t max;
-    Dcol** cols;
-    Dcol* add;
-    Dcol* cur;
-} Drow;
-
-
-/********************************************************************/
-/*                      ALLOUER/DESALLOUER                          */
-/********************************************************************/
-
-Dcol* Dsetcol() {
-    Dcol* nw=(Dcol*)calloc(1,sizeof(Dcol));
-    nw->nb=0;
-    nw->next=NULL;
-    return nw;
-}
-
-Dcol* Dfreecol(Dcol* c) {
-    if(c!=NULL) {
-        Dfreecol(c->next);
-        free(c);
-    }
-    return NULL;
-}
-
-Dcol* Dresetcol(Dcol* tg) {
-    if(tg!=NULL) {
-        tg->nb=0;
-        if (tg->next != NULL) {
-            tg->next = Dresetcol(tg->next);
-        }
-    } else {
-        tg = Dsetcol();
-    }
-    return tg;
-}
-
-/* alloue la table des buckets*/
-Drow* Dsetground(int32_t _max) {
-    int32_t i,sz=_max+1;
-    Drow* nw=(Drow*)calloc(1,sizeof(Drow));
-    nw->max=_max;
-    nw->cols=(Dcol**)calloc(1,sz*sizeof(Dcol*));
-    for (i = 0; i < sz; i++) {
-        nw->cols[i] = NULL;
-    }
-    nw->cur=NULL;
-    nw->add=Dsetcol();
-    return nw;
-}
-
-
-/********************************************************************/
-/*                     GESTION DES CELLULES                         */
-/********************************************************************/
-
-/*n'est en general pas appele directement*/
-Dcol* Dadd2col(Dcol* c, int32_t x, int32_t y, int32_t z,int32_t dx, int32_t dy, int32_t dz ) {
-    int32_t free=c->nb;
-    if(free<DC_SZ) {
-        c->tab[free].x=(int16_t)x;
-        c->tab[free].y=(int16_t)y;
-        c->tab[free].z=(int16_t)z;
-        c->tab[free].dx=(int16_t)dx;
-        c->tab[free].dy=(int16_t)dy;
-        c->tab[free].dz=(int16_t)dz;
-        c->nb++;
-    } else {
-        if(c->next==NULL) {
-            c->next=Dsetcol();
-        }
-        Dadd2col(c->next,x,y,z,dx,dy,dz);
-    }
-    return c;
-}
+} Dcell;
+
+typedef struct {
+    int32_t nb;          /* nombre de cellules occupees */
+    int32_t next;        /* bloc suivant du meme niveau (-1 : aucun) */
+    Dcell tab[DQ_BLOC];
+} Dbloc;
+
+typedef struct {
+    Dbloc *blocs;        /* reserve de blocs */
+    int32_t nblocs;      /* nombre de blocs utilises dans la reserve */
+    int32_t maxblocs;    /* taille de la reserve */
+    int32_t libre;       /* liste des blocs recycles (-1 : vide) */
+    index_t nniv;        /* nombre de niveaux (tableau circulaire) */
+    int32_t *tete;       /* premier bloc de chaque niveau */
+    int32_t *queue;      /* dernier bloc de chaque niveau */
+    index_t nbcell;      /* nombre de cellules en attente */
+} Dfile;
 
-Dcol* Dadd(Drow* r,int32_t x, int32_t y, int32_t z, int32_t dx, int32_t dy, int32_t dz, int32_t val) {
-    if (val > r->max) {
+/* ==================================== */
+static Dfile *Dfile_cree(index_t nniv)
+/* ==================================== */
+{
+    index_t i;
+    Dfile *F = (Dfile *)calloc(1, sizeof(Dfile));
+    if (F == NULL) {
+        return NULL;
+    }
+    F->nniv = nniv;
+    F->maxblocs = 1024;
+    F->libre = -1;
+    F->blocs = (Dbloc *)malloc(F->maxblocs * sizeof(Dbloc));
+    F->tete = (int32_t *)malloc(nniv * sizeof(int32_t));
+    F->queue = (int32_t *)malloc(nniv * sizeof(int32_t));
+    if ((F->blocs == NULL) || (F->tete == NULL) || (F->queue == NULL)) {
+        free(F->blocs);
+        free(F->tete);
+        free(F->queue);
+        free(F);
         return NULL;
     }
-    if (r->cols[val] == NULL) {
-        r->cols[val] = Dsetcol();
+    for (i = 0; i < nniv; i++) {
+        F->tete[i] = F->queue[i] = -1;
     }
-    return Dadd2col(r->cols[val],x,y,z,dx,dy,dz);
-}
+    return F;
+} // Dfile_cree()
 
-/********************************************************************/
-/*                    CODE POUR LES DISTANCES                       */
-/********************************************************************/
+/* ==================================== */
+static void Dfile_termine(Dfile *F)
+/* ==================================== */
+{
+    free(F->blocs);
+    free(F->tete);
+    free(F->queue);
+    free(F);
+} // Dfile_termine()
 
-void testAndAdd(Drow* r, struct xvimage* o,Dcell* t, int32_t d) {
-    int32_t nd;
-    int32_t rs=rowsize(o),cs=colsize(o),ds=depth(o);
-    uint32_t* O=ULONGDATA(o);
-    if(t->dx>0 && t->x<rs-1) {
-        nd=d+2*t->dx+1;
-        if(nd<O[(t->z*cs+t->y)*rs+t->x+1]) {
-            O[(t->z*cs+t->y)*rs+t->x+1]=nd;
-            Dadd(r,t->x+1,t->y,t->z,t->dx+1,t->dy,t->dz,nd);
+/* ==================================== */
+static int32_t Dfile_ajoute(Dfile *F, index_t niv, index_t x, index_t y, index_t z,
+                            index_t dx, index_t dy, index_t dz)
+/* ==================================== */
+// retourne 0 en cas d'echec d'allocation
+{
+    int32_t b;
+    Dcell *c;
+    niv = niv % F->nniv;
+    b = F->queue[niv];
+    if ((b == -1) || (F->blocs[b].nb == DQ_BLOC)) { // nouveau bloc
+        int32_t nb;
+        if (F->libre != -1) {
+            nb = F->libre;
+            F->libre = F->blocs[nb].next;
+        } else {
+            if (F->nblocs == F->maxblocs) {
+                Dbloc *t = (Dbloc *)realloc(F->blocs, 2 * F->maxblocs * sizeof(Dbloc));
+                if (t == NULL) {
+                    return 0;
+                }
+                F->blocs = t;
+                F->maxblocs *= 2;
+            }
+            nb = F->nblocs++;
         }
-    } else if(t->dx<0 && t->x>0) {
-        nd=d-2*t->dx+1;
-        if(nd<O[(t->z*cs+t->y)*rs+t->x-1]) {
-            O[(t->z*cs+t->y)*rs+t->x-1]=nd;
-            Dadd(r,t->x-1,t->y,t->z,t->dx-1,t->dy,t->dz,nd);
+        F->blocs[nb].nb = 0;
+        F->blocs[nb].next = -1;
+        if (b == -1) {
+            F->tete[niv] = nb;
+        } else {
+            F->blocs[b].next = nb;
+        }
+        F->queue[niv] = b = nb;
+    }
+    c = F->blocs[b].tab + F->blocs[b].nb++;
+    c->x = (int16_t)x;
+    c->y = (int16_t)y;
+    c->z = (int16_t)z;
+    c->dx = (int16_t)dx;
+    c->dy = (int16_t)dy;
+    c->dz = (int16_t)dz;
+    F->nbcell++;
+    return 1;
+} // Dfile_ajoute()
+
+/* ==================================== */
+static int32_t Dpropage(Dfile *F, uint32_t *O, index_t rs, index_t cs, index_t ds,
+                        index_t max, Dcell t, index_t d)
+/* ==================================== */
+// propage la distance d du point t a ses voisins dans la direction de son vecteur
+{
+    index_t nd, p = (t.z * cs + t.y) * rs + t.x;
+    int32_t ok = 1;
+    if (t.dx > 0 && t.x < rs - 1) {
+        nd = d + 2 * t.dx + 1;
+        if (nd < O[p + 1]) {
+            O[p + 1] = nd;
+            if (nd <= max) {
+                ok &= Dfile_ajoute(F, nd, t.x + 1, t.y, t.z, t.dx + 1, t.dy, t.dz);
+            }
+        }
+    } else if (t.dx < 0 && t.x > 0) {
+        nd = d - 2 * t.dx + 1;
+        if (nd < O[p - 1]) {
+            O[p - 1] = nd;
+            if (nd <= max) {
+                ok &= Dfile_ajoute(F, nd, t.x - 1, t.y, t.z, t.dx - 1, t.dy, t.dz);
+            }
         }
     }
-    if(t->dy>0 && t->y<cs-1) {
-        nd=d+2*t->dy+1;
-        if(nd<O[(t->z*cs+(t->y+1))*rs+t->x]) {
-            O[(t->z*cs+(t->y+1))*rs+t->x]=nd;
-            Dadd(r,t->x,t->y+1,t->z,t->dx,t->dy+1,t->dz,nd);
+    if (t.dy > 0 && t.y < cs - 1) {
+        nd = d + 2 * t.dy + 1;
+        if (nd < O[p + rs]) {
+            O[p + rs] = nd;
+            if (nd <= max) {
+                ok &= Dfile_ajoute(F, nd, t.x, t.y + 1, t.z, t.dx, t.dy + 1, t.dz);
+            }
         }
-    } else if(t->dy<0 && t->y>0) {
-        nd=d-2*t->dy+1;
-        if(nd<O[(t->z*cs+(t->y-1))*rs+t->x]) {
-            O[(t->z*cs+(t->y-1))*rs+t->x]=nd;
-            Dadd(r,t->x,t->y-1,t->z,t->dx,t->dy-1,t->dz,nd);
+    } else if (t.dy < 0 && t.y > 0) {
+        nd = d - 2 * t.dy + 1;
+        if (nd < O[p - rs]) {
+            O[p - rs] = nd;
+            if (nd <= max) {
+                ok &= Dfile_ajoute(F, nd, t.x, t.y - 1, t.z, t.dx, t.dy - 1, t.dz);
+            }
         }
     }
-    if(t->dz>0 && t->z<ds-1) {
-        nd=d+2*t->dz+1;
-        if(nd<O[((t->z+1)*cs+t->y)*rs+t->x]) {
-            O[((t->z+1)*cs+t->y)*rs+t->x]=nd;
-            Dadd(r,t->x,t->y,t->z+1,t->dx,t->dy,t->dz+1,nd);
+    if (t.dz > 0 && t.z < ds - 1) {
+        nd = d + 2 * t.dz + 1;
+        if (nd < O[p + rs * cs]) {
+            O[p + rs * cs] = nd;
+            if (nd <= max) {
+                ok &= Dfile_ajoute(F, nd, t.x, t.y, t.z + 1, t.dx, t.dy, t.dz + 1);
+            }
         }
-    } else if(t->dz<0 && t->z>0) {
-        nd=d-2*t->dz+1;
-        if(nd<O[((t->z-1)*cs+t->y)*rs+t->x]) {
-            O[((t->z-1)*cs+t->y)*rs+t->x]=nd;
-            Dadd(r,t->x,t->y,t->z-1,t->dx,t->dy,t->dz-1,nd);
+    } else if (t.dz < 0 && t.z > 0) {
+        nd = d - 2 * t.dz + 1;
+        if (nd < O[p - rs * cs]) {
+            O[p - rs * cs] = nd;
+            if (nd <= max) {
+                ok &= Dfile_ajoute(F, nd, t.x, t.y, t.z - 1, t.dx, t.dy, t.dz - 1);
+            }
         }
     }
-}
+    return ok;
+} // Dpropage()
 
 /* ======================================================== */
 int32_t ldistquad3d(struct xvimage* ob, struct xvimage* res)
 /* ======================================================== */
 // Computes the external distance (distance to nearest object point)
+#undef F_NAME
+#define F_NAME "ldistquad3d"
 {
     index_t rs=rowsize(ob),cs=colsize(ob),ds=depth(ob);
     index_t max=((rs-1)+(cs-1)+(ds-1))*((rs-1)+(cs-1)+(ds-1));
     uint32_t *O = ULONGDATA(res);
-    index_t xi,yi,zi,xj,yj,zj,i,j,d;
-    Drow* r=Dsetground(max);
+    index_t xi,yi,zi,xj,yj,zj,i,j,d,niv;
+    int32_t b, k, ok = 1;
+    Dfile *F;
+
+    if ((rs > INT16_MAX) || (cs > INT16_MAX) || (ds > INT16_MAX)) {
+        fprintf(stderr, "%s: image too large\n", F_NAME);
+        return 0;
+    }
+    F = Dfile_cree(2 * mcmax(rs, mcmax(cs, ds)) + 4);
+    if (F == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
 
     for (i = 0; i < rs * cs * ds; i++) {
         O[i] = MAXD;
@@ -1224,7 +1248,7 @@ int32_t ldistquad3d(struct xvimage* ob, struct xvimage* res)
                                     j = (zj - zi) * (zj - zi) + (yj - yi) * (yj - yi) +
                                         (xj - xi) * (xj - xi);
                                     if (O[(zj * cs + yj) * rs + xj] > j) {
-                                        Dadd(r, xj, yj, zj, xj - xi, yj - yi, zj - zi, j);
+                                        ok &= Dfile_ajoute(F, j, xj, yj, zj, xj - xi, yj - yi, zj - zi);
                                         O[(zj * cs + yj) * rs + xj] = j;
                                     }
                                 }
@@ -1238,13 +1262,30 @@ int32_t ldistquad3d(struct xvimage* ob, struct xvimage* res)
 
     /*step two: propagation throught the image*/
     d=0;
-    while((++d)<=max) {
-        _Drun(r->cols[d],ti,testAndAdd(r,res,ti,d));
-        Dfreecol(r->cols[d]);
+    while (ok && (F->nbcell > 0) && ((++d) <= max)) {
+        niv = d % F->nniv;
+        // les blocs ajoutes pendant le traitement vont a d'autres niveaux ;
+        // F->blocs peut etre realloue : acces par indice uniquement
+        for (b = F->tete[niv]; b != -1; b = F->blocs[b].next) {
+            for (k = 0; k < F->blocs[b].nb; k++) {
+                ok &= Dpropage(F, O, rs, cs, ds, max, F->blocs[b].tab[k], d);
+            }
+            F->nbcell -= F->blocs[b].nb;
+        }
+        if (F->tete[niv] != -1) { // recyclage des blocs du niveau
+            F->blocs[F->queue[niv]].next = F->libre;
+            F->libre = F->tete[niv];
+            F->tete[niv] = F->queue[niv] = -1;
+        }
     }
 
+    Dfile_termine(F);
+    if (!ok) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
     return 1;
-} // ldistquad3d_xd()
+} // ldistquad3d()
 
 /*
 
@@ -1707,104 +1748,252 @@ int32_t ldistSaito(struct xvimage *img,   /* donnee: image binaire */
 
 /* ======================================================== */
 /* ======================================================== */
-// Functions for the Reverse Euclidean Distance Transform (Coeurjolly)
-// Linear algorithm
+// Separable exact transforms (SEDT Meijster et al., REDT Coeurjolly):
+// multithreaded 1D passes
 /* ======================================================== */
 /* ======================================================== */
 
-#define Sep1(u,v,f,j) (((u*u)-(v*v)-f[u+rs*j]+f[v+rs*j])/(2*(u-v)))
-#define Sep2(u,v,f,i) (((u*u)-(v*v)-f[u*rs+i]+f[v*rs+i])/(2*(u-v)))
+/*
+  Chaque phase des algorithmes separables applique un meme traitement 1D
+  a toutes les lignes (ou colonnes, ou "piles" selon z) de l'image,
+  independamment les unes des autres : les lignes sont reparties entre
+  les threads (mcthreads). Pour les phases selon y et z, les points d'une
+  meme colonne sont a distance rs (ou rs*cs) en memoire ; on traite alors
+  DIST_BLOC colonnes voisines a la fois, recopiees dans un tampon ou
+  chaque colonne est contigue, ce qui evite un defaut de cache par point.
+*/
 
-#define F1(x,xp,f,j) (f[x+rs*j]-(xp-x)*(xp-x))
-#define F2(y,yp,f,i) (f[y*rs+i]-(yp-y)*(yp-y))
+#define DIST_BLOC 16 /* nombre de colonnes recopiees ensemble */
 
-#define Sep1_3d(u,v,f,j,k) (((u*u)-(v*v)-f[u+rs*j+ps*k]+f[v+rs*j+ps*k])/(2*(u-v)))
-#define Sep2_3d(u,v,f,i,k) (((u*u)-(v*v)-f[i+rs*u+ps*k]+f[i+rs*v+ps*k])/(2*(u-v)))
-#define Sep3_3d(u,v,f,i,j) (((u*u)-(v*v)-f[i+rs*j+ps*u]+f[i+rs*j+ps*v])/(2*(u-v)))
+#define DIST_SEDTLIGNE 0 /* premiere phase SEDT : image binaire -> carre de la distance 1D */
+#define DIST_SEDT      1 /* enveloppe inferieure des paraboles (Meijster) */
+#define DIST_REDT      2 /* enveloppe superieure des paraboles (Coeurjolly) */
 
-#define F1_3d(x,xp,f,j,k) (f[x+rs*j+ps*k]-(xp-x)*(xp-x))
-#define F2_3d(y,yp,f,i,k) (f[i+rs*y+ps*k]-(yp-y)*(yp-y))
-#define F3_3d(z,zp,f,i,j) (f[i+rs*j+ps*z]-(zp-z)*(zp-z))
+#define F_SEDT(y,yp,f) (f[y]+(yp-y)*(yp-y))
+#define Sep_SEDT(v,u,f) (((u*u)-(v*v)+f[u]-f[v])/(2*(u-v)))
+#define F_REDT(x,xp,f) (f[x]-(xp-x)*(xp-x))
+#define Sep_REDT(u,v,f) (((u*u)-(v*v)-f[u]+f[v])/(2*(u-v)))
 
 /* ======================================================== */
-static void REDT_line(int32_t *f, int32_t *g, index_t rs, index_t cs)
+static void SEDT_1d(uint32_t *f, uint32_t *g, int32_t n, uint32_t *s, uint32_t *t)
 /* ======================================================== */
 {
-    int32_t j, u, q, w; // attention: index signés (parcours inverse, petite taille)
-    int32_t *s = NULL, *t = NULL; //sommets des paraboles
-    s = (int32_t *)calloc(1,rs * sizeof(int32_t));
-    t = (int32_t *)calloc(1,rs * sizeof(int32_t));
-
-    for (j = 0; j < cs; j++) {
-        q = 0;
-        s[0] = 0;
-        t[0] = 0;
-        for (u = 1; u < rs; u++) {
-            while ((q >= 0) && (F1(s[q], t[q], f, j) < F1(u, t[q], f, j))) {
-                q--;
-            }
-            if (q < 0) {
-                q = 0;
-                s[0] = u;
-            } else {
-                w = 1 + Sep1(s[q],u,f,j);
-                if (w < rs) {
-                    q++;
-                    s[q] = u;
-                    t[q] = w;
-                }
+    int32_t u, q, w; // attention: index signés (parcours inverse, petite taille)
+    q = 0;
+    s[0] = 0;
+    t[0] = 0;
+    for (u = 1; u < n; u++) {
+        while ((q >= 0) && (F_SEDT(s[q], t[q], f) > F_SEDT(u, t[q], f))) {
+            q--;
+        }
+        if (q < 0) {
+            q = 0;
+            s[0] = u;
+        } else {
+            w = 1 + Sep_SEDT(s[q],u,f);
+            if (w < n) {
+                q++;
+                s[q] = u;
+                t[q] = w;
             }
         }
-        for (u = rs-1; u >= 0; u--) {
-            g[u + rs*j] = F1(s[q],u,f,j);
-            if (u == t[q]) {
-                q--;
+    }
+    for (u = n-1; u >= 0; u--) {
+        g[u] = F_SEDT(s[q],u,f);
+        if (u == t[q]) {
+            q--;
+        }
+    }
+} //  SEDT_1d()
+
+/* ======================================================== */
+static void REDT_1d(int32_t *f, int32_t *g, int32_t n, int32_t *s, int32_t *t)
+/* ======================================================== */
+{
+    int32_t u, q, w; // attention: index signés (parcours inverse, petite taille)
+    q = 0;
+    s[0] = 0;
+    t[0] = 0;
+    for (u = 1; u < n; u++) {
+        while ((q >= 0) && (F_REDT(s[q], t[q], f) < F_REDT(u, t[q], f))) {
+            q--;
+        }
+        if (q < 0) {
+            q = 0;
+            s[0] = u;
+        } else {
+            w = 1 + Sep_REDT(s[q],u,f);
+            if (w < n) {
+                q++;
+                s[q] = u;
+                t[q] = w;
             }
         }
     }
-    free(s);
-    free(t);
-} //  REDT_line()
+    for (u = n-1; u >= 0; u--) {
+        g[u] = F_REDT(s[q],u,f);
+        if (u == t[q]) {
+            q--;
+        }
+    }
+} //  REDT_1d()
 
 /* ======================================================== */
-static void REDT_column(int32_t *f, int32_t *g, index_t rs, index_t cs)
+static void SEDT_ligne1d(uint8_t *f, uint32_t *g, int32_t n, uint32_t inf)
 /* ======================================================== */
+// carre de la distance 1D au 0 le plus proche ; inf si la ligne n'en contient pas
 {
-    int32_t i, u, q, w; // attention: index signés (parcours inverse, petite taille)
-    int32_t *s = NULL, *t = NULL; //sommets des paraboles
-    s = (int32_t *)calloc(1,cs * sizeof(int32_t));
-    t = (int32_t *)calloc(1,cs * sizeof(int32_t));
+    int32_t i; // attention: index signés (parcours inverse, petite taille)
+    if (f[0] == 0) {
+        g[0] = 0;
+    } else {
+        g[0] = inf;
+    }
+    for (i = 1; i < n; i++) {
+        if (f[i] == 0) {
+            g[i] = 0;
+        } else {
+            g[i] = 1 + g[i - 1];
+        }
+    }
+    for (i = n - 2; i >= 0; i--) {
+        if (g[i + 1] < g[i]) {
+            g[i] = 1 + g[i + 1];
+        }
+    }
+    for (i = 0; i < n; i++) {
+        if (g[i] < inf) { // NECESSAIRE pour éviter un overflow
+            g[i] = g[i] * g[i];
+        }
+    }
+} //  SEDT_ligne1d()
 
-    for (i = 0; i < rs; i++) {
-        q = 0;
-        s[0] = 0;
-        t[0] = 0;
-        for (u = 1; u < cs; u++) {
-            while ((q >= 0) && (F2(s[q], t[q], f, i) < F2(u, t[q], f, i))) {
-                q--;
-            }
-            if (q < 0) {
-                q = 0;
-                s[0] = u;
+typedef struct {
+    void *f;            /* donnees (uint8_t pour DIST_SEDTLIGNE, 32 bits sinon) */
+    uint32_t *g;        /* resultat (distinct de f) */
+    int32_t algo;       /* DIST_SEDTLIGNE, DIST_SEDT ou DIST_REDT */
+    index_t n;          /* longueur des lignes traitees */
+    index_t W;          /* pas entre deux points d'une ligne ; 1 : lignes contigues */
+    index_t np;         /* W = 1 : nombre de lignes ; sinon : nombre de plans de W*n points */
+    index_t nunits;
+    uint32_t inf;       /* "infini" pour DIST_SEDTLIGNE */
+    int32_t nbands;
+    int32_t err;
+} distjob;
+
+/* ======================================================== */
+static void dist_1d(distjob *J, uint32_t *f, uint32_t *g, uint32_t *s, uint32_t *t)
+/* ======================================================== */
+{
+    if (J->algo == DIST_SEDT) {
+        SEDT_1d(f, g, (int32_t)J->n, s, t);
+    } else {
+        REDT_1d((int32_t *)f, (int32_t *)g, (int32_t)J->n, (int32_t *)s, (int32_t *)t);
+    }
+} //  dist_1d()
+
+/* ======================================================== */
+static void dist_band(void *arg, int32_t band)
+/* ======================================================== */
+{
+    distjob *J = (distjob *)arg;
+    index_t n = J->n, W = J->W, first, last, u, x0, u0, i;
+    index_t nblocs = (W + DIST_BLOC - 1) / DIST_BLOC;
+    int32_t b, nb;
+    uint32_t *s, *t, *bf = NULL, *bg = NULL, *f = (uint32_t *)J->f, *p, *q;
+
+    mcthreads_band(J->nunits, J->nbands, band, &first, &last);
+    s = (uint32_t *)malloc(n * sizeof(uint32_t));
+    t = (uint32_t *)malloc(n * sizeof(uint32_t));
+    if (W > 1) {
+        bf = (uint32_t *)malloc(DIST_BLOC * n * sizeof(uint32_t));
+        bg = (uint32_t *)malloc(DIST_BLOC * n * sizeof(uint32_t));
+    }
+    if ((s == NULL) || (t == NULL) || ((W > 1) && ((bf == NULL) || (bg == NULL)))) {
+        J->err = 1;
+        free(s);
+        free(t);
+        free(bf);
+        free(bg);
+        return;
+    }
+
+    for (u = first; u < last; u++) {
+        if (W == 1) { // lignes contigues
+            if (J->algo == DIST_SEDTLIGNE) {
+                SEDT_ligne1d((uint8_t *)J->f + u * n, J->g + u * n, (int32_t)n, J->inf);
             } else {
-                w = 1 + Sep2(s[q],u,f,i);
-                if (w < cs) {
-                    q++;
-                    s[q] = u;
-                    t[q] = w;
-                }
+                dist_1d(J, f + u * n, J->g + u * n, s, t);
             }
+            continue;
         }
-        for (u = cs-1; u >= 0; u--) {
-            g[rs*u + i] = F2(s[q],u,f,i);
-            if (u == t[q]) {
-                q--;
+        // bloc de colonnes : x0..x0+nb-1 dans le plan u / nblocs
+        x0 = (u % nblocs) * DIST_BLOC;
+        nb = (int32_t)mcmin(DIST_BLOC, W - x0);
+        u0 = (u / nblocs) * W * n + x0;
+        for (i = 0; i < n; i++) {
+            p = f + u0 + i * W;
+            for (b = 0; b < nb; b++) {
+                bf[b * n + i] = p[b];
+            }
+        }
+        for (b = 0; b < nb; b++) {
+            dist_1d(J, bf + b * n, bg + b * n, s, t);
+        }
+        for (i = 0; i < n; i++) {
+            q = J->g + u0 + i * W;
+            for (b = 0; b < nb; b++) {
+                q[b] = bg[b * n + i];
             }
         }
     }
     free(s);
     free(t);
-} //  REDT_column()
+    free(bf);
+    free(bg);
+} //  dist_band()
+
+/* ======================================================== */
+static int32_t dist_pass(void *f, uint32_t *g, int32_t algo, index_t n, index_t W, index_t np,
+                         uint32_t inf)
+/* ======================================================== */
+// applique le traitement 1D algo a toutes les lignes de f :
+// W = 1 : np lignes contigues de n points ;
+// W > 1 : dans chacun des np plans de W*n points, W colonnes de n points (pas W).
+#undef F_NAME
+#define F_NAME "dist_pass"
+{
+    distjob J;
+    J.f = f;
+    J.g = g;
+    J.algo = algo;
+    J.n = n;
+    J.W = W;
+    J.np = np;
+    J.inf = inf;
+    J.err = 0;
+    J.nunits = (W == 1) ? np : np * ((W + DIST_BLOC - 1) / DIST_BLOC);
+    J.nbands = mcthreads_nbands(J.nunits);
+    mcthreads_run(J.nbands, dist_band, &J);
+    if (J.err) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    return 1;
+} //  dist_pass()
+
+/* ======================================================== */
+/* ======================================================== */
+// Functions for the Reverse Euclidean Distance Transform (Coeurjolly)
+// Linear algorithm
+/* ======================================================== */
+/* ======================================================== */
+
+#define Sep1(u,v,f,j) (((u*u)-(v*v)-f[u+rs*j]+f[v+rs*j])/(2*(u-v)))
+#define Sep2(u,v,f,i) (((u*u)-(v*v)-f[u*rs+i]+f[v*rs+i])/(2*(u-v)))
+
+#define F1(x,xp,f,j) (f[x+rs*j]-(xp-x)*(xp-x))
+#define F2(y,yp,f,i) (f[y*rs+i]-(yp-y)*(yp-y))
 
 /* ======================================================== */
 int32_t lredt2d(struct xvimage* f, struct xvimage* res)
@@ -1833,11 +2022,13 @@ int32_t lredt2d(struct xvimage* f, struct xvimage* res)
         return(0);
     }
     T = SLONGDATA(tmp);
-    REDT_line(F, T, rs, cs);
-    copy2image(f, tmp);
-    REDT_column(F, T, rs, cs);
+    if (! dist_pass(F, (uint32_t *)T, DIST_REDT, rs, 1, cs, 0) ||
+        ! dist_pass(T, (uint32_t *)F, DIST_REDT, cs, rs, 1, 0)) {
+        freeimage(tmp);
+        return(0);
+    }
     for (i = 0; i < N; i++) {
-        if (T[i]) {
+        if (F[i]) {
             R[i] = NDG_MAX;
         } else {
             R[i] = 0;
@@ -1847,139 +2038,6 @@ int32_t lredt2d(struct xvimage* f, struct xvimage* res)
     return(1);
 } // lredt2d()
 
-/* ======================================================== */
-static void REDT_line_3d(int32_t *f, int32_t *g, index_t rs, index_t cs, index_t ds)
-/* ======================================================== */
-{
-    int32_t j, u, q, k, ps, w; // attention: index signés (parcours inverse, petite taille)
-    int32_t *s = NULL, *t = NULL; //sommets des paraboles
-    s = (int32_t *)calloc(1,rs * sizeof(int32_t));
-    t = (int32_t *)calloc(1,rs * sizeof(int32_t));
-    ps = cs * rs; // taille d'un plan
-
-    for(k = 0; k < ds; k++) {
-        for (j = 0; j < cs; j++) {
-            q = 0;
-            s[0] = 0;
-            t[0] = 0;
-            for (u = 1; u < rs; u++) {
-                while ((q >= 0) &&
-                        (F1_3d(s[q], t[q], f, j, k) < F1_3d(u, t[q], f, j, k))) {
-                    q--;
-                }
-                if (q < 0) {
-                    q = 0;
-                    s[0] = u;
-                } else {
-                    w = 1 + Sep1_3d(s[q],u,f,j,k);
-                    if (w < rs) {
-                        q++;
-                        s[q] = u;
-                        t[q] = w;
-                    }
-                }
-            }
-            for (u = rs-1; u >= 0; u--) {
-                g[u + rs*j + ps*k] = F1_3d(s[q],u,f,j,k);
-                if (u == t[q]) {
-                    q--;
-                }
-            }
-        }
-    }
-    free(s);
-    free(t);
-} //  REDT_line_3d()
-
-/* ======================================================== */
-static void REDT_column_3d(int32_t *f, int32_t *g, index_t rs, index_t cs, index_t ds)
-/* ======================================================== */
-{
-    int32_t i, u, q, k, ps, w; // attention: index signés (parcours inverse, petite taille)
-    int32_t *s = NULL, *t = NULL; //sommets des paraboles
-    s = (int32_t *)calloc(1,cs * sizeof(int32_t));
-    t = (int32_t *)calloc(1,cs * sizeof(int32_t));
-    ps = rs * cs; // taille d'un plan
-
-    for(k = 0; k < ds; k++) {
-        for (i = 0; i < rs; i++) {
-            q = 0;
-            s[0] = 0;
-            t[0] = 0;
-            for (u = 1; u < cs; u++) {
-                while ((q >= 0) &&
-                        (F2_3d(s[q], t[q], f, i, k) < F2_3d(u, t[q], f, i, k))) {
-                    q--;
-                }
-                if (q < 0) {
-                    q = 0;
-                    s[0] = u;
-                } else {
-                    w = 1 + Sep2_3d(s[q],u,f,i,k);
-                    if (w < cs) {
-                        q++;
-                        s[q] = u;
-                        t[q] = w;
-                    }
-                }
-            }
-            for (u = cs-1; u >= 0; u--) {
-                g[k*ps + rs*u + i] = F2_3d(s[q],u,f,i,k);
-                if (u == t[q]) {
-                    q--;
-                }
-            }
-        }
-    }
-    free(s);
-    free(t);
-} //  REDT_column_3d()
-
-
-/* ======================================================== */
-static void REDT_zaxis_3d(int32_t *f, int32_t *g, index_t rs, index_t cs, index_t ds)
-/* ======================================================== */
-{
-    int32_t i, u, q, j, ps, w; // attention: index signés (parcours inverse, petite taille)
-    int32_t *s = NULL, *t = NULL; //sommets des paraboles
-    s = (int32_t *)calloc(1,ds * sizeof(int32_t));
-    t = (int32_t *)calloc(1,ds * sizeof(int32_t));
-    ps = rs * cs; // taille d'un plan
-
-    for(j = 0; j < cs; j++) {
-        for (i = 0; i < rs; i++) {
-            q = 0;
-            s[0] = 0;
-            t[0] = 0;
-            for (u = 1; u < ds; u++) {
-                while ((q >= 0) &&
-                        (F3_3d(s[q], t[q], f, i, j) < F3_3d(u, t[q], f, i, j))) {
-                    q--;
-                }
-                if (q < 0) {
-                    q = 0;
-                    s[0] = u;
-                } else {
-                    w = 1 + Sep3_3d(s[q],u,f,i,j);
-                    if (w < ds) {
-                        q++;
-                        s[q] = u;
-                        t[q] = w;
-                    }
-                }
-            }
-            for (u = ds-1; u >= 0; u--) {
-                g[ps*u +  rs*j + i] = F3_3d(s[q],u,f,i,j);
-                if (u == t[q]) {
-                    q--;
-                }
-            }
-        }
-    }
-    free(s);
-    free(t);
-} //  REDT_zaxis_3d()
-
 /* ======================================================== */
 int32_t lredt3d(struct xvimage* f, struct xvimage* res)
 /* ======================================================== */
@@ -2007,11 +2065,12 @@ int32_t lredt3d(struct xvimage* f, struct xvimage* res)
         return(0);
     }
     T = SLONGDATA(tmp);
-    REDT_line_3d(F, T, rs, cs, ds);
-    copy2image(f, tmp);
-    REDT_column_3d(F, T, rs, cs, ds);
-    copy2image(f, tmp);
-    REDT_zaxis_3d(F, T, rs, cs, ds);
+    if (! dist_pass(F, (uint32_t *)T, DIST_REDT, rs, 1, cs * ds, 0) ||
+        ! dist_pass(T, (uint32_t *)F, DIST_REDT, cs, rs, ds, 0) ||
+        ! dist_pass(F, (uint32_t *)T, DIST_REDT, ds, rs * cs, 1, 0)) {
+        freeimage(tmp);
+        return(0);
+    }
     for (i = 0; i < N; i++) {
         if (T[i]) {
             R[i] = NDG_MAX;
@@ -2156,204 +2215,39 @@ int32_t lskeleton_ST(struct xvimage* f, struct xvimage* res)
 /* ======================================================== */
 /* ======================================================== */
 
-#define F_2_2d(y,yp,f,i) (f[y*rs+i]+(yp-y)*(yp-y))
-#define Sep_2_2d(v,u,f,i) (((u*u)-(v*v)+f[u*rs+i]-f[v*rs+i])/(2*(u-v)))
-
-#define F_2_3d(y,yp,f,i,k) (f[k*ps+y*rs+i]+(yp-y)*(yp-y))
-#define F_3_3d(z,zp,f,i,j) (f[z*ps+j*rs+i]+(zp-z)*(zp-z))
-#define Sep_2_3d(v,u,f,i,k) (((u*u)-(v*v)+f[k*ps+u*rs+i]-f[k*ps+v*rs+i])/(2*(u-v)))
-#define Sep_3_3d(v,u,f,i,j) (((u*u)-(v*v)+f[u*ps+j*rs+i]-f[v*ps+j*rs+i])/(2*(u-v)))
-
 /* ======================================================== */
 void SEDT_line(uint8_t *f, uint32_t *g, index_t rs, index_t cs)
 /* ======================================================== */
 {
-    int32_t i, j; // attention: index signés (parcours inverse, petite taille)
-    for (j = 0; j < cs; j++) {
-        if (f[0 + rs * j] == 0) {
-            g[0 + rs * j] = 0;
-        } else {
-            g[0 + rs * j] = rs * cs; // infinity
-        }
-        for (i = 1; i < rs; i++) {
-            if (f[i + rs * j] == 0) {
-                g[i + rs * j] = 0;
-            } else {
-                g[i + rs * j] = 1 + g[i - 1 + rs * j];
-            }
-        }
-        for (i = rs - 2; i >= 0; i--) {
-            if (g[i + 1 + rs * j] < g[i + rs * j]) {
-                g[i + rs * j] = 1 + g[i + 1 + rs * j];
-            }
-        }
-        for (i = 0; i < rs; i++) {
-            if (g[i + rs * j] < rs * cs) { // NECESSAIRE pour éviter un overflow
-                g[i + rs * j] = g[i + rs * j] * g[i + rs * j];
-            }
-        }
-    }
+    dist_pass(f, g, DIST_SEDTLIGNE, rs, 1, cs, (uint32_t)(rs * cs));
 } //  SEDT_line()
 
 /* ======================================================== */
 void SEDT_column(uint32_t *f, uint32_t *g, index_t rs, index_t cs)
 /* ======================================================== */
 {
-    int32_t i, u, q, w; // attention: index signés (parcours inverse, petite taille)
-    uint32_t *s = NULL, *t = NULL;
-    s = (uint32_t *)calloc(1,cs * sizeof(uint32_t));
-    t = (uint32_t *)calloc(1,cs * sizeof(uint32_t));
-
-    for (i = 0; i < rs; i++) {
-        q = 0;
-        s[0] = 0;
-        t[0] = 0;
-        for (u = 1; u < cs; u++) {
-            while ((q >= 0) && (F_2_2d(s[q], t[q], f, i) > F_2_2d(u, t[q], f, i))) {
-                q--;
-            }
-            if (q < 0) {
-                q = 0;
-                s[0] = u;
-            } else {
-                w = 1 + Sep_2_2d(s[q],u,f,i);
-                if (w < cs) {
-                    q++;
-                    s[q] = u;
-                    t[q] = w;
-                }
-            }
-        }
-        for (u = cs-1; u >= 0; u--) {
-            g[rs*u + i] = F_2_2d(s[q],u,f,i);
-            if (u == t[q]) {
-                q--;
-            }
-        }
-    }
-    free(s);
-    free(t);
+    dist_pass(f, g, DIST_SEDT, cs, rs, 1, 0);
 } //  SEDT_column()
 
 /* ======================================================== */
 void SEDT3d_line(uint8_t *f, uint32_t *g, index_t rs, index_t cs, index_t ds)
 /* ======================================================== */
 {
-    int32_t i, j, k, ps = rs*cs; // attention: index signés (parcours inverse, petite taille)
-    for (k = 0; k < ds; k++) {
-        for (j = 0; j < cs; j++) {
-            if (f[0 + rs * j + ps * k] == 0) {
-                g[0 + rs*j + ps*k] = 0;
-            } else {
-                g[0 + rs * j + ps * k] = rs * cs * ds; // infinity
-            }
-            for (i = 1; i < rs; i++) {
-                if (f[i + rs * j + ps * k] == 0) {
-                    g[i + rs * j + ps * k] = 0;
-                } else {
-                    g[i + rs * j + ps * k] = 1 + g[i - 1 + rs * j + ps * k];
-                }
-            }
-            for (i = rs - 2; i >= 0; i--) {
-                if (g[i + 1 + rs * j + ps * k] < g[i + rs * j + ps * k]) {
-                    g[i + rs * j + ps * k] = 1 + g[i + 1 + rs * j + ps * k];
-                }
-            }
-            for (i = 0; i < rs; i++) {
-                if (g[i + rs * j + ps * k] <
-                        rs * cs * ds) { // NECESSAIRE pour éviter un overflow
-                    g[i + rs * j + ps * k] =
-                        g[i + rs * j + ps * k] * g[i + rs * j + ps * k];
-                }
-            }
-        }
-    }
+    dist_pass(f, g, DIST_SEDTLIGNE, rs, 1, cs * ds, (uint32_t)(rs * cs * ds));
 } //  SEDT3d_line()
 
 /* ======================================================== */
 void SEDT3d_column(uint32_t *f, uint32_t *g, index_t rs, index_t cs, index_t ds)
 /* ======================================================== */
 {
-    int32_t i, k, u, q, ps = rs*cs, w; // attention: index signés (parcours inverse, petite taille)
-    uint32_t *s = NULL, *t = NULL;
-    s = (uint32_t *)calloc(1,cs * sizeof(uint32_t));
-    t = (uint32_t *)calloc(1,cs * sizeof(uint32_t));
-
-    for (k = 0; k < ds; k++) {
-        for (i = 0; i < rs; i++) {
-            q = 0;
-            s[0] = 0;
-            t[0] = 0;
-            for (u = 1; u < cs; u++) {
-                while ((q >= 0) &&
-                        (F_2_3d(s[q], t[q], f, i, k) > F_2_3d(u, t[q], f, i, k))) {
-                    q--;
-                }
-                if (q < 0) {
-                    q = 0;
-                    s[0] = u;
-                } else {
-                    w = 1 + Sep_2_3d(s[q],u,f,i,k);
-                    if (w < cs) {
-                        q++;
-                        s[q] = u;
-                        t[q] = w;
-                    }
-                }
-            }
-            for (u = cs-1; u >= 0; u--) {
-                g[ps*k + rs*u + i] = F_2_3d(s[q],u,f,i,k);
-                if (u == t[q]) {
-                    q--;
-                }
-            }
-        }
-    }
-    free(s);
-    free(t);
+    dist_pass(f, g, DIST_SEDT, cs, rs, ds, 0);
 } //  SEDT3d_column()
 
 /* ======================================================== */
 void SEDT3d_planes(uint32_t *f, uint32_t *g, index_t rs, index_t cs, index_t ds)
 /* ======================================================== */
 {
-    int32_t i, j, u, q, ps = rs*cs, w; // attention: index signés (parcours inverse, petite taille)
-    uint32_t *s = NULL, *t = NULL;
-    s = (uint32_t *)calloc(1,ds * sizeof(uint32_t));
-    t = (uint32_t *)calloc(1,ds * sizeof(uint32_t));
-
-    for (j = 0; j < cs; j++) {
-        for (i = 0; i < rs; i++) {
-            q = 0;
-            s[0] = 0;
-            t[0] = 0;
-            for (u = 1; u < ds; u++) {
-                while ((q >= 0) &&
-                        (F_3_3d(s[q], t[q], f, i, j) > F_3_3d(u, t[q], f, i, j))) {
-                    q--;
-                }
-                if (q < 0) {
-                    q = 0;
-                    s[0] = u;
-                } else {
-                    w = 1 + Sep_3_3d(s[q],u,f,i,j);
-                    if (w < ds) {
-                        q++;
-                        s[q] = u;
-                        t[q] = w;
-                    }
-                }
-            }
-            for (u = ds-1; u >= 0; u--) {
-                g[ps*u + rs*j + i] = F_3_3d(s[q],u,f,i,j);
-                if (u == t[q]) {
-                    q--;
-                }
-            }
-        }
-    }
-    free(s);
-    free(t);
+    dist_pass(f, g, DIST_SEDT, ds, rs * cs, 1, 0);
 } //  SEDT3d_planes()
 
 /* ==================================== */
@@ -2394,12 +2288,18 @@ int32_t lsedt_meijster(struct xvimage *img,   /* donnee: image binaire */
     F = UCHARDATA(img);
 
     if (ds == 1) {
-        SEDT_line(F, T, rs, cs);
-        SEDT_column(T, D, rs, cs);
+        if (! dist_pass(F, T, DIST_SEDTLIGNE, rs, 1, cs, (uint32_t)(rs * cs)) ||
+            ! dist_pass(T, D, DIST_SEDT, cs, rs, 1, 0)) {
+            freeimage(tmp);
+            return(0);
+        }
     } else {
-        SEDT3d_line(F, D, rs, cs, ds);
-        SEDT3d_column(D, T, rs, cs, ds);
-        SEDT3d_planes(T, D, rs, cs, ds);
+        if (! dist_pass(F, D, DIST_SEDTLIGNE, rs, 1, cs * ds, (uint32_t)(rs * cs * ds)) ||
+            ! dist_pass(D, T, DIST_SEDT, cs, rs, ds, 0) ||
+            ! dist_pass(T, D, DIST_SEDT, ds, rs * cs, 1, 0)) {
+            freeimage(tmp);
+            return(0);
+        }
     }
 
     freeimage(tmp);
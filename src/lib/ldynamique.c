@@ -86,7 +86,7 @@ Algo:
 #define PARANO
 
 /* =============================================================== */
-static int32_t i_Partitionner(int32_t *A, int32_t *T, int32_t p, int32_t r)
+static int32_t i_Partitionner(int32_t *A, index_t *T, int32_t p, int32_t r)
 /* =============================================================== */
 /*
   partitionne les elements de A entre l'indice p (compris) et l'indice r (compris)
@@ -94,7 +94,7 @@ static int32_t i_Partitionner(int32_t *A, int32_t *T, int32_t p, int32_t r)
 */
 {
     int32_t t;
-    int32_t x = T[A[p]];
+    index_t x = T[A[p]];
     int32_t i = p - 1;
     int32_t j = r + 1;
     while (1) {
@@ -115,7 +115,7 @@ static int32_t i_Partitionner(int32_t *A, int32_t *T, int32_t p, int32_t r)
 } /* i_Partitionner() */
 
 /* =============================================================== */
-static int32_t i_PartitionStochastique(int32_t *A, int32_t *T, int32_t p, int32_t r)
+static int32_t i_PartitionStochastique(int32_t *A, index_t *T, int32_t p, int32_t r)
 /* =============================================================== */
 /*
   partitionne les elements de A entre l'indice p (compris) et l'indice r (compris)
@@ -133,7 +133,7 @@ static int32_t i_PartitionStochastique(int32_t *A, int32_t *T, int32_t p, int32_
 } /* i_PartitionStochastique() */
 
 /* =============================================================== */
-static void i_TriRapideStochastique (int32_t * A, int32_t *T, int32_t p, int32_t r)
+static void i_TriRapideStochastique (int32_t * A, index_t *T, int32_t p, int32_t r)
 /* =============================================================== */
 /*
   trie les valeurs du tableau A de l'indice p (compris) a l'indice r (compris)
@@ -162,16 +162,16 @@ int32_t lordermaxima(struct xvimage *image, struct xvimage *order, int32_t conne
 #undef F_NAME
 #define F_NAME "lordermaxima"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     int32_t *O = SLONGDATA(order);      /* l'image de labels */
     int32_t *A; // table de correspondance pour le tri
-    int32_t *T; // table avec l'altitude de chaque maximum
+    index_t *T; // table avec l'altitude de chaque maximum
 
     if ((rowsize(order) != rs) || (colsize(order) != cs) || (depth(order) != ds)) {
         fprintf(stderr, "%s: incompatible image sizes\n", F_NAME);
@@ -179,7 +179,7 @@ int32_t lordermaxima(struct xvimage *image, struct xvimage *order, int32_t conne
     }
 
     A = (int32_t *)malloc(nblabels * sizeof(int32_t));
-    T = (int32_t *)malloc(nblabels * sizeof(int32_t));
+    T = (index_t *)malloc(nblabels * sizeof(index_t));
     if ((A == NULL) || (T == NULL)) {
         fprintf(stderr, "%s() : malloc failed\n", F_NAME);
         return(0);
@@ -190,7 +190,7 @@ int32_t lordermaxima(struct xvimage *image, struct xvimage *order, int32_t conne
 
     for (i = 0; i < N; i++) {
         if (O[i]) {
-            T[O[i]] = (int32_t)F[i];
+            T[O[i]] = (index_t)F[i];
         }
     }
 
@@ -224,18 +224,18 @@ int32_t lordermaximasurf(struct xvimage *image, struct xvimage *order, int32_t c
 #undef F_NAME
 #define F_NAME "lordermaximasurf"
 {
-    int32_t c, i, j, k, x;
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    index_t c, i, j, k, x;
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     int32_t *O = SLONGDATA(order);      /* l'image de labels */
     int32_t *A; // table de correspondance pour le tri
-    int32_t *T; // table avec l'altitude de chaque maximum
+    index_t *T; // table avec l'altitude de chaque maximum
     Fahs * FAHS;                    /* la file d'attente hierarchique */
-    int32_t *CM;                      /* etat d'un pixel */
+    index_t *CM;                      /* etat d'un pixel */
     ctree * CT;                   /* resultat : l'arbre des composantes */
 
     if ((rowsize(order) != rs) || (colsize(order) != cs) || (depth(order) != ds)) {
@@ -264,7 +264,7 @@ int32_t lordermaximasurf(struct xvimage *image, struct xvimage *order, int32_t c
     }
 
     A = (int32_t *)malloc(nblabels * sizeof(int32_t));
-    T = (int32_t *)calloc(nblabels, sizeof(int32_t));
+    T = (index_t *)calloc(nblabels, sizeof(index_t));
     if ((A == NULL) || (T == NULL)) {
         fprintf(stderr, "%s() : malloc failed\n", F_NAME);
         return(0);
@@ -289,7 +289,7 @@ int32_t lordermaximasurf(struct xvimage *image, struct xvimage *order, int32_t c
             // on prend la surface de l'avant-dernière composante
             T[i] = CT->tabnodes[j].area;
 #ifdef DEBUG
-            printf("max %d : val %d\n", i, T[i]);
+            printf("max %d : val %d\n", (int32_t)i, (int32_t)T[i]);
 #endif
         }
     } // for (x = 0; x < N; x++)
@@ -329,18 +329,18 @@ int32_t lordermaximavol(struct xvimage *image, struct xvimage *order, int32_t co
 #undef F_NAME
 #define F_NAME "lordermaximavol"
 {
-    int32_t c, i, j, k, x;
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    index_t c, i, j, k, x;
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     int32_t *O = SLONGDATA(order);      /* l'image de labels */
     int32_t *A; // table de correspondance pour le tri
-    int32_t *T; // table avec l'altitude de chaque maximum
+    index_t *T; // table avec l'altitude de chaque maximum
     Fahs * FAHS;                    /* la file d'attente hierarchique */
-    int32_t *CM;                      /* etat d'un pixel */
+    index_t *CM;                      /* etat d'un pixel */
     ctree * CT;                   /* resultat : l'arbre des composantes */
 
     if ((rowsize(order) != rs) || (colsize(order) != cs) || (depth(order) != ds)) {
@@ -369,7 +369,7 @@ int32_t lordermaximavol(struct xvimage *image, struct xvimage *order, int32_t co
     }
 
     A = (int32_t *)malloc(nblabels * sizeof(int32_t));
-    T = (int32_t *)calloc(nblabels, sizeof(int32_t));
+    T = (index_t *)calloc(nblabels, sizeof(index_t));
     if ((A == NULL) || (T == NULL)) {
         fprintf(stderr, "%s() : malloc failed\n", F_NAME);
         return(0);
@@ -394,7 +394,7 @@ int32_t lordermaximavol(struct xvimage *image, struct xvimage *order, int32_t co
             // on prend la volace de l'avant-dernière composante
             T[i] = CT->tabnodes[j].vol;
 #ifdef DEBUG
-            printf("max %d : val %d\n", i, T[i]);
+            printf("max %d : val %d\n", (int32_t)i, (int32_t)T[i]);
 #endif
         }
     } // for (x = 0; x < N; x++)
@@ -433,18 +433,18 @@ int32_t ldynamique_ldynamique(struct xvimage *image, struct xvimage *order, int3
 #undef F_NAME
 #define F_NAME "ldynamique_ldynamique"
 {
-    register int32_t i, j, k, x;      /* index muet */
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    register index_t i, j, k, x;      /* index muet */
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     int32_t *O = SLONGDATA(order);      /* l'image de labels */
     Fahs * FAHS;                    /* la file d'attente hierarchique */
-    int32_t *CM;                      /* etat d'un pixel */
+    index_t *CM;                      /* etat d'un pixel */
     ctree * CT;                   /* resultat : l'arbre des composantes */
-    int32_t *mu;                      /* pour représenter l'ordre */
+    index_t *mu;                      /* pour représenter l'ordre */
     int32_t *alpha;                   /* pour certains calculs intermédiaires */
     int32_t *dyn;                     /* pour représenter la dynamique */
 
@@ -478,7 +478,7 @@ int32_t ldynamique_ldynamique(struct xvimage *image, struct xvimage *order, int3
     writeimage(order, "_o");
 #endif
 
-    mu = (int32_t *)calloc(CT->nbleafs+1, sizeof(int32_t)); // 0 non utilise
+    mu = (index_t *)calloc(CT->nbleafs+1, sizeof(index_t)); // 0 non utilise
     dyn = (int32_t *)calloc(CT->nbleafs+1, sizeof(int32_t)); // 0 non utilise
     alpha = (int32_t *)calloc(CT->nbnodes, sizeof(int32_t));
     if ((mu == NULL) || (dyn == NULL) || (alpha == NULL)) {
@@ -497,7 +497,7 @@ int32_t ldynamique_ldynamique(struct xvimage *image, struct xvimage *order, int3
     for (i = CT->nbleafs; i >= 1; i--) {
         j = k = mu[i];
 #ifdef DEBUG
-        printf("node %d : %d ", i, k);
+        printf("node %d : %d ", (int32_t)i, (int32_t)k);
 #endif
         while ((k != -1) && (alpha[k] == 0)) {
             alpha[k] = i;
@@ -509,7 +509,7 @@ int32_t ldynamique_ldynamique(struct xvimage *image, struct xvimage *order, int3
             dyn[i] = CT->tabnodes[j].data - CT->tabnodes[k].data;
         }
 #ifdef DEBUG
-        printf("  ancestor %d, level %d\n", k, dyn[i]);
+        printf("  ancestor %d, level %d\n", (int32_t)k, dyn[i]);
 #endif
     } // for (i = CT->nbleafs; i >= 1; i--)
 
@@ -548,21 +548,21 @@ int32_t lfiltredynamique(struct xvimage *image, struct xvimage *order, int32_t c
 #undef F_NAME
 #define F_NAME "lfiltredynamique"
 {
-    register int32_t i, j, k, x;      /* index muet */
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    register index_t i, j, k, x;      /* index muet */
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     int32_t *O = SLONGDATA(order);      /* l'image de labels */
     Fahs * FAHS;                    /* la file d'attente hierarchique */
-    int32_t *CM;                      /* etat d'un pixel */
+    index_t *CM;                      /* etat d'un pixel */
     ctree * CT;                   /* resultat : l'arbre des composantes */
-    int32_t *mu;                      /* pour représenter l'ordre */
+    index_t *mu;                      /* pour représenter l'ordre */
     int32_t *alpha;                   /* pour certains calculs intermédiaires */
     int32_t *dyn;                     /* pour représenter la dynamique */
-    int32_t noleaf;
+    index_t noleaf;
 
     if ((rowsize(order) != rs) || (colsize(order) != cs) || (depth(order) != ds)) {
         fprintf(stderr, "%s: incompatible image sizes\n", F_NAME);
@@ -593,7 +593,7 @@ int32_t lfiltredynamique(struct xvimage *image, struct xvimage *order, int32_t c
     ComponentTreePrint(CT);
 #endif
 
-    mu = (int32_t *)calloc(CT->nbleafs+1, sizeof(int32_t)); // 0 non utilise
+    mu = (index_t *)calloc(CT->nbleafs+1, sizeof(index_t)); // 0 non utilise
     dyn = (int32_t *)calloc(CT->nbleafs+1, sizeof(int32_t)); // 0 non utilise
     alpha = (int32_t *)calloc(CT->nbnodes, sizeof(int32_t));
     if ((mu == NULL) || (dyn == NULL) || (alpha == NULL)) {
@@ -612,7 +612,7 @@ int32_t lfiltredynamique(struct xvimage *image, struct xvimage *order, int32_t c
     for (i = CT->nbleafs; i >= 1; i--) {
         j = k = mu[i];
 #ifdef DEBUG
-        printf("node %d : %d ", i, k);
+        printf("node %d : %d ", (int32_t)i, (int32_t)k);
 #endif
         while ((k != -1) && (alpha[k] == 0)) {
             alpha[k] = i;
@@ -624,7 +624,7 @@ int32_t lfiltredynamique(struct xvimage *image, struct xvimage *order, int32_t c
             dyn[i] = CT->tabnodes[j].data - CT->tabnodes[k].data;
         }
 #ifdef DEBUG
-        printf("  ancestor %d, level %d\n", k, dyn[i]);
+        printf("  ancestor %d, level %d\n", (int32_t)k, dyn[i]);
 #endif
     } // for (i = CT->nbleafs; i >= 1; i--)
 
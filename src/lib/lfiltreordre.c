@@ -35,6 +35,24 @@ knowledge of the CeCILL license and that you accept its terms.
 /* filtre d'ordre sur un voisinage quelconque */
 /* Michel Couprie - decembre 1997 */
 /* update juin 2001: 3D */
+/* update 2026: histogramme glissant (Huang), multithread */
+
+/*
+   Le filtre est calcule ligne par ligne par la methode de l'histogramme
+   glissant (T. S. Huang, G. J. Yang, G. Y. Tang, "A fast two-dimensional
+   median filtering algorithm", IEEE Trans. ASSP 27(1), 1979), etendue a
+   un element structurant quelconque : lors du passage du point x au point
+   x+1, on retire de l'histogramme les points du bord gauche de l'e.s.
+   et on ajoute ceux du bord droit. Le cout par point est proportionnel
+   au nombre de points de bord de l'e.s. (la hauteur pour un rectangle)
+   et non plus a son nombre de points.
+
+   La valeur de rang est cherchee dans un histogramme a deux niveaux
+   (16 classes de 16 niveaux de gris).
+
+   Les points de l'e.s. hors de l'image comptent pour la valeur 0.
+   Les lignes de l'image sont reparties entre les threads (mcthreads).
+*/
 
 #include <stdio.h>
 #include <stdint.h>
@@ -42,83 +60,233 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <stdlib.h>
 #include <mccodimage.h>
 #include <mcutil.h>
+#include <mcthreads.h>
 
 #define VERBOSE
 
-/* =================================================
-  Selection en temps moyen lineaire
-  D'apres "Introduction a l'algorithmique",
-    T. Cormen, C. Leiserson, R. Rivest, pp. 152, Dunod Ed.
-   =================================================
-*/
+typedef struct {
+    uint8_t *F;                      /* image resultat */
+    uint8_t *H;                      /* copie de l'image d'origine */
+    index_t rs, cs, ds, ps;
+    int32_t rang;                    /* rang cherche, de 1 a nptb */
+    int32_t nptb, nin, nout;
+    int32_t *es;                     /* points de l'e.s. (dx,dy,dz) */
+    int32_t *es_in;                  /* bord droit : points entrants */
+    int32_t *es_out;                 /* bord gauche : points sortants */
+    index_t *work;                   /* tableaux de travail des threads */
+    int32_t nbands;
+} filtreordre_job;
 
-/* =============================================================== */
-int32_t lfiltreordre_Partitionner(uint8_t *A, int32_t p, int32_t r)
-/* =============================================================== */
-/*
-  partitionne les elements de A entre l'indice p (compris) et l'indice r (compris)
-  en deux groupes : ceux <= A[p] et les autres.
-*/
+/* ==================================== */
+static int32_t filtreordre_val(filtreordre_job *J, index_t x, index_t y, index_t z,
+                               int32_t *d)
+/* ==================================== */
 {
-    uint8_t t;
-    uint8_t x = A[p];
-    int32_t i = p - 1;
-    int32_t j = r + 1;
-    while (1) {
-        do {
-            j--;
-        } while (A[j] > x);
-        do {
-            i++;
-        } while (A[i] < x);
-        if (i < j) {
-            t = A[i];
-            A[i] = A[j];
-            A[j] = t;
-        } else {
-            return j;
+    x += d[0];
+    y += d[1];
+    z += d[2];
+    if ((x < 0) || (x >= J->rs) || (y < 0) || (y >= J->cs) || (z < 0) || (z >= J->ds)) {
+        return 0;
+    }
+    return J->H[z * J->ps + y * J->rs + x];
+} /* filtreordre_val() */
+
+/* ==================================== */
+static uint8_t filtreordre_select(int32_t *hist, int32_t *hist16, int32_t rang)
+/* ==================================== */
+/* plus petite valeur v telle que le nombre de points <= v soit >= rang */
+{
+    int32_t c, v, acc = 0;
+    for (c = 0; c < 15; c++) {
+        if (acc + hist16[c] >= rang) {
+            break;
         }
-    } /* while (1) */
-} /* lfiltreordre_Partitionner() */
+        acc += hist16[c];
+    }
+    for (v = c << 4; v < 255; v++) {
+        acc += hist[v];
+        if (acc >= rang) {
+            break;
+        }
+    }
+    return (uint8_t)v;
+} /* filtreordre_select() */
 
-/* =============================================================== */
-int32_t lfiltreordre_PartitionStochastique(uint8_t *A, int32_t p, int32_t r)
-/* =============================================================== */
+/* ==================================== */
+static void filtreordre_band(void *arg, int32_t band)
+/* ==================================== */
 /*
-  partitionne les elements de A entre l'indice p (compris) et l'indice r (compris)
-  en deux groupes : ceux <= A[q] et les autres, avec q tire au hasard dans [p,r].
+  Pour chaque ligne, seuls les points de bord de l'e.s. situes sur une
+  ligne de l'image sont conserves : sur chaque ligne de l'e.s. il y a
+  autant de points entrants que de points sortants, et les autres
+  (valeur 0) s'annulent.
 */
 {
-    uint8_t t;
-    int32_t q;
-
-    q = p + (rand() % (r - p + 1));
-    t = A[p];         /* echange A[p] et A[q] */
-    A[p] = A[q];
-    A[q] = t;
-    return lfiltreordre_Partitionner(A, p, r);
-} /* lfiltreordre_PartitionStochastique() */
-
-/* =============================================================== */
-uint8_t lfiltreordre_SelectionStochastique (uint8_t * A, int32_t p, int32_t r, int32_t i)
-/* =============================================================== */
+    filtreordre_job *J = (filtreordre_job *)arg;
+    int32_t hist[256], hist16[16];
+    index_t first, last, l, x, xx, y, z, yy, zz;
+    index_t rs = J->rs;
+    uint8_t *H = J->H;
+    index_t *inb = J->work + (index_t)band * 2 * (J->nin + J->nout);
+    index_t *ind = inb + J->nin;
+    index_t *outb = ind + J->nin;
+    index_t *outd = outb + J->nout;
+    int32_t c, v, ni, no;
+
+    mcthreads_band(J->cs * J->ds, J->nbands, band, &first, &last);
+    for (l = first; l < last; l++) {
+        y = l % J->cs;
+        z = l / J->cs;
+        for (c = 0; c < 256; c++) {
+            hist[c] = 0;
+        }
+        for (c = 0; c < 16; c++) {
+            hist16[c] = 0;
+        }
+        for (c = 0; c < J->nptb; c++) {
+            v = filtreordre_val(J, 0, y, z, J->es + 3 * c);
+            hist[v]++;
+            hist16[v >> 4]++;
+        }
+        J->F[l * rs] = filtreordre_select(hist, hist16, J->rang);
+
+        for (c = ni = 0; c < J->nin; c++) {
+            yy = y + J->es_in[3 * c + 1];
+            zz = z + J->es_in[3 * c + 2];
+            if ((yy >= 0) && (yy < J->cs) && (zz >= 0) && (zz < J->ds)) {
+                inb[ni] = zz * J->ps + yy * rs;
+                ind[ni++] = J->es_in[3 * c];
+            }
+        }
+        for (c = no = 0; c < J->nout; c++) {
+            yy = y + J->es_out[3 * c + 1];
+            zz = z + J->es_out[3 * c + 2];
+            if ((yy >= 0) && (yy < J->cs) && (zz >= 0) && (zz < J->ds)) {
+                outb[no] = zz * J->ps + yy * rs;
+                outd[no++] = J->es_out[3 * c];
+            }
+        }
+
+        for (x = 1; x < rs; x++) {
+            for (c = 0; c < no; c++) {
+                xx = x - 1 + outd[c];
+                v = ((xx >= 0) && (xx < rs)) ? H[outb[c] + xx] : 0;
+                hist[v]--;
+                hist16[v >> 4]--;
+            }
+            for (c = 0; c < ni; c++) {
+                xx = x + ind[c];
+                v = ((xx >= 0) && (xx < rs)) ? H[inb[c] + xx] : 0;
+                hist[v]++;
+                hist16[v >> 4]++;
+            }
+            J->F[l * rs + x] = filtreordre_select(hist, hist16, J->rang);
+        }
+    }
+} /* filtreordre_band() */
+
+/* ==================================== */
+static int32_t filtreordre_histo(struct xvimage *f, struct xvimage *m,
+                                 int32_t xc, int32_t yc, int32_t zc, int32_t rang)
+/* ==================================== */
 /*
-  retourne la valeur de rang i dans le tableau A
-  entre l'indice m (compris) a l'indice n (compris)
+  remplace chaque point de f par la valeur de rang "rang" (1 : minimum,
+  nptb : maximum) parmi les valeurs de ses voisins selon le masque m
+  centre en (xc,yc,zc).
 */
+#undef F_NAME
+#define F_NAME "filtreordre_histo"
 {
-    int32_t q, k;
-    if (p == r) {
-        return A[p];
+    filtreordre_job J;
+    index_t rsm = rowsize(m), csm = colsize(m), dsm = depth(m);
+    index_t psm = rsm * csm, N, i, j, k;
+    uint8_t *M = UCHARDATA(m);
+    int32_t n;
+
+    J.F = UCHARDATA(f);
+    J.rs = rowsize(f);
+    J.cs = colsize(f);
+    J.ds = depth(f);
+    J.ps = J.rs * J.cs;
+    N = J.ps * J.ds;
+
+    J.nptb = J.nin = J.nout = 0;
+    for (k = 0; k < dsm; k++) {
+        for (j = 0; j < csm; j++) {
+            for (i = 0; i < rsm; i++) {
+                if (M[k * psm + j * rsm + i]) {
+                    J.nptb++;
+                    if ((i == rsm - 1) || !M[k * psm + j * rsm + i + 1]) {
+                        J.nin++;
+                    }
+                    if ((i == 0) || !M[k * psm + j * rsm + i - 1]) {
+                        J.nout++;
+                    }
+                }
+            }
+        }
+    }
+    if (J.nptb == 0) {
+        fprintf(stderr, "%s: empty structuring element\n", F_NAME);
+        return 0;
     }
-    q = lfiltreordre_PartitionStochastique(A, p, r);
-    k = q - p + 1;
-    if (i <= k) {
-        return lfiltreordre_SelectionStochastique(A, p, q, i);
-    } else {
-        return lfiltreordre_SelectionStochastique(A, q + 1, r, i - k);
+    J.rang = mcmax(1, mcmin(rang, J.nptb));
+
+    J.H = (uint8_t *)malloc(N * sizeof(uint8_t));
+    J.es = (int32_t *)malloc(3 * (J.nptb + J.nin + J.nout) * sizeof(int32_t));
+    if ((J.H == NULL) || (J.es == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(J.H);
+        free(J.es);
+        return 0;
     }
-} /* lfiltreordre_SelectionStochastique() */
+    J.es_in = J.es + 3 * J.nptb;
+    J.es_out = J.es_in + 3 * J.nin;
+    for (i = 0; i < N; i++) {
+        J.H[i] = J.F[i];
+    }
+
+    J.nptb = J.nin = J.nout = 0;
+    for (k = 0; k < dsm; k++) {
+        for (j = 0; j < csm; j++) {
+            for (i = 0; i < rsm; i++) {
+                if (M[k * psm + j * rsm + i]) {
+                    n = 3 * J.nptb++;
+                    J.es[n] = (int32_t)(i - xc);
+                    J.es[n + 1] = (int32_t)(j - yc);
+                    J.es[n + 2] = (int32_t)(k - zc);
+                    if ((i == rsm - 1) || !M[k * psm + j * rsm + i + 1]) {
+                        n = 3 * J.nin++;
+                        J.es_in[n] = (int32_t)(i - xc);
+                        J.es_in[n + 1] = (int32_t)(j - yc);
+                        J.es_in[n + 2] = (int32_t)(k - zc);
+                    }
+                    if ((i == 0) || !M[k * psm + j * rsm + i - 1]) {
+                        n = 3 * J.nout++;
+                        J.es_out[n] = (int32_t)(i - xc);
+                        J.es_out[n + 1] = (int32_t)(j - yc);
+                        J.es_out[n + 2] = (int32_t)(k - zc);
+                    }
+                }
+            }
+        }
+    }
+
+    J.nbands = mcthreads_nbands(J.cs * J.ds);
+    J.work = (index_t *)malloc((index_t)J.nbands * 2 * (J.nin + J.nout) * sizeof(index_t));
+    if (J.work == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(J.H);
+        free(J.es);
+        return 0;
+    }
+    mcthreads_run(J.nbands, filtreordre_band, &J);
+
+    free(J.H);
+    free(J.es);
+    free(J.work);
+    return 1;
+} /* filtreordre_histo() */
 
 /* ==================================== */
 int32_t lfiltreordre(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc, double r)
@@ -128,39 +296,16 @@ int32_t lfiltreordre(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
 /* ==================================== */
 {
     int32_t rang;
-    index_t x;                       /* index muet de pixel */
-    index_t y;                       /* index muet (generalement un voisin de x) */
-    register index_t i, j;                    /* index muet */
-    register index_t k, l;                    /* index muet */
-    index_t rs = rowsize(f);         /* taille ligne */
-    index_t cs = colsize(f);         /* taille colonne */
-    index_t N = rs * cs;             /* taille image */
-    index_t rsm = rowsize(m);        /* taille ligne masque */
-    index_t csm = colsize(m);        /* taille colonne masque */
-    index_t Nm = rsm * csm;
+    index_t i;                       /* index muet */
+    index_t Nm = rowsize(m) * colsize(m);
     uint8_t *M = UCHARDATA(m);
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H;                    /* image de travail */
-    int32_t c, nptb;                 /* nombre de points de l'e.s. */
-    int32_t *tab_es_x;               /* liste des coord. x des points de l'e.s. */
-    int32_t *tab_es_y;               /* liste des coord. y des points de l'e.s. */
-    uint8_t *tab_es_val;   /* liste des valeurs des points de l'e.s. */
+    int32_t nptb;                    /* nombre de points de l'e.s. */
 
     if (depth(f) != 1) {
         fprintf(stderr, "lfiltreordre: cette version ne traite pas les images volumiques\n");
         exit(0);
     }
 
-    H = (uint8_t *)calloc(1,N*sizeof(char));
-    if (H == NULL) {
-        fprintf(stderr,"lfiltreordre() : malloc failed for H\n");
-        return(0);
-    }
-
-    for (x = 0; x < N; x++) {
-        H[x] = F[x];
-    }
-
     nptb = 0;
     for (i = 0; i < Nm; i += 1) {
         if (M[i]) {
@@ -172,46 +317,8 @@ int32_t lfiltreordre(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t y
 #ifdef VERBOSE
     printf("r = %g ; nptb = %d ; rang = %d\n", r, nptb, rang);
 #endif
-    tab_es_x = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-    tab_es_y = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-    tab_es_val = (uint8_t *)calloc(1,nptb * sizeof(char));
-    if ((tab_es_x == NULL) || (tab_es_y == NULL) || (tab_es_val == NULL)) {
-        fprintf(stderr,"lfiltreordre() : malloc failed for tab_es\n");
-        return(0);
-    }
 
-    k = 0;
-    for (j = 0; j < csm; j += 1) {
-        for (i = 0; i < rsm; i += 1) {
-            if (M[j * rsm + i]) {
-                tab_es_x[k] = i;
-                tab_es_y[k] = j;
-                k += 1;
-            }
-        }
-    }
-
-    for (y = 0; y < cs; y++) {
-        for (x = 0; x < rs; x++) {
-            for (c = 0; c < nptb; c += 1) {
-                l = y + tab_es_y[c] - yc;
-                k = x + tab_es_x[c] - xc;
-                if ((l >= 0) && (l < cs) && (k >= 0) && (k < rs)) {
-                    tab_es_val[c] = H[l * rs + k];
-                } else {
-                    tab_es_val[c] = 0;
-                }
-            }
-            F[y * rs + x] =
-                lfiltreordre_SelectionStochastique(tab_es_val, 0, nptb - 1, rang);
-        }
-    }
-
-    free(H);
-    free(tab_es_x);
-    free(tab_es_y);
-    free(tab_es_val);
-    return 1;
+    return filtreordre_histo(f, m, xc, yc, 0, rang);
 } /* lfiltreordre() */
 
 /* ==================================== */
@@ -220,39 +327,16 @@ int32_t lfiltrerang(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
 /* xc, yc : coordonnees du "centre" de l'element structurant */
 /* ==================================== */
 {
-    index_t x;                       /* index muet de pixel */
-    index_t y;                       /* index muet (generalement un voisin de x) */
-    register index_t i, j;                    /* index muet */
-    register index_t k, l;                    /* index muet */
-    index_t rs = rowsize(f);         /* taille ligne */
-    index_t cs = colsize(f);         /* taille colonne */
-    index_t N = rs * cs;             /* taille image */
-    index_t rsm = rowsize(m);        /* taille ligne masque */
-    index_t csm = colsize(m);        /* taille colonne masque */
-    index_t Nm = rsm * csm;
+    index_t i;                       /* index muet */
+    index_t Nm = rowsize(m) * colsize(m);
     uint8_t *M = UCHARDATA(m);
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H;                    /* image de travail */
-    int32_t c, nptb;                 /* nombre de points de l'e.s. */
-    int32_t *tab_es_x;               /* liste des coord. x des points de l'e.s. */
-    int32_t *tab_es_y;               /* liste des coord. y des points de l'e.s. */
-    uint8_t *tab_es_val;   /* liste des valeurs des points de l'e.s. */
+    int32_t nptb;                    /* nombre de points de l'e.s. */
 
     if (depth(f) != 1) {
         fprintf(stderr, "lfiltrerang: cette version ne traite pas les images volumiques\n");
         exit(0);
     }
 
-    H = (uint8_t *)calloc(1,N*sizeof(char));
-    if (H == NULL) {
-        fprintf(stderr,"lfiltrerang() : malloc failed for H\n");
-        return(0);
-    }
-
-    for (x = 0; x < N; x++) {
-        H[x] = F[x];
-    }
-
     nptb = 0;
     for (i = 0; i < Nm; i += 1) {
         if (M[i]) {
@@ -268,46 +352,8 @@ int32_t lfiltrerang(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t yc
     //#ifdef VERBOSE
     printf("nptb = %d ; rang = %d\n", nptb, rang);
     //#endif
-    tab_es_x = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-    tab_es_y = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-    tab_es_val = (uint8_t *)calloc(1,nptb * sizeof(char));
-    if ((tab_es_x == NULL) || (tab_es_y == NULL) || (tab_es_val == NULL)) {
-        fprintf(stderr,"lfiltrerang() : malloc failed for tab_es\n");
-        return(0);
-    }
-
-    k = 0;
-    for (j = 0; j < csm; j += 1) {
-        for (i = 0; i < rsm; i += 1) {
-            if (M[j * rsm + i]) {
-                tab_es_x[k] = i;
-                tab_es_y[k] = j;
-                k += 1;
-            }
-        }
-    }
 
-    for (y = 0; y < cs; y++) {
-        for (x = 0; x < rs; x++) {
-            for (c = 0; c < nptb; c += 1) {
-                l = y + tab_es_y[c] - yc;
-                k = x + tab_es_x[c] - xc;
-                if ((l >= 0) && (l < cs) && (k >= 0) && (k < rs)) {
-                    tab_es_val[c] = H[l * rs + k];
-                } else {
-                    tab_es_val[c] = 0;
-                }
-            }
-            F[y * rs + x] =
-                lfiltreordre_SelectionStochastique(tab_es_val, 0, nptb - 1, rang);
-        }
-    }
-
-    free(H);
-    free(tab_es_x);
-    free(tab_es_y);
-    free(tab_es_val);
-    return 1;
+    return filtreordre_histo(f, m, xc, yc, 0, rang);
 } /* lfiltrerang() */
 
 /* ==================================== */
@@ -318,37 +364,10 @@ int32_t lfiltreordre3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t
 /* ==================================== */
 {
     int32_t rang;
-    index_t x, y, z;
-    register index_t i, j, k;                 /* index muet */
-    register index_t n, o, p;                 /* index muet */
-    index_t rs = rowsize(f);         /* taille ligne */
-    index_t cs = colsize(f);         /* taille colonne */
-    index_t ds = depth(f);           /* nb plans */
-    index_t ps = rs * cs;            /* taille plan */
-    index_t N = ps * ds;             /* taille image */
-    index_t rsm = rowsize(m);        /* taille ligne masque */
-    index_t csm = colsize(m);        /* taille colonne masque */
-    index_t dsm = depth(m);          /* nb plans masque */
-    index_t psm = rsm * csm;         /* taille plan masque */
-    index_t Nm = psm * dsm;          /* taille masque */
+    index_t i;                       /* index muet */
+    index_t Nm = rowsize(m) * colsize(m) * depth(m); /* taille masque */
     uint8_t *M = UCHARDATA(m);
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H;                    /* image de travail */
-    int32_t c, nptb;                 /* nombre de points de l'e.s. */
-    int32_t *tab_es_x;               /* liste des coord. x des points de l'e.s. */
-    int32_t *tab_es_y;               /* liste des coord. y des points de l'e.s. */
-    int32_t *tab_es_z;               /* liste des coord. z des points de l'e.s. */
-    uint8_t *tab_es_val;   /* liste des valeurs des points de l'e.s. */
-
-    H = (uint8_t *)calloc(1,N*sizeof(char));
-    if (H == NULL) {
-        fprintf(stderr,"lfiltreordre3d() : malloc failed for H\n");
-        return(0);
-    }
-
-    for (x = 0; x < N; x++) {
-        H[x] = F[x];
-    }
+    int32_t nptb;                    /* nombre de points de l'e.s. */
 
     nptb = 0;
     for (i = 0; i < Nm; i += 1) {
@@ -362,53 +381,5 @@ int32_t lfiltreordre3d(struct xvimage *f, struct xvimage *m, int32_t xc, int32_t
     printf("r = %g ; nptb = %d ; rang = %d\n", r, nptb, rang);
 #endif
 
-    tab_es_x = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-    tab_es_y = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-    tab_es_z = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-    tab_es_val = (uint8_t *)calloc(1,nptb * sizeof(char));
-    if ((tab_es_x == NULL) || (tab_es_y == NULL) || (tab_es_z == NULL) || (tab_es_val == NULL)) {
-        fprintf(stderr,"lfiltreordre3d() : malloc failed for tab_es\n");
-        return(0);
-    }
-
-    n = 0;
-    for (k = 0; k < dsm; k += 1) {
-        for (j = 0; j < csm; j += 1) {
-            for (i = 0; i < rsm; i += 1) {
-                if (M[k * psm + j * rsm + i]) {
-                    tab_es_x[n] = i;
-                    tab_es_y[n] = j;
-                    tab_es_z[n] = k;
-                    n += 1;
-                }
-            }
-        }
-    }
-
-    for (z = 0; z < ds; z++) {
-        for (y = 0; y < cs; y++) {
-            for (x = 0; x < rs; x++) {
-                for (c = 0; c < nptb; c += 1) {
-                    o = z + tab_es_z[c] - zc;
-                    p = y + tab_es_y[c] - yc;
-                    n = x + tab_es_x[c] - xc;
-                    if ((o >= 0) && (o < ds) && (p >= 0) && (p < cs) && (n >= 0) &&
-                            (n < rs)) {
-                        tab_es_val[c] = H[o * ps + p * rs + n];
-                    } else {
-                        tab_es_val[c] = 0;
-                    }
-                }
-                F[z * ps + y * rs + x] =
-                    lfiltreordre_SelectionStochastique(tab_es_val, 0, nptb - 1, rang);
-            }
-        }
-    }
-
-    free(H);
-    free(tab_es_x);
-    free(tab_es_y);
-    free(tab_es_z);
-    free(tab_es_val);
-    return 1;
+    return filtreordre_histo(f, m, xc, yc, zc, rang);
 } /* lfiltreordre3d() */
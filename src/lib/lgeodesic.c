@@ -38,6 +38,8 @@ knowledge of the CeCILL license and that you accept its terms.
  d'apres la these de Michel Grimaud (pp 22)
  Michel Couprie - juillet 1996
  Update 12/02/2010: MC - fix memory leakage (missing calls to IndicsTermine)
+ Update 10/2026: reconstruction (niter = -1) par l'algorithme hybride
+   de Vincent (lreconshybride)
 */
 
 #include <stdio.h>
@@ -49,6 +51,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcfifo.h>
 #include <mcindic.h>
 #include <mcutil.h>
+#include <lreconshybride.h>
 #include <lgeodesic.h>
 
 //#define VERBOSE
@@ -75,6 +78,9 @@ int32_t lgeodilat(
 #endif
 
     COMPARE_SIZE(f, g);
+    if ((niter == -1) && (datatype(f) == datatype(g)) && lreconshybride_possible(f, connex)) {
+        return lreconshybride(g, f, connex, 0);
+    }
     ACCEPTED_TYPES3(f, VFF_TYP_1_BYTE, VFF_TYP_2_BYTE, VFF_TYP_4_BYTE);
     ACCEPTED_TYPES3(g, VFF_TYP_1_BYTE, VFF_TYP_2_BYTE, VFF_TYP_4_BYTE);
     if (datatype(f) != datatype(g)) {
@@ -162,6 +168,7 @@ int32_t lgeodilat2d(
 #undef F_NAME
 #define F_NAME "lgeodilat2d"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -203,11 +210,15 @@ int32_t lgeodilat2d(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     H = (uint8_t *)calloc(1,N*sizeof(char));
@@ -228,7 +239,7 @@ int32_t lgeodilat2d(
         nbchang = 0;
         while (! FifoVide(FIFO[iter % 2])) {
             x = FifoPop(FIFO[iter % 2]);
-            UnSet(x, iter % 2);
+            IndUnSet(Ind, x, iter % 2);
             sup = G[x];
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
@@ -240,15 +251,15 @@ int32_t lgeodilat2d(
             sup = mcmin(sup, F[x]);
             if (G[x] != sup) { /* changement: on enregistre x ainsi que ses voisins */
                 nbchang += 1;
-                if (! IsSet(x, (iter + 1) % 2)) {
+                if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                     FifoPush(FIFO[(iter + 1) % 2], x);
-                    Set(x, (iter + 1) % 2);
+                    IndSet(Ind, x, (iter + 1) % 2);
                 }
                 for (k = 0; k < 8; k += 1) {
                     y = voisin(x, k, rs, N);
-                    if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                    if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                         FifoPush(FIFO[(iter + 1) % 2], y);
-                        Set(y, (iter + 1) % 2);
+                        IndSet(Ind, y, (iter + 1) % 2);
                     }
                 } /* for k */
             }
@@ -278,7 +289,7 @@ int32_t lgeodilat2d(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } /* lgeodilat2d() */
 
@@ -300,6 +311,7 @@ int32_t lgeodilatcond2d(
 #undef F_NAME
 #define F_NAME "lgeodilatcond2d"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -339,12 +351,16 @@ int32_t lgeodilatcond2d(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) { /* mise en fifo initiale de tous les points */
         if (C[x]) {
             FifoPush(FIFO[1], x);
-            Set(x, 1);
+            IndSet(Ind, x, 1);
         }
     }
 
@@ -363,7 +379,7 @@ int32_t lgeodilatcond2d(
         nbchang = 0;
         while (! FifoVide(FIFO[iter % 2])) {
             x = FifoPop(FIFO[iter % 2]);
-            UnSet(x, iter % 2);
+            IndUnSet(Ind, x, iter % 2);
             sup = G[x];
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
@@ -375,15 +391,15 @@ int32_t lgeodilatcond2d(
             sup = mcmin(sup, F[x]);
             if (G[x] != sup) { /* changement: on enregistre x ainsi que ses voisins */
                 nbchang += 1;
-                if (! IsSet(x, (iter + 1) % 2)) {
+                if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                     FifoPush(FIFO[(iter + 1) % 2], x);
-                    Set(x, (iter + 1) % 2);
+                    IndSet(Ind, x, (iter + 1) % 2);
                 }
                 for (k = 0; k < 8; k += 1) {
                     y = voisin(x, k, rs, N);
-                    if ((y != -1) && (C[y]) && (! IsSet(y, (iter + 1) % 2))) {
+                    if ((y != -1) && (C[y]) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                         FifoPush(FIFO[(iter + 1) % 2], y);
-                        Set(y, (iter + 1) % 2);
+                        IndSet(Ind, y, (iter + 1) % 2);
                     }
                 } /* for k */
             }
@@ -413,7 +429,7 @@ int32_t lgeodilatcond2d(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } /* lgeodilatcond2d() */
 
@@ -433,6 +449,7 @@ int32_t lgeodilat2d_short(
 #undef F_NAME
 #define F_NAME "lgeodilat2d_short"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -474,11 +491,15 @@ int32_t lgeodilat2d_short(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     H = (int16_t *)calloc(1,N*sizeof(int16_t));
@@ -499,7 +520,7 @@ int32_t lgeodilat2d_short(
         nbchang = 0;
         while (! FifoVide(FIFO[iter % 2])) {
             x = FifoPop(FIFO[iter % 2]);
-            UnSet(x, iter % 2);
+            IndUnSet(Ind, x, iter % 2);
             sup = G[x];
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
@@ -511,15 +532,15 @@ int32_t lgeodilat2d_short(
             sup = mcmin(sup, F[x]);
             if (G[x] != sup) { /* changement: on enregistre x ainsi que ses voisins */
                 nbchang += 1;
-                if (! IsSet(x, (iter + 1) % 2)) {
+                if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                     FifoPush(FIFO[(iter + 1) % 2], x);
-                    Set(x, (iter + 1) % 2);
+                    IndSet(Ind, x, (iter + 1) % 2);
                 }
                 for (k = 0; k < 8; k += 1) {
                     y = voisin(x, k, rs, N);
-                    if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                    if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                         FifoPush(FIFO[(iter + 1) % 2], y);
-                        Set(y, (iter + 1) % 2);
+                        IndSet(Ind, y, (iter + 1) % 2);
                     }
                 } /* for k */
             }
@@ -549,7 +570,7 @@ int32_t lgeodilat2d_short(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } /* lgeodilat2d_short() */
 
@@ -569,6 +590,7 @@ int32_t lgeodilat2d_long(
 #undef F_NAME
 #define F_NAME "lgeodilat2d_long"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -610,11 +632,15 @@ int32_t lgeodilat2d_long(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     H = (int32_t *)calloc(1,N*sizeof(int32_t));
@@ -635,7 +661,7 @@ int32_t lgeodilat2d_long(
         nbchang = 0;
         while (! FifoVide(FIFO[iter % 2])) {
             x = FifoPop(FIFO[iter % 2]);
-            UnSet(x, iter % 2);
+            IndUnSet(Ind, x, iter % 2);
             sup = G[x];
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
@@ -647,15 +673,15 @@ int32_t lgeodilat2d_long(
             sup = mcmin(sup, F[x]);
             if (G[x] != sup) { /* changement: on enregistre x ainsi que ses voisins */
                 nbchang += 1;
-                if (! IsSet(x, (iter + 1) % 2)) {
+                if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                     FifoPush(FIFO[(iter + 1) % 2], x);
-                    Set(x, (iter + 1) % 2);
+                    IndSet(Ind, x, (iter + 1) % 2);
                 }
                 for (k = 0; k < 8; k += 1) {
                     y = voisin(x, k, rs, N);
-                    if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                    if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                         FifoPush(FIFO[(iter + 1) % 2], y);
-                        Set(y, (iter + 1) % 2);
+                        IndSet(Ind, y, (iter + 1) % 2);
                     }
                 } /* for k */
             }
@@ -685,7 +711,7 @@ int32_t lgeodilat2d_long(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } /* lgeodilat2d_long() */
 
@@ -719,6 +745,7 @@ int32_t lgeoeros(
 #undef F_NAME
 #define F_NAME "lgeoeros"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -743,6 +770,10 @@ int32_t lgeoeros(
         break;
     } /* switch (connex) */
 
+    if ((niter == -1) && (datatype(f) == datatype(g)) && lreconshybride_possible(f, connex)) {
+        return lreconshybride(g, f, connex, 1);
+    }
+
     if ((rowsize(f) != rs) || (colsize(f) != cs)) {
         fprintf(stderr, "%s: incompatible sizes\n", F_NAME);
         return 0;
@@ -766,11 +797,15 @@ int32_t lgeoeros(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     for (x = 0; x < N; x++) { /* force G à être >= F */
@@ -785,7 +820,7 @@ int32_t lgeoeros(
         nbchang = 0;
         while (! FifoVide(FIFO[iter % 2])) {
             x = FifoPop(FIFO[iter % 2]);
-            UnSet(x, iter % 2);
+            IndUnSet(Ind, x, iter % 2);
             inf = G[x];
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
@@ -797,15 +832,15 @@ int32_t lgeoeros(
             inf = mcmax(inf, F[x]);
             if (G[x] != inf) {         /* le point a change : on l'enregistre ainsi que ses voisins */
                 nbchang += 1;
-                if (! IsSet(x, (iter + 1) % 2)) {
+                if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                     FifoPush(FIFO[(iter + 1) % 2], x);
-                    Set(x, (iter + 1) % 2);
+                    IndSet(Ind, x, (iter + 1) % 2);
                 }
                 for (k = 0; k < 8; k += 1) {
                     y = voisin(x, k, rs, N);
-                    if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                    if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                         FifoPush(FIFO[(iter + 1) % 2], y);
-                        Set(y, (iter + 1) % 2);
+                        IndSet(Ind, y, (iter + 1) % 2);
                     }
                 } /* for k */
             }
@@ -835,7 +870,7 @@ int32_t lgeoeros(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } /* lgeoeros() */
 
@@ -1152,6 +1187,7 @@ int32_t lgeodilat3d(
 #undef F_NAME
 #define F_NAME "lgeodilat3d"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -1180,11 +1216,15 @@ int32_t lgeodilat3d(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     H = (uint8_t *)calloc(1,N*sizeof(char));
@@ -1206,7 +1246,7 @@ int32_t lgeodilat3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 26; k += 1) {
                     y = voisin26(x, k, rs, n, N);
@@ -1219,15 +1259,15 @@ int32_t lgeodilat3d(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 26; k += 1) {
                         y = voisin26(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1247,7 +1287,7 @@ int32_t lgeodilat3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 18; k += 1) {
                     y = voisin18(x, k, rs, n, N);
@@ -1260,15 +1300,15 @@ int32_t lgeodilat3d(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 18; k += 1) {
                         y = voisin18(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1288,7 +1328,7 @@ int32_t lgeodilat3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
@@ -1301,15 +1341,15 @@ int32_t lgeodilat3d(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k <= 10; k += 2) {
                         y = voisin6(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1339,7 +1379,7 @@ int32_t lgeodilat3d(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } // lgeodilat3d(
 
@@ -1361,6 +1401,7 @@ int32_t lgeodilatcond3d(
 #undef F_NAME
 #define F_NAME "lgeodilatcond3d"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -1396,12 +1437,16 @@ int32_t lgeodilatcond3d(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) { /* mise en fifo initiale de tous les points */
         if (C[x]) {
             FifoPush(FIFO[1], x);
-            Set(x, 1);
+            IndSet(Ind, x, 1);
         }
     }
 
@@ -1424,7 +1469,7 @@ int32_t lgeodilatcond3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 26; k += 1) {
                     y = voisin26(x, k, rs, n, N);
@@ -1437,15 +1482,15 @@ int32_t lgeodilatcond3d(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 26; k += 1) {
                         y = voisin26(x, k, rs, n, N);
-                        if ((y != -1) && (C[y]) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (C[y]) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1465,7 +1510,7 @@ int32_t lgeodilatcond3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 18; k += 1) {
                     y = voisin18(x, k, rs, n, N);
@@ -1478,15 +1523,15 @@ int32_t lgeodilatcond3d(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 18; k += 1) {
                         y = voisin18(x, k, rs, n, N);
-                        if ((y != -1) && (C[y]) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (C[y]) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1506,7 +1551,7 @@ int32_t lgeodilatcond3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
@@ -1519,15 +1564,15 @@ int32_t lgeodilatcond3d(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k <= 10; k += 2) {
                         y = voisin6(x, k, rs, n, N);
-                        if ((y != -1) && (C[y]) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (C[y]) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1557,7 +1602,7 @@ int32_t lgeodilatcond3d(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } // lgeodilatcond3d(
 
@@ -1577,6 +1622,7 @@ int32_t lgeodilat3d_short(
 #undef F_NAME
 #define F_NAME "lgeodilat3d_short"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -1605,11 +1651,15 @@ int32_t lgeodilat3d_short(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     H = (int16_t *)calloc(1,N*sizeof(int16_t));
@@ -1631,7 +1681,7 @@ int32_t lgeodilat3d_short(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 26; k += 1) {
                     y = voisin26(x, k, rs, n, N);
@@ -1644,15 +1694,15 @@ int32_t lgeodilat3d_short(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 26; k += 1) {
                         y = voisin26(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1672,7 +1722,7 @@ int32_t lgeodilat3d_short(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 18; k += 1) {
                     y = voisin18(x, k, rs, n, N);
@@ -1685,15 +1735,15 @@ int32_t lgeodilat3d_short(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 18; k += 1) {
                         y = voisin18(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1713,7 +1763,7 @@ int32_t lgeodilat3d_short(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
@@ -1726,15 +1776,15 @@ int32_t lgeodilat3d_short(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k <= 10; k += 2) {
                         y = voisin6(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1764,7 +1814,7 @@ int32_t lgeodilat3d_short(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } // lgeodilat3d_short(
 
@@ -1784,6 +1834,7 @@ int32_t lgeodilat3d_long(
 #undef F_NAME
 #define F_NAME "lgeodilat3d_long"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -1812,11 +1863,15 @@ int32_t lgeodilat3d_long(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     H = (int32_t *)calloc(1,N*sizeof(int32_t));
@@ -1838,7 +1893,7 @@ int32_t lgeodilat3d_long(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 26; k += 1) {
                     y = voisin26(x, k, rs, n, N);
@@ -1851,15 +1906,15 @@ int32_t lgeodilat3d_long(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 26; k += 1) {
                         y = voisin26(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1879,7 +1934,7 @@ int32_t lgeodilat3d_long(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k < 18; k += 1) {
                     y = voisin18(x, k, rs, n, N);
@@ -1892,15 +1947,15 @@ int32_t lgeodilat3d_long(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 18; k += 1) {
                         y = voisin18(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1920,7 +1975,7 @@ int32_t lgeodilat3d_long(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 sup = G[x];
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
@@ -1933,15 +1988,15 @@ int32_t lgeodilat3d_long(
                 if (G[x] != sup) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k <= 10; k += 2) {
                         y = voisin6(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -1971,7 +2026,7 @@ int32_t lgeodilat3d_long(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } // lgeodilat3d_long(
 
@@ -1986,6 +2041,9 @@ int32_t lreconsdilat3d(
 /* resultat dans g */
 /* ==================================== */
 {
+    if ((datatype(f) == datatype(g)) && lreconshybride_possible(f, connex)) {
+        return lreconshybride(g, f, connex, 0);
+    }
     return lgeodilat3d(g, f, connex, -1);
 }
 
@@ -2005,6 +2063,7 @@ int32_t lgeoeros3d(
 #undef F_NAME
 #define F_NAME "lgeoeros3d"
 {
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     index_t nbchang, iter;
     index_t x;                       /* index muet de pixel */
     index_t y;                       /* index muet (generalement un voisin de x) */
@@ -2021,6 +2080,10 @@ int32_t lgeoeros3d(
     uint8_t inf;
     Fifo * FIFO[2];
 
+    if ((niter == -1) && (datatype(f) == datatype(g)) && lreconshybride_possible(f, connex)) {
+        return lreconshybride(g, f, connex, 1);
+    }
+
     if ((rowsize(f) != rs) || (colsize(f) != cs) || (depth(f) != d)) {
         fprintf(stderr, "%s: incompatible sizes\n", F_NAME);
         return 0;
@@ -2033,11 +2096,15 @@ int32_t lgeoeros3d(
         return(0);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
 
     for (x = 0; x < N; x++) {    /* mise en fifo initiale de tous les points */
         FifoPush(FIFO[1], x);
-        Set(x, 1);
+        IndSet(Ind, x, 1);
     }
 
     H = (uint8_t *)calloc(1,N*sizeof(char));
@@ -2059,7 +2126,7 @@ int32_t lgeoeros3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 inf = G[x];
                 for (k = 0; k < 26; k += 1) {
                     y = voisin26(x, k, rs, n, N);
@@ -2072,15 +2139,15 @@ int32_t lgeoeros3d(
                 if (G[x] != inf) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 26; k += 1) {
                         y = voisin26(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -2100,7 +2167,7 @@ int32_t lgeoeros3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 inf = G[x];
                 for (k = 0; k < 18; k += 1) {
                     y = voisin18(x, k, rs, n, N);
@@ -2113,15 +2180,15 @@ int32_t lgeoeros3d(
                 if (G[x] != inf) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k < 18; k += 1) {
                         y = voisin18(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -2141,7 +2208,7 @@ int32_t lgeoeros3d(
             nbchang = 0;
             while (! FifoVide(FIFO[iter % 2])) {
                 x = FifoPop(FIFO[iter % 2]);
-                UnSet(x, iter % 2);
+                IndUnSet(Ind, x, iter % 2);
                 inf = G[x];
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
@@ -2154,15 +2221,15 @@ int32_t lgeoeros3d(
                 if (G[x] != inf) {
                     /* changement: on enregistre x ainsi que ses voisins */
                     nbchang += 1;
-                    if (! IsSet(x, (iter + 1) % 2)) {
+                    if (! IndIsSet(Ind, x, (iter + 1) % 2)) {
                         FifoPush(FIFO[(iter + 1) % 2], x);
-                        Set(x, (iter + 1) % 2);
+                        IndSet(Ind, x, (iter + 1) % 2);
                     }
                     for (k = 0; k <= 10; k += 2) {
                         y = voisin6(x, k, rs, n, N);
-                        if ((y != -1) && (! IsSet(y, (iter + 1) % 2))) {
+                        if ((y != -1) && (! IndIsSet(Ind, y, (iter + 1) % 2))) {
                             FifoPush(FIFO[(iter + 1) % 2], y);
-                            Set(y, (iter + 1) % 2);
+                            IndSet(Ind, y, (iter + 1) % 2);
                         }
                     } /* for k */
                 }
@@ -2192,7 +2259,7 @@ int32_t lgeoeros3d(
 
     FifoTermine(FIFO[0]);
     FifoTermine(FIFO[1]);
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     return 1;
 } // lgeoeros3d(
 
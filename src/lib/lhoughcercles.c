@@ -38,20 +38,367 @@ knowledge of the CeCILL license and that you accept its terms.
    avec le rayon variant a partir de rayonmin
    par pas de pasrayon (nombre de pas = nbpas)
 */
+/* octobre 2026 : vote depuis les seuls points non nuls (points de
+   contour), rayons traites en parallele avec un accumulateur par tache ;
+   lhoughcercles_pics : vote restreint a la direction du gradient et
+   extraction des maxima locaux sans stocker tous les plans de rayon
+*/
 
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
 #include <sys/types.h>
 #include <stdlib.h>
+#include <math.h>
 #include <mcimage.h>
 #include <mccodimage.h>
 #include <mcutil.h>
+#include <mcthreads.h>
 #include <lbresen.h>
 #include <lhoughcercles.h>
 
 #define VERBOSE
 
+typedef struct {
+    int32_t n;           /* nombre de points du cercle */
+    int32_t *dx, *dy;    /* decalages des points par rapport au centre, par angle croissant */
+    double *ang;         /* angle de chaque decalage, dans [-pi, pi] */
+} hough_cercle;
+
+typedef struct {
+    int32_t rs, cs;
+    int32_t ne;          /* nombre de points votants */
+    int32_t *ex, *ey;    /* coordonnees des points votants */
+    uint32_t *ev;        /* poids (niveau de gris) des points votants */
+    double *eth;         /* direction du gradient (NULL : vote sur tout le cercle) */
+    uint8_t *eok;        /* gradient non nul */
+    hough_cercle *C;     /* un cercle discret par rayon */
+    int32_t n0, n1;      /* indices des rayons du lot courant : n0 .. n1-1 */
+    int32_t ntaches;
+    uint32_t **accu;     /* un accumulateur par tache */
+    uint8_t *H;          /* lhoughcercles : tous les plans (nbpas * N) */
+    float **plans;       /* lhoughcercles_pics : plans en anneau */
+    int32_t W;           /* nombre de plans de l'anneau */
+    int32_t *maxh;       /* maximum de chaque plan (lhoughcercles) */
+} hough_job;
+
+/* ==================================== */
+static int32_t hough_cmpang(const void *a, const void *b)
+/* ==================================== */
+{
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da < db) ? -1 : ((da > db) ? 1 : 0);
+}
+
+/* ==================================== */
+static int32_t hough_cercle_cree(hough_cercle *C, int32_t rayon)
+/* ==================================== */
+/* genere le cercle discret de rayon donne (trace de lellipse), trie par angle */
+{
+    int32_t rsm = 2 * rayon + 1, Nm = rsm * rsm, i, j, k;
+    uint8_t *M;
+    double *tri;
+
+    M = (uint8_t *)calloc(1, Nm);
+    if (M == NULL) {
+        return 0;
+    }
+    lellipse(M, rsm, rsm, (int32_t)rayon, 0, 0, (int32_t)rayon, (int32_t)rayon, (int32_t)rayon);
+    C->n = 0;
+    for (i = 0; i < Nm; i += 1) {
+        if (M[i]) {
+            C->n += 1;
+        }
+    }
+    C->dx = (int32_t *)malloc((C->n + 1) * sizeof(int32_t));
+    C->dy = (int32_t *)malloc((C->n + 1) * sizeof(int32_t));
+    C->ang = (double *)malloc((C->n + 1) * sizeof(double));
+    tri = (double *)malloc((C->n + 1) * 3 * sizeof(double));
+    if ((C->dx == NULL) || (C->dy == NULL) || (C->ang == NULL) || (tri == NULL)) {
+        free(M);
+        free(tri);
+        return 0;
+    }
+    k = 0;
+    for (j = 0; j < rsm; j += 1) {
+        for (i = 0; i < rsm; i += 1) {
+            if (M[j * rsm + i]) {
+                tri[3 * k] = atan2((double)(j - rayon), (double)(i - rayon));
+                tri[3 * k + 1] = (double)(i - rayon);
+                tri[3 * k + 2] = (double)(j - rayon);
+                k += 1;
+            }
+        }
+    }
+    qsort(tri, C->n, 3 * sizeof(double), hough_cmpang);
+    for (k = 0; k < C->n; k++) {
+        C->ang[k] = tri[3 * k];
+        C->dx[k] = (int32_t)tri[3 * k + 1];
+        C->dy[k] = (int32_t)tri[3 * k + 2];
+    }
+    free(tri);
+    free(M);
+    return 1;
+} // hough_cercle_cree()
+
+/* ==================================== */
+static void hough_cercles_termine(hough_cercle *C, int32_t nbpas)
+/* ==================================== */
+{
+    int32_t n;
+    if (C == NULL) {
+        return;
+    }
+    for (n = 0; n < nbpas; n++) {
+        free(C[n].dx);
+        free(C[n].dy);
+        free(C[n].ang);
+    }
+    free(C);
+}
+
+/* ==================================== */
+static hough_cercle *hough_cercles_cree(int32_t rayonmin, int32_t pasrayon, int32_t nbpas)
+/* ==================================== */
+{
+    hough_cercle *C;
+    int32_t n;
+    C = (hough_cercle *)calloc(nbpas, sizeof(hough_cercle));
+    if (C == NULL) {
+        return NULL;
+    }
+    for (n = 0; n < nbpas; n++) {
+        if (!hough_cercle_cree(&C[n], rayonmin + n * pasrayon)) {
+            hough_cercles_termine(C, nbpas);
+            return NULL;
+        }
+    }
+    return C;
+}
+
+/* ==================================== */
+static int32_t hough_votants(hough_job *J, uint8_t *F, uint8_t *G)
+/* ==================================== */
+/* liste des points non nuls de F ; si G != NULL, direction du gradient
+   de G (Sobel) en ces points */
+{
+    int32_t rs = J->rs, cs = J->cs, x, y, k;
+    int32_t gx, gy;
+    uint8_t *g;
+
+    J->ne = 0;
+    for (k = 0; k < rs * cs; k++) {
+        if (F[k]) {
+            J->ne += 1;
+        }
+    }
+    J->ex = (int32_t *)malloc((J->ne + 1) * sizeof(int32_t));
+    J->ey = (int32_t *)malloc((J->ne + 1) * sizeof(int32_t));
+    J->ev = (uint32_t *)malloc((J->ne + 1) * sizeof(uint32_t));
+    J->eth = NULL;
+    J->eok = NULL;
+    if ((J->ex == NULL) || (J->ey == NULL) || (J->ev == NULL)) {
+        return 0;
+    }
+    if (G != NULL) {
+        J->eth = (double *)malloc((J->ne + 1) * sizeof(double));
+        J->eok = (uint8_t *)malloc(J->ne + 1);
+        if ((J->eth == NULL) || (J->eok == NULL)) {
+            return 0;
+        }
+    }
+    k = 0;
+    for (y = 0; y < cs; y++) {
+        for (x = 0; x < rs; x++) {
+            if (F[y * rs + x] == 0) {
+                continue;
+            }
+            J->ex[k] = x;
+            J->ey[k] = y;
+            J->ev[k] = (uint32_t)F[y * rs + x];
+            if (G != NULL) {
+                J->eok[k] = 0;
+                if ((x > 0) && (y > 0) && (x < rs - 1) && (y < cs - 1)) {
+                    g = G + y * rs + x;
+                    gx = (g[1 - rs] + 2 * g[1] + g[1 + rs]) - (g[-1 - rs] + 2 * g[-1] + g[-1 + rs]);
+                    gy = (g[rs - 1] + 2 * g[rs] + g[rs + 1]) - (g[-rs - 1] + 2 * g[-rs] + g[-rs + 1]);
+                    if ((gx != 0) || (gy != 0)) {
+                        J->eth[k] = atan2((double)gy, (double)gx);
+                        J->eok[k] = 1;
+                    }
+                }
+            }
+            k++;
+        }
+    }
+    return 1;
+} // hough_votants()
+
+/* ==================================== */
+static void hough_votants_termine(hough_job *J)
+/* ==================================== */
+{
+    free(J->ex);
+    free(J->ey);
+    free(J->ev);
+    free(J->eth);
+    free(J->eok);
+}
+
+/* ==================================== */
+static void hough_arc(uint32_t *Accu, int32_t rs, int32_t cs, hough_cercle *C,
+                      int32_t x, int32_t y, uint32_t v, double theta)
+/* ==================================== */
+/* vote pour les points du cercle C centre en (x,y) dont l'angle est dans
+   [theta - HOUGH_TOLANGLE, theta + HOUGH_TOLANGLE] */
+{
+    int32_t lo, hi, mid, c, i, k, l;
+    double a = theta - HOUGH_TOLANGLE;
+
+    if (a < -M_PI) {
+        a += 2 * M_PI;
+    }
+    lo = 0; // premier point d'angle >= a
+    hi = C->n;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (C->ang[mid] < a) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (i = 0, c = lo; i < C->n; i++, c++) {
+        if (c == C->n) {
+            c = 0;
+            a -= 2 * M_PI;
+        }
+        if (C->ang[c] - a > 2 * HOUGH_TOLANGLE) {
+            break;
+        }
+        l = y + C->dy[c];
+        k = x + C->dx[c];
+        if ((l >= 0) && (l < cs) && (k >= 0) && (k < rs)) {
+            Accu[l * rs + k] += v;
+        }
+    }
+} // hough_arc()
+
+/* ==================================== */
+static void hough_vote(hough_job *J, int32_t n, uint32_t *Accu)
+/* ==================================== */
+/* accumulateur du rayon d'indice n : chaque point votant p renforce les
+   points situes a la distance 'rayon' de p (dans la direction du gradient,
+   dans les deux sens, si elle est connue) */
+{
+    int32_t rs = J->rs, cs = J->cs, e, c, k, l, x, y;
+    hough_cercle *C = &J->C[n];
+    uint32_t v;
+
+    memset(Accu, 0, (index_t)rs * cs * sizeof(uint32_t));
+    for (e = 0; e < J->ne; e++) {
+        x = J->ex[e];
+        y = J->ey[e];
+        v = J->ev[e];
+        if ((J->eth != NULL) && J->eok[e]) {
+            hough_arc(Accu, rs, cs, C, x, y, v, J->eth[e]);
+            hough_arc(Accu, rs, cs, C, x, y, v, (J->eth[e] > 0) ? J->eth[e] - M_PI : J->eth[e] + M_PI);
+            continue;
+        }
+        for (c = 0; c < C->n; c += 1) {
+            l = y + C->dy[c];
+            k = x + C->dx[c];
+            if ((l >= 0) && (l < cs) && (k >= 0) && (k < rs)) {
+                Accu[l * rs + k] += v;
+            }
+        }
+    }
+} // hough_vote()
+
+/* ==================================== */
+static void hough_tache_image(void *arg, int32_t t)
+/* ==================================== */
+{
+    hough_job *J = (hough_job *)arg;
+    index_t N = (index_t)J->rs * J->cs, x;
+    int32_t n, nptb, maxh;
+    uint32_t *Accu = J->accu[t], tmp;
+    uint8_t *H;
+
+    for (n = J->n0 + t; n < J->n1; n += J->ntaches) {
+        hough_vote(J, n, Accu);
+        /* normalisation : le max theorique est obtenu pour un cercle blanc complet */
+        nptb = J->C[n].n;
+        H = J->H + n * N;
+        maxh = NDG_MIN;
+        for (x = 0; x < N; x++) {
+            tmp = Accu[x] / nptb;
+            H[x] = (uint8_t)tmp;
+            if ((int32_t)tmp > maxh) {
+                maxh = tmp;
+            }
+        }
+        J->maxh[n] = maxh;
+    }
+} // hough_tache_image()
+
+/* ==================================== */
+static void hough_tache_plans(void *arg, int32_t t)
+/* ==================================== */
+{
+    hough_job *J = (hough_job *)arg;
+    index_t N = (index_t)J->rs * J->cs, x;
+    int32_t n;
+    uint32_t *Accu = J->accu[t];
+    float *P, nptb;
+
+    for (n = J->n0 + t; n < J->n1; n += J->ntaches) {
+        hough_vote(J, n, Accu);
+        nptb = (float)J->C[n].n;
+        P = J->plans[n % J->W];
+        for (x = 0; x < N; x++) {
+            P[x] = (float)Accu[x] / nptb;
+        }
+    }
+} // hough_tache_plans()
+
+/* ==================================== */
+static uint32_t **hough_accus(int32_t ntaches, index_t N)
+/* ==================================== */
+{
+    uint32_t **A;
+    int32_t t;
+    A = (uint32_t **)calloc(ntaches, sizeof(uint32_t *));
+    if (A == NULL) {
+        return NULL;
+    }
+    for (t = 0; t < ntaches; t++) {
+        A[t] = (uint32_t *)malloc(N * sizeof(uint32_t));
+        if (A[t] == NULL) {
+            for (t = 0; t < ntaches; t++) {
+                free(A[t]);
+            }
+            free(A);
+            return NULL;
+        }
+    }
+    return A;
+}
+
+/* ==================================== */
+static void hough_accus_termine(uint32_t **A, int32_t ntaches)
+/* ==================================== */
+{
+    int32_t t;
+    if (A == NULL) {
+        return;
+    }
+    for (t = 0; t < ntaches; t++) {
+        free(A[t]);
+    }
+    free(A);
+}
+
 /* ==================================== */
 int32_t lhoughcercles(struct xvimage *f, /* image de depart - en niveaux de gris */
                       int32_t rayonmin,      /* premier rayon */
@@ -60,130 +407,227 @@ int32_t lhoughcercles(struct xvimage *f, /* image de depart - en niveaux de gris
                       struct xvimage *h  /* accumulateur - doit etre alloue aux bonnes dimensions */
                      )
 /* ==================================== */
+/*
+  Seuls les points non nuls de f votent (un point nul n'apporte rien a
+  l'accumulateur) : le cout est O(nombre de points non nuls * taille des
+  cercles). Les rayons sont repartis entre les threads (mcthreads), chacun
+  disposant de son propre accumulateur.
+*/
 {
-    int32_t x;                       /* index muet de pixel */
-    int32_t y;                       /* index muet (generalement un voisin de x) */
-    register int32_t i, j;                    /* index muet */
-    register int32_t k, l;                    /* index muet */
-    int32_t rs = rowsize(f);         /* taille ligne */
-    int32_t cs = colsize(f);         /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
-    int32_t rsm;                     /* taille ligne masque */
-    int32_t csm;                     /* taille colonne masque */
-    int32_t Nm;
-    struct xvimage *m;
-    uint8_t *M;
-    uint8_t *F = UCHARDATA(f);
-    uint8_t *H;            /* resultat */
-    uint32_t *Accu;         /* accumulateur temporaire */
-    uint32_t tmp;
-    int32_t rayon, n;
-    int32_t nptb;                    /* nombre de points du cercle */
-    int32_t *tab_es_x;               /* liste des coord. x des points du cercle */
-    int32_t *tab_es_y;               /* liste des coord. y des points du cercle */
-    int32_t c, maxh;
+    index_t rs = rowsize(f);         /* taille ligne */
+    index_t cs = colsize(f);         /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
+    int32_t n, ret = 0;
+    hough_job J;
 
     if (depth(f) != 1) {
         fprintf(stderr, "lhoughcercles: cette version ne traite pas les images volumiques\n");
         return 0;
     }
 
-    /* verifie les dimensions de l'image resultat et alloue l'accu temporaire */
+    /* verifie les dimensions de l'image resultat */
     if ((depth(h) < nbpas) || (rowsize(h) != rs) || (colsize(h) != cs)) {
         fprintf(stderr, "lhoughcercles: dimensions incompatibles\n");
         return 0;
     }
-    H = UCHARDATA(h);
+    if ((rayonmin < 1) || (pasrayon < 0) || (nbpas < 1)) {
+        fprintf(stderr, "lhoughcercles: bad parameters\n");
+        return 0;
+    }
 
-    Accu = (uint32_t *)calloc(1,N * sizeof(int32_t));
-    if (Accu == NULL) {
-        fprintf(stderr,"lhoughcercles() : calloc failed for H\n");
-        return(0);
+    memset(&J, 0, sizeof(J));
+    J.rs = rs;
+    J.cs = cs;
+    J.H = UCHARDATA(h);
+    J.n0 = 0;
+    J.n1 = nbpas;
+    J.ntaches = mcmin(mcthreads_nthreads(), nbpas);
+    J.C = hough_cercles_cree(rayonmin, pasrayon, nbpas);
+    J.accu = hough_accus(J.ntaches, N);
+    J.maxh = (int32_t *)calloc(nbpas, sizeof(int32_t));
+    if ((J.C == NULL) || (J.accu == NULL) || (J.maxh == NULL) ||
+        !hough_votants(&J, UCHARDATA(f), NULL)) {
+        fprintf(stderr,"lhoughcercles() : malloc failed\n");
+        goto fin;
     }
 
-    /* boucle sur les rayons */
+    mcthreads_run(J.ntaches, hough_tache_image, &J);
+
+#ifdef VERBOSE
+    for (n = 0; n < nbpas; n++) {
+        printf("rayon = %d, max = %d\n", rayonmin + n * pasrayon, J.maxh[n]);
+    }
+#endif
+    ret = 1;
 
-    for (rayon = rayonmin, n = 0;
-            n < nbpas;
-            rayon += pasrayon, n++
-        ) {
-        memset(Accu, 0, N * sizeof(int32_t));
+fin:
+    hough_votants_termine(&J);
+    hough_accus_termine(J.accu, J.ntaches);
+    hough_cercles_termine(J.C, nbpas);
+    free(J.maxh);
+    return ret;
+} // lhoughcercles()
 
-        rsm = 2 * rayon + 1;     /* taille ligne masque */
-        csm = 2 * rayon + 1;     /* taille colonne masque */
-        Nm = rsm * csm;
+/* ==================================== */
+static int32_t hough_maxlocal(float **P, int32_t W, int32_t nbpas, int32_t n,
+                              int32_t rs, int32_t cs, int32_t x, int32_t y)
+/* ==================================== */
+/* teste si (x,y,n) est un maximum local (voisinage 3x3x3) ; en cas
+   d'egalite, seul le premier point (ordre n, y, x) est retenu */
+{
+    int32_t dn, dx, dy, xx, yy;
+    float v = P[n % W][y * rs + x], w;
 
-        /* genere un cercle dans une imagette m */
-        m = allocimage(NULL, rsm, csm, 1, VFF_TYP_1_BYTE);
-        if (m == NULL) {
-            fprintf(stderr,"lhoughcercles() : allocimage failed\n");
-            return(0);
+    for (dn = -1; dn <= 1; dn++) {
+        if ((n + dn < 0) || (n + dn >= nbpas)) {
+            continue;
         }
-        M = UCHARDATA(m);
-        memset(M, 0, Nm);
-        lellipse(M, rsm, csm, (int32_t)rayon, 0, 0, (int32_t)rayon, (int32_t)rayon, (int32_t)rayon);
-
-        /* compte le nombre de points du cercle */
-        nptb = 0;
-        for (i = 0; i < Nm; i += 1) {
-            if (M[i]) {
-                nptb += 1;
+        for (dy = -1; dy <= 1; dy++) {
+            yy = y + dy;
+            if ((yy < 0) || (yy >= cs)) {
+                continue;
+            }
+            for (dx = -1; dx <= 1; dx++) {
+                xx = x + dx;
+                if ((xx < 0) || (xx >= rs) || ((dn == 0) && (dy == 0) && (dx == 0))) {
+                    continue;
+                }
+                w = P[(n + dn) % W][yy * rs + xx];
+                if (w > v) {
+                    return 0;
+                }
+                if ((w == v) && ((dn < 0) || ((dn == 0) && ((dy < 0) || ((dy == 0) && (dx < 0)))))) {
+                    return 0;
+                }
             }
         }
+    }
+    return 1;
+} // hough_maxlocal()
 
-        /* dresse la liste des points du cercle */
-        tab_es_x = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-        tab_es_y = (int32_t *)calloc(1,nptb * sizeof(int32_t));
-        if ((tab_es_x == NULL) || (tab_es_y == NULL)) {
-            fprintf(stderr,"lhoughcercles() : malloc failed for tab_es\n");
-            return(0);
-        }
+/* ==================================== */
+houghcercle *lhoughcercles_pics(struct xvimage *f, /* image des contours - en niveaux de gris */
+                                struct xvimage *g, /* image pour le gradient, ou NULL */
+                                int32_t rayonmin,  /* premier rayon */
+                                int32_t pasrayon,  /* increment du rayon */
+                                int32_t nbpas,     /* nombre de rayons a considerer */
+                                double seuil,      /* score minimal d'un cercle */
+                                int32_t *nbcercles /* (sortie) nombre de cercles */
+                               )
+/* ==================================== */
+/*! \fn houghcercle *lhoughcercles_pics(struct xvimage *f, struct xvimage *g, int32_t rayonmin, int32_t pasrayon, int32_t nbpas, double seuil, int32_t *nbcercles)
+    \param f (entrée) : image des contours (les points non nuls votent avec leur niveau de gris)
+    \param g (entrée) : image dont le gradient (Sobel) oriente les votes, ou NULL
+    \param rayonmin, pasrayon, nbpas (entrée) : rayons a considerer
+    \param seuil (entrée) : score minimal d'un cercle
+    \param nbcercles (sortie) : nombre de cercles trouves
+    \return tableau des cercles trouves (a liberer par free), NULL en cas d'echec
+    \brief detecte les cercles : maxima locaux (voisinage 3x3x3 en x, y, rayon)
+       de l'accumulateur de Hough dont le score est >= seuil.
+       Le score est normalise comme dans lhoughcercles : somme des votes
+       divisee par le nombre de points du cercle (255 pour un cercle blanc complet).
+       Si g est fourni, chaque point de contour de gradient non nul ne vote que
+       pour les centres situes dans la direction du gradient (a HOUGH_TOLANGLE
+       pres, dans les deux sens).
+       Les rayons sont traites par lots de la taille de la reserve de threads
+       (un accumulateur par tache) ; seuls ces plans, plus deux, sont conserves.
+*/
+{
+    index_t rs = rowsize(f), cs = colsize(f), N = rs * cs, x;
+    int32_t n, k, nmax = 0, faits, W = 0;
+    houghcercle *R = NULL, *tmp;
+    float *P;
+    hough_job J;
+#undef F_NAME
+#define F_NAME "lhoughcercles_pics"
 
-        k = 0;
-        for (j = 0; j < csm; j += 1) {
-            for (i = 0; i < rsm; i += 1) {
-                if (M[j * rsm + i]) {
-                    tab_es_x[k] = i;
-                    tab_es_y[k] = j;
-                    k += 1;
-                }
-            }
+    *nbcercles = 0;
+    if ((depth(f) != 1) || (datatype(f) != VFF_TYP_1_BYTE)) {
+        fprintf(stderr, "%s: only 2D byte images are supported\n", F_NAME);
+        return NULL;
+    }
+    if ((g != NULL) && ((rowsize(g) != rs) || (colsize(g) != cs) || (depth(g) != 1) ||
+                        (datatype(g) != VFF_TYP_1_BYTE))) {
+        fprintf(stderr, "%s: incompatible gradient image\n", F_NAME);
+        return NULL;
+    }
+    if ((rayonmin < 1) || (pasrayon < 0) || (nbpas < 1)) {
+        fprintf(stderr, "%s: bad parameters\n", F_NAME);
+        return NULL;
+    }
+
+    memset(&J, 0, sizeof(J));
+    J.rs = rs;
+    J.cs = cs;
+    J.ntaches = mcmin(mcthreads_nthreads(), nbpas);
+    J.W = W = J.ntaches + 2;
+    J.C = hough_cercles_cree(rayonmin, pasrayon, nbpas);
+    J.accu = hough_accus(J.ntaches, N);
+    J.plans = (float **)calloc(W, sizeof(float *));
+    R = (houghcercle *)malloc(16 * sizeof(houghcercle));
+    nmax = 16;
+    if ((J.C == NULL) || (J.accu == NULL) || (J.plans == NULL) || (R == NULL) ||
+        !hough_votants(&J, UCHARDATA(f), (g != NULL) ? UCHARDATA(g) : NULL)) {
+        goto echec;
+    }
+    for (k = 0; k < W; k++) {
+        J.plans[k] = (float *)malloc(N * sizeof(float));
+        if (J.plans[k] == NULL) {
+            goto echec;
         }
+    }
 
-        /* pour tous les points p de l'image, renforce les points de l'accumulateur qui sont a
-           une distance 'rayon' du point p */
-        for (y = 0; y < cs; y++) {
-            for (x = 0; x < rs; x++) {
-                tmp = (uint32_t)F[y * rs + x];
-                for (c = 0; c < nptb; c += 1) {
-                    l = y + tab_es_y[c] - rayon;
-                    k = x + tab_es_x[c] - rayon;
-                    if ((l >= 0) && (l < cs) && (k >= 0) && (k < rs)) {
-                        Accu[l * rs + k] += tmp;
+    /* lot de plans [n0, n1[ calcule en parallele, puis maxima locaux des
+       plans dont les deux voisins sont connus ; le lot suivant ecrase des
+       plans d'indice < n1 - 2, deja examines */
+    faits = 0;
+    for (J.n0 = 0; J.n0 < nbpas; J.n0 = J.n1) {
+        J.n1 = mcmin(J.n0 + J.ntaches, nbpas);
+        mcthreads_run(J.ntaches, hough_tache_plans, &J);
+        for (n = faits; (n < J.n1 - 1) || ((J.n1 == nbpas) && (n < nbpas)); n++) {
+            P = J.plans[n % W];
+            for (x = 0; x < N; x++) {
+                if ((P[x] >= seuil) && hough_maxlocal(J.plans, W, nbpas, n, rs, cs, x % rs, x / rs)) {
+                    if (*nbcercles == nmax) {
+                        nmax *= 2;
+                        tmp = (houghcercle *)realloc(R, nmax * sizeof(houghcercle));
+                        if (tmp == NULL) {
+                            goto echec;
+                        }
+                        R = tmp;
                     }
+                    R[*nbcercles].x = x % rs;
+                    R[*nbcercles].y = x / rs;
+                    R[*nbcercles].rayon = rayonmin + n * pasrayon;
+                    R[*nbcercles].score = P[x];
+                    *nbcercles += 1;
                 }
             }
         }
+        faits = n;
+    }
 
-        /* normalisation : le max theorique est obtenu pour un cercle blanc complet */
-        maxh = NDG_MIN;
-        for (x = 0; x < N; x++) {
-            tmp = Accu[x] / nptb;
-            H[n * N + x] = (uint8_t)tmp;
-            if (tmp > maxh) {
-                maxh = tmp;
-            }
-        }
-
-#ifdef VERBOSE
-        printf("rayon = %d, max = %d\n", rayon, maxh);
-#endif
-
-        free(tab_es_x);
-        free(tab_es_y);
-        freeimage(m);
+    hough_votants_termine(&J);
+    hough_accus_termine(J.accu, J.ntaches);
+    hough_cercles_termine(J.C, nbpas);
+    for (k = 0; k < W; k++) {
+        free(J.plans[k]);
     }
+    free(J.plans);
+    return R;
 
-    free(Accu);
-    return 1;
-}
+echec:
+    fprintf(stderr, "%s: malloc failed\n", F_NAME);
+    hough_votants_termine(&J);
+    hough_accus_termine(J.accu, J.ntaches);
+    hough_cercles_termine(J.C, nbpas);
+    if (J.plans != NULL) {
+        for (k = 0; k < W; k++) {
+            free(J.plans[k]);
+        }
+    }
+    free(J.plans);
+    free(R);
+    *nbcercles = 0;
+    return NULL;
+} // lhoughcercles_pics()
@@ -39,6 +39,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <string.h>
 #include <mccodimage.h>
 #include <mclifo.h>
+#include <mclabel.h>
 #include <llabelextrema.h>
 
 //#define DEBUG
@@ -55,6 +56,7 @@ knowledge of the CeCILL license and that you accept its terms.
 * Written By: Michel Couprie
 * Update: april 1998 - image d'entiers longs
 * Update: jan 2005 - llabeldil
+* Update: oct 2026 - etiquetage par union-find (mclabel) pour 4, 8, 6, 18, 26
 *
 *
 * Remarques:
@@ -74,16 +76,17 @@ int32_t llabelextrema(
 #undef F_NAME
 #define F_NAME "llabelextrema"
 {
-    int32_t k, w, x, y;
+    int32_t k;
+    index_t w, x, y;
     uint8_t *F;
     int32_t *FL;
     int32_t *LABEL =  SLONGDATA(lab);
-    int32_t rs = rowsize(img);
-    int32_t cs = colsize(img);
-    int32_t d = depth(img);
-    int32_t n = rs * cs;          /* taille plan */
-    int32_t N = n * d;            /* taille image */
-    int32_t tailleplateau;
+    index_t rs = rowsize(img);
+    index_t cs = colsize(img);
+    index_t d = depth(img);
+    index_t n = rs * cs;          /* taille plan */
+    index_t N = n * d;            /* taille image */
+    index_t tailleplateau;
     Lifo * LIFO;
     int32_t label;
 
@@ -97,6 +100,10 @@ int32_t llabelextrema(
         return 0;
     }
 
+    if (mclabel_possible(img, connex)) { /* union-find, par bandes paralleles */
+        return mclabel(img, connex, minimum ? MCLABEL_MIN : MCLABEL_MAX, lab, nlabels);
+    }
+
     /* le LABEL initialement est mis a -1 */
     for (x = 0; x < N; x++) {
         LABEL[x] = -1;
@@ -119,14 +126,14 @@ int32_t llabelextrema(
                 LifoPush(LIFO, x);         /* on va parcourir le plateau auquel appartient x */
                 tailleplateau = 0;
 #ifdef DEBUG
-                printf("(%d,%d): init label %d\n", x%rs, x/rs, *nlabels);
+                printf("(%d,%d): init label %d\n", (int32_t)(x%rs), (int32_t)(x/rs), *nlabels);
 #endif
                 while (! LifoVide(LIFO)) {
                     tailleplateau++;
                     w = LifoPop(LIFO);
                     label = LABEL[w];
 #ifdef DEBUG
-                    printf("Pop(%d,%d): label %d\n", w%rs, w/rs, label);
+                    printf("Pop(%d,%d): label %d\n", (int32_t)(w%rs), (int32_t)(w/rs), label);
 #endif
                     switch (connex) {
                     case 4:
@@ -277,7 +284,7 @@ int32_t llabelextrema(
                                     LifoFlush(LIFO);
                                     LifoPush(LIFO, w);
 #ifdef DEBUG
-                                    printf("Push(%d,%d), non extremum: label %d\n", w%rs, w/rs, label);
+                                    printf("Push(%d,%d), non extremum: label %d\n", (int32_t)(w%rs), (int32_t)(w/rs), label);
 #endif
                                 } else if (F[y] == F[w]) {
                                     if (((label > 0) && (LABEL[y] == -1)) ||
@@ -285,7 +292,7 @@ int32_t llabelextrema(
                                         LABEL[y] = label;
                                         LifoPush(LIFO, y);
 #ifdef DEBUG
-                                        printf("Push(%d,%d): label %d\n", y%rs, y/rs, label);
+                                        printf("Push(%d,%d): label %d\n", (int32_t)(y%rs), (int32_t)(y/rs), label);
 #endif
                                     } /* if .. */
                                 } /* if F ... */
@@ -614,12 +621,13 @@ int32_t llabeldil(struct xvimage *f,
 #undef F_NAME
 #define F_NAME "llabeldil"
 {
-    int32_t x, y, v, w;           /* index muet de pixel */
+    index_t x, y, v, w;           /* index muet de pixel */
     register int32_t i, j;           /* index muet */
-    register int32_t k, l, c;        /* index muet */
-    int32_t rs = rowsize(f);         /* taille ligne */
-    int32_t cs = colsize(f);         /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    register index_t k, l;           /* index muet */
+    register int32_t c;              /* index muet */
+    index_t rs = rowsize(f);         /* taille ligne */
+    index_t cs = colsize(f);         /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     int32_t rsm = rowsize(m);        /* taille ligne masque */
     int32_t csm = colsize(m);        /* taille colonne masque */
     int32_t Nm = rsm * csm;
@@ -732,18 +740,20 @@ int32_t llabelbin(struct xvimage *f,
                   struct xvimage *lab, /* resultat: image de labels */
                   int32_t *nlabels)    /* resultat: nombre de composantes + 1 */
 /* labels the connected components according to adjacency relation connex.*/
+/* For an int32_t image, every nonzero voxel is foreground. */
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "llabelbin"
 {
-    int32_t x, v, w;           /* index muet de pixel */
+    index_t x, v, w;           /* index muet de pixel */
     register int32_t k;        /* index muet */
-    int32_t rs = rowsize(f);         /* taille ligne */
-    int32_t cs = colsize(f);         /* taille colonne */
-    int32_t ds = depth(f);           /* nb plans */
-    int32_t ps = rs * cs;            /* taille plan */
-    int32_t N = ps * ds;             /* taille image */
+    index_t rs = rowsize(f);         /* taille ligne */
+    index_t cs = colsize(f);         /* taille colonne */
+    index_t ds = depth(f);           /* nb plans */
+    index_t ps = rs * cs;            /* taille plan */
+    index_t N = ps * ds;             /* taille image */
     uint8_t *F = UCHARDATA(f);
+    int32_t *FL = (datatype(f) == VFF_TYP_4_BYTE) ? SLONGDATA(f) : NULL;
     int32_t *LABEL = SLONGDATA(lab);
     int32_t label;
     Lifo * LIFO;
@@ -758,8 +768,14 @@ int32_t llabelbin(struct xvimage *f,
         return 0;
     }
 
+    if (mclabel_possible(f, connex)) { /* union-find, par bandes paralleles */
+        return mclabel(f, connex, MCLABEL_BIN, lab, nlabels);
+    }
+
 #undef NOLABEL
 #define NOLABEL 0
+#undef FGD
+#define FGD(p) (FL ? (FL[p] != 0) : (F[p] != 0))
     /* le LABEL initialement est mis a NOLABEL */
     for (x = 0; x < N; x++) {
         LABEL[x] = NOLABEL;
@@ -774,7 +790,7 @@ int32_t llabelbin(struct xvimage *f,
     label = NOLABEL;
 
     for (w = 0; w < N; w++) {
-        if ((F[w]) && (LABEL[w] == NOLABEL)) { /* on trouve un point w non etiquete */
+        if (FGD(w) && (LABEL[w] == NOLABEL)) { /* on trouve un point w non etiquete */
             label += 1;       /* on cree un numero d'etiquette */
             LABEL[w] = label;
             LifoPush(LIFO, w);   /* on va parcourir la composante a laquelle appartient w */
@@ -784,7 +800,7 @@ int32_t llabelbin(struct xvimage *f,
                 case 4:
                     for (k = 0; k < 8; k += 2) {
                         v = voisin(x, k, rs, N);
-                        if ((v != -1)  && (F[v]) && (LABEL[v] == NOLABEL)) {
+                        if ((v != -1)  && FGD(v) && (LABEL[v] == NOLABEL)) {
                             LABEL[v] = label;
                             LifoPush(LIFO, v);
                         }
@@ -793,7 +809,7 @@ int32_t llabelbin(struct xvimage *f,
                 case 8:
                     for (k = 0; k < 8; k += 1) {
                         v = voisin(x, k, rs, N);
-                        if ((v != -1)  && (F[v]) && (LABEL[v] == NOLABEL)) {
+                        if ((v != -1)  && FGD(v) && (LABEL[v] == NOLABEL)) {
                             LABEL[v] = label;
                             LifoPush(LIFO, v);
                         }
@@ -802,7 +818,7 @@ int32_t llabelbin(struct xvimage *f,
                 case 6:
                     for (k = 0; k <= 10; k += 2) { /* parcourt les 6 voisins */
                         v = voisin6(x, k, rs, ps, N);
-                        if ((v != -1)  && (F[v]) && (LABEL[v] == NOLABEL)) {
+                        if ((v != -1)  && FGD(v) && (LABEL[v] == NOLABEL)) {
                             LABEL[v] = label;
                             LifoPush(LIFO, v);
                         }
@@ -811,7 +827,7 @@ int32_t llabelbin(struct xvimage *f,
                 case 18:
                     for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                         v = voisin18(x, k, rs, ps, N);
-                        if ((v != -1)  && (F[v]) && (LABEL[v] == NOLABEL)) {
+                        if ((v != -1)  && FGD(v) && (LABEL[v] == NOLABEL)) {
                             LABEL[v] = label;
                             LifoPush(LIFO, v);
                         }
@@ -820,7 +836,7 @@ int32_t llabelbin(struct xvimage *f,
                 case 26:
                     for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                         v = voisin26(x, k, rs, ps, N);
-                        if ((v != -1)  && (F[v]) && (LABEL[v] == NOLABEL)) {
+                        if ((v != -1)  && FGD(v) && (LABEL[v] == NOLABEL)) {
                             LABEL[v] = label;
                             LifoPush(LIFO, v);
                         }
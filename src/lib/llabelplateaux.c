@@ -38,6 +38,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <stdlib.h>
 #include <mccodimage.h>
 #include <mclifo.h>
+#include <mclabel.h>
 #ifdef PERF
 #include <mcchrono.h>
 #endif
@@ -117,6 +118,10 @@ int32_t llabelplateaux(
         return 0;
     }
 
+    if (mclabel_possible(img, connex)) { /* union-find, par bandes paralleles */
+        return mclabel(img, connex, MCLABEL_PLA, lab, nlabels);
+    }
+
     /* le LABEL initialement est mis a 0 (minimum) */
     for (x = 0; x < N; x++) {
         LABEL[x] = 0;
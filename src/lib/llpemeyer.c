@@ -46,6 +46,8 @@ knowledge of the CeCILL license and that you accept its terms.
    Update janvier 2000 : generation d'una animation (flag ANIMATE)
    Update janvier 2001 : mise a jour 2D-3D
    Update juin 2004  : "écriture" d'une version sans ligne
+   Update 2026 : images de type short, long et float (niveaux sur 32 bits
+                 dans la fah, sans requantification)
 */
 
 /*
@@ -85,6 +87,62 @@ int32_t llpemeyer_NotIn(int32_t e, int32_t *list, int32_t n)
     return 1;
 } /* llpemeyer_NotIn() */
 
+/* ==================================== */
+static int32_t llpemeyer_typeok(struct xvimage *image)
+/* ==================================== */
+/* types acceptes pour l'image a inonder */
+{
+    int32_t t = datatype(image);
+    return (t == VFF_TYP_1_BYTE) || (t == VFF_TYP_2_BYTE) ||
+           (t == VFF_TYP_4_BYTE) || (t == VFF_TYP_FLOAT);
+} /* llpemeyer_typeok() */
+
+/* ==================================== */
+static inline uint32_t llpemeyer_niveau(void *F, int32_t typ, index_t x)
+/* ==================================== */
+/*
+  Niveau du point x dans la fah : entier sur 32 bits qui respecte l'ordre
+  des valeurs de F (egal a F[x] pour les types byte et short).
+*/
+{
+    uint32_t u;
+    switch (typ) {
+    case VFF_TYP_1_BYTE:
+        return ((uint8_t *)F)[x];
+    case VFF_TYP_2_BYTE:
+        return ((uint16_t *)F)[x];
+    case VFF_TYP_4_BYTE:
+        return (uint32_t)(((int32_t *)F)[x]) ^ 0x80000000;
+    default:
+        memcpy(&u, &(((float *)F)[x]), sizeof(uint32_t));
+        if (u == 0x80000000) { /* -0.0 : meme niveau que +0.0 */
+            u = 0;
+        }
+        return (u & 0x80000000) ? ~u : (u | 0x80000000);
+    }
+} /* llpemeyer_niveau() */
+
+/* ==================================== */
+static inline void llpemeyer_ecrit(void *F, int32_t typ, index_t x, uint8_t v)
+/* ==================================== */
+/* ecrit le resultat (0 ou 255) au point x, dans le type de l'image */
+{
+    switch (typ) {
+    case VFF_TYP_1_BYTE:
+        ((uint8_t *)F)[x] = v;
+        break;
+    case VFF_TYP_2_BYTE:
+        ((uint16_t *)F)[x] = v;
+        break;
+    case VFF_TYP_4_BYTE:
+        ((int32_t *)F)[x] = v;
+        break;
+    default:
+        ((float *)F)[x] = v;
+        break;
+    }
+} /* llpemeyer_ecrit() */
+
 /* ==================================== */
 int32_t llpemeyer(
     struct xvimage *image,
@@ -103,13 +161,15 @@ int32_t llpemeyer(
     index_t rs = rowsize(image);     /* taille ligne */
     index_t cs = colsize(image);     /* taille colonne */
     index_t N = rs * cs;             /* taille image */
-    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     uint8_t *B = UCHARDATA(marqueurs);       /* l'image de marqueurs */
     uint8_t *BF;                             /* l'image de marqueurs du fond */
     uint8_t *MA;                             /* l'image de masque */
     int32_t *M;             /* l'image d'etiquettes */
     index_t nlabels;                 /* nombre de labels differents */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[4];
     int32_t ncc;
     int32_t incr_vois;
@@ -124,7 +184,7 @@ int32_t llpemeyer(
         return llpemeyer3d(image, marqueurs, marqueursfond, masque, connex);
     }
 
-    ACCEPTED_TYPES1(image, VFF_TYP_1_BYTE);
+    ACCEPTED_TYPES4(image, VFF_TYP_1_BYTE, VFF_TYP_2_BYTE, VFF_TYP_4_BYTE, VFF_TYP_FLOAT);
     ACCEPTED_TYPES1(marqueurs, VFF_TYP_1_BYTE);
     COMPARE_SIZE(image, marqueurs);
     if (masque) ACCEPTED_TYPES1(masque, VFF_TYP_1_BYTE);
@@ -139,7 +199,11 @@ int32_t llpemeyer(
         BF = UCHARDATA(marqueursfond);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s : CreeFah failed\n", F_NAME);
@@ -220,9 +284,9 @@ int32_t llpemeyer(
         if (M[x] && (!masque || MA[x])) {          /* on va empiler les voisins des regions marquees */
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
-                if ((y != -1) && !M[y] && !IsSet(y, EN_FAH)) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
+                if ((y != -1) && !M[y] && !IndIsSet(Ind, y, EN_FAH)) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (M[x]) */
@@ -242,17 +306,17 @@ int32_t llpemeyer(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 #ifdef ANIMATE
-        if (F[x] > curlev) {
-            printf("Niveau %d\n", F[x]);
+        if ((int32_t)llpemeyer_niveau(F, typ, x) > curlev) {
+            printf("Niveau %u\n", llpemeyer_niveau(F, typ, x));
             sprintf(imname, "anim%03d.pgm", nimage);
             nimage++;
             for (y = 0; y < N; y++)
                 if ((M[y] == nlabels) || (M[y] == 0)) A[y] = 255;
                 else A[y] = 0;
             writeimage(animimage, imname);
-            curlev = F[x];
+            curlev = (int32_t)llpemeyer_niveau(F, typ, x);
         }
 #endif
 
@@ -269,10 +333,10 @@ int32_t llpemeyer(
             M[x] = etiqcc[0];
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
         } else if (ncc > 1) {
             M[x] = nlabels;
@@ -283,9 +347,9 @@ int32_t llpemeyer(
 
     for (x = 0; x < N; x++) {
         if ((M[x] == nlabels) || (M[x] == 0)) {
-            F[x] = 255;
+            llpemeyer_ecrit(F, typ, x, 255);
         } else {
-            F[x] = 0;
+            llpemeyer_ecrit(F, typ, x, 0);
         }
     }
 
@@ -293,7 +357,7 @@ int32_t llpemeyer(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     free(M);
     return(1);
@@ -319,10 +383,12 @@ int32_t llpemeyer2(
     index_t rs = rowsize(image);     /* taille ligne */
     index_t cs = colsize(image);     /* taille colonne */
     index_t N = rs * cs;             /* taille image */
-    uint8_t *F = UCHARDATA(image);  /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     int32_t *M = SLONGDATA(marqueurs);   /* l'image de marqueurs */
     uint8_t *MA;                         /* l'image de masque */
     Fah * FAH;                                 /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[4];
     int32_t ncc;
     int32_t incr_vois;
@@ -332,7 +398,7 @@ int32_t llpemeyer2(
         return llpemeyer3d2(image, marqueurs, masque, connex);
     }
 
-    ACCEPTED_TYPES1(image, VFF_TYP_1_BYTE);
+    ACCEPTED_TYPES4(image, VFF_TYP_1_BYTE, VFF_TYP_2_BYTE, VFF_TYP_4_BYTE, VFF_TYP_FLOAT);
     ACCEPTED_TYPES1(marqueurs, VFF_TYP_4_BYTE);
     if (masque) ACCEPTED_TYPES1(masque, VFF_TYP_1_BYTE);
     COMPARE_SIZE(image, marqueurs);
@@ -341,7 +407,11 @@ int32_t llpemeyer2(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s : CreeFah failed\n", F_NAME);
@@ -380,9 +450,9 @@ int32_t llpemeyer2(
         if (M[x] && (!masque || MA[x])) {          /* on va empiler les voisins des regions marquees */
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
-                if ((y != -1) && !M[y] && !IsSet(y, EN_FAH)) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
+                if ((y != -1) && !M[y] && !IndIsSet(Ind, y, EN_FAH)) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (M[x]) */
@@ -398,7 +468,7 @@ int32_t llpemeyer2(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         for (k = 0; k < 8; k += incr_vois) {
@@ -413,10 +483,10 @@ int32_t llpemeyer2(
             M[x] = etiqcc[0];
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
         } else if (ncc > 1) {
             M[x] = nlabels;
@@ -426,9 +496,9 @@ int32_t llpemeyer2(
 
     for (x = 0; x < N; x++) {
         if ((M[x] == nlabels) || (M[x] == 0)) {
-            F[x] = 255;
+            llpemeyer_ecrit(F, typ, x, 255);
         } else {
-            F[x] = 0;
+            llpemeyer_ecrit(F, typ, x, 0);
         }
     }
 
@@ -436,7 +506,7 @@ int32_t llpemeyer2(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     return(1);
 } // llpemeyer2()
@@ -492,16 +562,18 @@ int32_t llpemeyer3(
     index_t rs = rowsize(image);     /* taille ligne */
     index_t cs = colsize(image);     /* taille colonne */
     index_t N = rs * cs;             /* taille image */
-    uint8_t *F = UCHARDATA(image);  /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     int32_t *M = SLONGDATA(marqueurs);   /* l'image de marqueurs */
     uint8_t *MA;                         /* l'image de masque */
     Fah * FAH;                                 /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[4];
     int32_t ncc;
     int32_t incr_vois;
 
-    if (datatype(image) != VFF_TYP_1_BYTE) {
-        fprintf(stderr, "%s: image type must be VFF_TYP_1_BYTE\n", F_NAME);
+    if (!llpemeyer_typeok(image)) {
+        fprintf(stderr, "%s: image type must be byte, short, long or float\n", F_NAME);
         return 0;
     }
 
@@ -537,7 +609,11 @@ int32_t llpemeyer3(
         return 0;
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s : CreeFah failed\n", F_NAME);
@@ -569,9 +645,9 @@ int32_t llpemeyer3(
         if (M[x] && (!masque || MA[x])) {          /* on va empiler les voisins des regions marquees */
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
-                if ((y != -1) && !M[y] && !IsSet(y, EN_FAH) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
+                if ((y != -1) && !M[y] && !IndIsSet(Ind, y, EN_FAH) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (M[x]) */
@@ -586,7 +662,7 @@ int32_t llpemeyer3(
 
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         for (k = 0; k < 8; k += incr_vois) {
@@ -601,10 +677,10 @@ int32_t llpemeyer3(
 
         for (k = 0; k < 8; k += incr_vois) {
             y = voisin(x, k, rs, N);
-            if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                FahPush(FAH, y, F[y]);
-                Set(y, EN_FAH);
-            } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+            if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                IndSet(Ind, y, EN_FAH);
+            } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
         } /* for k */
     } /* while (! FahVide(FAH)) */
     /* FIN PROPAGATION */
@@ -613,7 +689,7 @@ int32_t llpemeyer3(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     return(1);
 } // llpemeyer3()
@@ -650,6 +726,7 @@ superieure a celle des elements de rang 2.
     int32_t *M;             /* l'image d'etiquettes */
     index_t nlabels;                 /* nombre de labels differents */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[4];
     int32_t ncc;
     index_t tab[27];
@@ -700,7 +777,11 @@ superieure a celle des elements de rang 2.
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -772,7 +853,7 @@ superieure a celle des elements de rang 2.
             Thetacarre2d(rs, cs, x%rs, x/rs, tab, &n);
             for (k = 0; k < n; k++) { /* parcourt les eventuels theta-voisins */
                 y = tab[k];
-                if (!M[y] && !IsSet(y, EN_FAH)) {
+                if (!M[y] && !IndIsSet(Ind, y, EN_FAH)) {
                     if (CARRE(y % rs, y / rs)) {
                         FahPush(FAH, y, F[y] * 2);
                     } else {
@@ -781,7 +862,7 @@ superieure a celle des elements de rang 2.
                             F[y] * 2 +
                             1); // plus grande priorite pour les elements de rang <2
                     }
-                    Set(y, EN_FAH);
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (M[x]) */
@@ -797,7 +878,7 @@ superieure a celle des elements de rang 2.
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         Thetacarre2d(rs, cs, x%rs, x/rs, tab, &n);
@@ -814,7 +895,7 @@ superieure a celle des elements de rang 2.
             Thetacarre2d(rs, cs, x%rs, x/rs, tab, &n);
             for (k = 0; k < n; k++) { /* parcourt les eventuels theta-voisins */
                 y = tab[k];
-                if ((M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
+                if ((M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
                     if (CARRE(y % rs, y / rs)) {
                         FahPush(FAH, y, F[y] * 2);
                     } else {
@@ -822,8 +903,8 @@ superieure a celle des elements de rang 2.
                                 F[y] * 2 +
                                 1); // priorite superieure pour les element de rang <2
                     }
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
         } else if (ncc > 1) {
             M[x] = nlabels;
@@ -844,7 +925,7 @@ superieure a celle des elements de rang 2.
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     free(M);
     return(1);
@@ -870,13 +951,15 @@ int32_t llpemeyersansligne(
     index_t rs = rowsize(image);     /* taille ligne */
     index_t cs = colsize(image);     /* taille colonne */
     index_t N = rs * cs;             /* taille image */
-    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     uint8_t *B = UCHARDATA(marqueurs);       /* l'image de marqueurs */
     uint8_t *BF;                             /* l'image de marqueurs du fond */
     uint8_t *MA;                             /* l'image de masque */
     int32_t *M;             /* l'image d'etiquettes */
     index_t nlabels;                 /* nombre de labels differents */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[4];
     int32_t ncc;
     int32_t incr_vois;
@@ -892,8 +975,8 @@ int32_t llpemeyersansligne(
         exit(0);
     }
 
-    if (datatype(image) != VFF_TYP_1_BYTE) {
-        fprintf(stderr, "%s: image type must be VFF_TYP_1_BYTE\n", F_NAME);
+    if (!llpemeyer_typeok(image)) {
+        fprintf(stderr, "%s: image type must be byte, short, long or float\n", F_NAME);
         return 0;
     }
 
@@ -937,7 +1020,11 @@ int32_t llpemeyersansligne(
         BF = UCHARDATA(marqueursfond);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s : CreeFah failed\n", F_NAME);
@@ -1015,9 +1102,9 @@ int32_t llpemeyersansligne(
         if (M[x] && (!masque || MA[x])) {          /* on va empiler les voisins des regions marquees */
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
-                if ((y != -1) && !M[y] && !IsSet(y, EN_FAH)) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
+                if ((y != -1) && !M[y] && !IndIsSet(Ind, y, EN_FAH)) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (M[x]) */
@@ -1037,17 +1124,17 @@ int32_t llpemeyersansligne(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 #ifdef ANIMATE
-        if (F[x] > curlev) {
-            printf("Niveau %d\n", F[x]);
+        if ((int32_t)llpemeyer_niveau(F, typ, x) > curlev) {
+            printf("Niveau %u\n", llpemeyer_niveau(F, typ, x));
             sprintf(imname, "anim%03d.pgm", nimage);
             nimage++;
             for (y = 0; y < N; y++)
                 if ((M[y] == nlabels) || (M[y] == 0)) A[y] = 255;
                 else A[y] = 0;
             writeimage(animimage, imname);
-            curlev = F[x];
+            curlev = (int32_t)llpemeyer_niveau(F, typ, x);
         }
 #endif
 
@@ -1064,10 +1151,10 @@ int32_t llpemeyersansligne(
         M[x] = etiqcc[0];
         for (k = 0; k < 8; k += incr_vois) {
             y = voisin(x, k, rs, N);
-            if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                FahPush(FAH, y, F[y]);
-                Set(y, EN_FAH);
-            } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+            if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                IndSet(Ind, y, EN_FAH);
+            } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
         } /* for k */
 
     } /* while (! FahVide(FAH)) */
@@ -1077,7 +1164,7 @@ int32_t llpemeyersansligne(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     return(1);
 } // llpemeyersansligne()
@@ -1099,10 +1186,12 @@ int32_t llpemeyersanslignelab(
     index_t rs = rowsize(image);     /* taille ligne */
     index_t cs = colsize(image);     /* taille colonne */
     index_t N = rs * cs;             /* taille image */
-    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     int32_t *M = SLONGDATA(marqueurs);      /* l'image de marqueurs */
     uint8_t *MA;                             /* l'image de masque */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[4];
     int32_t ncc;
     int32_t incr_vois;
@@ -1112,8 +1201,8 @@ int32_t llpemeyersanslignelab(
         exit(0);
     }
 
-    if (datatype(image) != VFF_TYP_1_BYTE) {
-        fprintf(stderr, "%s: image type must be VFF_TYP_1_BYTE\n", F_NAME);
+    if (!llpemeyer_typeok(image)) {
+        fprintf(stderr, "%s: image type must be byte, short, long or float\n", F_NAME);
         return 0;
     }
 
@@ -1140,7 +1229,11 @@ int32_t llpemeyersanslignelab(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s : CreeFah failed\n", F_NAME);
@@ -1172,9 +1265,9 @@ int32_t llpemeyersanslignelab(
         if (M[x] && (!masque || MA[x])) {          /* on va empiler les voisins des regions marquees */
             for (k = 0; k < 8; k += incr_vois) {
                 y = voisin(x, k, rs, N);
-                if ((y != -1) && !M[y] && !IsSet(y, EN_FAH)) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
+                if ((y != -1) && !M[y] && !IndIsSet(Ind, y, EN_FAH)) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (M[x]) */
@@ -1189,7 +1282,7 @@ int32_t llpemeyersanslignelab(
 
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         for (k = 0; k < 8; k += incr_vois) {
@@ -1204,10 +1297,10 @@ int32_t llpemeyersanslignelab(
         M[x] = etiqcc[0];
         for (k = 0; k < 8; k += incr_vois) {
             y = voisin(x, k, rs, N);
-            if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                FahPush(FAH, y, F[y]);
-                Set(y, EN_FAH);
-            } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+            if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                IndSet(Ind, y, EN_FAH);
+            } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
         } /* for k */
 
     } /* while (! FahVide(FAH)) */
@@ -1217,7 +1310,7 @@ int32_t llpemeyersanslignelab(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     return(1);
 } // llpemeyersanslignelab()
@@ -1258,18 +1351,20 @@ int32_t llpemeyer3d(
     index_t d = depth(image);        /* nb plans */
     index_t n = rs * cs;             /* taille plan */
     index_t N = n * d;               /* taille image */
-    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     uint8_t *B = UCHARDATA(marqueurs);       /* l'image de marqueurs */
     uint8_t *BF;                             /* l'image de marqueurs du fond */
     uint8_t *MA;                             /* l'image de masque */
     int32_t *M;             /* l'image d'etiquettes */
     index_t nlabels;                 /* nombre de labels differents */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[6];
     int32_t ncc;
 
     ONLY_3D(image);
-    ACCEPTED_TYPES1(image, VFF_TYP_1_BYTE);
+    ACCEPTED_TYPES4(image, VFF_TYP_1_BYTE, VFF_TYP_2_BYTE, VFF_TYP_4_BYTE, VFF_TYP_FLOAT);
     ACCEPTED_TYPES1(marqueurs, VFF_TYP_1_BYTE);
     COMPARE_SIZE(image, marqueurs);
     if (masque) ACCEPTED_TYPES1(masque, VFF_TYP_1_BYTE);
@@ -1284,7 +1379,11 @@ int32_t llpemeyer3d(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -1399,27 +1498,27 @@ int32_t llpemeyer3d(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 8; k += 2) */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 18; k += 1) */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 26; k += 1) */
                 break;
@@ -1437,7 +1536,7 @@ int32_t llpemeyer3d(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         switch (connex) {
@@ -1476,28 +1575,28 @@ int32_t llpemeyer3d(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             } /* switch (connex) */
@@ -1509,9 +1608,9 @@ int32_t llpemeyer3d(
 
     for (x = 0; x < N; x++) {
         if ((M[x] == nlabels) || (M[x] == 0)) {
-            F[x] = 255;
+            llpemeyer_ecrit(F, typ, x, 255);
         } else {
-            F[x] = 0;
+            llpemeyer_ecrit(F, typ, x, 0);
         }
     }
 
@@ -1519,7 +1618,7 @@ int32_t llpemeyer3d(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     free(M);
     return(1);
@@ -1547,18 +1646,20 @@ int32_t llpemeyer3dsansligne(
     index_t d = depth(image);        /* nb plans */
     index_t n = rs * cs;             /* taille plan */
     index_t N = n * d;               /* taille image */
-    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     uint8_t *B = UCHARDATA(marqueurs);       /* l'image de marqueurs */
     uint8_t *BF;                             /* l'image de marqueurs du fond */
     uint8_t *MA;                             /* l'image de masque */
     int32_t *M;             /* l'image d'etiquettes */
     index_t nlabels;                 /* nombre de labels differents */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[6];
     int32_t ncc;
 
-    if (datatype(image) != VFF_TYP_1_BYTE) {
-        fprintf(stderr, "%s: image type must be VFF_TYP_1_BYTE\n", F_NAME);
+    if (!llpemeyer_typeok(image)) {
+        fprintf(stderr, "%s: image type must be byte, short, long or float\n", F_NAME);
         return 0;
     }
 
@@ -1607,7 +1708,11 @@ int32_t llpemeyer3dsansligne(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -1719,27 +1824,27 @@ int32_t llpemeyer3dsansligne(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 8; k += 2) */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 18; k += 1) */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 26; k += 1) */
                 break;
@@ -1757,7 +1862,7 @@ int32_t llpemeyer3dsansligne(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         switch (connex) {
@@ -1796,28 +1901,28 @@ int32_t llpemeyer3dsansligne(
         case 6:
             for (k = 0; k <= 10; k += 2) {
                 y = voisin6(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         case 18:
             for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                 y = voisin18(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         case 26:
             for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                 y = voisin26(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         } /* switch (connex) */
@@ -1828,7 +1933,7 @@ int32_t llpemeyer3dsansligne(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     return(1);
 } /* llpemeyer3dsansligne() */
@@ -1852,15 +1957,17 @@ int32_t llpemeyer3dsanslignelab(
     index_t d = depth(image);        /* nb plans */
     index_t n = rs * cs;             /* taille plan */
     index_t N = n * d;               /* taille image */
-    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     int32_t *M = SLONGDATA(marqueurs);      /* l'image de marqueurs */
     uint8_t *MA;                             /* l'image de masque */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[6];
     int32_t ncc;
 
-    if (datatype(image) != VFF_TYP_1_BYTE) {
-        fprintf(stderr, "%s: image type must be VFF_TYP_1_BYTE\n", F_NAME);
+    if (!llpemeyer_typeok(image)) {
+        fprintf(stderr, "%s: image type must be byte, short, long or float\n", F_NAME);
         return 0;
     }
 
@@ -1892,7 +1999,11 @@ int32_t llpemeyer3dsanslignelab(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -1914,27 +2025,27 @@ int32_t llpemeyer3dsanslignelab(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 8; k += 2) */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 18; k += 1) */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 26; k += 1) */
                 break;
@@ -1951,7 +2062,7 @@ int32_t llpemeyer3dsanslignelab(
 
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         switch (connex) {
@@ -1990,28 +2101,28 @@ int32_t llpemeyer3dsanslignelab(
         case 6:
             for (k = 0; k <= 10; k += 2) {
                 y = voisin6(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         case 18:
             for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                 y = voisin18(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         case 26:
             for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                 y = voisin26(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         } /* switch (connex) */
@@ -2022,7 +2133,7 @@ int32_t llpemeyer3dsanslignelab(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     return(1);
 } /* llpemeyer3dsanslignelab() */
@@ -2047,10 +2158,12 @@ int32_t llpemeyer3d2(
     index_t d = depth(image);          /* nb plans */
     index_t n = rs * cs;               /* taille plan */
     index_t N = n * d;                 /* taille image */
-    uint8_t *F = UCHARDATA(image);     /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     uint8_t *MA;                       /* l'image de masque */
     int32_t *M = SLONGDATA(marqueurs); /* l'image d'etiquettes */
     Fah * FAH;                         /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[6];
     int32_t ncc;
     index_t nlabels;
@@ -2060,7 +2173,7 @@ int32_t llpemeyer3d2(
 #endif
 
     ONLY_3D(image);
-    ACCEPTED_TYPES1(image, VFF_TYP_1_BYTE);
+    ACCEPTED_TYPES4(image, VFF_TYP_1_BYTE, VFF_TYP_2_BYTE, VFF_TYP_4_BYTE, VFF_TYP_FLOAT);
     ACCEPTED_TYPES1(marqueurs, VFF_TYP_4_BYTE);
     if (masque) ACCEPTED_TYPES1(masque, VFF_TYP_1_BYTE);
     COMPARE_SIZE(image, marqueurs);
@@ -2069,7 +2182,11 @@ int32_t llpemeyer3d2(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -2098,27 +2215,27 @@ int32_t llpemeyer3d2(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 8; k += 2) */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 18; k += 1) */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 26; k += 1) */
                 break;
@@ -2136,7 +2253,7 @@ int32_t llpemeyer3d2(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         switch (connex) {
@@ -2176,28 +2293,28 @@ int32_t llpemeyer3d2(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             } /* switch (connex) */
@@ -2210,9 +2327,9 @@ int32_t llpemeyer3d2(
 
     for (x = 0; x < N; x++) {
         if ((M[x] == nlabels) || (M[x] == 0)) {
-            F[x] = 255;
+            llpemeyer_ecrit(F, typ, x, 255);
         } else {
-            F[x] = 0;
+            llpemeyer_ecrit(F, typ, x, 0);
         }
     }
 
@@ -2220,7 +2337,7 @@ int32_t llpemeyer3d2(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
 
     return(1);
@@ -2251,10 +2368,12 @@ int32_t llpemeyer3d2b(
     index_t d = depth(image);          /* nb plans */
     index_t n = rs * cs;               /* taille plan */
     index_t N = n * d;                 /* taille image */
-    uint8_t *F = UCHARDATA(image);     /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     uint8_t *MA;                       /* l'image de masque */
     int32_t *M = SLONGDATA(marqueurs); /* l'image d'etiquettes */
     Fah * FAH;                         /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[6];
     int32_t ncc;
     index_t nlabels;
@@ -2268,8 +2387,8 @@ int32_t llpemeyer3d2b(
         exit(0);
     }
 
-    if (datatype(image) != VFF_TYP_1_BYTE) {
-        fprintf(stderr, "%s: image type must be VFF_TYP_1_BYTE\n", F_NAME);
+    if (!llpemeyer_typeok(image)) {
+        fprintf(stderr, "%s: image type must be byte, short, long or float\n", F_NAME);
         return 0;
     }
 
@@ -2296,7 +2415,11 @@ int32_t llpemeyer3d2b(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -2325,27 +2448,27 @@ int32_t llpemeyer3d2b(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 8; k += 2) */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 18; k += 1) */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 26; k += 1) */
                 break;
@@ -2362,7 +2485,7 @@ int32_t llpemeyer3d2b(
 
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         switch (connex) {
@@ -2402,28 +2525,28 @@ int32_t llpemeyer3d2b(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
-                    } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
+                    } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
                 } /* for k */
                 break;
             } /* switch (connex) */
@@ -2447,9 +2570,9 @@ int32_t llpemeyer3d2b(
 
     for (x = 0; x < N; x++) {
         if ((M[x] > nlabels) || (M[x] == 0)) {
-            F[x] = 255;
+            llpemeyer_ecrit(F, typ, x, 255);
         } else {
-            F[x] = 0;
+            llpemeyer_ecrit(F, typ, x, 0);
         }
     }
 
@@ -2457,7 +2580,7 @@ int32_t llpemeyer3d2b(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
 
     return(1);
@@ -2483,10 +2606,12 @@ int32_t llpemeyer3d3(
     index_t d = depth(image);          /* nb plans */
     index_t n = rs * cs;               /* taille plan */
     index_t N = n * d;                 /* taille image */
-    uint8_t *F = UCHARDATA(image);     /* l'image de depart */
+    void *F = (void *)(image->image_data); /* l'image de depart */
+    int32_t typ = datatype(image);   /* type de l'image de depart */
     uint8_t *MA;                       /* l'image de masque */
     int32_t *M = SLONGDATA(marqueurs); /* l'image d'etiquettes */
     Fah * FAH;                         /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[6];
     int32_t ncc;
 
@@ -2499,8 +2624,8 @@ int32_t llpemeyer3d3(
         exit(0);
     }
 
-    if (datatype(image) != VFF_TYP_1_BYTE) {
-        fprintf(stderr, "%s: image type must be VFF_TYP_1_BYTE\n", F_NAME);
+    if (!llpemeyer_typeok(image)) {
+        fprintf(stderr, "%s: image type must be byte, short, long or float\n", F_NAME);
         return 0;
     }
 
@@ -2527,7 +2652,11 @@ int32_t llpemeyer3d3(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -2549,27 +2678,27 @@ int32_t llpemeyer3d3(
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 8; k += 2) */
                 break;
             case 18:
                 for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                     y = voisin18(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 18; k += 1) */
                 break;
             case 26:
                 for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                     y = voisin26(x, k, rs, n, N);
-                    if ((y!=-1) && !M[y] && !IsSet(y,EN_FAH) && (!masque || MA[y])) {
-                        FahPush(FAH, y, F[y]);
-                        Set(y, EN_FAH);
+                    if ((y!=-1) && !M[y] && !IndIsSet(Ind, y,EN_FAH) && (!masque || MA[y])) {
+                        FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                        IndSet(Ind, y, EN_FAH);
                     }
                 } /* for (k = 0; k < 26; k += 1) */
                 break;
@@ -2586,7 +2715,7 @@ int32_t llpemeyer3d3(
 
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
         switch (connex) {
@@ -2627,28 +2756,28 @@ int32_t llpemeyer3d3(
         case 6:
             for (k = 0; k <= 10; k += 2) {
                 y = voisin6(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         case 18:
             for (k = 0; k < 18; k += 1) { /* parcourt les 18 voisins */
                 y = voisin18(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         case 26:
             for (k = 0; k < 26; k += 1) { /* parcourt les 26 voisins */
                 y = voisin26(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
-                    FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
+                    FahPushU32(FAH, y, llpemeyer_niveau(F, typ, y));
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
             break;
         } /* switch (connex) */
@@ -2659,7 +2788,7 @@ int32_t llpemeyer3d3(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
 
     return(1);
@@ -2690,6 +2819,7 @@ int32_t llpemeyerbiconnecte(
     int32_t *M;             /* l'image d'etiquettes */
     index_t nlabels;                 /* nombre de labels differents */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[4];
     int32_t ncc;
     const int32_t incr_vois=1;
@@ -2744,7 +2874,11 @@ int32_t llpemeyerbiconnecte(
         BF = UCHARDATA(marqueursfond);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s : CreeFah failed\n", F_NAME);
@@ -2814,9 +2948,9 @@ int32_t llpemeyerbiconnecte(
         if (M[x] && (!masque || MA[x])) {          /* on va empiler les voisins des regions marquees */
             for (k = 0; k < 6; k += incr_vois) {
                 y = voisin6b(x, k, rs, N, parite);
-                if ((y != -1) && !M[y] && !IsSet(y, EN_FAH)) {
+                if ((y != -1) && !M[y] && !IndIsSet(Ind, y, EN_FAH)) {
                     FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (M[x]) */
@@ -2836,7 +2970,7 @@ int32_t llpemeyerbiconnecte(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 #ifdef ANIMATE
         if (F[x] > curlev) {
             printf("Niveau %d\n", F[x]);
@@ -2863,10 +2997,10 @@ int32_t llpemeyerbiconnecte(
             M[x] = etiqcc[0];
             for (k = 0; k < 6; k += incr_vois) {
                 y = voisin6b(x, k, rs, N, parite);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
                     FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
         } else if (ncc > 1) {
             M[x] = nlabels;
@@ -2887,7 +3021,7 @@ int32_t llpemeyerbiconnecte(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     free(M);
     return(1);
@@ -2920,6 +3054,7 @@ int32_t llpemeyerbiconnecte3d(
     int32_t *M;             /* l'image d'etiquettes */
     index_t nlabels;                 /* nombre de labels differents */
     Fah * FAH;                   /* la file d'attente hierarchique */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
     int32_t etiqcc[6];
     int32_t ncc;
 
@@ -2963,7 +3098,11 @@ int32_t llpemeyerbiconnecte3d(
         MA = UCHARDATA(masque);
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        return(0);
+    }
     FAH = CreeFahVide(N+1);
     if (FAH == NULL) {
         fprintf(stderr, "%s() : CreeFah failed\n", F_NAME);
@@ -3033,9 +3172,9 @@ int32_t llpemeyerbiconnecte3d(
         if (M[x] && (!masque || MA[x])) {  /* on va empiler les voisins des regions marquees */
             for (k = 0; k < 14; k ++) {
                 y = voisin14b(x, k, rs, n, N);
-                if ((y!=-1)&&!M[y]&&!IsSet(y,EN_FAH)) {
+                if ((y!=-1)&&!M[y]&&!IndIsSet(Ind, y,EN_FAH)) {
                     FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
+                    IndSet(Ind, y, EN_FAH);
                 }
             } /* for (k = 0; k < 8; k += 2) */
         } /* if (B[x]) */
@@ -3050,7 +3189,7 @@ int32_t llpemeyerbiconnecte3d(
     nlabels += 1;          /* cree le label pour les points de la LPE */
     while (! FahVide(FAH)) {
         x = FahPop(FAH);
-        UnSet(x, EN_FAH);
+        IndUnSet(Ind, x, EN_FAH);
 
         ncc = 0;
 
@@ -3068,10 +3207,10 @@ int32_t llpemeyerbiconnecte3d(
 
             for (k = 0; k < 14; k ++) {
                 y = voisin14b(x, k, rs, n, N);
-                if ((y != -1) && (M[y] == 0) && (! IsSet(y, EN_FAH)) && (!masque || MA[y])) {
+                if ((y != -1) && (M[y] == 0) && (! IndIsSet(Ind, y, EN_FAH)) && (!masque || MA[y])) {
                     FahPush(FAH, y, F[y]);
-                    Set(y, EN_FAH);
-                } /* if ((y != -1) && (! IsSet(y, EN_FAH))) */
+                    IndSet(Ind, y, EN_FAH);
+                } /* if ((y != -1) && (! IndIsSet(Ind, y, EN_FAH))) */
             } /* for k */
 
         } else if (ncc > 1) {
@@ -3092,7 +3231,7 @@ int32_t llpemeyerbiconnecte3d(
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahTermine(FAH);
     free(M);
     return(1);
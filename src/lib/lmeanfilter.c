@@ -70,12 +70,13 @@ int32_t lmeanfilter(
 #undef F_NAME
 #define F_NAME "lmeanfilter"
 {
-    int32_t rs = rowsize(image);
-    int32_t cs = colsize(image);
-    int32_t ds = depth(image);
-    int32_t ps = rs * cs;
-    int32_t N = ds * ps;
-    int32_t x, y, k, C;
+    index_t rs = rowsize(image);
+    index_t cs = colsize(image);
+    index_t ds = depth(image);
+    index_t ps = rs * cs;
+    index_t N = ds * ps;
+    index_t x, y;
+    int32_t k, C;
     struct xvimage *auximage;
     float *F;
     float *G;
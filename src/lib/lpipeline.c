@@ -0,0 +1,693 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Execution d'une chaine d'operateurs Pink dans un seul processus, les
+   resultats intermediaires restant en memoire (pas de passage par
+   writeimage / readimage entre deux etapes).
+
+   Le script comporte une instruction par ligne (ou separees par ';'),
+   '#' debute un commentaire :
+
+     nom = operateur arg1 arg2 ...
+     write nom fichier
+
+   Les arguments images designent des resultats d'instructions
+   precedentes. $1, $2, ... sont remplaces par les arguments passes a
+   lpipeline. Un operateur qui modifie son premier argument (type 'i',
+   voir la table des operateurs) travaille sur une copie de celui-ci, sauf
+   s'il s'agit de la derniere utilisation : l'image est alors reprise telle
+   quelle. Chaque image est liberee des sa derniere utilisation.
+
+   Exemple (gradient morphologique) :
+
+     f = read $1
+     d = dilation f $2
+     e = erosion f $2
+     g = sub d e
+     write g $3
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <mcutil.h>
+#include <mcimage.h>
+#include <mccodimage.h>
+#include <larith.h>
+#include <ldilateros.h>
+#include <ldilateros3d.h>
+#include <ldist.h>
+#include <lgeodesic.h>
+#include <lhtkern.h>
+#include <lhtkern3d.h>
+#include <lseltopo.h>
+#include <lseuil.h>
+#include <lskelpar.h>
+#include <lskelpar3d.h>
+#include <lpipeline.h>
+
+#define PL_MAXARGS 8
+
+/*
+   Types d'arguments (champ args de la table des operateurs) :
+   'i' : image modifiee par l'operateur, qui devient le resultat
+   'j' : image lue seulement
+   'o' : image lue seulement, ou "null"
+   's' : element structurant (nom de fichier, lu par readse)
+   'n' : entier
+   'd' : reel
+   'f' : nom de fichier
+   Les arguments de rang superieur ou egal a nmin sont facultatifs.
+*/
+
+typedef struct {
+    struct xvimage *im;   /* types i, j, o, s */
+    index_t x, y, z;      /* type s : origine de l'element structurant */
+    double val;           /* types n, d */
+    char *str;            /* l'argument tel qu'ecrit dans le script */
+} plarg;
+
+/* *res vaut initialement a[0].im pour les operateurs de type 'i', NULL
+   sinon ; l'operateur peut le remplacer (en liberant l'ancien) */
+typedef int32_t (*plfun)(plarg *a, int32_t n, struct xvimage **res);
+
+typedef struct {
+    const char *name;
+    const char *args;
+    int32_t nmin;
+    int32_t result;       /* 1 si l'instruction produit une image */
+    plfun fun;
+    const char *usage;
+} plop;
+
+typedef struct {
+    int32_t op;
+    int32_t line;
+    int32_t dest;         /* 1 si l'instruction produit une valeur */
+    int32_t nargs;
+    char *arg[PL_MAXARGS];
+    int32_t val[PL_MAXARGS]; /* pour les arguments images : l'instruction qui l'a produite */
+} plstep;
+
+/* ==================================== */
+static int32_t pl_read(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    *res = readimage(a[0].str);
+    return (*res != NULL);
+} /* pl_read() */
+
+/* ==================================== */
+static int32_t pl_write(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    writeimage(a[0].im, a[1].str);
+    return 1;
+} /* pl_write() */
+
+/* ==================================== */
+static int32_t pl_copy(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+/* la copie est faite par lpipeline */
+{
+    return 1;
+} /* pl_copy() */
+
+/* ==================================== */
+static int32_t pl_arith2(plarg *a, struct xvimage **res, int32_t (*f)(struct xvimage *, struct xvimage *))
+/* ==================================== */
+{
+    struct xvimage *im2 = a[1].im;
+    int32_t ret;
+    if (datatype(*res) != datatype(im2)) {
+        /* convertgen peut remplacer ses deux arguments : le second
+           appartient a l'appelant, on le protege par une copie */
+        im2 = copyimage(im2);
+        if (im2 == NULL) {
+            return 0;
+        }
+        if (! convertgen(res, &im2)) {
+            freeimage(im2);
+            return 0;
+        }
+    }
+    ret = f(*res, im2);
+    if (im2 != a[1].im) {
+        freeimage(im2);
+    }
+    return ret;
+} /* pl_arith2() */
+
+/* ==================================== */
+static int32_t pl_add(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return pl_arith2(a, res, ladd);
+} /* pl_add() */
+
+/* ==================================== */
+static int32_t pl_sub(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return pl_arith2(a, res, lsub);
+} /* pl_sub() */
+
+/* ==================================== */
+static int32_t pl_min(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return pl_arith2(a, res, lmin);
+} /* pl_min() */
+
+/* ==================================== */
+static int32_t pl_max(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return pl_arith2(a, res, lmax);
+} /* pl_max() */
+
+/* ==================================== */
+static int32_t pl_mult(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return pl_arith2(a, res, lmult);
+} /* pl_mult() */
+
+/* ==================================== */
+static int32_t pl_inverse(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return linverse(*res);
+} /* pl_inverse() */
+
+/* ==================================== */
+static int32_t pl_seuil(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    struct xvimage *image = *res, *imagebin;
+    index_t x, N = rowsize(image) * colsize(image) * depth(image);
+    uint8_t *F;
+
+    if (n == 2) {
+        if (! lseuil(image, a[1].val)) {
+            return 0;
+        }
+    } else {
+        if (! lseuil3(image, a[1].val, a[2].val)) {
+            return 0;
+        }
+    }
+    if (datatype(image) == VFF_TYP_1_BYTE) {
+        return 1;
+    }
+    /* comme l'outil seuil : le resultat est une image binaire (byte) */
+    imagebin = allocimage(NULL, rowsize(image), colsize(image), depth(image), VFF_TYP_1_BYTE);
+    if (imagebin == NULL) {
+        return 0;
+    }
+    F = UCHARDATA(imagebin);
+    if (datatype(image) == VFF_TYP_4_BYTE) {
+        int32_t *FL = SLONGDATA(image);
+        for (x = 0; x < N; x++) {
+            F[x] = (uint8_t)FL[x];
+        }
+    } else if (datatype(image) == VFF_TYP_2_BYTE) {
+        int16_t *FL = SSHORTDATA(image);
+        for (x = 0; x < N; x++) {
+            F[x] = (uint8_t)FL[x];
+        }
+    } else if (datatype(image) == VFF_TYP_FLOAT) {
+        float *FL = FLOATDATA(image);
+        for (x = 0; x < N; x++) {
+            F[x] = (FL[x] == 0.0) ? NDG_MIN : NDG_MAX;
+        }
+    } else if (datatype(image) == VFF_TYP_DOUBLE) {
+        double *FL = DOUBLEDATA(image);
+        for (x = 0; x < N; x++) {
+            F[x] = (FL[x] == 0.0) ? NDG_MIN : NDG_MAX;
+        }
+    } else {
+        freeimage(imagebin);
+        return 0;
+    }
+    freeimage(image);
+    *res = imagebin;
+    return 1;
+} /* pl_seuil() */
+
+/* ==================================== */
+static int32_t pl_dilation(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    if (depth(*res) == 1) {
+        return ldilateros_ldilat(*res, a[1].im, a[1].x, a[1].y);
+    }
+    return ldilat3d(*res, a[1].im, a[1].x, a[1].y, a[1].z);
+} /* pl_dilation() */
+
+/* ==================================== */
+static int32_t pl_erosion(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    if (depth(*res) == 1) {
+        return ldilateros_leros(*res, a[1].im, a[1].x, a[1].y);
+    }
+    return leros3d(*res, a[1].im, a[1].x, a[1].y, a[1].z);
+} /* pl_erosion() */
+
+/* ==================================== */
+static int32_t pl_dilatball(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    if (a[1].val < 0) {
+        return 0;
+    }
+    return ldilatball(*res, (int32_t)a[1].val, (n > 2) ? (int32_t)a[2].val : 0);
+} /* pl_dilatball() */
+
+/* ==================================== */
+static int32_t pl_erosball(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    if (a[1].val < 0) {
+        return 0;
+    }
+    return lerosball(*res, (int32_t)a[1].val, (n > 2) ? (int32_t)a[2].val : 0);
+} /* pl_erosball() */
+
+/* ==================================== */
+static int32_t pl_geodilat(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    if (n == 5) {
+        return lgeodilatcond(*res, a[1].im, a[4].im, (int32_t)a[2].val, (int32_t)a[3].val);
+    }
+    return lgeodilat(*res, a[1].im, (int32_t)a[2].val, (int32_t)a[3].val);
+} /* pl_geodilat() */
+
+/* ==================================== */
+static int32_t pl_geoeros(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lgeoeros(*res, a[1].im, (int32_t)a[2].val, (int32_t)a[3].val);
+} /* pl_geoeros() */
+
+/* ==================================== */
+static int32_t pl_ptend(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lptend(*res, (int32_t)a[1].val);
+} /* pl_ptend() */
+
+/* ==================================== */
+static int32_t pl_ptisolated(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lptisolated(*res, (int32_t)a[1].val);
+} /* pl_ptisolated() */
+
+/* ==================================== */
+static int32_t pl_skelAMK(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    struct xvimage *inhibit = (n > 2) ? a[2].im : NULL;
+    if (depth(*res) == 1) {
+        return lskelNK2b(*res, (int32_t)a[1].val, inhibit);
+    }
+    return lskelAMK3(*res, (int32_t)a[1].val, inhibit);
+} /* pl_skelAMK() */
+
+/* ==================================== */
+static int32_t pl_htkern(plarg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    int32_t connex = (int32_t)a[2].val;
+    if ((connex == 4) || (connex == 8)) {
+        return lhtkern(*res, a[1].im, connex);
+    }
+    return mctopo3d_lhtkern3d(*res, a[1].im, connex);
+} /* pl_htkern() */
+
+static const plop pl_ops[] = {
+    { "read",       "f",     1, 1, pl_read,       "read file" },
+    { "write",      "jf",    2, 0, pl_write,      "write im file" },
+    { "copy",       "i",     1, 1, pl_copy,       "copy im" },
+    { "add",        "ij",    2, 1, pl_add,        "add im1 im2" },
+    { "sub",        "ij",    2, 1, pl_sub,        "sub im1 im2" },
+    { "min",        "ij",    2, 1, pl_min,        "min im1 im2" },
+    { "max",        "ij",    2, 1, pl_max,        "max im1 im2" },
+    { "mult",       "ij",    2, 1, pl_mult,       "mult im1 im2" },
+    { "inverse",    "i",     1, 1, pl_inverse,    "inverse im" },
+    { "seuil",      "idd",   2, 1, pl_seuil,      "seuil im seuil [seuil2]" },
+    { "dilation",   "is",    2, 1, pl_dilation,   "dilation im se.pgm" },
+    { "erosion",    "is",    2, 1, pl_erosion,    "erosion im se.pgm" },
+    { "dilatball",  "inn",   2, 1, pl_dilatball,  "dilatball im r [dist]" },
+    { "erosball",   "inn",   2, 1, pl_erosball,   "erosball im r [dist]" },
+    { "geodilat",   "ijnnj", 4, 1, pl_geodilat,   "geodilat g f connex niter [cond]" },
+    { "geoeros",    "ijnn",  4, 1, pl_geoeros,    "geoeros g f connex niter" },
+    { "ptend",      "in",    2, 1, pl_ptend,      "ptend im connex" },
+    { "ptisolated", "in",    2, 1, pl_ptisolated, "ptisolated im connex" },
+    { "skel_AMK",   "inj",   2, 1, pl_skelAMK,    "skel_AMK im nsteps [inhibit]" },
+    { "htkern",     "ion",   3, 1, pl_htkern,     "htkern im {cond|null} connex" },
+};
+
+#define PL_NOPS ((int32_t)(sizeof(pl_ops) / sizeof(pl_ops[0])))
+
+/* ==================================== */
+void lpipeline_listops(FILE *fd)
+/* ==================================== */
+{
+    int32_t i;
+    for (i = 0; i < PL_NOPS; i++) {
+        fprintf(fd, "  %s%s\n", pl_ops[i].result ? "res = " : "", pl_ops[i].usage);
+    }
+}
+
+/* ==================================== */
+static int32_t pl_findop(char *name)
+/* ==================================== */
+{
+    int32_t i;
+    for (i = 0; i < PL_NOPS; i++) {
+        if (strcmp(pl_ops[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* ==================================== */
+static int32_t pl_findname(char **names, int32_t nsteps, char *name)
+/* ==================================== */
+/* derniere instruction (parmi les nsteps premieres) ayant produit name */
+{
+    int32_t s;
+    for (s = nsteps - 1; s >= 0; s--) {
+        if ((names[s] != NULL) && (strcmp(names[s], name) == 0)) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+/* ==================================== */
+static void pl_libere(const plop *op, plarg *a, int32_t nargs)
+/* ==================================== */
+/* libere les images appartenant a l'instruction en cours (arguments 'i',
+   repris ou copies, et elements structurants 's') */
+{
+    int32_t k;
+    for (k = 0; k < nargs; k++) {
+        if (((op->args[k] == 'i') || (op->args[k] == 's')) && (a[k].im != NULL)) {
+            freeimage(a[k].im);
+            a[k].im = NULL;
+        }
+    }
+}
+
+/* ==================================== */
+int32_t lpipeline(
+    char *script,   /* texte du script */
+    int32_t argc,   /* nombre d'arguments ($1 ... $argc) */
+    char **argv)    /* arguments */
+/* ==================================== */
+#undef F_NAME
+#define F_NAME "lpipeline"
+{
+    char *buf, *p, *q, *c, *tok[PL_MAXARGS + 3];
+    int32_t ntok, line, nsteps, maxsteps, s, k, kk, v, ret = 0;
+    plstep *steps = NULL;
+    char **names = NULL;          /* nom de la valeur produite par chaque instruction */
+    int32_t *last = NULL;         /* derniere instruction utilisant chaque valeur */
+    struct xvimage **V = NULL;    /* les valeurs */
+    plarg a[PL_MAXARGS];
+    struct xvimage *res;
+
+    buf = (char *)malloc(strlen(script) + 1);
+    if (buf == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    strcpy(buf, script);
+    maxsteps = 1;
+    for (p = buf; *p; p++) {
+        if ((*p == '\n') || (*p == ';')) {
+            maxsteps++;
+        }
+    }
+    steps = (plstep *)calloc(maxsteps, sizeof(plstep));
+    names = (char **)calloc(maxsteps, sizeof(char *));
+    last = (int32_t *)malloc(maxsteps * sizeof(int32_t));
+    V = (struct xvimage **)calloc(maxsteps, sizeof(struct xvimage *));
+    if ((steps == NULL) || (names == NULL) || (last == NULL) || (V == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        goto end;
+    }
+
+    /* ---------------------------------------------------------- */
+    /* analyse du script */
+    /* ---------------------------------------------------------- */
+    nsteps = 0;
+    line = 1;
+    for (p = buf; p != NULL; p = q) {
+        plstep *st = &steps[nsteps];
+        const plop *op;
+        int32_t first;
+
+        /* isole l'instruction (et retire le commentaire) */
+        st->line = line;
+        q = p + strcspn(p, "#;\n");
+        if (*q == '#') {
+            *q++ = '\0';
+            q += strcspn(q, "\n");
+        }
+        if (*q == '\0') {
+            q = NULL;
+        } else {
+            if (*q == '\n') {
+                line++;
+            }
+            *q++ = '\0';
+        }
+
+        /* decoupage en mots */
+        ntok = 0;
+        for (c = p; ; ) {
+            while (isspace((unsigned char)*c)) {
+                c++;
+            }
+            if (*c == '\0') {
+                break;
+            }
+            if (ntok == PL_MAXARGS + 3) {
+                fprintf(stderr, "%s: line %d: too many arguments\n", F_NAME, st->line);
+                goto end;
+            }
+            tok[ntok++] = c;
+            while (*c && !isspace((unsigned char)*c)) {
+                c++;
+            }
+            if (*c) {
+                *c++ = '\0';
+            }
+        }
+        if (ntok == 0) {
+            continue;
+        }
+
+        /* substitution des arguments $1 ... */
+        for (k = 0; k < ntok; k++) {
+            if ((tok[k][0] == '$') && isdigit((unsigned char)tok[k][1])) {
+                int32_t i = atoi(tok[k] + 1);
+                if ((i < 1) || (i > argc)) {
+                    fprintf(stderr, "%s: line %d: missing argument %s\n", F_NAME, st->line, tok[k]);
+                    goto end;
+                }
+                tok[k] = argv[i - 1];
+            }
+        }
+
+        first = 0;
+        if ((ntok >= 2) && (strcmp(tok[1], "=") == 0)) {
+            st->dest = 1;
+            first = 2;
+            if (ntok == 2) {
+                fprintf(stderr, "%s: line %d: missing operator\n", F_NAME, st->line);
+                goto end;
+            }
+        }
+        st->op = pl_findop(tok[first]);
+        if (st->op < 0) {
+            fprintf(stderr, "%s: line %d: unknown operator %s\n", F_NAME, st->line, tok[first]);
+            goto end;
+        }
+        op = &pl_ops[st->op];
+        if (op->result != st->dest) {
+            fprintf(stderr, "%s: line %d: %s\n", F_NAME, st->line,
+                    op->result ? "result must be assigned (res = ...)" : "operator has no result");
+            goto end;
+        }
+        st->nargs = ntok - first - 1;
+        if ((st->nargs < op->nmin) || (st->nargs > (int32_t)strlen(op->args))) {
+            fprintf(stderr, "%s: line %d: usage: %s\n", F_NAME, st->line, op->usage);
+            goto end;
+        }
+        for (k = 0; k < st->nargs; k++) {
+            char t = op->args[k];
+            st->arg[k] = tok[first + 1 + k];
+            st->val[k] = -1;
+            if ((t == 'i') || (t == 'j') || ((t == 'o') && strcmp(st->arg[k], "null"))) {
+                st->val[k] = pl_findname(names, nsteps, st->arg[k]);
+                if (st->val[k] < 0) {
+                    fprintf(stderr, "%s: line %d: undefined image %s\n", F_NAME, st->line, st->arg[k]);
+                    goto end;
+                }
+            }
+        }
+        if (st->dest) {
+            names[nsteps] = tok[0];
+        }
+        nsteps++;
+    } /* while (*p) */
+
+    /* derniere utilisation de chaque valeur */
+    for (s = 0; s < nsteps; s++) {
+        last[s] = -1;
+    }
+    for (s = 0; s < nsteps; s++) {
+        for (k = 0; k < steps[s].nargs; k++) {
+            if (steps[s].val[k] >= 0) {
+                last[steps[s].val[k]] = s;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------- */
+    /* execution */
+    /* ---------------------------------------------------------- */
+    for (s = 0; s < nsteps; s++) {
+        plstep *st = &steps[s];
+        const plop *op = &pl_ops[st->op];
+
+        memset(a, 0, sizeof(a));
+        for (k = 0; k < st->nargs; k++) {
+            char t = op->args[k];
+            a[k].str = st->arg[k];
+            v = st->val[k];
+            if (t == 'i') {
+                int32_t shared = 0;
+                for (kk = 0; kk < st->nargs; kk++) {
+                    if ((kk != k) && (st->val[kk] == v)) {
+                        shared = 1;
+                    }
+                }
+                if ((last[v] == s) && !shared) {
+                    a[k].im = V[v];   /* derniere utilisation : pas de copie */
+                    V[v] = NULL;
+                } else {
+                    a[k].im = copyimage(V[v]);
+                    if (a[k].im == NULL) {
+                        fprintf(stderr, "%s: line %d: copyimage failed\n", F_NAME, st->line);
+                        pl_libere(op, a, k);
+                        goto end;
+                    }
+                    a[k].im->xdim = V[v]->xdim; /* non recopies par copyimage */
+                    a[k].im->ydim = V[v]->ydim;
+                    a[k].im->zdim = V[v]->zdim;
+                }
+            } else if ((t == 'j') || (t == 'o')) {
+                a[k].im = (v >= 0) ? V[v] : NULL;
+            } else if (t == 's') {
+                a[k].im = readse(st->arg[k], &a[k].x, &a[k].y, &a[k].z);
+                if (a[k].im == NULL) {
+                    fprintf(stderr, "%s: line %d: readse failed\n", F_NAME, st->line);
+                    pl_libere(op, a, k);
+                    goto end;
+                }
+            } else if ((t == 'n') || (t == 'd')) {
+                a[k].val = atof(st->arg[k]);
+            }
+        }
+
+        res = (op->args[0] == 'i') ? a[0].im : NULL;
+        k = op->fun(a, st->nargs, &res);
+        for (kk = 0; kk < st->nargs; kk++) {
+            if (op->args[kk] == 's') {
+                freeimage(a[kk].im);
+            }
+        }
+        if (!k) {
+            fprintf(stderr, "%s: line %d: %s failed\n", F_NAME, st->line, op->name);
+            if (res != NULL) {
+                freeimage(res);
+            }
+            goto end;
+        }
+
+        if (st->dest) {
+            if (last[s] < 0) {
+                freeimage(res); /* resultat inutilise */
+            } else {
+                V[s] = res;
+            }
+        }
+        for (k = 0; k < st->nargs; k++) {
+            v = st->val[k];
+            if ((v >= 0) && (last[v] == s) && (V[v] != NULL)) {
+                freeimage(V[v]);
+                V[v] = NULL;
+            }
+        }
+    } /* for s */
+    ret = 1;
+
+end:
+    if (V != NULL) {
+        for (s = 0; s < maxsteps; s++) {
+            if (V[s] != NULL) {
+                freeimage(V[s]);
+            }
+        }
+    }
+    free(V);
+    free(last);
+    free(names);
+    free(steps);
+    free(buf);
+    return ret;
+} /* lpipeline() */
@@ -38,6 +38,8 @@ knowledge of the CeCILL license and that you accept its terms.
   - d'images numériques
 
   Michel Couprie - juillet 2002 - avril 2005 - novembre 2008
+
+  octobre 2026 : plus proches voisins par arbre k-d (mckdtree)
 */
 
 #include <stdio.h>
@@ -51,6 +53,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mclin.h>
 #include <mcgeo.h>
 #include <mcpowell.h>
+#include <mckdtree.h>
 #include <lrecalagerigide.h>
 
 #define VERBOSE
@@ -131,6 +134,9 @@ double lrecalagerigide_F(double *G, ensemble *ens)
 /* ==================================== */
 {
     lrecalagerigide_Tgamma(ens->X, ens->n, G, ens->Tmp);
+    if (ens->Kd != NULL) {
+        return KdSommeDistances(ens->Kd, ens->Tmp, ens->n, ens->Proche);
+    }
     return lrecalagerigide_Delta(ens->Tmp, ens->n, ens->Y, ens->m);
 } // lrecalagerigide_F()
 
@@ -177,7 +183,7 @@ double *lrecalagerigide_lrecalagerigide2d(double *X, int32_t n, double *Y, int32
         X[2*i] -= BX1;
         X[2*i + 1] -= BX2;
     }
-    for (i = 0; i < n; i++) {
+    for (i = 0; i < m; i++) {
         Y[2*i] -= BY1;
         Y[2*i + 1] -= BY2;
     }
@@ -187,6 +193,7 @@ double *lrecalagerigide_lrecalagerigide2d(double *X, int32_t n, double *Y, int32
     ens.Y = Y;
     ens.m = m;
     ens.Tmp = (double *)calloc(1, 2 * mcmax(n,m) * sizeof(double));
+    ens.Kd = KdCreeVoisins(ens.Y, ens.m, 2, ens.n, &ens.Proche);
 
     powell(lrecalagerigide_F, &ens, G, 5, PRECISION, 0.1, MAXITER, &fmin);
 
@@ -202,6 +209,7 @@ double *lrecalagerigide_lrecalagerigide2d(double *X, int32_t n, double *Y, int32
 
     Gamma = (double *)calloc(1, 5 * sizeof(double));
     memcpy(Gamma, G, 5 * sizeof(double));
+    KdTermineVoisins(ens.Kd, ens.Proche);
     free(ens.Tmp);
     return Gamma;
 } // lrecalagerigide_lrecalagerigide2d()
@@ -248,7 +256,7 @@ double *lrecalagerigide_lrecalagerigidesanszoom2d(double *X, int32_t n, double *
         X[2*i] -= BX1;
         X[2*i + 1] -= BX2;
     }
-    for (i = 0; i < n; i++) {
+    for (i = 0; i < m; i++) {
         Y[2*i] -= BY1;
         Y[2*i + 1] -= BY2;
     }
@@ -258,6 +266,7 @@ double *lrecalagerigide_lrecalagerigidesanszoom2d(double *X, int32_t n, double *
     ens.Y = Y;
     ens.m = m;
     ens.Tmp = (double *)calloc(1, 2 * mcmax(n,m) * sizeof(double));
+    ens.Kd = KdCreeVoisins(ens.Y, ens.m, 2, ens.n, &ens.Proche);
 
     powell(lrecalagerigide_F, &ens, G, 3, PRECISION, 0.1, MAXITER, &fmin);
 
@@ -273,6 +282,7 @@ double *lrecalagerigide_lrecalagerigidesanszoom2d(double *X, int32_t n, double *
 
     Gamma = (double *)calloc(1, 3 * sizeof(double));
     memcpy(Gamma, G, 3 * sizeof(double));
+    KdTermineVoisins(ens.Kd, ens.Proche);
     free(ens.Tmp);
     return Gamma;
 } // lrecalagerigide_lrecalagerigidesanszoom2d()
@@ -366,6 +376,9 @@ double lrecalagerigide_F3d(double *G, ensemble *ens)
 /* ==================================== */
 {
     lrecalagerigide_Tgamma3d(ens->X, ens->n, G, ens->Tmp);
+    if (ens->Kd != NULL) {
+        return KdSommeDistances(ens->Kd, ens->Tmp, ens->n, ens->Proche);
+    }
     return lrecalagerigide_Delta3d(ens->Tmp, ens->n, ens->Y, ens->m);
 } // lrecalagerigide_F3d()
 
@@ -428,6 +441,7 @@ double *lrecalagerigide3d(double *X, int32_t n, double *Y, int32_t m)
     ens.Y = Y;
     ens.m = m;
     ens.Tmp = (double *)calloc(1, 3 * mcmax(n,m) * sizeof(double));
+    ens.Kd = KdCreeVoisins(ens.Y, ens.m, 3, ens.n, &ens.Proche);
 
 
     powell(lrecalagerigide_F3d, &ens, G, 8, PRECISION, 0.1, MAXITER, &fmin);
@@ -446,6 +460,7 @@ double *lrecalagerigide3d(double *X, int32_t n, double *Y, int32_t m)
 
     Gamma = (double *)calloc(1, 8 * sizeof(double));
     memcpy(Gamma, G, 8 * sizeof(double));
+    KdTermineVoisins(ens.Kd, ens.Proche);
     free(ens.Tmp);
     return Gamma;
 } // lrecalagerigide3d()
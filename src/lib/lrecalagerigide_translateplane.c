@@ -48,6 +48,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mclin.h>
 #include <mcgeo.h>
 #include <mcpowell.h>
+#include <mckdtree.h>
 #include <lrecalagerigide.h>
 
 #define VERBOSE
@@ -127,6 +128,9 @@ double lrecalagerigide_transparentplane_F(double *G, ensemble *ens)
 /* ==================================== */
 {
     lrecalagerigide_translateplane_Tgamma(ens->X, ens->n, G, ens->Tmp);
+    if (ens->Kd != NULL) {
+        return KdSommeDistances(ens->Kd, ens->Tmp, ens->n, ens->Proche);
+    }
     return lrecalagerigide_translateplane_Delta(ens->Tmp, ens->n, ens->Y, ens->m);
 } // lrecalagerigide_transparentplane_F()
 
@@ -173,7 +177,7 @@ double *lrecalagerigide2d_translateplane(double *X, int32_t n, double *Y, int32_
         X[2*i] -= BX1;
         X[2*i + 1] -= BX2;
     }
-    for (i = 0; i < n; i++) {
+    for (i = 0; i < m; i++) {
         Y[2*i] -= BY1;
         Y[2*i + 1] -= BY2;
     }
@@ -183,6 +187,7 @@ double *lrecalagerigide2d_translateplane(double *X, int32_t n, double *Y, int32_
     ens.Y = Y;
     ens.m = m;
     ens.Tmp = (double *)calloc(1, 2 * mcmax(n,m) * sizeof(double));
+    ens.Kd = KdCreeVoisins(ens.Y, ens.m, 2, ens.n, &ens.Proche);
 
     powell(lrecalagerigide_transparentplane_F, &ens, G, 5, 1e-6, 0.1, MAXITER, &fmin);
 
@@ -198,6 +203,7 @@ double *lrecalagerigide2d_translateplane(double *X, int32_t n, double *Y, int32_
 
     Gamma = (double *)calloc(1,5 * sizeof(double));
     memcpy(Gamma, G, 5 * sizeof(double));
+    KdTermineVoisins(ens.Kd, ens.Proche);
     free(ens.Tmp);
     return Gamma;
 } // lrecalagerigide2d_translateplane()
@@ -290,6 +296,9 @@ double lrecalagerigide_transparentplane_F3d(double *G, ensemble *ens)
 /* ==================================== */
 {
     lrecalagerigide_translateplane_Tgamma3d(ens->X, ens->n, G, ens->Tmp);
+    if (ens->Kd != NULL) {
+        return KdSommeDistances(ens->Kd, ens->Tmp, ens->n, ens->Proche);
+    }
     return lrecalagerigide_translateplane_Delta3d(ens->Tmp, ens->n, ens->Y, ens->m);
 } // lrecalagerigide_transparentplane_F3d()
 
@@ -355,6 +364,7 @@ double *lrecalagerigide3d_translateplane(double *X, int n, double *Y, int m)
     ens.Y = Y;
     ens.m = m;
     ens.Tmp = (double *)calloc(1, 3 * mcmax(n,m) * sizeof(double));
+    ens.Kd = KdCreeVoisins(ens.Y, ens.m, 3, ens.n, &ens.Proche);
 
 
     //  powell(lrecalagerigide_transparentplane_F3d, &ens, G, 2, 1e-6, 0.1, MAXITER, &fmin);
@@ -375,6 +385,7 @@ double *lrecalagerigide3d_translateplane(double *X, int n, double *Y, int m)
 
     Gamma = (double *)calloc(1, 2 * sizeof(double));
     memcpy(Gamma, G, 2 * sizeof(double));
+    KdTermineVoisins(ens.Kd, ens.Proche);
     free(ens.Tmp);
     return Gamma;
 } // lrecalagerigide3d()
@@ -441,6 +452,7 @@ double *lrecalagerigide3d_translate(double *X, int n, double *Y, int m)
     ens.Y = Y;
     ens.m = m;
     ens.Tmp = (double *)calloc(1, 3 * mcmax(n,m) * sizeof(double));
+    ens.Kd = KdCreeVoisins(ens.Y, ens.m, 3, ens.n, &ens.Proche);
 
 
     //  powell(lrecalagerigide_transparentplane_F3d, &ens, G, 2, 1e-6, 0.1, MAXITER, &fmin);
@@ -462,6 +474,7 @@ double *lrecalagerigide3d_translate(double *X, int n, double *Y, int m)
 
     Gamma = (double *)calloc(1, 3 * sizeof(double));
     memcpy(Gamma, G, 3 * sizeof(double));
+    KdTermineVoisins(ens.Kd, ens.Proche);
     free(ens.Tmp);
     return Gamma;
 } // lrecalagerigide3d_translate()
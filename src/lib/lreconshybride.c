@@ -0,0 +1,375 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Reconstruction geodesique par dilatation ou par erosion, algorithme
+   hybride de L. Vincent ("Morphological grayscale reconstruction in image
+   analysis: applications and efficient algorithms", IEEE TIP 1993) :
+   - un balayage raster (voisins anterieurs) puis un balayage anti-raster
+     (voisins posterieurs), qui propagent l'essentiel du marqueur ;
+   - une file (Fifo) initialisee avec les seuls points encore capables de
+     faire monter un voisin, traitee jusqu'a stabilite.
+
+   Images 2d (4, 8) ou 3d (6, 18, 26) d'octets, d'entiers courts, d'entiers
+   longs ou de flottants. La reconstruction par erosion se ramene a la
+   reconstruction par dilatation des complements (255 - v pour les octets,
+   ~v pour les entiers, -v pour les flottants), qui sont exacts.
+
+   Avec plusieurs threads (mcthreads), les deux balayages sont faits en
+   parallele sur des bandes de lignes (2d) ou de plans (3d), chacune
+   ignorant les voisins hors de la bande ; les points instables, y compris
+   le long des frontieres, sont ensuite detectes en parallele sur tout le
+   voisinage, puis traites par la file. Le resultat ne depend pas du
+   nombre de threads.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mccodimage.h>
+#include <mcfifo.h>
+#include <mcutil.h>
+#include <mcthreads.h>
+#include <lreconshybride.h>
+
+#define RH_MAXVOIS 13 /* nombre max de voisins anterieurs (26-connexite) */
+
+typedef struct {
+    void *G, *F;         /* marqueur (resultat), masque */
+    int32_t type;
+    index_t rs, cs, ds, ps, N;
+    int32_t nv;          /* nombre de voisins anterieurs */
+    int32_t dx[RH_MAXVOIS], dy[RH_MAXVOIS], dz[RH_MAXVOIS];
+    index_t off[RH_MAXVOIS]; /* decalages (negatifs) des voisins anterieurs */
+    index_t maxoff;      /* plus grand |off| */
+    uint8_t *M;          /* point en file (ou a mettre en file) */
+    Fifo *FIFO;
+    int32_t nbands;
+    int32_t plans;       /* 1 : bandes de plans ; 0 : bandes de lignes */
+} rh_job;
+
+/* ==================================== */
+static void rh_coords(rh_job *J, index_t i, index_t *x, index_t *y, index_t *z)
+/* ==================================== */
+{
+    *x = i % J->rs;
+    *y = (i / J->rs) % J->cs;
+    *z = i / J->ps;
+}
+
+/* ==================================== */
+static inline int32_t rh_interieur(rh_job *J, index_t i, index_t x, index_t y, index_t z,
+                                   index_t s, index_t e)
+/* ==================================== */
+/* tous les voisins de i sont dans l'image et dans [s, e[ */
+{
+    return (x > 0) && (x < J->rs - 1) && (y > 0) && (y < J->cs - 1) &&
+           ((J->ds == 1) || ((z > 0) && (z < J->ds - 1))) &&
+           (i - J->maxoff >= s) && (i + J->maxoff < e);
+}
+
+/* ==================================== */
+static inline int32_t rh_valide(rh_job *J, int32_t k, int32_t sens, index_t i,
+                                index_t x, index_t y, index_t z,
+                                index_t s, index_t e, index_t *j)
+/* ==================================== */
+/* voisin k de i, anterieur (sens = 1) ou posterieur (sens = -1) :
+   vrai s'il est dans l'image et dans [s, e[ */
+{
+    index_t xx = x + sens * J->dx[k], yy = y + sens * J->dy[k], zz = z + sens * J->dz[k];
+    if ((xx < 0) || (xx >= J->rs) || (yy < 0) || (yy >= J->cs) || (zz < 0) || (zz >= J->ds)) {
+        return 0;
+    }
+    *j = i + sens * J->off[k];
+    return (*j >= s) && (*j < e);
+}
+
+#define RH_TYPE uint8_t
+#define RH_NOM(f) f##_uint8
+#define RH_COMPL(v) ((uint8_t)(NDG_MAX - (v)))
+#include <lreconshybride_code.h>
+#undef RH_TYPE
+#undef RH_NOM
+#undef RH_COMPL
+
+#define RH_TYPE int16_t
+#define RH_NOM(f) f##_int16
+#define RH_COMPL(v) ((int16_t)~(v))
+#include <lreconshybride_code.h>
+#undef RH_TYPE
+#undef RH_NOM
+#undef RH_COMPL
+
+#define RH_TYPE int32_t
+#define RH_NOM(f) f##_int32
+#define RH_COMPL(v) (~(v))
+#include <lreconshybride_code.h>
+#undef RH_TYPE
+#undef RH_NOM
+#undef RH_COMPL
+
+#define RH_TYPE float
+#define RH_NOM(f) f##_float
+#define RH_COMPL(v) (-(v))
+#include <lreconshybride_code.h>
+#undef RH_TYPE
+#undef RH_NOM
+#undef RH_COMPL
+
+/* ==================================== */
+static void rh_bande_limites(rh_job *J, int32_t band, index_t *s, index_t *e)
+/* ==================================== */
+{
+    index_t first, last, unite = J->plans ? J->ps : J->rs;
+    mcthreads_band(J->plans ? J->ds : J->cs, J->nbands, band, &first, &last);
+    *s = first * unite;
+    *e = last * unite;
+}
+
+/* ==================================== */
+static void rh_balayages(void *arg, int32_t band)
+/* ==================================== */
+{
+    rh_job *J = (rh_job *)arg;
+    index_t s, e;
+    int32_t detecte = (J->nbands == 1);
+
+    rh_bande_limites(J, band, &s, &e);
+    switch (J->type) {
+    case VFF_TYP_1_BYTE:
+        rh_avant_uint8(J, s, e);
+        rh_arriere_uint8(J, s, e, detecte);
+        break;
+    case VFF_TYP_2_BYTE:
+        rh_avant_int16(J, s, e);
+        rh_arriere_int16(J, s, e, detecte);
+        break;
+    case VFF_TYP_4_BYTE:
+        rh_avant_int32(J, s, e);
+        rh_arriere_int32(J, s, e, detecte);
+        break;
+    default:
+        rh_avant_float(J, s, e);
+        rh_arriere_float(J, s, e, detecte);
+        break;
+    }
+} // rh_balayages()
+
+/* ==================================== */
+static void rh_detection(void *arg, int32_t band)
+/* ==================================== */
+{
+    rh_job *J = (rh_job *)arg;
+    index_t s, e;
+
+    rh_bande_limites(J, band, &s, &e);
+    switch (J->type) {
+    case VFF_TYP_1_BYTE:
+        rh_detecte_uint8(J, s, e);
+        break;
+    case VFF_TYP_2_BYTE:
+        rh_detecte_int16(J, s, e);
+        break;
+    case VFF_TYP_4_BYTE:
+        rh_detecte_int32(J, s, e);
+        break;
+    default:
+        rh_detecte_float(J, s, e);
+        break;
+    }
+} // rh_detection()
+
+/* ==================================== */
+static void rh_complement(struct xvimage *I, index_t N)
+/* ==================================== */
+{
+    switch (datatype(I)) {
+    case VFF_TYP_1_BYTE:
+        rh_complemente_uint8(I->image_data, N);
+        break;
+    case VFF_TYP_2_BYTE:
+        rh_complemente_int16(I->image_data, N);
+        break;
+    case VFF_TYP_4_BYTE:
+        rh_complemente_int32(I->image_data, N);
+        break;
+    default:
+        rh_complemente_float(I->image_data, N);
+        break;
+    }
+} // rh_complement()
+
+/* ==================================== */
+int32_t lreconshybride_possible(struct xvimage *f, int32_t connex)
+/* ==================================== */
+/*! \fn int32_t lreconshybride_possible(struct xvimage *f, int32_t connex)
+    \return 1 si lreconshybride traite ce type d'image et cette connexite, 0 sinon
+*/
+{
+    if ((datatype(f) != VFF_TYP_1_BYTE) && (datatype(f) != VFF_TYP_2_BYTE) &&
+        (datatype(f) != VFF_TYP_4_BYTE) && (datatype(f) != VFF_TYP_FLOAT)) {
+        return 0;
+    }
+    if (depth(f) == 1) {
+        return (connex == 4) || (connex == 8);
+    }
+    return (connex == 6) || (connex == 18) || (connex == 26);
+} // lreconshybride_possible()
+
+/* ==================================== */
+int32_t lreconshybride(struct xvimage *g, struct xvimage *f, int32_t connex,
+                       int32_t erosion)
+/* ==================================== */
+/*! \fn int32_t lreconshybride(struct xvimage *g, struct xvimage *f, int32_t connex, int32_t erosion)
+    \param g (entrée/sortie) : image marqueur
+    \param f (entrée) : image masque (meme type et memes dimensions que g)
+    \param connex (entrée) : 4, 8 (2d) ou 6, 18, 26 (3d)
+    \param erosion (entrée) : 0 : reconstruction par dilatation de min(g, f)
+       sous f ; 1 : reconstruction par erosion de max(g, f) au-dessus de f
+    \return 1 si succes, 0 sinon
+    \brief reconstruction geodesique (algorithme hybride de Vincent) ;
+       resultat dans g. Memes resultats que lgeodilat / lgeoeros avec
+       niter = -1.
+*/
+{
+    rh_job J;
+    index_t i;
+    int32_t dx, dy, dz, d;
+#undef F_NAME
+#define F_NAME "lreconshybride"
+
+    if (!lreconshybride_possible(f, connex)) {
+        fprintf(stderr, "%s: bad data type or connexity\n", F_NAME);
+        return 0;
+    }
+    if ((datatype(g) != datatype(f)) || (rowsize(g) != rowsize(f)) ||
+        (colsize(g) != colsize(f)) || (depth(g) != depth(f))) {
+        fprintf(stderr, "%s: incompatible images\n", F_NAME);
+        return 0;
+    }
+
+    memset(&J, 0, sizeof(J));
+    J.G = g->image_data;
+    J.F = f->image_data;
+    J.type = datatype(f);
+    J.rs = rowsize(f);
+    J.cs = colsize(f);
+    J.ds = depth(f);
+    J.ps = J.rs * J.cs;
+    J.N = J.ps * J.ds;
+
+    /* voisins anterieurs dans l'ordre raster */
+    for (dz = -1; dz <= 0; dz++) {
+        for (dy = -1; dy <= 1; dy++) {
+            for (dx = -1; dx <= 1; dx++) {
+                if ((dz == 0) && ((dy > 0) || ((dy == 0) && (dx >= 0)))) {
+                    continue;
+                }
+                d = mcabs(dx) + mcabs(dy) + mcabs(dz);
+                if (((connex == 4) && ((dz != 0) || (d > 1))) ||
+                    ((connex == 8) && (dz != 0)) ||
+                    ((connex == 6) && (d > 1)) ||
+                    ((connex == 18) && (d > 2))) {
+                    continue;
+                }
+                J.dx[J.nv] = dx;
+                J.dy[J.nv] = dy;
+                J.dz[J.nv] = dz;
+                J.off[J.nv] = dz * J.ps + dy * J.rs + dx;
+                if (-J.off[J.nv] > J.maxoff) {
+                    J.maxoff = -J.off[J.nv];
+                }
+                J.nv++;
+            }
+        }
+    }
+
+    J.M = (uint8_t *)calloc(J.N + 1, 1);
+    J.FIFO = CreeFifoVide(J.N);
+    if ((J.M == NULL) || (J.FIFO == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(J.M);
+        if (J.FIFO) {
+            FifoTermine(J.FIFO);
+        }
+        return 0;
+    }
+
+    if (erosion) {
+        rh_complement(g, J.N);
+        if (f != g) {
+            rh_complement(f, J.N);
+        }
+    }
+
+    J.plans = (J.ds > 1);
+    J.nbands = mcthreads_nbands(J.plans ? J.ds : J.cs);
+    mcthreads_run(J.nbands, rh_balayages, &J);
+    if (J.nbands > 1) {
+        mcthreads_run(J.nbands, rh_detection, &J);
+        for (i = 0; i < J.N; i++) {
+            if (J.M[i]) {
+                FifoPush(J.FIFO, i);
+            }
+        }
+    }
+
+    switch (J.type) {
+    case VFF_TYP_1_BYTE:
+        rh_propage_uint8(&J);
+        break;
+    case VFF_TYP_2_BYTE:
+        rh_propage_int16(&J);
+        break;
+    case VFF_TYP_4_BYTE:
+        rh_propage_int32(&J);
+        break;
+    default:
+        rh_propage_float(&J);
+        break;
+    }
+
+    if (erosion) {
+        rh_complement(g, J.N);
+        if (f != g) {
+            rh_complement(f, J.N);
+        }
+    }
+
+    free(J.M);
+    FifoTermine(J.FIFO);
+    return 1;
+} // lreconshybride()
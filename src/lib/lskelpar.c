@@ -207,6 +207,8 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcimage.h>
 #include <mctopo.h>
 #include <mcrbt.h>
+#include <mclifo.h>
+#include <mcthreads.h>
 #include <mcutil.h>
 #include <lskelpar.h>
 
@@ -243,17 +245,17 @@ knowledge of the CeCILL license and that you accept its terms.
 #define UNSET_CRUCIAL(f)    (f&=~S_CRUCIAL)
 #define UNSET_CURVE(f)      (f&=~S_CURVE)
 
-static int32_t jangrec_match23(uint8_t *F, int32_t x, int32_t rs, int32_t N);
-static int32_t jang_match27b(uint8_t *F, int32_t x, int32_t rs, int32_t N);
-static int32_t jang_match28b(uint8_t *F, int32_t x, int32_t rs, int32_t N);
+static int32_t jangrec_match23(uint8_t *F, index_t x, index_t rs, index_t N);
+static int32_t jang_match27b(uint8_t *F, index_t x, index_t rs, index_t N);
+static int32_t jang_match28b(uint8_t *F, index_t x, index_t rs, index_t N);
 
 
 /* ==================================== */
 static void extract_vois(
     uint8_t *img,          /* pointeur base image */
-    int32_t p,                       /* index du point */
-    int32_t rs,                      /* taille rangee */
-    int32_t N,                       /* taille image */
+    index_t p,                       /* index du point */
+    index_t rs,                      /* taille rangee */
+    index_t N,                       /* taille image */
     uint8_t *vois)
 /*
   retourne dans "vois" les valeurs des 8 voisins de p, dans l'ordre suivant:
@@ -319,9 +321,9 @@ static void rotate90_vois(uint8_t *vois)
 /* ==================================== */
 static int32_t extract_vois2(
     uint8_t *img,          /* pointeur base image */
-    int32_t p,                       /* index du point */
-    int32_t rs,                      /* taille rangee */
-    int32_t N,                       /* taille image */
+    index_t p,                       /* index du point */
+    index_t rs,                      /* taille rangee */
+    index_t N,                       /* taille image */
     uint8_t *vois)
 /*
   retourne dans "vois" les valeurs des 16 voisins d'ordre 2 de p, dans l'ordre suivant:
@@ -338,7 +340,7 @@ static int32_t extract_vois2(
 #undef F_NAME
 #define F_NAME "extract_vois2"
     register uint8_t * ptr = img+p;
-    register int32_t rs2 = rs + rs;
+    register index_t rs2 = rs + rs;
     if ((p%rs>=rs-2) || (p<rs2) || (p%rs<2) || (p>=N-rs2)) { /* point de bord */
 #ifdef PARANO
         printf("%s: ERREUR: point de bord\n", F_NAME);
@@ -398,7 +400,194 @@ static void rotate90_vois2(uint8_t *vois)
 } /* rotate90_vois2() */
 
 /* ==================================== */
-static int32_t pav_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+/* Moteur "frontiere" des algorithmes paralleles */
+/* ==================================== */
+
+typedef int32_t (*skelpar_match_t)(uint8_t *F, index_t x, index_t rs, index_t N);
+
+#define SKELPAR_RADIUS    2 /* rayon (norme infinie) du support des predicats */
+#define SKELPAR_MAXPERIOD 4 /* nombre max de sous-iterations par cycle */
+#define SKELPAR_GRAIN  1024 /* nombre min de candidats par bande */
+
+typedef struct {
+    uint8_t *F;                      /* image (lue seulement) */
+    uint8_t *M;                      /* resultats : M[x] = 2 si x est a supprimer */
+    index_t rs, N;
+    skelpar_match_t m;               /* predicat de l'etape */
+    index_t *pts;                    /* candidats (NULL : tous les points) */
+    index_t npts;                    /* nombre de candidats */
+    int32_t nbands;
+} skelpar_job;
+
+/* ==================================== */
+static void skelpar_match_band(void *arg, int32_t band)
+/* ==================================== */
+// teste les points de la bande "band" ; chaque point n'ecrit que sa propre marque
+{
+    skelpar_job *J = (skelpar_job *)arg;
+    index_t i, first, last, x;
+    if (J->pts == NULL) {
+        mcthreads_band(J->N, J->nbands, band, &first, &last);
+        for (x = first; x < last; x++) {
+            if (J->F[x] && J->m(J->F, x, J->rs, J->N)) {
+                J->M[x] = 2;
+            }
+        }
+    } else {
+        mcthreads_band(J->npts, J->nbands, band, &first, &last);
+        for (i = first; i < last; i++) {
+            x = J->pts[i];
+            if (J->m(J->F, x, J->rs, J->N)) {
+                J->M[x] = 2;
+            }
+        }
+    }
+} /* skelpar_match_band() */
+
+/* ==================================== */
+static int32_t skelpar_frontier(
+    uint8_t *F,                      /* image binaire (valeurs 0/1) */
+    index_t rs,                      /* taille rangee */
+    index_t cs,                      /* taille colonne */
+    int32_t *step,                   /* compteur d'etapes (entree/sortie) */
+    int32_t nsteps,                  /* nombre max d'etapes */
+    skelpar_match_t *match,          /* predicats de suppression */
+    int32_t period)                  /* nombre de predicats */
+/*
+  Enchaine jusqu'a stabilite (ou jusqu'a nsteps) les etapes paralleles :
+  a l'etape s, tous les points objet x tels que match[s % period](F, x, rs, N)
+  sont supprimes simultanement.
+
+  Chaque predicat ne lit que le voisinage de rayon SKELPAR_RADIUS de x.
+  Un point non supprime par match[k] a l'etape s-period ne peut donc l'etre
+  a l'etape s que si l'un de ses voisins a ete supprime au cours des period
+  dernieres etapes : seuls ces points (liste de bord, sans doublons) sont
+  testes. Les period premieres etapes examinent tous les points objet.
+  Le resultat est identique a celui du parcours complet de l'image.
+
+  Les tests d'une etape sont independants : ils sont repartis par bandes
+  entre les threads de mcthreads, les suppressions etant effectuees
+  ensuite par le thread appelant.
+
+  Retourne 0 en cas d'erreur d'allocation, 1 sinon.
+*/
+/* ==================================== */
+{
+#undef F_NAME
+#define F_NAME "skelpar_frontier"
+    index_t N = rs * cs;
+    index_t x, y, px, py;
+    int32_t dx, dy, s0, nonstab;
+    index_t i, n1, first, cur;
+    index_t dstart[SKELPAR_MAXPERIOD];
+    skelpar_job J;
+    Lifo *C;          /* candidats de l'etape courante */
+    Lifo *D;          /* points supprimes (chacun l'est au plus une fois) */
+    uint8_t *M;       /* 1 : point present dans C ; 2 : point a supprimer */
+
+    assert((period > 0) && (period <= SKELPAR_MAXPERIOD));
+
+    n1 = 0;
+    for (x = 0; x < N; x++) {
+        if (F[x]) {
+            n1++;
+        }
+    }
+    if (n1 == 0) {
+        return 1;
+    }
+
+    C = CreeLifoVide(n1);
+    D = CreeLifoVide(n1);
+    M = (uint8_t *)calloc(N, sizeof(uint8_t));
+    if ((C == NULL) || (D == NULL) || (M == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        if (C != NULL) {
+            LifoTermine(C);
+        }
+        if (D != NULL) {
+            LifoTermine(D);
+        }
+        free(M);
+        return 0;
+    }
+    J.F = F;
+    J.M = M;
+    J.rs = rs;
+    J.N = N;
+
+    s0 = *step;
+    nonstab = 1;
+    while (nonstab && (*step < nsteps)) {
+        nonstab = 0;
+        (*step)++;
+#ifdef VERBOSE
+        printf("step %d\n", *step);
+#endif
+        J.m = match[*step % period];
+        cur = D->Sp;
+
+        if (*step - s0 <= period) {
+            J.pts = NULL;
+            J.nbands = mcthreads_nbands(cs);
+            mcthreads_run(J.nbands, skelpar_match_band, &J);
+            for (x = 0; x < N; x++) {
+                if (M[x]) {
+                    M[x] = 0;
+                    LifoPush(D, x);
+                }
+            }
+        } else {
+            first = dstart[*step % period]; // suppressions depuis l'etape *step - period
+            for (i = first; i < cur; i++) {
+                x = D->Pts[i];
+                px = x % rs;
+                py = x / rs;
+                for (dy = -SKELPAR_RADIUS; dy <= SKELPAR_RADIUS; dy++) {
+                    if ((py + dy < 0) || (py + dy >= cs)) {
+                        continue;
+                    }
+                    for (dx = -SKELPAR_RADIUS; dx <= SKELPAR_RADIUS; dx++) {
+                        if ((px + dx < 0) || (px + dx >= rs)) {
+                            continue;
+                        }
+                        y = x + dy * rs + dx;
+                        if (F[y] && !M[y]) {
+                            M[y] = 1;
+                            LifoPush(C, y);
+                        }
+                    }
+                }
+            }
+            J.pts = C->Pts;
+            J.npts = C->Sp;
+            J.nbands = mcthreads_nbands((C->Sp + SKELPAR_GRAIN - 1) / SKELPAR_GRAIN);
+            mcthreads_run(J.nbands, skelpar_match_band, &J);
+            for (i = 0; i < C->Sp; i++) {
+                y = C->Pts[i];
+                if (M[y] == 2) {
+                    LifoPush(D, y);
+                }
+                M[y] = 0;
+            }
+            LifoFlush(C);
+        }
+        dstart[*step % period] = cur;
+
+        for (i = cur; i < D->Sp; i++) {
+            F[D->Pts[i]] = 0;
+            nonstab = 1;
+        }
+    } // while (nonstab && (*step < nsteps))
+
+    LifoTermine(C);
+    LifoTermine(D);
+    free(M);
+    return 1;
+} /* skelpar_frontier() */
+
+/* ==================================== */
+static int32_t pav_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   A A A   avec origine = (1,1) et au moins un des A et au moins un des B non nuls
@@ -430,7 +619,7 @@ fail:
 } /* pav_match1() */
 
 /* ==================================== */
-static int32_t pav_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t pav_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   D D D     avec origine = (1,1) et valeurs des pixels D quelconques
@@ -460,7 +649,7 @@ fail:
 } /* pav_match2() */
 
 /* ==================================== */
-static int32_t pav_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t pav_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 // condition for "tentatively multiple" points
 /*
@@ -503,7 +692,7 @@ fail:
 } /* pav_match3() */
 
 /* ==================================== */
-static int32_t pav_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t pav_match4(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 // condition for "corner" points
 {
@@ -532,7 +721,7 @@ fail:
 } /* pav_match4() */
 
 /* ==================================== */
-static int32_t pav_multiple(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t pav_multiple(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t m1 = pav_match1(F, x, rs, N);
@@ -557,10 +746,10 @@ int32_t lskelpavlidis(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelpavlidis"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -653,10 +842,10 @@ int32_t lskelpavlidis1(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelpavlidis1"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -697,7 +886,7 @@ int32_t lskelpavlidis1(struct xvimage *image,
 } /* lskelpavlidis1() */
 
 /* ==================================== */
-static int32_t eck_perfect(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t eck_perfect(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i = x % rs;
@@ -726,10 +915,10 @@ int32_t lskeleckhardt(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskeleckhardt"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -808,7 +997,7 @@ int32_t lskeleckhardt(struct xvimage *image,
 } /* lskeleckhardt() */
 
 /* ==================================== */
-static int32_t crossing_nb(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t crossing_nb(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 // retourne le nombre de transitions 1 -> 0 dans la liste ordonnée et cyclique des voisins
 {
@@ -824,7 +1013,7 @@ static int32_t crossing_nb(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* crossing_nb() */
 
 /* ==================================== */
-static int32_t rutovitz_match(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t rutovitz_match(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
 #undef F_NAME
@@ -867,14 +1056,13 @@ int32_t lskelrutovitz(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelrutovitz"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
+    int32_t step;
+    skelpar_match_t match[1] = {rutovitz_match};
 
     if (inhibit != NULL) {
         fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
@@ -896,29 +1084,9 @@ int32_t lskelrutovitz(struct xvimage *image,
     /* ================================================ */
 
     step = 0;
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-        for (i = 0; i < N; i++) {
-            if (rutovitz_match(F, i, rs, N))
-                //if (rutovitz_match(F, i, rs, N) && !jangrec_match23(F, i, rs, N)) // correction mc
-            {
-                nonstab = 1;
-                T[i] = 1;
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (T[i] == 1) {
-                F[i] = 0;
-            } else if (F[i]) {
-                F[i] = 1;
-            }
-        }
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match, 1)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
     }
 
 #ifdef VERBOSE1
@@ -931,12 +1099,11 @@ int32_t lskelrutovitz(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskelrutovitz() */
 
 /* ==================================== */
-static int32_t zhangsuen_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t zhangsuen_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
 #undef F_NAME
@@ -964,7 +1131,7 @@ static int32_t zhangsuen_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* zhangsuen_match1() */
 
 /* ==================================== */
-static int32_t zhangsuen_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t zhangsuen_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
 #undef F_NAME
@@ -1000,14 +1167,13 @@ int32_t lskelzhangsuen(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelzhangsuen"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
+    int32_t step;
+    skelpar_match_t match[2] = {zhangsuen_match1, zhangsuen_match2};
 
     if (inhibit != NULL) {
         fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
@@ -1029,36 +1195,9 @@ int32_t lskelzhangsuen(struct xvimage *image,
     /* ================================================ */
 
     step = 0;
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-        if ((step%2) == 0) {
-            for (i = 0; i < N; i++) {
-                if (zhangsuen_match1(F, i, rs, N)) {
-                    nonstab = 1;
-                    T[i] = 1;
-                }
-            }
-        } else {
-            for (i = 0; i < N; i++) {
-                if (zhangsuen_match2(F, i, rs, N)) {
-                    nonstab = 1;
-                    T[i] = 1;
-                }
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (T[i] == 1) {
-                F[i] = 0;
-            } else if (F[i]) {
-                F[i] = 1;
-            }
-        }
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match, 2)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
     }
 
 #ifdef VERBOSE1
@@ -1071,12 +1210,11 @@ int32_t lskelzhangsuen(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskelzhangsuen() */
 
 /* ==================================== */
-static int32_t KwonGiKang_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t KwonGiKang_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
 #undef F_NAME
@@ -1104,7 +1242,7 @@ static int32_t KwonGiKang_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* KwonGiKang_match1() */
 
 /* ==================================== */
-static int32_t KwonGiKang_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t KwonGiKang_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
 #undef F_NAME
@@ -1132,7 +1270,7 @@ static int32_t KwonGiKang_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* KwonGiKang_match2() */
 
 /* ==================================== */
-static int32_t KwonGiKang_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t KwonGiKang_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
 #undef F_NAME
@@ -1166,14 +1304,14 @@ int32_t lskelKwonGiKang(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelKwonGiKang"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
+    int32_t step;
+    skelpar_match_t match12[2] = {KwonGiKang_match1, KwonGiKang_match2};
+    skelpar_match_t match3[1] = {KwonGiKang_match3};
 
     if (inhibit != NULL) {
         fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
@@ -1195,67 +1333,22 @@ int32_t lskelKwonGiKang(struct xvimage *image,
     /* ================================================ */
 
     step = 0;
-    nonstab = 1;
 
     // PASS 1
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-        if ((step%2) == 0) {
-            for (i = 0; i < N; i++) {
-                if (KwonGiKang_match1(F, i, rs, N)) {
-                    nonstab = 1;
-                    T[i] = 1;
-                }
-            }
-        } else {
-            for (i = 0; i < N; i++) {
-                if (KwonGiKang_match2(F, i, rs, N)) {
-                    nonstab = 1;
-                    T[i] = 1;
-                }
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (T[i] == 1) {
-                F[i] = 0;
-            } else if (F[i]) {
-                F[i] = 1;
-            }
-        }
-    } // while
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match12, 2)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
+    }
 
 #ifdef VERBOSE1
     printf("PASS1 ended, number of steps: %d\n", step);
 #endif
 
     // PASS 2
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-        for (i = 0; i < N; i++) {
-            if (KwonGiKang_match3(F, i, rs, N)) {
-                nonstab = 1;
-                T[i] = 1;
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (T[i] == 1) {
-                F[i] = 0;
-            } else if (F[i]) {
-                F[i] = 1;
-            }
-        }
-    } // while
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match3, 1)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
+    }
 
 #ifdef VERBOSE1
     printf("PASS2 ended, number of steps: %d\n", step);
@@ -1267,12 +1360,11 @@ int32_t lskelKwonGiKang(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskelKwonGiKang() */
 
 /* ==================================== */
-static int32_t zhangwang_match(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t zhangwang_match(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
 #undef F_NAME
@@ -1312,14 +1404,13 @@ int32_t lskelzhangwang(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelzhangwang"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
+    int32_t step;
+    skelpar_match_t match[1] = {zhangwang_match};
 
     if (inhibit != NULL) {
         fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
@@ -1341,29 +1432,9 @@ int32_t lskelzhangwang(struct xvimage *image,
     /* ================================================ */
 
     step = 0;
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-        for (i = 0; i < N; i++) {
-            if (zhangwang_match(F, i, rs, N))
-                //if (zhangwang_match(F, i, rs, N) && !jangrec_match23(F, i, rs, N)) // correction mc
-            {
-                nonstab = 1;
-                T[i] = 1;
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (T[i] == 1) {
-                F[i] = 0;
-            } else if (F[i]) {
-                F[i] = 1;
-            }
-        }
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match, 1)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
     }
 
 #ifdef VERBOSE1
@@ -1376,12 +1447,11 @@ int32_t lskelzhangwang(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskelzhangwang() */
 
 /* ==================================== */
-static int32_t hanlarhee_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hanlarhee_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -1426,7 +1496,7 @@ static int32_t hanlarhee_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hanlarhee_match2() */
 
 /* ==================================== */
-static int32_t hanlarhee_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hanlarhee_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -1480,7 +1550,7 @@ static int32_t hanlarhee_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hanlarhee_match3() */
 
 /* ==================================== */
-static int32_t hanlarhee_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hanlarhee_match4(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -1516,7 +1586,7 @@ static int32_t hanlarhee_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hanlarhee_match4() */
 
 /* ==================================== */
-static int32_t hanlarhee_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hanlarhee_match5(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -1553,7 +1623,7 @@ static int32_t hanlarhee_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hanlarhee_match5() */
 
 /* ==================================== */
-static int32_t hanlarhee_match6(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hanlarhee_match6(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -1590,7 +1660,7 @@ static int32_t hanlarhee_match6(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hanlarhee_match6() */
 
 /* ==================================== */
-static int32_t hanlarhee_match7(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hanlarhee_match7(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i, n;
@@ -1620,7 +1690,7 @@ static int32_t hanlarhee_match7(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hanlarhee_match7() */
 
 /* ==================================== */
-static int32_t hanlarhee_match(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hanlarhee_match(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -1664,10 +1734,10 @@ int32_t lskelhanlarhee(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelhanlarhee"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -1742,7 +1812,7 @@ int32_t lskelhanlarhee(struct xvimage *image,
 #define F_NAME "lskelguohall"
 
 /* ==================================== */
-static int32_t guohall_L(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t guohall_L(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -1761,7 +1831,7 @@ static int32_t guohall_L(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* guohall_L() */
 
 /* ==================================== */
-static int32_t guohall_d1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t guohall_d1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -1776,7 +1846,7 @@ static int32_t guohall_d1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* guohall_d1() */
 
 /* ==================================== */
-static int32_t guohall_d2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t guohall_d2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -1791,7 +1861,7 @@ static int32_t guohall_d2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* guohall_d2() */
 
 /* ==================================== */
-static int32_t guohall_d3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t guohall_d3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -1807,7 +1877,7 @@ static int32_t guohall_d3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* guohall_d3() */
 
 /* ==================================== */
-static int32_t guohall_b1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t guohall_b1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -1816,7 +1886,7 @@ static int32_t guohall_b1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* guohall_b1() */
 
 /* ==================================== */
-static int32_t guohall_b2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t guohall_b2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -1825,112 +1895,90 @@ static int32_t guohall_b2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* guohall_b2() */
 
 /* ==================================== */
-int32_t lskelguohall(struct xvimage *image,
-                     int32_t nsteps,
-                     struct xvimage *inhibit,
-                     int32_t variante)
+static int32_t guohall_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
-// described in Guo & Hall : "Fast fully parallel thinning algorithms"
-#undef F_NAME
-#define F_NAME "lskelguohall"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
-    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
+    return (F[x] && bordext4(F, x, rs, N) && (nbvois8(F, x, rs, N) > 2)
+            && (crossing_nb(F, x, rs, N) == 1) && !guohall_L(F, x, rs, N));
+} /* guohall_match1() */
 
-    if (inhibit != NULL) {
-        fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
-        return 0;
-    }
-
-    if (nsteps == -1) {
-        nsteps = 1000000000;
-    }
-
-    for (i = 0; i < N; i++) {
-        if (F[i]) {
-            F[i] = 1; // normalize values
-        }
-    }
-
-    /* ================================================ */
-    /*               DEBUT ALGO                         */
-    /* ================================================ */
+/* ==================================== */
+static int32_t guohall_match2(uint8_t *F, index_t x, index_t rs, index_t N)
+/* ==================================== */
+{
+    return (F[x] && bordext4(F, x, rs, N) && (nbvois8(F, x, rs, N) > 2)
+            && (crossing_nb(F, x, rs, N) == 1) && !guohall_d1(F, x, rs, N)
+            && !guohall_d2(F, x, rs, N) && !guohall_d3(F, x, rs, N));
+} /* guohall_match2() */
 
-    step = 0;
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
+/* ==================================== */
+static int32_t guohall_match3(uint8_t *F, index_t x, index_t rs, index_t N)
+/* ==================================== */
+{
+    return (F[x] &&
+            ((bordext4(F, x, rs, N) && (nbvois8(F, x, rs, N) > 2)
+              && (crossing_nb(F, x, rs, N) == 1) && !guohall_d1(F, x, rs, N)
+              && !guohall_d2(F, x, rs, N) && !guohall_d3(F, x, rs, N)) ||
+             guohall_b1(F, x, rs, N) || guohall_b2(F, x, rs, N)));
+} /* guohall_match3() */
 
-        switch (variante) {
-        case 1:
-            for (i = 0; i < N; i++) {
-                if (F[i] && bordext4(F, i, rs, N) && (nbvois8(F, i, rs, N) > 2)
-                        && (crossing_nb(F, i, rs, N) == 1) && !guohall_L(F, i, rs, N)) {
-                    nonstab = 1;
-                    T[i] = 1;
-                }
-            }
-            for (i = 0; i < N; i++) {
-                if (T[i] == 1) {
-                    F[i] = 0;
-                } else if (F[i]) {
-                    F[i] = 1;
-                }
-            }
-            break;
-        case 2:
-            for (i = 0; i < N; i++) {
-                if (F[i] && bordext4(F, i, rs, N) && (nbvois8(F, i, rs, N) > 2)
-                        && (crossing_nb(F, i, rs, N) == 1) && !guohall_d1(F, i, rs, N)
-                        && !guohall_d2(F, i, rs, N) && !guohall_d3(F, i, rs, N)) {
-                    nonstab = 1;
-                    T[i] = 1;
-                }
-            }
-            for (i = 0; i < N; i++) {
-                if (T[i] == 1) {
-                    F[i] = 0;
-                } else if (F[i]) {
-                    F[i] = 1;
-                }
-            }
-            break;
-        case 3:
-            for (i = 0; i < N; i++) {
-                if (F[i] &&
-                        ((bordext4(F, i, rs, N) && (nbvois8(F, i, rs, N) > 2)
-                          && (crossing_nb(F, i, rs, N) == 1) && !guohall_d1(F, i, rs, N)
-                          && !guohall_d2(F, i, rs, N) && !guohall_d3(F, i, rs, N)) ||
-                         guohall_b1(F, i, rs, N) || guohall_b2(F, i, rs, N))) {
-                    nonstab = 1;
-                    T[i] = 1;
-                }
-            }
-            for (i = 0; i < N; i++) {
-                if (T[i] == 1) {
-                    F[i] = 0;
-                } else if (F[i]) {
-                    F[i] = 1;
-                }
-            }
-            break;
-        default:
-            fprintf(stderr, "%s: variant not implemented\n", F_NAME);
-            return 0;
-        } // switch (variante)
+/* ==================================== */
+int32_t lskelguohall(struct xvimage *image,
+                     int32_t nsteps,
+                     struct xvimage *inhibit,
+                     int32_t variante)
+/* ==================================== */
+// described in Guo & Hall : "Fast fully parallel thinning algorithms"
+#undef F_NAME
+#define F_NAME "lskelguohall"
+{
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
+    uint8_t *F = UCHARDATA(image);      /* l'image de depart */
+    int32_t step;
+    skelpar_match_t match[1];
 
-    } // while (nonstab && (step < nsteps))
+    if (inhibit != NULL) {
+        fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
+        return 0;
+    }
+
+    switch (variante) {
+    case 1:
+        match[0] = guohall_match1;
+        break;
+    case 2:
+        match[0] = guohall_match2;
+        break;
+    case 3:
+        match[0] = guohall_match3;
+        break;
+    default:
+        fprintf(stderr, "%s: variant not implemented\n", F_NAME);
+        return 0;
+    } // switch (variante)
+
+    if (nsteps == -1) {
+        nsteps = 1000000000;
+    }
+
+    for (i = 0; i < N; i++) {
+        if (F[i]) {
+            F[i] = 1; // normalize values
+        }
+    }
+
+    /* ================================================ */
+    /*               DEBUT ALGO                         */
+    /* ================================================ */
+
+    step = 0;
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match, 1)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
+    }
 
 #ifdef VERBOSE1
     printf("number of steps: %d\n", step);
@@ -1942,12 +1990,11 @@ int32_t lskelguohall(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskelguohall() */
 
 /* ==================================== */
-static int32_t chinwan_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t chinwan_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0
@@ -1973,7 +2020,7 @@ fail:
 } /* chinwan_match1() */
 
 /* ==================================== */
-static int32_t chinwan_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t chinwan_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   X 0 0
@@ -1999,7 +2046,7 @@ fail:
 } /* chinwan_match2() */
 
 /* ==================================== */
-static int32_t chinwan_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t chinwan_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -2014,6 +2061,14 @@ static int32_t chinwan_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
     return ((v[0] && !v[4] && !q1) || (!v[2] && v[6] && !q2));
 } /* chinwan_match3() */
 
+/* ==================================== */
+static int32_t chinwan_match(uint8_t *F, index_t x, index_t rs, index_t N)
+/* ==================================== */
+{
+    return (F[x] && (chinwan_match1(F, x, rs, N) || chinwan_match2(F, x, rs, N)) &&
+            !chinwan_match3(F, x, rs, N));
+} /* chinwan_match() */
+
 /* ==================================== */
 int32_t lskelchinwan(struct xvimage *image,
                      int32_t nsteps,
@@ -2023,14 +2078,13 @@ int32_t lskelchinwan(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelchinwan"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
+    int32_t step;
+    skelpar_match_t match[1] = {chinwan_match};
 
     if (inhibit != NULL) {
         fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
@@ -2052,31 +2106,10 @@ int32_t lskelchinwan(struct xvimage *image,
     /* ================================================ */
 
     step = 0;
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-
-        for (i = 0; i < N; i++) {
-            if (F[i] && (chinwan_match1(F, i, rs, N) || chinwan_match2(F, i, rs, N)) &&
-                    !chinwan_match3(F, i, rs, N)) {
-                nonstab = 1;
-                T[i] = 1;
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (T[i] == 1) {
-                F[i] = 0;
-            } else if (F[i]) {
-                F[i] = 1;
-            }
-        }
-
-    } // while (nonstab && (step < nsteps))
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match, 1)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
+    }
 
 #ifdef VERBOSE1
     printf("number of steps: %d\n", step);
@@ -2088,12 +2121,11 @@ int32_t lskelchinwan(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskelchinwan() */
 
 /* ==================================== */
-static int32_t jang_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 x   avec origine = (1,1) et x = don't care
@@ -2116,7 +2148,7 @@ fail:
 } /* jang_match1() */
 
 /* ==================================== */
-static int32_t jang_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match5(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 0 x   avec origine = (1,1) et x = don't care
@@ -2139,7 +2171,7 @@ fail:
 } /* jang_match5() */
 
 /* ==================================== */
-static int32_t jang_match9(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match9(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0   avec origine = (1,1) et (p ou q)
@@ -2165,7 +2197,7 @@ fail:
 } /* jang_match9() */
 
 /* ==================================== */
-static int32_t jang_match13(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match13(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2190,7 +2222,7 @@ fail:
 } /* jang_match13() */
 
 /* ==================================== */
-static int32_t jang_match17(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match17(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2216,7 +2248,7 @@ fail:
 } /* jang_match17() */
 
 /* ==================================== */
-static int32_t jang_match21(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match21(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2234,7 +2266,7 @@ static int32_t jang_match21(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jang_match21() */
 
 /* ==================================== */
-static int32_t jang_match22(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match22(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2252,7 +2284,7 @@ static int32_t jang_match22(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jang_match22() */
 
 /* ==================================== */
-static int32_t jang_match23(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match23(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2270,7 +2302,7 @@ static int32_t jang_match23(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jang_match23() */
 
 /* ==================================== */
-static int32_t jang_match24(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match24(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2288,7 +2320,7 @@ static int32_t jang_match24(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jang_match24() */
 
 /* ==================================== */
-static int32_t jang_match25(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match25(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2306,7 +2338,7 @@ static int32_t jang_match25(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jang_match25() */
 
 /* ==================================== */
-static int32_t jang_match26(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match26(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2324,7 +2356,7 @@ static int32_t jang_match26(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jang_match26() */
 
 /* ==================================== */
-static int32_t jang_match27(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match27(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2349,7 +2381,7 @@ fail:
 } /* jang_match27() */
 
 /* ==================================== */
-static int32_t jang_match27b(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match27b(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2374,7 +2406,7 @@ fail:
 } /* jang_match27b() */
 
 /* ==================================== */
-static int32_t jang_match28b(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jang_match28b(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2398,6 +2430,68 @@ fail:
     return 0;
 } /* jang_match28b() */
 
+/* ==================================== */
+static int32_t jang_match(uint8_t *F, index_t x, index_t rs, index_t N)
+/* ==================================== */
+{
+    int32_t m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12;
+    if (!F[x]) {
+        return 0;
+    }
+    m1 = jang_match1(F, x, rs, N);
+    m2 = jang_match5(F, x, rs, N);
+    m3 = jang_match9(F, x, rs, N);
+    m4 = jang_match13(F, x, rs, N);
+    m5 = jang_match17(F, x, rs, N);
+    m6 = jang_match21(F, x, rs, N);
+    m7 = jang_match22(F, x, rs, N);
+    m8 = jang_match23(F, x, rs, N);
+    m9 = jang_match24(F, x, rs, N);
+    m10 = jang_match25(F, x, rs, N);
+    m11 = jang_match26(F, x, rs, N);
+    m12 = jang_match27(F, x, rs, N);
+    if ((m1 || m2 || m3 || m4 || m5) && !m6 && !m7 && !m8 && !m9 && !m10 && !m11 && !m12) {
+//#define DEBUG_JANG
+#ifdef DEBUG_JANG
+        printf("i = %d,%d : %d %d %d    %d %d %d    %d %d %d    %d %d %d\n",
+               x%rs, x/rs, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+#endif
+        return 1; // delete point
+    }
+    return 0;
+} /* jang_match() */
+
+/* ==================================== */
+static int32_t jangcor_match(uint8_t *F, index_t x, index_t rs, index_t N)
+/* ==================================== */
+{
+    int32_t m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13;
+    if (!F[x]) {
+        return 0;
+    }
+    m1 = jang_match1(F, x, rs, N);
+    m2 = jang_match5(F, x, rs, N);
+    m3 = jang_match9(F, x, rs, N);
+    m4 = jang_match13(F, x, rs, N);
+    m5 = jang_match17(F, x, rs, N);
+    m6 = jang_match21(F, x, rs, N);
+    m7 = jang_match22(F, x, rs, N);
+    m8 = jang_match23(F, x, rs, N);
+    m9 = jang_match24(F, x, rs, N);
+    m10 = jang_match25(F, x, rs, N);
+    m11 = jang_match26(F, x, rs, N);
+    m12 = jang_match27b(F, x, rs, N);
+    m13 = jang_match28b(F, x, rs, N);
+    if ((m1 || m2 || m3 || m4 || m5) && !m6 && !m7 && !m8 && !m9 && !m10 && !m11 && !m12 && !m13) {
+#ifdef DEBUG_JANG
+        printf("i = %d,%d : %d %d %d    %d %d %d    %d %d %d    %d %d %d %d\n",
+               x%rs, x/rs, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+#endif
+        return 1; // delete point
+    }
+    return 0;
+} /* jangcor_match() */
+
 /* ==================================== */
 int32_t lskeljang(struct xvimage *image,
                   int32_t nsteps,
@@ -2407,15 +2501,13 @@ int32_t lskeljang(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskeljang"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
-    int32_t m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12;
+    int32_t step;
+    skelpar_match_t match[1] = {jang_match};
 
     if (inhibit != NULL) {
         fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
@@ -2437,46 +2529,9 @@ int32_t lskeljang(struct xvimage *image,
     /* ================================================ */
 
     step = 0;
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-        for (i = 0; i < N; i++) {
-            if (F[i]) {
-                m1 = jang_match1(F, i, rs, N);
-                m2 = jang_match5(F, i, rs, N);
-                m3 = jang_match9(F, i, rs, N);
-                m4 = jang_match13(F, i, rs, N);
-                m5 = jang_match17(F, i, rs, N);
-                m6 = jang_match21(F, i, rs, N);
-                m7 = jang_match22(F, i, rs, N);
-                m8 = jang_match23(F, i, rs, N);
-                m9 = jang_match24(F, i, rs, N);
-                m10 = jang_match25(F, i, rs, N);
-                m11 = jang_match26(F, i, rs, N);
-                m12 = jang_match27(F, i, rs, N);
-                if ((m1 || m2 || m3 || m4 || m5) && !m6 && !m7 && !m8 && !m9 && !m10 && !m11 && !m12) {
-//#define DEBUG_JANG
-#ifdef DEBUG_JANG
-                    printf("i = %d,%d : %d %d %d    %d %d %d    %d %d %d    %d %d %d\n",
-                           i%rs, i/rs, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
-#endif
-                    T[i] = 1; // delete point
-
-                }
-            }
-        }
-
-        for (i = 0; i < N; i++) {
-            if (T[i]) {
-                F[i] = 0;
-                nonstab = 1;
-            }
-        }
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match, 1)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
     }
 
 #ifdef VERBOSE1
@@ -2489,7 +2544,6 @@ int32_t lskeljang(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskeljang() */
 
@@ -2503,15 +2557,13 @@ int32_t lskeljangcor(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskeljang"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
-    struct xvimage *tmp = copyimage(image);
-    uint8_t *T = UCHARDATA(tmp);
-    int32_t step, nonstab;
-    int32_t m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13;
+    int32_t step;
+    skelpar_match_t match[1] = {jangcor_match};
 
     if (inhibit != NULL) {
         fprintf(stderr, "%s: inhibit image: not implemented\n", F_NAME);
@@ -2533,46 +2585,9 @@ int32_t lskeljangcor(struct xvimage *image,
     /* ================================================ */
 
     step = 0;
-    nonstab = 1;
-    while (nonstab && (step < nsteps)) {
-        nonstab = 0;
-        step++;
-#ifdef VERBOSE
-        printf("step %d\n", step);
-#endif
-        memset(T, 0, N);
-        for (i = 0; i < N; i++) {
-            if (F[i]) {
-                m1 = jang_match1(F, i, rs, N);
-                m2 = jang_match5(F, i, rs, N);
-                m3 = jang_match9(F, i, rs, N);
-                m4 = jang_match13(F, i, rs, N);
-                m5 = jang_match17(F, i, rs, N);
-                m6 = jang_match21(F, i, rs, N);
-                m7 = jang_match22(F, i, rs, N);
-                m8 = jang_match23(F, i, rs, N);
-                m9 = jang_match24(F, i, rs, N);
-                m10 = jang_match25(F, i, rs, N);
-                m11 = jang_match26(F, i, rs, N);
-                m12 = jang_match27b(F, i, rs, N);
-                m13 = jang_match28b(F, i, rs, N);
-                if ((m1 || m2 || m3 || m4 || m5) && !m6 && !m7 && !m8 && !m9 && !m10 && !m11 && !m12 && !m13) {
-#ifdef DEBUG_JANG
-                    printf("i = %d,%d : %d %d %d    %d %d %d    %d %d %d    %d %d %d %d\n",
-                           i%rs, i/rs, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
-#endif
-                    T[i] = 1; // delete point
-
-                }
-            }
-        }
-
-        for (i = 0; i < N; i++) {
-            if (T[i]) {
-                F[i] = 0;
-                nonstab = 1;
-            }
-        }
+    if (!skelpar_frontier(F, rs, cs, &step, nsteps, match, 1)) {
+        fprintf(stderr, "%s: skelpar_frontier failed\n", F_NAME);
+        return 0;
     }
 
 #ifdef VERBOSE1
@@ -2585,12 +2600,11 @@ int32_t lskeljangcor(struct xvimage *image,
         }
     }
 
-    freeimage(tmp);
     return(1);
 } /* lskeljangcor() */
 
 /* ==================================== */
-int32_t mns_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mns_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2617,7 +2631,7 @@ fail:
 } /* mns_match1() */
 
 /* ==================================== */
-int32_t mns_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mns_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2644,7 +2658,7 @@ fail:
 } /* mns_match2() */
 
 /* ==================================== */
-int32_t mns_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mns_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2671,7 +2685,7 @@ fail:
 } /* mns_match3() */
 
 /* ==================================== */
-int32_t mns_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mns_match4(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2698,7 +2712,7 @@ fail:
 } /* mns_match4() */
 
 /* ==================================== */
-int32_t mns_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mns_match5(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2725,7 +2739,7 @@ fail:
 } /* mns_match5() */
 
 /* ==================================== */
-int32_t mns_match6(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mns_match6(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -2759,10 +2773,10 @@ int32_t lskelmns(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelmns"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -2859,7 +2873,7 @@ int32_t lskelmns(struct xvimage *image,
 } /* lskelmns() */
 
 /* ==================================== */
-static int32_t jangrec_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 q   avec origine = (1,1) et (p ou q)
@@ -2885,7 +2899,7 @@ fail:
 } /* jangrec_match1() */
 
 /* ==================================== */
-static int32_t jangrec_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match5(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 x   avec origine = (1,1) et x = don't care
@@ -2908,7 +2922,7 @@ fail:
 } /* jangrec_match5() */
 
 /* ==================================== */
-static int32_t jangrec_match9(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match9(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 0 x   avec origine = (1,1) et x = don't care
@@ -2931,7 +2945,7 @@ fail:
 } /* jangrec_match9() */
 
 /* ==================================== */
-static int32_t jangrec_match13(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match13(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0   avec origine = (1,1)
@@ -2954,7 +2968,7 @@ fail:
 } /* jangrec_match13() */
 
 /* ==================================== */
-static int32_t jangrec_match17(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match17(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2972,7 +2986,7 @@ static int32_t jangrec_match17(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jangrec_match17() */
 
 /* ==================================== */
-static int32_t jangrec_match18(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match18(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -2990,7 +3004,7 @@ static int32_t jangrec_match18(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jangrec_match18() */
 
 /* ==================================== */
-static int32_t jangrec_match19(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match19(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -3008,7 +3022,7 @@ static int32_t jangrec_match19(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jangrec_match19() */
 
 /* ==================================== */
-static int32_t jangrec_match20(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match20(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -3026,7 +3040,7 @@ static int32_t jangrec_match20(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jangrec_match20() */
 
 /* ==================================== */
-static int32_t jangrec_match21(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match21(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -3044,7 +3058,7 @@ static int32_t jangrec_match21(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jangrec_match21() */
 
 /* ==================================== */
-static int32_t jangrec_match22(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match22(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8], v2[16];
@@ -3062,7 +3076,7 @@ static int32_t jangrec_match22(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* jangrec_match22() */
 
 /* ==================================== */
-static int32_t jangrec_match23(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t jangrec_match23(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
    0 0 0 0   avec origine = (1,1)
@@ -3094,10 +3108,10 @@ int32_t lskeljangrec(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskeljangrec"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     uint8_t *I;            /* l'image d'inhibition (axe médian) */
     struct xvimage *tmp = copyimage(image);
@@ -3182,7 +3196,7 @@ int32_t lskeljangrec(struct xvimage *image,
 } /* lskeljangrec() */
 
 /* ==================================== */
-static int32_t choy_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 x   avec origine = (1,1) et x = don't care
@@ -3205,7 +3219,7 @@ fail:
 } /* choy_match1() */
 
 /* ==================================== */
-static int32_t choy_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_match5(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 0 x   avec origine = (1,1) et x = don't care
@@ -3228,7 +3242,7 @@ fail:
 } /* choy_match5() */
 
 /* ==================================== */
-static int32_t choy_match9(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_match9(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0   avec origine = (1,1) et (p ou q)
@@ -3254,7 +3268,7 @@ fail:
 } /* choy_match9() */
 
 /* ==================================== */
-static int32_t choy_matchb1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 0 x
@@ -3272,7 +3286,7 @@ static int32_t choy_matchb1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_matchb1() */
 
 /* ==================================== */
-static int32_t choy_matchb2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 0 0
@@ -3290,7 +3304,7 @@ static int32_t choy_matchb2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_matchb2() */
 
 /* ==================================== */
-static int32_t choy_matchb3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 x
@@ -3308,7 +3322,7 @@ static int32_t choy_matchb3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_matchb3() */
 
 /* ==================================== */
-static int32_t choy_matchb7(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb7(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 1 1
@@ -3325,7 +3339,7 @@ static int32_t choy_matchb7(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_matchb7() */
 
 /* ==================================== */
-static int32_t choy_matchb8(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb8(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 1
@@ -3342,7 +3356,7 @@ static int32_t choy_matchb8(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_matchb8() */
 
 /* ==================================== */
-static int32_t choy_matchb11(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb11(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
     1 0 0
@@ -3359,7 +3373,7 @@ static int32_t choy_matchb11(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_match11() */
 
 /* ==================================== */
-static int32_t choy_matchb21(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb21(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0
@@ -3376,7 +3390,7 @@ static int32_t choy_matchb21(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_match21() */
 
 /* ==================================== */
-static int32_t choy_matchb22(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb22(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0
@@ -3394,7 +3408,7 @@ static int32_t choy_matchb22(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_match22() */
 
 /* ==================================== */
-static int32_t choy_matchb23(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb23(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0
@@ -3412,7 +3426,7 @@ static int32_t choy_matchb23(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* choy_match23() */
 
 /* ==================================== */
-static int32_t choy_matchb24(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t choy_matchb24(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
     0 0 0
@@ -3437,10 +3451,10 @@ int32_t lskelchoy(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelchoy"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -3528,7 +3542,7 @@ int32_t lskelchoy(struct xvimage *image,
 } /* lskelchoy() */
 
 /* ==================================== */
-int32_t mb_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mb_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x x 1 x
@@ -3558,7 +3572,7 @@ fail:
 } /* mb_match1() */
 
 /* ==================================== */
-int32_t mb_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mb_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 x x
@@ -3589,7 +3603,7 @@ fail:
 } /* mb_match2() */
 
 /* ==================================== */
-int32_t mb_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t mb_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x x x
@@ -3622,10 +3636,10 @@ int32_t lskelmanz(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelmanz"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -3709,7 +3723,7 @@ int32_t lskelmanz(struct xvimage *image,
 } /* lskelmanz() */
 
 /* ==================================== */
-static int32_t hall_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hall_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -3718,7 +3732,7 @@ static int32_t hall_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hall_match1() */
 
 /* ==================================== */
-static int32_t hall_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hall_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -3727,7 +3741,7 @@ static int32_t hall_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* hall_match2() */
 
 /* ==================================== */
-static int32_t hall_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t hall_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     uint8_t v[8];
@@ -3747,10 +3761,10 @@ int32_t lskelhall(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelhall"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -3867,7 +3881,7 @@ int32_t lskelhall(struct xvimage *image,
 } /* lskelhall() */
 
 /* ==================================== */
-static int32_t wutsai_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   1 1 p   avec origine = (1,1) et (!p ou !q)
@@ -3887,7 +3901,7 @@ static int32_t wutsai_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match1() */
 
 /* ==================================== */
-static int32_t wutsai_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   1 1 1   avec origine = (1,1) et (!p ou !q)
@@ -3907,7 +3921,7 @@ static int32_t wutsai_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match2() */
 
 /* ==================================== */
-static int32_t wutsai_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   p 1 1     avec origine = (1,1) et (!p ou !q)
@@ -3933,7 +3947,7 @@ static int32_t wutsai_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match3() */
 
 /* ==================================== */
-static int32_t wutsai_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match4(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   p 0 q     avec origine = (1,1) et (!p ou !q)
@@ -3960,7 +3974,7 @@ static int32_t wutsai_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match4() */
 
 /* ==================================== */
-static int32_t wutsai_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match5(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 0 0   avec origine = (1,1) et x = don't care
@@ -3974,7 +3988,7 @@ static int32_t wutsai_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match5() */
 
 /* ==================================== */
-static int32_t wutsai_match6(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match6(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 1 1   avec origine = (1,1) et x = don't care
@@ -3988,7 +4002,7 @@ static int32_t wutsai_match6(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match6() */
 
 /* ==================================== */
-static int32_t wutsai_match7(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match7(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 1 0   avec origine = (1,1)
@@ -4002,7 +4016,7 @@ static int32_t wutsai_match7(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match7() */
 
 /* ==================================== */
-static int32_t wutsai_match8(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match8(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   x 1 x   avec origine = (1,1) et x = don't care
@@ -4016,7 +4030,7 @@ static int32_t wutsai_match8(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match8() */
 
 /* ==================================== */
-static int32_t wutsai_match9(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match9(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 x   avec origine = (1,1) et x = don't care
@@ -4030,7 +4044,7 @@ static int32_t wutsai_match9(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match9() */
 
 /* ==================================== */
-static int32_t wutsai_match10(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match10(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0   avec origine = (1,1)
@@ -4044,7 +4058,7 @@ static int32_t wutsai_match10(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* wutsai_match10() */
 
 /* ==================================== */
-static int32_t wutsai_match11(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t wutsai_match11(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   0 0 0   avec origine = (1,1)
@@ -4075,10 +4089,10 @@ int32_t lskelwutsai(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelwutsai"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -4162,7 +4176,7 @@ int32_t lskelwutsai(struct xvimage *image,
 } /* lskelwutsai() */
 
 /* ==================================== */
-static int32_t mc_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 //      m1 : match   A 2 B   avec origine = (1,0) et [au moins un des A et au moins un des B non nuls]
 //                   A 2 B   ou [A et B tous nuls] (+ rotation 90)
@@ -4191,7 +4205,7 @@ fail:
 } /* mc_match1() */
 
 /* ==================================== */
-static int32_t mc_match1b(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_match1b(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 //     m1b : match   0 2 0   avec origine = (1,0) (+ rotation 90)
 //                   0 2 0
@@ -4213,7 +4227,7 @@ fail:
 } /* mc_match1b() */
 
 /* ==================================== */
-static int32_t mc_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4239,7 +4253,7 @@ fail:
 } /* mc_match2() */
 
 /* ==================================== */
-static int32_t mc_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4264,7 +4278,7 @@ fail:
 } /* mc_match3() */
 
 /* ==================================== */
-static int32_t mc_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_match4(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4289,7 +4303,7 @@ fail:
 } /* mc_match4() */
 
 /* ==================================== */
-static int32_t mc_match5(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_match5(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4310,7 +4324,7 @@ fail:
 } /* mc_match5() */
 
 /* ==================================== */
-static int32_t mc_match6(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_match6(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4329,7 +4343,7 @@ fail:
 
 
 /* ==================================== */
-static int32_t mc_maskend1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_maskend1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4352,7 +4366,7 @@ fail:
 } /* mc_maskend1() */
 
 /* ==================================== */
-static int32_t mc_maskend2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_maskend2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4375,7 +4389,7 @@ fail:
 } /* mc_maskend2() */
 
 /* ==================================== */
-static int32_t mc_maskend3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_maskend3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     int32_t i;
@@ -4398,7 +4412,7 @@ fail:
 } /* mc_maskend3() */
 
 /* ==================================== */
-static int32_t mc_end2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t mc_end2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 {
     return mc_maskend1(F, x, rs, N) || mc_maskend2(F, x, rs, N) || mc_maskend3(F, x, rs, N);
@@ -4412,10 +4426,10 @@ int32_t lskelmcultime(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelmcultime"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -4519,10 +4533,10 @@ int32_t lskelmccurv(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelmccurv"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -4626,10 +4640,10 @@ int32_t lskelmccurvrec(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelmccurvrec"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *X = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -4793,10 +4807,10 @@ int32_t lskelmccurvrecold(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelmccurvrec"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *X = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -4967,7 +4981,7 @@ int32_t lskelmccurvrecold(struct xvimage *image,
 } /* lskelmccurvrecold() */
 
 /* ==================================== */
-int32_t bertrand_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t bertrand_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
 A     A
@@ -4990,7 +5004,7 @@ B     B
 } /* bertrand_match1() */
 
 /* ==================================== */
-int32_t bertrand_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t bertrand_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
 A   2   B
@@ -5021,10 +5035,10 @@ int32_t lskelNK2(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelNK2"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);   /* l'image de depart */
     uint8_t *I = NULL;               /* l'image d'inhibition */
     struct xvimage *tmp = copyimage(image);
@@ -5155,10 +5169,10 @@ int32_t lskelNK2b(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelNK2b"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);   /* l'image de depart */
     uint8_t *I = NULL;               /* l'image d'inhibition */
     int32_t step, nonstab;
@@ -5250,10 +5264,10 @@ int32_t lskelNK2p(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelNK2p"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);   /* l'image de depart */
     uint8_t *I = NULL;               /* l'image d'inhibition */
     int16_t *T;
@@ -5385,10 +5399,10 @@ int32_t lskelNK2_pers(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelNK2_pers"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);   /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     struct xvimage *inhibit;
@@ -5498,7 +5512,7 @@ int32_t lskelNK2_pers(struct xvimage *image,
 } /* lskelNK2_pers() */
 
 /* ==================================== */
-int32_t bertrand_match3(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t bertrand_match3(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 // A 2 B   avec origine = (1,0) et au moins un des A et au moins un des B non nuls
 // A 2 B   (+ rotation 90)
@@ -5524,7 +5538,7 @@ fail:
 } /* bertrand_match3() */
 
 /* ==================================== */
-int32_t bertrand_match3b(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t bertrand_match3b(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 // A 2 B   avec origine = (1,0) et (au moins un des A et au moins un des B non nuls ou tous les A,B nuls)
 // A 2 B   (+ rotation 90)
@@ -5553,7 +5567,7 @@ fail:
 } /* bertrand_match3b() */
 
 /* ==================================== */
-int32_t bertrand_match4(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+int32_t bertrand_match4(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 // 2 A
 // B C   (+ rotation 90)
@@ -5601,10 +5615,10 @@ Répéter jusqu'à stabilité
 #undef F_NAME
 #define F_NAME "lskelbertrand_sym"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *t = copyimage(image);
     uint8_t *T = UCHARDATA(t);
@@ -5715,10 +5729,10 @@ int32_t lskelbertrand_asym_s(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelbertrand_asym_s"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *X = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -5833,10 +5847,10 @@ Répéter jusqu'à stabilité
 #undef F_NAME
 #define F_NAME "lskelMK2"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *S = UCHARDATA(image);   /* l'image de depart */
     uint8_t *I;                      /* l'image d'inhibition */
     struct xvimage *t = copyimage(image);
@@ -5969,10 +5983,10 @@ Répéter jusqu'à stabilité
 #undef F_NAME
 #define F_NAME "lskelMK2b"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *S = UCHARDATA(image);   /* l'image de depart */
     uint8_t *I;                      /* l'image d'inhibition */
     struct xvimage *r = copyimage(image);
@@ -6090,10 +6104,10 @@ Répéter jusqu'à stabilité
 #undef F_NAME
 #define F_NAME "lskelAK2"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *S = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *t = copyimage(image);
     uint8_t *T = UCHARDATA(t);
@@ -6232,7 +6246,7 @@ Répéter jusqu'à stabilité
 } /* lskelAK2() */
 
 /* ==================================== */
-static int32_t ros_match1(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t ros_match1(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   D D D     avec origine = (1,1) et valeurs des pixels D quelconques
@@ -6261,7 +6275,7 @@ fail:
 } /* ros_match1() */
 
 /* ==================================== */
-static int32_t ros_match2(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t ros_match2(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   D 0 0     avec origine = (1,1)
@@ -6296,7 +6310,7 @@ fail:
 } /* ros_match2() */
 
 /* ==================================== */
-static int32_t ros_north(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t ros_north(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   D 0 D     avec origine = (1,1) et valeurs des pixels D quelconques
@@ -6314,7 +6328,7 @@ static int32_t ros_north(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* ros_north() */
 
 /* ==================================== */
-static int32_t ros_south(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t ros_south(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   D D D     avec origine = (1,1) et valeurs des pixels D quelconques
@@ -6332,7 +6346,7 @@ static int32_t ros_south(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* ros_south() */
 
 /* ==================================== */
-static int32_t ros_east(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t ros_east(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   D D D     avec origine = (1,1) et valeurs des pixels D quelconques
@@ -6350,7 +6364,7 @@ static int32_t ros_east(uint8_t *F, int32_t x, int32_t rs, int32_t N)
 } /* ros_east() */
 
 /* ==================================== */
-static int32_t ros_west(uint8_t *F, int32_t x, int32_t rs, int32_t N)
+static int32_t ros_west(uint8_t *F, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   D D D     avec origine = (1,1) et valeurs des pixels D quelconques
@@ -6376,10 +6390,10 @@ int32_t lskelrosenfeld(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelrosenfeld"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -6489,10 +6503,10 @@ int32_t lskelrosenfeld_var1(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelrosenfeld_var1"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -6602,10 +6616,10 @@ int32_t lskelrosenfeld_var2(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelrosenfeld_var2"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -6920,10 +6934,10 @@ Voir "Parallel thinning algorithms based on Ronse's sufficient conditions for to
 #undef F_NAME
 #define F_NAME "lskelnemethpalagyi"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *T = UCHARDATA(tmp);
@@ -7103,19 +7117,19 @@ Voir "Parallel thinning algorithms based on Ronse's sufficient conditions for to
 #define MATCH_C(D, p, n, e, s, ne, se) (D[p] && D[e] && (D[n]||D[ne]) && (D[s] || D[se]))
 #define MATCH_C(D, p, n, e, s, ne, se) (D[p] && D[e] && (D[n]||D[ne]) && (D[s] || D[se]))
 
-void getNeighborhood(uint8_t *F, uint32_t rs, uint32_t N, uint32_t p, uint8_t k, uint8_t * neighborhood);
+void getNeighborhood(uint8_t *F, index_t rs, index_t N, index_t p, uint8_t k, uint8_t * neighborhood);
 void printNeighborhood(uint8_t *neighborhood);
-void match_C1(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C2(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C3(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C4(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-
-void match_C1_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C2_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C3_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C4_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
-void match_C_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N);
+void match_C1(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C2(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C3(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C4(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+
+void match_C1_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C2_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C3_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C4_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
+void match_C_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N);
 
 /* |--------+--------+-------+--------+--------| */
 /* |        | 1  nnw | 2  nn | 3  nne |        | */
@@ -7129,7 +7143,7 @@ void match_C_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_
 /* |        | 21 sww | 22 ss | 23 sse |        | */
 /* |--------+--------+-------+--------+--------| */
 
-void getNeighborhood(uint8_t *F, uint32_t rs, uint32_t N, uint32_t p, uint8_t k, uint8_t * neighborhood)
+void getNeighborhood(uint8_t *F, index_t rs, index_t N, index_t p, uint8_t k, uint8_t * neighborhood)
 /* neighborhood is a 25 (5x5) elements array */
 {
     neighborhood[ 1] = F[NNW(p,rs)]>=k ? IN_SET : 0;  //nnw
@@ -7173,10 +7187,10 @@ void printNeighborhood(uint8_t *neighborhood) {
 int32_t lhthinpar(struct xvimage *image, int32_t nsteps) {
 #undef F_NAME
 #define F_NAME "lhthinpar"
-    int32_t p;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t p;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     int32_t step, nonstab;
     // Windows(tm) the declaration must go on the beginning of the block
@@ -7265,10 +7279,10 @@ int32_t lhthinpar(struct xvimage *image, int32_t nsteps) {
 int32_t lhthinpar_asymmetric(struct xvimage *image, int32_t nsteps) {
 #undef F_NAME
 #define F_NAME "lhthinpar_asymmetric"
-    int32_t p;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t p;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     int32_t step, nonstab;
     struct xvimage *destructible;
@@ -7352,8 +7366,8 @@ int32_t lhthinpar_asymmetric(struct xvimage *image, int32_t nsteps) {
     return 1;
 }
 
-void match_C1(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C1(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7389,8 +7403,8 @@ void match_C1(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
 }
 
 
-void match_C1_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C1_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7425,8 +7439,8 @@ void match_C1_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32
     }
 }
 
-void match_C2(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C2(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7461,8 +7475,8 @@ void match_C2(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
 }
 
 
-void match_C2_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C2_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7496,8 +7510,8 @@ void match_C2_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32
     }
 }
 
-void match_C3(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C3(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7532,8 +7546,8 @@ void match_C3(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
 }
 
 
-void match_C3_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C3_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7567,8 +7581,8 @@ void match_C3_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32
     }
 }
 
-void match_C4(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C4(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7605,8 +7619,8 @@ void match_C4(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
     }
 }
 
-void match_C4_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C4_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7643,8 +7657,8 @@ void match_C4_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32
     }
 }
 
-void match_C(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7678,8 +7692,8 @@ void match_C(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
 }
 
 
-void match_C_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, uint32_t rs, uint32_t N) {
-    uint32_t p;
+void match_C_asymmetric(uint8_t* F, uint8_t* D, uint8_t* A, index_t rs, index_t N) {
+    index_t p;
     uint8_t k;
     uint8_t Fk[25];
 
@@ -7733,10 +7747,10 @@ Attention : l'objet ne doit pas toucher le bord de l'image
 #undef F_NAME
 #define F_NAME "lskelCK2"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     uint8_t *I;
@@ -7868,10 +7882,10 @@ int32_t lskelCK2_pers(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelCK2_pers"
 {
-    int32_t i;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t i;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *F = UCHARDATA(image);   /* l'image de depart */
     struct xvimage *tmp = copyimage(image);
     struct xvimage *inhibit;
@@ -7979,7 +7993,7 @@ int32_t lskelCK2_pers(struct xvimage *image,
 } /* lskelCK2_pers() */
 
 /* ==================================== */
-static int32_t clique0_match(uint8_t *F, uint8_t *Y, int32_t x, int32_t rs, int32_t N)
+static int32_t clique0_match(uint8_t *F, uint8_t *Y, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   3 2 1
@@ -8019,7 +8033,7 @@ fail:
 } /* clique0_match() */
 
 /* ==================================== */
-static int32_t clique1_match(uint8_t *F, uint8_t *Y, int32_t x, int32_t rs, int32_t N)
+static int32_t clique1_match(uint8_t *F, uint8_t *Y, index_t x, index_t rs, index_t N)
 /* ==================================== */
 /*
   3 2 1
@@ -8065,12 +8079,13 @@ fail:
 } /* clique1_match() */
 
 /* ==================================== */
-static void D_Crucial_Isthmes(uint8_t *F, uint8_t *K, int32_t rs, int32_t N, uint8_t *Y, uint8_t *Z, uint8_t *A, uint8_t *B)
+static void D_Crucial_Isthmes(uint8_t *F, uint8_t *K, index_t rs, index_t N, uint8_t *Y, uint8_t *Z, uint8_t *A, uint8_t *B)
 /* ==================================== */
 {
 #undef F_NAME
 #define F_NAME "D_Crucial_Isthmes"
-    int32_t i, r;
+    index_t i;
+    int32_t r;
     memcpy(Y, K, N);
     memset(Z, 0, N);
     memset(A, 0, N);
@@ -8079,12 +8094,12 @@ static void D_Crucial_Isthmes(uint8_t *F, uint8_t *K, int32_t rs, int32_t N, uin
     for (i = 0; i < N; i++) {
         if (F[i] && (K[i] || !simple8(F, i, rs, N))) {
 #ifdef DEBUG_D_Crucial_Isthmes
-            printf("2-crucial %d %d\n", i % rs, i / rs);
+            printf("2-crucial %d %d\n", (int32_t)(i % rs), (int32_t)(i / rs));
 #endif
             A[i] = 1;
             if (!K[i] && t8(mask(F, i, rs, N)) > 1) {
 #ifdef DEBUG_D_Crucial_Isthmes
-                printf("isthme mince %d %d\n", i % rs, i / rs);
+                printf("isthme mince %d %d\n", (int32_t)(i % rs), (int32_t)(i / rs));
 #endif
                 B[i] = 1;
             }
@@ -8105,12 +8120,12 @@ static void D_Crucial_Isthmes(uint8_t *F, uint8_t *K, int32_t rs, int32_t N, uin
             r = clique1_match(F, Y, i, rs, N);
             if (r > 0) {
 #ifdef DEBUG_D_Crucial_Isthmes
-                printf("1-crucial %d %d\n", i % rs, i / rs);
+                printf("1-crucial %d %d\n", (int32_t)(i % rs), (int32_t)(i / rs));
 #endif
                 A[i] = 1;
                 if (r > 1) {
 #ifdef DEBUG_D_Crucial_Isthmes
-                    printf("isthme epais %d %d\n", i % rs, i / rs);
+                    printf("isthme epais %d %d\n", (int32_t)(i % rs), (int32_t)(i / rs));
 #endif
                     B[i] = 1;
                 }
@@ -8130,7 +8145,7 @@ static void D_Crucial_Isthmes(uint8_t *F, uint8_t *K, int32_t rs, int32_t N, uin
     for (i = 0; i < N; i++) {
         if (F[i] && !Y[i] && clique0_match(F, Y, i, rs, N)) {
 #ifdef DEBUG_D_Crucial_Isthmes
-            printf("0-crucial %d %d\n", i % rs, i / rs);
+            printf("0-crucial %d %d\n", (int32_t)(i % rs), (int32_t)(i / rs));
 #endif
             Y[i] = 1;
         }
@@ -8189,10 +8204,10 @@ int32_t lskelCK2_pers_topo(struct xvimage *image,
 #undef F_NAME
 #define F_NAME "lskelCK2_pers_topo"
 {
-    int32_t x;
-    int32_t rs = rowsize(image);     /* taille ligne */
-    int32_t cs = colsize(image);     /* taille colonne */
-    int32_t N = rs * cs;             /* taille image */
+    index_t x;
+    index_t rs = rowsize(image);     /* taille ligne */
+    index_t cs = colsize(image);     /* taille colonne */
+    index_t N = rs * cs;             /* taille image */
     uint8_t *X = UCHARDATA(image);   /* l'image de depart */
     struct xvimage *Yimage = copyimage(image);
     struct xvimage *Zimage = copyimage(image);
@@ -8204,7 +8219,8 @@ int32_t lskelCK2_pers_topo(struct xvimage *image,
     uint8_t *Y = UCHARDATA(Yimage);
     uint8_t *Z = UCHARDATA(Zimage);
     uint8_t *K = UCHARDATA(Kimage);
-    int32_t step, ndel;
+    int32_t step;
+    index_t ndel;
     float *P = FLOATDATA(persistence); /* résultat */
     Rbt * Q;
     index_t taillemaxrbt;
@@ -8274,7 +8290,7 @@ int32_t lskelCK2_pers_topo(struct xvimage *image,
         }
 
 #ifdef VERBOSE
-        printf("ndel = %d\n", ndel);
+        printf("ndel = %lld\n", (long long int)ndel);
 #endif
 
     } while (ndel > 0);
@@ -84,6 +84,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcutil.h>
 #include <mcindic.h>
 #include <mcrlifo.h>
+#include <mcthreads.h>
 #include <lskelpar3d.h>
 
 #define PERS_INIT_VAL 0
@@ -266,6 +267,197 @@ static void insert_vois(
     *(ptr) = vois[26];
 } /* insert_vois() */
 
+/* ==================================== */
+/* Phases paralleles (mcthreads) */
+/* ==================================== */
+
+/*
+  Les passes "point par point" des algorithmes paralleles (test de
+  simplicite, points de surface, points residuels, suppression) ne
+  dependent pas de l'ordre de parcours. Elles sont reparties par bandes
+  de plans entre les threads de mcthreads. Pour eviter toute ecriture
+  concurrente dans le voisinage d'un point, les passes qui lisent les
+  voisins ecrivent leur resultat dans T ; ce resultat est reporte dans S
+  par une passe suivante (SKEL3D_OR, SKEL3D_UNSET), apres la barriere.
+
+  Les passes de marquage des cliques D-cruciales (match0, match1,
+  match2...) restent sequentielles : elles marquent une clique seulement
+  si aucun de ses points n'est deja marque, et leur resultat depend donc
+  de l'ordre de parcours.
+*/
+
+#define SKEL3D_SIMPLE      1 /* T := S_SIMPLE si objet, simple et non dans I */
+#define SKEL3D_SURF        2 /* T := S_SURF|S_SELECTED (objet non simple) */
+#define SKEL3D_OR          3 /* S := S | T */
+#define SKEL3D_RESIDUEL6   4 /* T := 1 si residuel (6-voisins) et non voisin d'un pt de surface */
+#define SKEL3D_RESIDUEL26  5 /* T := 1 si residuel (26-voisins) et non voisin d'un pt de surface */
+#define SKEL3D_UNSET       6 /* UNSET_DCRUCIAL, et UNSET_SIMPLE si T */
+#define SKEL3D_UNSETSEL    7 /* UNSET_SELECTED */
+#define SKEL3D_SELDCRUC    8 /* S_SELECTED -> S_DCRUCIAL */
+#define SKEL3D_DELETE      9 /* supprime les pts simples non D-cruciaux, S := S_OBJECT sinon */
+
+#define SKEL3D_MAXBANDS (4 * MCTHREADS_MAX)
+
+typedef struct {
+    uint8_t *S, *T, *I;
+    index_t rs, ps, N, ds;
+    int32_t phase;
+    int32_t nbands;
+    uint8_t changed[SKEL3D_MAXBANDS];
+} skel3d_job;
+
+/* ==================================== */
+static void skel3d_init_job(skel3d_job *J, uint8_t *S, uint8_t *T, uint8_t *I,
+                            index_t rs, index_t ps, index_t ds)
+/* ==================================== */
+{
+    J->S = S;
+    J->T = T;
+    J->I = I;
+    J->rs = rs;
+    J->ps = ps;
+    J->ds = ds;
+    J->N = ps * ds;
+    J->nbands = mcthreads_nbands(ds);
+} /* skel3d_init_job() */
+
+/* ==================================== */
+static void skel3d_band(void *arg, int32_t band)
+/* ==================================== */
+{
+    skel3d_job *J = (skel3d_job *)arg;
+    uint8_t *S = J->S, *T = J->T, *I = J->I;
+    index_t rs = J->rs, ps = J->ps, N = J->N;
+    index_t i, j, first, last;
+    int32_t k, top, topb;
+    uint8_t changed = 0;
+
+    mcthreads_band(J->ds, J->nbands, band, &first, &last);
+    first *= ps;
+    last *= ps;
+
+    switch (J->phase) {
+    case SKEL3D_SIMPLE:
+        mctopo3d_init_topo3d(); // globales de mctopo3d propres a ce thread
+        for (i = first; i < last; i++) {
+            T[i] = 0;
+            if (IS_OBJECT(S[i]) && (!I || !I[i]) && mctopo3d_simple26(S, i, rs, ps, N)) {
+                T[i] = S_SIMPLE;
+            }
+        }
+        break;
+    case SKEL3D_SURF:
+        mctopo3d_init_topo3d();
+        for (i = first; i < last; i++) {
+            T[i] = 0;
+            if (IS_OBJECT(S[i]) && !IS_SIMPLE(S[i])) {
+                mctopo3d_top26(S, i, rs, ps, N, &top, &topb);
+                if (topb > 1) {
+                    SET_SURF(T[i]);
+                }
+                if (topb == 0) {
+                    SET_SELECTED(T[i]);
+                }
+            }
+        }
+        break;
+    case SKEL3D_OR:
+        for (i = first; i < last; i++) {
+            S[i] |= T[i];
+        }
+        break;
+    case SKEL3D_RESIDUEL6:
+    case SKEL3D_RESIDUEL26:
+        for (i = first; i < last; i++) {
+            T[i] = 0;
+            if (IS_OBJECT(S[i])) {
+                if (J->phase == SKEL3D_RESIDUEL6) {
+                    for (k = 0; k < 12; k += 2) {      /* parcourt les voisins en 6-connexite */
+                        j = voisin6(i, k, rs, ps, N);
+                        if ((j != -1) && IS_SELECTED(S[j])) {
+                            break;
+                        }
+                    }
+                    if (k < 12) {
+                        continue;
+                    }
+                } else {
+                    for (k = 0; k < 26; k += 1) {      /* parcourt les voisins en 26-connexite */
+                        j = voisin26(i, k, rs, ps, N);
+                        if ((j != -1) && IS_SELECTED(S[j])) {
+                            break;
+                        }
+                    }
+                    if (k < 26) {
+                        continue;
+                    }
+                }
+                // le voxel est résiduel
+                for (k = 0; k < 26; k += 1) {      /* parcourt les voisins en 26-connexite */
+                    j = voisin26(i, k, rs, ps, N);
+                    if ((j != -1) && IS_SURF(S[j])) {
+                        break;
+                    }
+                }
+                if (k == 26) {
+                    T[i] = 1;
+                }
+            }
+        }
+        break;
+    case SKEL3D_UNSET:
+        for (i = first; i < last; i++) {
+            UNSET_DCRUCIAL(S[i]);
+            if (T[i]) {
+                UNSET_SIMPLE(S[i]);
+            }
+        }
+        break;
+    case SKEL3D_UNSETSEL:
+        for (i = first; i < last; i++) {
+            UNSET_SELECTED(S[i]);
+        }
+        break;
+    case SKEL3D_SELDCRUC:
+        for (i = mcmax(first, 1); i < last; i++) {
+            if (IS_SELECTED(S[i])) {
+                UNSET_SELECTED(S[i]);
+                SET_DCRUCIAL(S[i]);
+            }
+        }
+        break;
+    case SKEL3D_DELETE: // S := [S \ P] \cup M, où M représente les pts marqués
+        for (i = first; i < last; i++) {
+            if (S[i]) {
+                if (!IS_SIMPLE(S[i]) || IS_DCRUCIAL(S[i])) {
+                    S[i] = S_OBJECT;
+                } else {
+                    S[i] = 0;
+                    changed = 1;
+                }
+            }
+        }
+        break;
+    default:
+        assert(0);
+    }
+    J->changed[band] = changed;
+} /* skel3d_band() */
+
+/* ==================================== */
+static int32_t skel3d_phase(skel3d_job *J, int32_t phase)
+/* ==================================== */
+// execute la passe "phase" sur toute l'image ; retourne 1 si un point a ete supprime
+{
+    int32_t b, changed = 0;
+    J->phase = phase;
+    mcthreads_run(J->nbands, skel3d_band, J);
+    for (b = 0; b < J->nbands; b++) {
+        changed |= J->changed[b];
+    }
+    return changed;
+} /* skel3d_phase() */
+
 #ifdef DEBUG
 /* ==================================== */
 static void print_vois(uint8_t *vois)
@@ -1834,7 +2026,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
 #undef F_NAME
 #define F_NAME "lskelCK3"
 {
-    index_t i, j, k;
+    index_t i;
     index_t rs = rowsize(image);     /* taille ligne */
     index_t cs = colsize(image);     /* taille colonne */
     index_t ds = depth(image);       /* nb plans */
@@ -1845,8 +2037,8 @@ Attention : l'objet ne doit pas toucher le bord de l'image
     uint8_t *T = UCHARDATA(t);
     uint8_t *I;
     int32_t step, nonstab;
-    int32_t top, topb;
     uint8_t v[27];
+    skel3d_job J;
 
     if (inhibit == NULL) {
         inhibit = copyimage(image);
@@ -1865,6 +2057,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
     }
 
     mctopo3d_init_topo3d();
+    skel3d_init_job(&J, S, T, I, rs, ps, ds);
 
     /* ================================================ */
     /*               DEBUT ALGO                         */
@@ -1880,11 +2073,8 @@ Attention : l'objet ne doit pas toucher le bord de l'image
 #endif
 
         // MARQUE LES POINTS SIMPLES NON DANS I
-        for (i = 0; i < N; i++) {
-            if (IS_OBJECT(S[i]) && !I[i] && mctopo3d_simple26(S, i, rs, ps, N)) {
-                SET_SIMPLE(S[i]);
-            }
-        }
+        skel3d_phase(&J, SKEL3D_SIMPLE);
+        skel3d_phase(&J, SKEL3D_OR);
         // MARQUE LES POINTS DE SURFACE (2)
         for (i = 0; i < N; i++) {
             if (IS_SIMPLE(S[i])) {
@@ -1895,50 +2085,16 @@ Attention : l'objet ne doit pas toucher le bord de l'image
             }
         }
         // MARQUE LES POINTS DE SURFACE (3) ET LES POINTS INTERIEURS
-        for (i = 0; i < N; i++) {
-            if (IS_OBJECT(S[i]) && !IS_SIMPLE(S[i])) {
-                mctopo3d_top26(S, i, rs, ps, N, &top, &topb);
-                if (topb > 1) {
-                    SET_SURF(S[i]);
-                }
-                if (topb == 0) {
-                    SET_SELECTED(S[i]);
-                }
-            }
-        }
+        skel3d_phase(&J, SKEL3D_SURF);
+        skel3d_phase(&J, SKEL3D_OR);
 
         // DEMARQUE PTS ET REND "NON-SIMPLES" LES CANDIDATS
-        for (i = 0; i < N; i++) {
-            UNSET_DCRUCIAL(S[i]);
-            if (IS_OBJECT(S[i])) {
 #ifdef RESIDUEL6
-                for (k = 0; k < 12; k += 2) {      /* parcourt les voisins en 6-connexite */
-                    j = voisin6(i, k, rs, ps, N);
-                    if ((j != -1) && IS_SELECTED(S[j])) {
-                        break;
-                    }
-                }
-                if (k == 12) // le voxel est résiduel
+        skel3d_phase(&J, SKEL3D_RESIDUEL6);
 #else
-                for (k = 0; k < 26; k += 1) {      /* parcourt les voisins en 26-connexite */
-                    j = voisin26(i, k, rs, ps, N);
-                    if ((j != -1) && IS_SELECTED(S[j])) break;
-                }
-                if (k == 26) // le voxel est résiduel
+        skel3d_phase(&J, SKEL3D_RESIDUEL26);
 #endif
-                {
-                    for (k = 0; k < 26; k += 1) {      /* parcourt les voisins en 26-connexite */
-                        j = voisin26(i, k, rs, ps, N);
-                        if ((j != -1) && IS_SURF(S[j])) {
-                            break;
-                        }
-                    }
-                    if (k == 26) {
-                        UNSET_SIMPLE(S[i]);
-                    }
-                }
-            }
-        }
+        skel3d_phase(&J, SKEL3D_UNSET);
         // MARQUE LES POINTS 2-D-CRUCIAUX
         for (i = 0; i < N; i++) {
             if (IS_SIMPLE(S[i])) {
@@ -1967,27 +2123,9 @@ Attention : l'objet ne doit pas toucher le bord de l'image
             }
         }
 
-        memset(T, 0, N);
-        for (i = 0; i < N;
-                i++) { // T := [S \ P] \cup M, où M représente les pts marqués
-            if ((S[i] && !IS_SIMPLE(S[i])) || IS_DCRUCIAL(S[i])) {
-                T[i] = 1;
-            }
-        }
-#ifdef DEBUG
-        writeimage(t,"_T");
-#endif
-
-        for (i = 0; i < N; i++) {
-            if (S[i] && !T[i]) {
-                S[i] = 0;
-                nonstab = 1;
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (S[i]) {
-                S[i] = S_OBJECT;
-            }
+        // S := [S \ P] \cup M, où M représente les pts marqués
+        if (skel3d_phase(&J, SKEL3D_DELETE)) {
+            nonstab = 1;
         }
     }
 
@@ -2235,6 +2373,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
     uint8_t *I = NULL;
     int32_t step, nonstab;
     uint8_t v[27];
+    skel3d_job J;
 
     if (n_steps == -1) {
         n_steps = 1000000000;
@@ -2251,6 +2390,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
     }
 
     mctopo3d_init_topo3d();
+    skel3d_init_job(&J, S, T, I, rs, ps, ds);
 
     /* ================================================ */
     /*               DEBUT ALGO                         */
@@ -2266,12 +2406,8 @@ Attention : l'objet ne doit pas toucher le bord de l'image
 #endif
 
         // PREMIERE SOUS-ITERATION : MARQUE LES POINTS SIMPLES ET PAS DANS I
-        for (i = 0; i < N; i++) {
-            if (IS_OBJECT(S[i]) && mctopo3d_simple26(S, i, rs, ps, N) &&
-                    (!I || !I[i])) {
-                SET_SIMPLE(S[i]);
-            }
-        }
+        skel3d_phase(&J, SKEL3D_SIMPLE);
+        skel3d_phase(&J, SKEL3D_OR);
         // DEUXIEME SOUS-ITERATION : MARQUE LES POINTS 2-D-CRUCIAUX
         for (i = 0; i < N; i++) {
             if (IS_SIMPLE(S[i])) {
@@ -2302,24 +2438,9 @@ Attention : l'objet ne doit pas toucher le bord de l'image
             }
         }
 
-        memset(T, 0, N);
-        for (i = 0; i < N;
-                i++) { // T := [S \ P] \cup  R, où R représente les pts marqués
-            if ((S[i] && !IS_SIMPLE(S[i])) || IS_DCRUCIAL(S[i])) {
-                T[i] = 1;
-            }
-        }
-
-        for (i = 0; i < N; i++) {
-            if (S[i] && !T[i]) {
-                S[i] = 0;
-                nonstab = 1;
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (S[i]) {
-                S[i] = S_OBJECT;
-            }
+        // S := [S \ P] \cup  R, où R représente les pts marqués
+        if (skel3d_phase(&J, SKEL3D_DELETE)) {
+            nonstab = 1;
         }
     }
 
@@ -4111,7 +4232,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
 #undef F_NAME
 #define F_NAME "lskelACK3"
 {
-    index_t i, j, k;
+    index_t i;
     index_t rs = rowsize(image);     /* taille ligne */
     index_t cs = colsize(image);     /* taille colonne */
     index_t ds = depth(image);       /* nb plans */
@@ -4122,8 +4243,8 @@ Attention : l'objet ne doit pas toucher le bord de l'image
     uint8_t *T = UCHARDATA(t);
     uint8_t *I;
     int32_t step, nonstab;
-    int32_t top, topb;
     uint8_t v[27];
+    skel3d_job J;
 
     if (inhibit == NULL) {
         inhibit = copyimage(image);
@@ -4142,6 +4263,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
     }
 
     mctopo3d_init_topo3d();
+    skel3d_init_job(&J, S, T, I, rs, ps, ds);
 
     /* ================================================ */
     /*               DEBUT ALGO                         */
@@ -4157,11 +4279,8 @@ Attention : l'objet ne doit pas toucher le bord de l'image
 #endif
 
         // MARQUE LES POINTS SIMPLES NON DANS I
-        for (i = 0; i < N; i++) {
-            if (IS_OBJECT(S[i]) && !I[i] && mctopo3d_simple26(S, i, rs, ps, N)) {
-                SET_SIMPLE(S[i]);
-            }
-        }
+        skel3d_phase(&J, SKEL3D_SIMPLE);
+        skel3d_phase(&J, SKEL3D_OR);
         // MARQUE LES POINTS DE SURFACE (2)
         for (i = 0; i < N; i++) {
             if (IS_SIMPLE(S[i])) {
@@ -4172,45 +4291,13 @@ Attention : l'objet ne doit pas toucher le bord de l'image
             }
         }
         // MARQUE LES POINTS DE SURFACE (3) ET LES POINTS INTERIEURS
-        for (i = 0; i < N; i++) {
-            if (IS_OBJECT(S[i]) && !IS_SIMPLE(S[i])) {
-                mctopo3d_top26(S, i, rs, ps, N, &top, &topb);
-                if (topb > 1) {
-                    SET_SURF(S[i]);
-                }
-                if (topb == 0) {
-                    SET_SELECTED(S[i]);
-                }
-            }
-        }
+        skel3d_phase(&J, SKEL3D_SURF);
+        skel3d_phase(&J, SKEL3D_OR);
 
         // DEMARQUE PTS ET REND "NON-SIMPLES" LES CANDIDATS
-        for (i = 0; i < N; i++) {
-            UNSET_DCRUCIAL(S[i]);
-            if (IS_OBJECT(S[i])) {
-                for (k = 0; k < 26; k += 1) {      /* parcourt les voisins en 26-connexite */
-                    j = voisin26(i, k, rs, ps, N);
-                    if ((j != -1) && IS_SELECTED(S[j])) {
-                        break;
-                    }
-                }
-                if (k == 26) { // le voxel est résiduel
-                    for (k = 0; k < 26; k += 1) {      /* parcourt les voisins en 26-connexite */
-                        j = voisin26(i, k, rs, ps, N);
-                        if ((j != -1) && IS_SURF(S[j])) {
-                            break;
-                        }
-                    }
-                    if (k == 26) {
-                        UNSET_SIMPLE(S[i]);
-                    }
-                }
-            }
-        }
-
-        for (i = 0; i < N; i++) {
-            UNSET_SELECTED(S[i]);
-        }
+        skel3d_phase(&J, SKEL3D_RESIDUEL26);
+        skel3d_phase(&J, SKEL3D_UNSET);
+        skel3d_phase(&J, SKEL3D_UNSETSEL);
 
         // MARQUE LES POINTS 2-D-CRUCIAUX
         for (i = 0; i < N; i++) {
@@ -4221,12 +4308,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
                 }
             }
         }
-        for (i = 1; i < N; i++) {
-            if (IS_SELECTED(S[i])) {
-                UNSET_SELECTED(S[i]);
-                SET_DCRUCIAL(S[i]);
-            }
-        }
+        skel3d_phase(&J, SKEL3D_SELDCRUC);
 
         // MARQUE LES POINTS 1-D-CRUCIAUX
         for (i = 0; i < N; i++) {
@@ -4237,12 +4319,7 @@ Attention : l'objet ne doit pas toucher le bord de l'image
                 }
             }
         }
-        for (i = 1; i < N; i++) {
-            if (IS_SELECTED(S[i])) {
-                UNSET_SELECTED(S[i]);
-                SET_DCRUCIAL(S[i]);
-            }
-        }
+        skel3d_phase(&J, SKEL3D_SELDCRUC);
 
         // MARQUE LES POINTS 0-D-CRUCIAUX
         for (i = 0; i < N; i++) {
@@ -4253,34 +4330,11 @@ Attention : l'objet ne doit pas toucher le bord de l'image
                 }
             }
         }
-        for (i = 1; i < N; i++) {
-            if (IS_SELECTED(S[i])) {
-                UNSET_SELECTED(S[i]);
-                SET_DCRUCIAL(S[i]);
-            }
-        }
-
-        memset(T, 0, N);
-        for (i = 0; i < N;
-                i++) { // T := [S \ P] \cup M, où M représente les pts marqués
-            if ((S[i] && !IS_SIMPLE(S[i])) || IS_DCRUCIAL(S[i])) {
-                T[i] = 1;
-            }
-        }
-#ifdef DEBUG
-        writeimage(t,"_T");
-#endif
+        skel3d_phase(&J, SKEL3D_SELDCRUC);
 
-        for (i = 0; i < N; i++) {
-            if (S[i] && !T[i]) {
-                S[i] = 0;
-                nonstab = 1;
-            }
-        }
-        for (i = 0; i < N; i++) {
-            if (S[i]) {
-                S[i] = S_OBJECT;
-            }
+        // S := [S \ P] \cup M, où M représente les pts marqués
+        if (skel3d_phase(&J, SKEL3D_DELETE)) {
+            nonstab = 1;
         }
     }
 
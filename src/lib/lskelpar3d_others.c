@@ -113,6 +113,7 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <mcindic.h>
 #include <mctopo.h>
 #include <mctopo3d.h>
+#include <mctables.h>
 #include <lskelpar3d_others.h>
 
 //#define VERBOSE
@@ -6264,32 +6265,14 @@ void set_char_mask( void ) {
       char_mask
 ----------------*/
 void init_lut( char* mask_name ) {
-    char  lutname [100];
-    FILE * lutfile = NULL;
 
-    /* alloc lut_deletable */
-    lut_deletable = (unsigned char *)malloc(0x00400000);    /* 4 Mbyte */
+    /* map lut_deletable (4 Mbyte), searched by mctables_load */
+    lut_deletable = mctables_load(mask_name, 0x00400000, NULL);
     if ( lut_deletable == NULL) {
-        printf("\n Alloc error!!!\n");
+        printf("ERROR: Couldn't read LUT %s\n", mask_name);
         exit(1);
     }  /* end if */
 
-    /* open lutfile */
-    strcpy( lutname, mask_name);
-    lutfile = fopen( lutname, "rb");
-    if ( lutfile == NULL) {
-        printf("\n\n file %s is not found!!!\n", mask_name);
-        exit(1);
-    }  /* end if */
-
-    /* reading lutfile */
-    if ( fread( lut_deletable, 1, 0x00400000, lutfile) != 0x00400000 ) {    /* 4 Mbyte */
-        printf("ERROR: Couldn't read LUT\n");
-        exit(1);
-    }
-
-    fclose(lutfile);
-
     /* setting masks */
     set_long_mask();
     set_char_mask();
@@ -7144,7 +7127,6 @@ void thinning(void) {
 int32_t palagyi_skelpar_curv_98(struct xvimage *input) {
 #undef F_NAME
 #define F_NAME "palagyi_skelpar_curv_98"
-    char tablefilename[512];
     pgmimage=input;
     /********************/
     /* READ INPUT IMAGE */
@@ -7154,8 +7136,7 @@ int32_t palagyi_skelpar_curv_98(struct xvimage *input) {
     /***************/
     /* READING LUT */
     /***************/
-    sprintf(tablefilename, "%s/src/tables/palagyi_pardir_curv_98.dat", getenv("PINK"));
-    init_lut(tablefilename);
+    init_lut("palagyi_pardir_curv_98.dat");
 
     /************/
     /* THINNING */
@@ -7173,7 +7154,8 @@ int32_t palagyi_skelpar_curv_98(struct xvimage *input) {
     /********/
     /* FREE */
     /********/
-    free(lut_deletable);
+    mctables_release(lut_deletable, 0x00400000);
+    lut_deletable = NULL;
 
 
     return(0);
@@ -7193,28 +7175,14 @@ int32_t palagyi_skelpar_curv_98(struct xvimage *input) {
       char_mask
 ----------------*/
 void init_lut_simple( char* mask_name ) {
-    char  lutname [100];
-    FILE * lutfile = NULL;
 
-    /* alloc lut_simple */
-    lut_simple = (unsigned char *)malloc(0x00800000);
+    /* map lut_simple (8 Mbyte), searched by mctables_load */
+    lut_simple = mctables_load(mask_name, 0x00800000, NULL);
     if ( lut_simple == NULL) {
-        printf("\n Alloc error!!!\n");
+        printf("ERROR: Couldn't read LUT %s\n", mask_name);
         exit(1);
     }  /* end if */
 
-    /* open lutfile */
-    strcpy( lutname, mask_name);
-    lutfile = fopen( lutname, "rb");
-    if ( lutfile == NULL) {
-        printf("\n\n file %s is not found!!!\n", mask_name);
-        exit(1);
-    }  /* end if */
-
-    /* reading lutfile */
-    fread( lut_simple, 1, 0x00800000, lutfile);
-    fclose(lutfile);
-
     /* setting masks */
     set_long_mask();
     set_char_mask();
@@ -7639,7 +7607,6 @@ void sequential_thinning2(void) {
 int32_t palagyi_skelpar_curv_06(struct xvimage *input) {
 #undef F_NAME
 #define F_NAME "palagyi_skelpar_curv_06"
-    char tablefilename[512];
     pgmimage=input;
     DEL6NEI = 1;
     /********************/
@@ -7650,8 +7617,7 @@ int32_t palagyi_skelpar_curv_06(struct xvimage *input) {
     /***************/
     /* READING LUT */
     /***************/
-    sprintf(tablefilename, "%s/src/tables/palagyi_pardir_curv_06.dat", getenv("PINK"));
-    init_lut_simple(tablefilename);
+    init_lut_simple("palagyi_pardir_curv_06.dat");
 
     /************/
     /* THINNING */
@@ -7669,7 +7635,8 @@ int32_t palagyi_skelpar_curv_06(struct xvimage *input) {
     /********/
     /* FREE */
     /********/
-    free(lut_simple);
+    mctables_release(lut_simple, 0x00800000);
+    lut_simple = NULL;
 
 
     return(0);
@@ -8158,7 +8125,6 @@ void thinning3(void) {
 int32_t palagyi_skelpar_surf_02(struct xvimage *input) {
 #undef F_NAME
 #define F_NAME "palagyi_skelpar_surf_02"
-    char tablefilename[512];
     pgmimage=input;
     /********************/
     /* READ INPUT IMAGE */
@@ -8168,8 +8134,7 @@ int32_t palagyi_skelpar_surf_02(struct xvimage *input) {
     /***************/
     /* READING LUT */
     /***************/
-    sprintf(tablefilename, "%s/src/tables/palagyi_pardir_surf_02.dat", getenv("PINK"));
-    init_lut(tablefilename);
+    init_lut("palagyi_pardir_surf_02.dat");
 
     /************/
     /* THINNING */
@@ -8187,7 +8152,8 @@ int32_t palagyi_skelpar_surf_02(struct xvimage *input) {
     /********/
     /* FREE */
     /********/
-    free(lut_deletable);
+    mctables_release(lut_deletable, 0x00400000);
+    lut_deletable = NULL;
 
 
     return(0);
@@ -8637,7 +8603,6 @@ void thinning4(void) {
 int32_t palagyi_skelpar_surf_08(struct xvimage *input) {
 #undef F_NAME
 #define F_NAME "palagyi_skelpar_surf_08"
-    char tablefilename[512];
     pgmimage=input;
     /********************/
     /* READ INPUT IMAGE */
@@ -8647,8 +8612,7 @@ int32_t palagyi_skelpar_surf_08(struct xvimage *input) {
     /***************/
     /* READING LUT */
     /***************/
-    sprintf(tablefilename, "%s/src/tables/palagyi_pardir_surf_08.dat", getenv("PINK"));
-    init_lut(tablefilename);
+    init_lut("palagyi_pardir_surf_08.dat");
 
     /************/
     /* THINNING */
@@ -8666,7 +8630,8 @@ int32_t palagyi_skelpar_surf_08(struct xvimage *input) {
     /********/
     /* FREE */
     /********/
-    free(lut_deletable);
+    mctables_release(lut_deletable, 0x00400000);
+    lut_deletable = NULL;
 
 
     return(0);
@@ -0,0 +1,772 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Execution "hors memoire" d'un operateur local sur un volume brut
+   (P5 byte, P8 int32_t, P9 float) trop gros pour tenir en memoire.
+
+   Le volume est traite par tranches de nplans plans : chaque tranche est
+   lue avec une marge (halo) de h plans de part et d'autre, l'operateur
+   est applique a cette sous-image, et seuls les plans centraux sont
+   ecrits dans le fichier resultat, dont l'en-tete est ecrit au
+   prealable. La memoire utilisee est donc bornee par la taille d'une
+   tranche (nplans + 2h plans, plus la memoire de travail de l'operateur)
+   et non par celle du volume.
+
+   Pour les operateurs de support fini (dilatation, erosion, convolution,
+   seuil, arithmetique), le halo couvre le support de l'operateur selon z
+   et le resultat est identique a celui obtenu en memoire. Les filtres
+   recursifs de Deriche ont un support infini : le halo est alors de
+   LSTREAM_DERICHE / alpha plans, et l'erreur commise sur les plans
+   centraux est de l'ordre de (1 + LSTREAM_DERICHE) exp(-LSTREAM_DERICHE),
+   soit 1e-4 relativement a la dynamique de l'image (au plus un niveau de
+   gris pour les images byte).
+
+   Les arguments de type 'j' sont des volumes lus en parallele du volume
+   principal (memes dimensions, meme type), par tranches identiques.
+
+   Les operateurs qui dependent d'une valeur globale du volume (inverse :
+   maximum des images int32_t et float) la calculent par une premiere
+   passe de lecture, tranche par tranche.
+
+   Le resultat est ecrit dans un fichier temporaire du repertoire de
+   outfile, renomme en outfile en cas de succes et supprime sinon : le
+   fichier resultat peut donc etre l'un des volumes lus.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <mcutil.h>
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <larith.h>
+#include <lconvol3.h>
+#include <lderiche.h>
+#include <ldilateros3d.h>
+#include <lseuil.h>
+#include <lstream.h>
+
+#define ST_MAXARGS 4
+#define ST_BUFFERSIZE 10000
+#define LSTREAM_DERICHE 12.0
+
+/* volume brut ouvert en lecture */
+typedef struct {
+    FILE *fd;
+    index_t rs, cs, ds;
+    int32_t type;         /* VFF_TYP_1_BYTE, VFF_TYP_4_BYTE ou VFF_TYP_FLOAT */
+    size_t plan;          /* taille d'un plan en octets */
+    off_t debut;          /* position des donnees dans le fichier */
+    double xdim, ydim, zdim;
+} stvol;
+
+/*
+   Types d'arguments (champ args de la table des operateurs) :
+   'j' : volume (nom de fichier) lu par tranches avec le volume principal
+   's' : element structurant (nom de fichier, lu par readse)
+   'm' : image lue en entier (nom de fichier, lue par readimage)
+   'c' : mot cle "norm"
+   'd' : reel
+   Les arguments de rang superieur ou egal a nmin sont facultatifs.
+*/
+
+typedef struct {
+    struct xvimage *im;   /* types j (tranche courante), s, m */
+    index_t x, y, z;      /* type s : origine de l'element structurant */
+    double val;           /* type d */
+    stvol vol;            /* type j */
+    char *str;
+} starg;
+
+/* a[0].im est la tranche courante du volume principal ; l'operateur
+   travaille en place sur *res (qui vaut initialement a[0].im) ou le
+   remplace (en liberant l'ancien) */
+typedef int32_t (*stfun)(starg *a, int32_t n, struct xvimage **res);
+typedef index_t (*sthalo)(starg *a, int32_t n);
+
+typedef struct {
+    const char *name;
+    const char *args;     /* ne comprend pas le volume principal */
+    int32_t nmin;
+    int32_t type;         /* type du resultat (0 : celui du volume principal) */
+    int32_t maxglobal;    /* 1 : maximum du volume principal (int32_t, float)
+                             calcule au prealable dans a[0].val */
+    sthalo halo;          /* NULL : pas de halo */
+    stfun fun;
+    const char *usage;
+} stop;
+
+/* ==================================== */
+static int32_t st_ouvre(char *filename, stvol *v)
+/* ==================================== */
+#undef F_NAME
+#define F_NAME "st_ouvre"
+{
+    char buffer[ST_BUFFERSIZE];
+    int32_t c, ndgmax = 255;
+
+    memset(v, 0, sizeof(stvol));
+    v->xdim = v->ydim = v->zdim = 1.0;
+    v->fd = fopen(filename, "rb");
+    if (v->fd == NULL) {
+        fprintf(stderr, "%s: file not found: %s\n", F_NAME, filename);
+        return 0;
+    }
+    if ((fgets(buffer, ST_BUFFERSIZE, v->fd) == NULL) || (buffer[0] != 'P')) {
+        fprintf(stderr, "%s: invalid image format: %s\n", F_NAME, filename);
+        goto erreur;
+    }
+    switch (buffer[1]) {
+    case '5':
+    case '7':
+        v->type = VFF_TYP_1_BYTE;
+        break;
+    case '8':
+        v->type = VFF_TYP_4_BYTE;
+        break;
+    case '9':
+        v->type = VFF_TYP_FLOAT;
+        break;
+    default:
+        fprintf(stderr, "%s: %s: only raw byte, int32_t and float images can be streamed\n", F_NAME, filename);
+        goto erreur;
+    }
+
+    do {
+        if (fgets(buffer, ST_BUFFERSIZE, v->fd) == NULL) {
+            fprintf(stderr, "%s: %s: truncated header\n", F_NAME, filename);
+            goto erreur;
+        }
+        if (strncmp(buffer, "#xdim", 5) == 0) {
+            sscanf(buffer + 5, "%lf", &v->xdim);
+        } else if (strncmp(buffer, "#ydim", 5) == 0) {
+            sscanf(buffer + 5, "%lf", &v->ydim);
+        } else if (strncmp(buffer, "#zdim", 5) == 0) {
+            sscanf(buffer + 5, "%lf", &v->zdim);
+        }
+    } while (!isdigit((unsigned char)buffer[0]));
+
+#ifdef MC_64_BITS
+    c = sscanf(buffer, "%lld %lld %lld", (long long int *)&v->rs, (long long int *)&v->cs, (long long int *)&v->ds);
+#else
+    c = sscanf(buffer, "%d %d %d", (int *)&v->rs, (int *)&v->cs, (int *)&v->ds);
+#endif
+    if (c == 2) {
+        v->ds = 1;
+    } else if (c != 3) {
+        fprintf(stderr, "%s: %s: invalid image format\n", F_NAME, filename);
+        goto erreur;
+    }
+    if (fgets(buffer, ST_BUFFERSIZE, v->fd) == NULL) {
+        fprintf(stderr, "%s: %s: truncated header\n", F_NAME, filename);
+        goto erreur;
+    }
+    sscanf(buffer, "%d", &ndgmax);
+    if ((v->type == VFF_TYP_1_BYTE) && (ndgmax > 255)) {
+        fprintf(stderr, "%s: %s: 16-bit images cannot be streamed\n", F_NAME, filename);
+        goto erreur;
+    }
+
+    switch (v->type) {
+    case VFF_TYP_1_BYTE:
+        v->plan = sizeof(uint8_t);
+        break;
+    case VFF_TYP_4_BYTE:
+        v->plan = sizeof(int32_t);
+        break;
+    default:
+        v->plan = sizeof(float);
+        break;
+    }
+    v->plan *= (size_t)v->rs * (size_t)v->cs;
+    v->debut = ftello(v->fd);
+    return 1;
+
+erreur:
+    fclose(v->fd);
+    v->fd = NULL;
+    return 0;
+} /* st_ouvre() */
+
+/* ==================================== */
+static struct xvimage *st_lit(stvol *v, index_t za, index_t zb)
+/* ==================================== */
+/* lit les plans za (inclus) a zb (exclu) */
+#undef F_NAME
+#define F_NAME "st_lit"
+{
+    struct xvimage *im;
+    size_t n = (size_t)(zb - za) * v->plan;
+
+    im = allocimage(NULL, v->rs, v->cs, zb - za, v->type);
+    if (im == NULL) {
+        fprintf(stderr, "%s: allocimage failed\n", F_NAME);
+        return NULL;
+    }
+    if ((fseeko(v->fd, v->debut + (off_t)za * (off_t)v->plan, SEEK_SET) != 0) ||
+        (fread(im->image_data, 1, n, v->fd) != n)) {
+        fprintf(stderr, "%s: read error (truncated file?)\n", F_NAME);
+        freeimage(im);
+        return NULL;
+    }
+    im->xdim = v->xdim;
+    im->ydim = v->ydim;
+    im->zdim = v->zdim;
+    return im;
+} /* st_lit() */
+
+/* ==================================== */
+static void st_entete(FILE *fd, int32_t type, stvol *v)
+/* ==================================== */
+/* meme en-tete que writerawimage */
+{
+    if (type == VFF_TYP_1_BYTE) {
+        fputs("P5\n", fd);
+    } else if (type == VFF_TYP_4_BYTE) {
+        fputs("P8\n", fd);
+    } else {
+        fputs("P9\n", fd);
+    }
+    if ((v->xdim != 0.0) && (v->ds > 1)) {
+        fprintf(fd, "#xdim %g\n#ydim %g\n#zdim %g\n", v->xdim, v->ydim, v->zdim);
+    }
+    if ((v->xdim != 0.0) && (v->ds == 1)) {
+        fprintf(fd, "#xdim %g\n#ydim %g\n", v->xdim, v->ydim);
+    }
+#ifdef MC_64_BITS
+    if (v->ds > 1) {
+        fprintf(fd, "%lld %lld %lld\n", (long long int)v->rs, (long long int)v->cs, (long long int)v->ds);
+    } else {
+        fprintf(fd, "%lld %lld\n", (long long int)v->rs, (long long int)v->cs);
+    }
+#else
+    if (v->ds > 1) {
+        fprintf(fd, "%d %d %d\n", v->rs, v->cs, v->ds);
+    } else {
+        fprintf(fd, "%d %d\n", v->rs, v->cs);
+    }
+#endif
+    if (type == VFF_TYP_1_BYTE) {
+        fputs("255\n", fd);
+    } else if (type == VFF_TYP_4_BYTE) {
+        fputs("4294967295\n", fd);
+    } else {
+        fputs("0\n", fd);
+    }
+} /* st_entete() */
+
+/* ==================================== */
+static index_t st_halo_se(starg *a, int32_t n)
+/* ==================================== */
+/* extension selon z de l'element structurant, de part et d'autre de l'origine */
+{
+    index_t d = depth(a[1].im), zc = a[1].z;
+    return mcmax(zc, d - 1 - zc);
+} /* st_halo_se() */
+
+/* ==================================== */
+static index_t st_halo_deriche(starg *a, int32_t n)
+/* ==================================== */
+{
+    return (index_t)ceil(LSTREAM_DERICHE / a[1].val);
+} /* st_halo_deriche() */
+
+/* ==================================== */
+static int32_t st_dilatbin3d(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return ldilatbin3d(*res, a[1].im, (int32_t)a[1].x, (int32_t)a[1].y, (int32_t)a[1].z);
+} /* st_dilatbin3d() */
+
+/* ==================================== */
+static int32_t st_eros3d(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return leros3d(*res, a[1].im, (int32_t)a[1].x, (int32_t)a[1].y, (int32_t)a[1].z);
+} /* st_eros3d() */
+
+/* ==================================== */
+static int32_t st_convol3(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+/* lconvol3 ne traite que les images 2d : plan par plan */
+{
+    struct xvimage *im = *res, *p;
+    index_t z, ds = depth(im), N = rowsize(im) * colsize(im);
+    int32_t normalise = (n > 2);
+
+    if (ds == 1) {
+        return lconvol3(im, a[1].im, normalise);
+    }
+    p = allocimage(NULL, rowsize(im), colsize(im), 1, VFF_TYP_1_BYTE);
+    if (p == NULL) {
+        return 0;
+    }
+    for (z = 0; z < ds; z++) {
+        memcpy(UCHARDATA(p), UCHARDATA(im) + z * N, N);
+        if (! lconvol3(p, a[1].im, normalise)) {
+            freeimage(p);
+            return 0;
+        }
+        memcpy(UCHARDATA(im) + z * N, UCHARDATA(p), N);
+    }
+    freeimage(p);
+    return 1;
+} /* st_convol3() */
+
+/* ==================================== */
+static int32_t st_seuil(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    struct xvimage *image = *res, *imagebin;
+    index_t x, N = rowsize(image) * colsize(image) * depth(image);
+    uint8_t *F;
+
+    if (n == 2) {
+        if (! lseuil(image, a[1].val)) {
+            return 0;
+        }
+    } else {
+        if (! lseuil3(image, a[1].val, a[2].val)) {
+            return 0;
+        }
+    }
+    if (datatype(image) == VFF_TYP_1_BYTE) {
+        return 1;
+    }
+    /* comme l'outil seuil : le resultat est une image binaire (byte) */
+    imagebin = allocimage(NULL, rowsize(image), colsize(image), depth(image), VFF_TYP_1_BYTE);
+    if (imagebin == NULL) {
+        return 0;
+    }
+    F = UCHARDATA(imagebin);
+    if (datatype(image) == VFF_TYP_4_BYTE) {
+        int32_t *FL = SLONGDATA(image);
+        for (x = 0; x < N; x++) {
+            F[x] = (uint8_t)FL[x];
+        }
+    } else {
+        float *FL = FLOATDATA(image);
+        for (x = 0; x < N; x++) {
+            F[x] = (FL[x] == 0.0) ? NDG_MIN : NDG_MAX;
+        }
+    }
+    freeimage(image);
+    *res = imagebin;
+    return 1;
+} /* st_seuil() */
+
+/* ==================================== */
+static int32_t st_deriche3d(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    int32_t function = (int32_t)a[2].val;
+    if ((function == 4) && (datatype(*res) == VFF_TYP_1_BYTE)) {
+        return llisseurrec3d(*res, a[1].val);
+    }
+    return lderiche3d(*res, a[1].val, function, (n > 3) ? a[3].val : 0.0);
+} /* st_deriche3d() */
+
+/* ==================================== */
+static int32_t st_add(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return ladd(*res, a[1].im);
+} /* st_add() */
+
+/* ==================================== */
+static int32_t st_sub(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lsub(*res, a[1].im);
+} /* st_sub() */
+
+/* ==================================== */
+static int32_t st_min(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lmin(*res, a[1].im);
+} /* st_min() */
+
+/* ==================================== */
+static int32_t st_max(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lmax(*res, a[1].im);
+} /* st_max() */
+
+/* ==================================== */
+static int32_t st_mult(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lmult(*res, a[1].im);
+} /* st_mult() */
+
+/* ==================================== */
+static int32_t st_diff(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return ldiff(*res, a[1].im);
+} /* st_diff() */
+
+/* ==================================== */
+static int32_t st_xor(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lxor(*res, a[1].im);
+} /* st_xor() */
+
+/* ==================================== */
+static int32_t st_inverse(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+/* comme linverse, mais avec le maximum du volume entier (a[0].val) */
+{
+    struct xvimage *im = *res;
+    index_t x, N = rowsize(im) * colsize(im) * depth(im);
+
+    if (datatype(im) == VFF_TYP_4_BYTE) {
+        int32_t *F = SLONGDATA(im), vmax = (int32_t)a[0].val;
+        for (x = 0; x < N; x++) {
+            F[x] = vmax - F[x];
+        }
+        return 1;
+    }
+    if (datatype(im) == VFF_TYP_FLOAT) {
+        float *F = FLOATDATA(im), vmax = (float)a[0].val;
+        for (x = 0; x < N; x++) {
+            F[x] = vmax - F[x];
+        }
+        return 1;
+    }
+    return linverse(im);
+} /* st_inverse() */
+
+/* ==================================== */
+static int32_t st_addconst(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+/* comme l'outil addconst : constante entiere sauf pour les images float */
+{
+    if (datatype(*res) == VFF_TYP_FLOAT) {
+        return laddconst2(*res, a[1].val);
+    }
+    return laddconst(*res, atoi(a[1].str));
+} /* st_addconst() */
+
+/* ==================================== */
+static int32_t st_scale(starg *a, int32_t n, struct xvimage **res)
+/* ==================================== */
+{
+    return lscale(*res, a[1].val);
+} /* st_scale() */
+
+static const stop st_ops[] = {
+    { "dilatbin3d", "s",   1, 0,              0, st_halo_se,      st_dilatbin3d, "dilatbin3d se.pgm" },
+    { "eros3d",     "s",   1, 0,              0, st_halo_se,      st_eros3d,     "eros3d se.pgm" },
+    { "convol3",    "mc",  1, 0,              0, NULL,            st_convol3,    "convol3 mask.pgm [norm]" },
+    { "seuil",      "dd",  1, VFF_TYP_1_BYTE, 0, NULL,            st_seuil,      "seuil seuil [seuil2]" },
+    { "deriche3d",  "ddd", 2, 0,              0, st_halo_deriche, st_deriche3d,  "deriche3d alpha function [l]" },
+    { "add",        "j",   1, 0,              0, NULL,            st_add,        "add in2.pgm" },
+    { "sub",        "j",   1, 0,              0, NULL,            st_sub,        "sub in2.pgm" },
+    { "min",        "j",   1, 0,              0, NULL,            st_min,        "min in2.pgm" },
+    { "max",        "j",   1, 0,              0, NULL,            st_max,        "max in2.pgm" },
+    { "mult",       "j",   1, 0,              0, NULL,            st_mult,       "mult in2.pgm" },
+    { "diff",       "j",   1, 0,              0, NULL,            st_diff,       "diff in2.pgm" },
+    { "xor",        "j",   1, 0,              0, NULL,            st_xor,        "xor in2.pgm" },
+    { "inverse",    "",    0, 0,              1, NULL,            st_inverse,    "inverse" },
+    { "addconst",   "d",   1, 0,              0, NULL,            st_addconst,   "addconst const" },
+    { "scale",      "d",   1, 0,              0, NULL,            st_scale,      "scale const" },
+};
+
+#define ST_NOPS ((int32_t)(sizeof(st_ops) / sizeof(st_ops[0])))
+
+/* ==================================== */
+void lstream_listops(FILE *fd)
+/* ==================================== */
+{
+    int32_t i;
+    for (i = 0; i < ST_NOPS; i++) {
+        fprintf(fd, "  %s\n", st_ops[i].usage);
+    }
+}
+
+/* ==================================== */
+int32_t lstream(
+    char *infile,     /* volume a traiter */
+    char *outfile,    /* volume resultat */
+    index_t nplans,   /* nombre de plans resultat par tranche */
+    char *opname,     /* nom de l'operateur */
+    int32_t nargs,    /* nombre d'arguments de l'operateur */
+    char **args)      /* arguments de l'operateur */
+/* ==================================== */
+#undef F_NAME
+#define F_NAME "lstream"
+{
+    const stop *op = NULL;
+    stvol vol;
+    starg a[ST_MAXARGS + 1];
+    struct xvimage *res;
+    FILE *fd = NULL;
+    char *tmpfile = NULL;
+    int tmpfd;
+    mode_t masque;
+    index_t h, z0, z1, za, zb;
+    int32_t i, k, n, type, ret = 0;
+    size_t nw;
+
+    for (i = 0; i < ST_NOPS; i++) {
+        if (strcmp(st_ops[i].name, opname) == 0) {
+            op = &st_ops[i];
+        }
+    }
+    if (op == NULL) {
+        fprintf(stderr, "%s: unknown operator %s\n", F_NAME, opname);
+        return 0;
+    }
+    if ((nargs < op->nmin) || (nargs > (int32_t)strlen(op->args))) {
+        fprintf(stderr, "%s: usage: %s\n", F_NAME, op->usage);
+        return 0;
+    }
+    if (nplans < 1) {
+        fprintf(stderr, "%s: bad slab size\n", F_NAME);
+        return 0;
+    }
+
+    /* ---------------------------------------------------------- */
+    /* ouverture des volumes et lecture des arguments */
+    /* ---------------------------------------------------------- */
+    memset(a, 0, sizeof(a));
+    n = nargs + 1;
+    if (! st_ouvre(infile, &vol)) {
+        return 0;
+    }
+    for (k = 1; k < n; k++) {
+        char t = op->args[k - 1];
+        a[k].str = args[k - 1];
+        if (t == 'j') {
+            if (! st_ouvre(a[k].str, &a[k].vol)) {
+                goto end;
+            }
+            if ((a[k].vol.rs != vol.rs) || (a[k].vol.cs != vol.cs) ||
+                (a[k].vol.ds != vol.ds) || (a[k].vol.type != vol.type)) {
+                fprintf(stderr, "%s: %s: incompatible volume\n", F_NAME, a[k].str);
+                goto end;
+            }
+        } else if (t == 's') {
+            a[k].im = readse(a[k].str, &a[k].x, &a[k].y, &a[k].z);
+            if (a[k].im == NULL) {
+                fprintf(stderr, "%s: readse failed\n", F_NAME);
+                goto end;
+            }
+        } else if (t == 'm') {
+            a[k].im = readimage(a[k].str);
+            if (a[k].im == NULL) {
+                fprintf(stderr, "%s: readimage failed\n", F_NAME);
+                goto end;
+            }
+        } else if (t == 'c') {
+            if (strcmp(a[k].str, "norm") != 0) {
+                fprintf(stderr, "%s: usage: %s\n", F_NAME, op->usage);
+                goto end;
+            }
+        } else {
+            a[k].val = atof(a[k].str);
+        }
+    }
+    if ((op->halo == st_halo_deriche) && (a[1].val <= 0.0)) {
+        fprintf(stderr, "%s: alpha must be positive\n", F_NAME);
+        goto end;
+    }
+    h = (op->halo != NULL) ? op->halo(a, n) : 0;
+    if (vol.ds == 1) {
+        h = 0;
+    }
+
+    /* ---------------------------------------------------------- */
+    /* premiere passe : maximum global (comme linverse, a partir de 0) */
+    /* ---------------------------------------------------------- */
+    if (op->maxglobal && (vol.type != VFF_TYP_1_BYTE)) {
+        index_t x, N;
+        for (z0 = 0; z0 < vol.ds; z0 = z1) {
+            z1 = mcmin(z0 + nplans, vol.ds);
+            a[0].im = st_lit(&vol, z0, z1);
+            if (a[0].im == NULL) {
+                goto end;
+            }
+            N = rowsize(a[0].im) * colsize(a[0].im) * depth(a[0].im);
+            if (vol.type == VFF_TYP_4_BYTE) {
+                int32_t *F = SLONGDATA(a[0].im);
+                for (x = 0; x < N; x++) {
+                    if (F[x] > a[0].val) {
+                        a[0].val = F[x];
+                    }
+                }
+            } else {
+                float *F = FLOATDATA(a[0].im);
+                for (x = 0; x < N; x++) {
+                    if (F[x] > a[0].val) {
+                        a[0].val = F[x];
+                    }
+                }
+            }
+            freeimage(a[0].im);
+            a[0].im = NULL;
+        }
+    }
+
+    /* le resultat est ecrit a cote de outfile, qui peut etre un des volumes lus */
+    type = (op->type != 0) ? op->type : vol.type;
+    tmpfile = (char *)malloc(strlen(outfile) + 8);
+    if (tmpfile == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        goto end;
+    }
+    sprintf(tmpfile, "%s.XXXXXX", outfile);
+    tmpfd = mkstemp(tmpfile);
+    if (tmpfd < 0) {
+        fprintf(stderr, "%s: cannot create a file next to %s\n", F_NAME, outfile);
+        free(tmpfile);
+        tmpfile = NULL;
+        goto end;
+    }
+    masque = umask(0);
+    umask(masque);
+    (void)fchmod(tmpfd, 0666 & ~masque);
+    fd = fdopen(tmpfd, "wb");
+    if (fd == NULL) {
+        fprintf(stderr, "%s: cannot open file: %s\n", F_NAME, tmpfile);
+        close(tmpfd);
+        goto end;
+    }
+    st_entete(fd, type, &vol);
+
+    /* ---------------------------------------------------------- */
+    /* traitement par tranches */
+    /* ---------------------------------------------------------- */
+    for (z0 = 0; z0 < vol.ds; z0 = z1) {
+        z1 = mcmin(z0 + nplans, vol.ds);
+        za = mcmax(z0 - h, 0);
+        zb = mcmin(z1 + h, vol.ds);
+
+        a[0].im = st_lit(&vol, za, zb);
+        if (a[0].im == NULL) {
+            goto end;
+        }
+        for (k = 1; k < n; k++) {
+            if (op->args[k - 1] == 'j') {
+                a[k].im = st_lit(&a[k].vol, za, zb);
+                if (a[k].im == NULL) {
+                    goto end;
+                }
+            }
+        }
+
+        res = a[0].im;
+        a[0].im = NULL;
+        if (! op->fun(a, n, &res)) {
+            fprintf(stderr, "%s: operator %s failed\n", F_NAME, op->name);
+            if (res != NULL) {
+                freeimage(res);
+            }
+            goto end;
+        }
+        if ((datatype(res) != type) || (depth(res) != zb - za)) {
+            fprintf(stderr, "%s: operator %s: unexpected result\n", F_NAME, op->name);
+            freeimage(res);
+            goto end;
+        }
+
+        /* ecriture des plans centraux */
+        nw = (size_t)(z1 - z0) * (size_t)rowsize(res) * (size_t)colsize(res);
+        switch (type) {
+        case VFF_TYP_1_BYTE:
+            nw *= sizeof(uint8_t);
+            break;
+        case VFF_TYP_4_BYTE:
+            nw *= sizeof(int32_t);
+            break;
+        default:
+            nw *= sizeof(float);
+            break;
+        }
+        i = (fwrite((uint8_t *)res->image_data + (size_t)(z0 - za) * (nw / (size_t)(z1 - z0)),
+                    1, nw, fd) == nw);
+        freeimage(res);
+        for (k = 1; k < n; k++) {
+            if (op->args[k - 1] == 'j') {
+                freeimage(a[k].im);
+                a[k].im = NULL;
+            }
+        }
+        if (!i) {
+            fprintf(stderr, "%s: write error\n", F_NAME);
+            goto end;
+        }
+    } /* for z0 */
+    ret = 1;
+
+end:
+    if ((fd != NULL) && (fclose(fd) != 0) && ret) {
+        fprintf(stderr, "%s: write error\n", F_NAME);
+        ret = 0;
+    }
+    if (tmpfile != NULL) {
+        if (ret && (rename(tmpfile, outfile) != 0)) {
+            fprintf(stderr, "%s: cannot rename %s to %s\n", F_NAME, tmpfile, outfile);
+            ret = 0;
+        }
+        if (!ret) {
+            unlink(tmpfile);
+        }
+        free(tmpfile);
+    }
+    for (k = 1; k < n; k++) {
+        if (a[k].im != NULL) {
+            freeimage(a[k].im);
+        }
+        if (a[k].vol.fd != NULL) {
+            fclose(a[k].vol.fd);
+        }
+    }
+    if (a[0].im != NULL) {
+        freeimage(a[0].im);
+    }
+    fclose(vol.fd);
+    return ret;
+} /* lstream() */
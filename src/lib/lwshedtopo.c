@@ -60,8 +60,8 @@ Updates:
 #include <assert.h>
 
 int32_t lwshedtopobin_classic(xvimage* image, xvimage* marqueur_local, int32_t connex);
-static void compressTree(ctree *CT, int32_t *CM, int32_t *newCM, int32_t N);
-static void reconsTree(ctree *CT, int32_t *CM, int32_t *newCM, int32_t N, uint8_t *G);
+static void compressTree(ctree *CT, index_t *CM, index_t *newCM, index_t N);
+static void reconsTree(ctree *CT, index_t *CM, index_t *newCM, index_t N, uint8_t *G);
 
 #define EN_FAHS     0
 #define WATERSHED  1
@@ -84,13 +84,14 @@ static void reconsTree(ctree *CT, int32_t *CM, int32_t *newCM, int32_t N, uint8_
 //#define LCASLOW
 
 /* ==================================== */
-static int32_t TrouveComposantes(int32_t x, uint8_t *F, int32_t rs, int32_t ps, int32_t N, int32_t connex,
-                                 int32_t *CM, int32_t *tabcomp)
+static int32_t TrouveComposantes(index_t x, uint8_t *F, index_t rs, index_t ps, index_t N, int32_t connex,
+                                 index_t *CM, index_t *tabcomp)
 /* ==================================== */
 // variante sans simplification
 // place la plus haute composante (ou l'une des plus hautes) en premier
 {
-    int32_t k, y, n = 1, maxval = F[x], first = 1;
+    index_t y;
+    int32_t k, n = 1, maxval = F[x], first = 1;
 
     switch (connex) {
     case 4:
@@ -215,13 +216,13 @@ static int32_t TrouveComposantes(int32_t x, uint8_t *F, int32_t rs, int32_t ps,
 } // TrouveComposantes()
 
 #ifdef __GNUC__
-static int32_t LowComAncSlow(ctree * CT, int32_t c1, int32_t c2) __attribute__ ((unused));
+static index_t LowComAncSlow(ctree * CT, index_t c1, index_t c2) __attribute__ ((unused));
 #endif
 /* ==================================== */
-static int32_t LowComAncSlow(
+static index_t LowComAncSlow(
     ctree * CT,
-    int32_t c1,
-    int32_t c2)
+    index_t c1,
+    index_t c2)
 /* Retourne le plus proche commun ancetre des cellules c1,c2
    Utilise le champ "flags".
 */
@@ -229,7 +230,7 @@ static int32_t LowComAncSlow(
 #undef F_NAME
 #define F_NAME "LowComAncSlow"
 {
-    int32_t x, lca = -1;
+    index_t x, lca = -1;
 
     x = c1;
     do {
@@ -270,8 +271,8 @@ static int32_t LowComAncSlow(
 //
 
 // Depth-first preprocessing
-int32_t LCApreprocessDepthFirst(ctree *CT, int32_t node, int32_t depth, int32_t *nbr, int32_t *rep, int32_t *Euler, int32_t *Represent, int32_t *Depth, int32_t *Number) {
-    int32_t son;
+index_t LCApreprocessDepthFirst(ctree *CT, index_t node, index_t depth, index_t *nbr, index_t *rep, index_t *Euler, index_t *Represent, index_t *Depth, index_t *Number) {
+    index_t son;
     soncell * sc = NULL;
 
     if (CT->tabnodes[node].nbsons > -1) {
@@ -291,17 +292,18 @@ int32_t LCApreprocessDepthFirst(ctree *CT, int32_t node, int32_t depth, int32_t
     return *nbr;
 }
 
-int32_t ** LCApreprocess(ctree *CT,   int32_t *Euler, int32_t *Depth, int32_t *Represent, int32_t *Number, int32_t *nbR, int32_t *lognR)
+index_t ** LCApreprocess(ctree *CT,   index_t *Euler, index_t *Depth, index_t *Represent, index_t *Number, index_t *nbR, int32_t *lognR)
 #undef F_NAME
 #define F_NAME "LCApreprocess"
 {
     //O(n.log(n)) preprocessing
-    int32_t nbr, rep, nbNodes;
-    int32_t nbRepresent;
+    index_t nbr, rep, nbNodes;
+    index_t nbRepresent;
     int32_t logn;
-    int32_t i,j,k1,k2;
-    int32_t * minim = NULL;
-    int32_t **Minim = NULL;
+    index_t i,k1,k2;
+    int32_t j;
+    index_t * minim = NULL;
+    index_t **Minim = NULL;
 
     nbr = -1; // Initialization number of euler nodes
     rep = 0;
@@ -315,7 +317,7 @@ int32_t ** LCApreprocess(ctree *CT,   int32_t *Euler, int32_t *Depth, int32_t *R
 
     // Check that the number of nodes in the tree was correct
 #ifdef _DEBUG_
-    printf("rep = %d, nbr = %d, nbnodes = %d, 2*nbnodes = %d\n", rep, nbr, nbNodes, 2*nbNodes);
+    printf("rep = %d, nbr = %d, nbnodes = %d, 2*nbnodes = %d\n", (int32_t)rep, (int32_t)nbr, (int32_t)nbNodes, (int32_t)(2*nbNodes));
 #endif
     assert((nbr+1) == (2*nbNodes-1));
 
@@ -324,8 +326,8 @@ int32_t ** LCApreprocess(ctree *CT,   int32_t *Euler, int32_t *Depth, int32_t *R
     *nbR = nbRepresent;
     *lognR = logn;
 
-    minim = (int32_t *)calloc(logn*nbRepresent, sizeof(int32_t));
-    Minim = (int32_t **)calloc(logn, sizeof(int32_t*));
+    minim = (index_t *)calloc(logn*nbRepresent, sizeof(index_t));
+    Minim = (index_t **)calloc(logn, sizeof(index_t*));
     if ((minim == NULL) || (Minim == NULL)) {
         fprintf(stderr, "%s : malloc failed\n", F_NAME);
         return NULL;
@@ -342,7 +344,7 @@ int32_t ** LCApreprocess(ctree *CT,   int32_t *Euler, int32_t *Depth, int32_t *R
     Minim[0][nbRepresent-1] = nbRepresent-1;
 
     for (j=1; j<logn; j++) {
-        k1 = 1<<(j-1);
+        k1 = (index_t)1<<(j-1);
         k2 = k1<<1;
         Minim[j] = &minim[j*nbRepresent];
         for (i=0; i<nbRepresent; i++) {
@@ -358,20 +360,21 @@ int32_t ** LCApreprocess(ctree *CT,   int32_t *Euler, int32_t *Depth, int32_t *R
         }
     }
 #ifdef _DEBUG_
-    for (i=0; i<logn; i++) {
-        for (j=0; j<nbRepresent; j++)
-            printf("M[%d][%d] = %d - ", i, j, Minim[i][j]);
+    for (j=0; j<logn; j++) {
+        for (i=0; i<nbRepresent; i++)
+            printf("M[%d][%d] = %d - ", j, (int32_t)i, (int32_t)Minim[j][i]);
         printf("\n");
     }
 #endif
     return Minim;
 }
 
-int32_t LowComAncFast(int32_t n1, int32_t n2, int32_t *Euler, int32_t *Number, int32_t *Depth, int32_t **Minim)
+index_t LowComAncFast(index_t n1, index_t n2, index_t *Euler, index_t *Number, index_t *Depth, index_t **Minim)
 #undef F_NAME
 #define F_NAME "LowComAncFast"
 {
-    int32_t ii, jj, kk, k;
+    index_t ii, jj, kk;
+    int32_t k;
 
     ii = Number[n1];
     jj = Number[n2];
@@ -387,19 +390,19 @@ int32_t LowComAncFast(int32_t n1, int32_t n2, int32_t *Euler, int32_t *Number, i
 
     k = (int32_t)(log((double)(jj - ii))/log(2.));
 
-    if (Depth[Euler[Minim[k][ii]]] < Depth[Euler[Minim[k][jj-(1<<(k))]]]) {
+    if (Depth[Euler[Minim[k][ii]]] < Depth[Euler[Minim[k][jj-((index_t)1<<k)]]]) {
         return Number[Euler[Minim[k][ii]]];
     } else {
-        return Number[Euler[Minim[k][jj-(1<<k)]]];
+        return Number[Euler[Minim[k][jj-((index_t)1<<k)]]];
     }
 }
 
 /* ==================================== */
-static void W_Constructible(int32_t x, uint8_t *F, int32_t rs, int32_t ps, int32_t N, int32_t connex,
-                            ctree *CT, int32_t *CM, int32_t *tabcomp,
-                            int32_t *c, int32_t *lcalevel
+static void W_Constructible(index_t x, uint8_t *F, index_t rs, index_t ps, index_t N, int32_t connex,
+                            ctree *CT, index_t *CM, index_t *tabcomp,
+                            index_t *c, int32_t *lcalevel
 #ifndef LCASLOW
-                            , int32_t *Euler, int32_t *Represent, int32_t *Depth, int32_t *Number, int32_t **Minim
+                            , index_t *Euler, index_t *Represent, index_t *Depth, index_t *Number, index_t **Minim
 #endif
                            )
 
@@ -408,7 +411,8 @@ static void W_Constructible(int32_t x, uint8_t *F, int32_t rs, int32_t ps, int32
 // à laquelle x peut être ajouté.
 // Sinon la valeur retournée dans c est -1
 {
-    int32_t c1, k, ncomp = TrouveComposantes(x, F, rs, ps, N, connex, CM, tabcomp);
+    index_t c1;
+    int32_t k, ncomp = TrouveComposantes(x, F, rs, ps, N, connex, CM, tabcomp);
 
     if (ncomp > 0) {
         if (ncomp == 1) {
@@ -437,7 +441,7 @@ static void W_Constructible(int32_t x, uint8_t *F, int32_t rs, int32_t ps, int32
 
 /* ==================================== */
 static void Watershed(struct xvimage *image, int32_t connex,
-                      Fahs * FAHS, int32_t *CM, ctree * CT)
+                      Fahs * FAHS, IndicsCtx * Ind, index_t *CM, ctree * CT)
 /* ==================================== */
 //
 // inondation a partir des voisins des maxima, suivant les ndg decroissants
@@ -448,27 +452,29 @@ static void Watershed(struct xvimage *image, int32_t connex,
 #define F_NAME "Watershed"
 {
     uint8_t *F = UCHARDATA(image);
-    int32_t rs = rowsize(image);
-    int32_t ps = rs * colsize(image);
-    int32_t N = ps * depth(image);
-    int32_t i, k, x, y;
-    int32_t c;                        /* une composante */
-    int32_t tabcomp[26];              /* liste de composantes */
+    index_t rs = rowsize(image);
+    index_t ps = rs * colsize(image);
+    index_t N = ps * depth(image);
+    index_t i, x, y;
+    int32_t k;
+    index_t c;                        /* une composante */
+    index_t tabcomp[26];              /* liste de composantes */
     int32_t nbelev;                   /* nombre d'elevations effectuees */
     int32_t lcalevel;                 /* niveau du lca */
     int32_t incr_vois;
 #ifndef LCASLOW
-    int32_t logn, nbRepresent;
-    int32_t *Euler, *Depth, *Represent, *Number, **Minim;
+    int32_t logn;
+    index_t nbRepresent;
+    index_t *Euler, *Depth, *Represent, *Number, **Minim;
 #endif
     // INITIALISATIONS
     FahsFlush(FAHS); // Re-initialise la FAHS
 
 #ifndef LCASLOW
-    Euler = (int32_t *)calloc(2*CT->nbnodes-1, sizeof(int32_t));
-    Represent = (int32_t *)calloc(CT->nbnodes, sizeof(int32_t));
-    Depth = (int32_t *)calloc(CT->nbnodes, sizeof(int32_t));
-    Number = (int32_t *)calloc(CT->nbnodes, sizeof(int32_t));
+    Euler = (index_t *)calloc(2*CT->nbnodes-1, sizeof(index_t));
+    Represent = (index_t *)calloc(CT->nbnodes, sizeof(index_t));
+    Depth = (index_t *)calloc(CT->nbnodes, sizeof(index_t));
+    Number = (index_t *)calloc(CT->nbnodes, sizeof(index_t));
     if ((Euler == NULL) || (Represent == NULL)
             || (Depth == NULL) || (Number == NULL)) {
         fprintf(stderr, "%s : malloc failed\n", F_NAME);
@@ -479,7 +485,7 @@ static void Watershed(struct xvimage *image, int32_t connex,
 #ifdef _DEBUG_
     printf("Comparison Slow/Fast lca\n");
     {
-        int32_t i,j, anc;
+        index_t i,j, anc;
         int32_t nbErrors = 0;
         for (i=0; i<CT->nbnodes; i++)
             for (j=0; j<CT->nbnodes; j++) {
@@ -487,9 +493,9 @@ static void Watershed(struct xvimage *image, int32_t connex,
                     anc = Represent[LowComAncFast(i,j,Euler,Number,Depth,Minim)];
                     if (anc != LowComAncSlow(CT,i,j)) {
                         nbErrors++;
-                        printf("Error node lca(%d, %d) = %d ou %d ?\n", i, j, anc, LowComAncSlow(CT,i,j));
+                        printf("Error node lca(%d, %d) = %d ou %d ?\n", (int32_t)i, (int32_t)j, (int32_t)anc, (int32_t)LowComAncSlow(CT,i,j));
                     } else {
-                        printf("Ok node lca(%d, %d) = %d\n", i, j, anc);
+                        printf("Ok node lca(%d, %d) = %d\n", (int32_t)i, (int32_t)j, (int32_t)anc);
                     }
                 }
             }
@@ -512,7 +518,7 @@ static void Watershed(struct xvimage *image, int32_t connex,
     for (i = 0; i < N; i++) {
         c = CM[i];
         if (CT->tabnodes[c].nbsons == 0) {
-            Set(i,MASSIF);
+            IndSet(Ind, i,MASSIF);
         }
     } // for (i = 0; i < N; i++)
 
@@ -520,7 +526,7 @@ static void Watershed(struct xvimage *image, int32_t connex,
     for (i = 0; i < N; i++) {
 #ifdef OLDVERSION
         // empile tous les points
-        Set(i,EN_FAHS);
+        IndSet(Ind, i,EN_FAHS);
         FahsPush(FAHS, i, NDG_MAX - F[i]);
 #else
         // empile les points voisins d'un minima
@@ -530,7 +536,7 @@ static void Watershed(struct xvimage *image, int32_t connex,
         case 8:
             for (k = 0; (k < 8) && (flag == 0); k += incr_vois) {
                 y = voisin(i, k, rs, N);
-                if ((y != -1) && (IsSet(y,MASSIF))) {
+                if ((y != -1) && (IndIsSet(Ind, y,MASSIF))) {
                     flag = 1;
                 }
             }
@@ -538,7 +544,7 @@ static void Watershed(struct xvimage *image, int32_t connex,
         case 6:
             for (k = 0; k <= 10; k += 2) {
                 y = voisin6(i, k, rs, ps, N);
-                if ((y != -1) && (IsSet(y,MASSIF))) {
+                if ((y != -1) && (IndIsSet(Ind, y,MASSIF))) {
                     flag = 1;
                 }
             }
@@ -546,7 +552,7 @@ static void Watershed(struct xvimage *image, int32_t connex,
         case 18:
             for (k = 0; k < 18; k += 1) {
                 y = voisin18(i, k, rs, ps, N);
-                if ((y != -1) && (IsSet(y,MASSIF))) {
+                if ((y != -1) && (IndIsSet(Ind, y,MASSIF))) {
                     flag = 1;
                 }
             }
@@ -554,14 +560,14 @@ static void Watershed(struct xvimage *image, int32_t connex,
         case 26:
             for (k = 0; k < 26; k += 1) {
                 y = voisin26(i, k, rs, ps, N);
-                if ((y != -1) && (IsSet(y,MASSIF))) {
+                if ((y != -1) && (IndIsSet(Ind, y,MASSIF))) {
                     flag = 1;
                 }
             }
             break;
         } /* switch (connex) */
         if (flag) {
-            Set(i,EN_FAHS);
+            IndSet(Ind, i,EN_FAHS);
             FahsPush(FAHS, i, NDG_MAX - F[i]);
         }
 #endif
@@ -572,7 +578,7 @@ static void Watershed(struct xvimage *image, int32_t connex,
     nbelev = 0;
     while (!FahsVide(FAHS)) {
         x = FahsPop(FAHS);
-        UnSet(x,EN_FAHS);
+        IndUnSet(Ind, x,EN_FAHS);
         W_Constructible(x, F, rs, ps, N, connex, CT, CM, tabcomp, &c, &lcalevel
 #ifndef LCASLOW
                         , Euler, Represent, Depth, Number, Minim
@@ -582,9 +588,9 @@ static void Watershed(struct xvimage *image, int32_t connex,
             nbelev++;
             F[x] = lcalevel;      // eleve le niveau du point x
             CM[x] = c;            // maj pointeur image -> composantes
-            Set(x,MODIFIE);
+            IndSet(Ind, x,MODIFIE);
             if (CT->tabnodes[c].nbsons == 0) { // feuille
-                Set(x,MASSIF);
+                IndSet(Ind, x,MASSIF);
             } // if feuille
             else if (CT->tabnodes[c].nbsons > 1) { // noeud
             }
@@ -598,8 +604,8 @@ static void Watershed(struct xvimage *image, int32_t connex,
             case 8:
                 for (k = 0; k < 8; k += incr_vois) {
                     y = voisin(x, k, rs, N);
-                    if ((y != -1) && (!IsSet(y,MASSIF)) && (!IsSet(y,EN_FAHS))) {
-                        Set(y,EN_FAHS);
+                    if ((y != -1) && (!IndIsSet(Ind, y,MASSIF)) && (!IndIsSet(Ind, y,EN_FAHS))) {
+                        IndSet(Ind, y,EN_FAHS);
                         FahsPush(FAHS, y, NDG_MAX - F[y]);
                     }
                 }
@@ -607,8 +613,8 @@ static void Watershed(struct xvimage *image, int32_t connex,
             case 6:
                 for (k = 0; k <= 10; k += 2) {
                     y = voisin6(x, k, rs, ps, N);
-                    if ((y != -1) && (!IsSet(y,MASSIF)) && (!IsSet(y,EN_FAHS))) {
-                        Set(y,EN_FAHS);
+                    if ((y != -1) && (!IndIsSet(Ind, y,MASSIF)) && (!IndIsSet(Ind, y,EN_FAHS))) {
+                        IndSet(Ind, y,EN_FAHS);
                         FahsPush(FAHS, y, NDG_MAX - F[y]);
                     }
                 }
@@ -616,8 +622,8 @@ static void Watershed(struct xvimage *image, int32_t connex,
             case 18:
                 for (k = 0; k < 18; k += 1) {
                     y = voisin18(x, k, rs, ps, N);
-                    if ((y != -1) && (!IsSet(y,MASSIF)) && (!IsSet(y,EN_FAHS))) {
-                        Set(y,EN_FAHS);
+                    if ((y != -1) && (!IndIsSet(Ind, y,MASSIF)) && (!IndIsSet(Ind, y,EN_FAHS))) {
+                        IndSet(Ind, y,EN_FAHS);
                         FahsPush(FAHS, y, NDG_MAX - F[y]);
                     }
                 }
@@ -625,8 +631,8 @@ static void Watershed(struct xvimage *image, int32_t connex,
             case 26:
                 for (k = 0; k < 26; k += 1) {
                     y = voisin26(x, k, rs, ps, N);
-                    if ((y != -1) && (!IsSet(y,MASSIF)) && (!IsSet(y,EN_FAHS))) {
-                        Set(y,EN_FAHS);
+                    if ((y != -1) && (!IndIsSet(Ind, y,MASSIF)) && (!IndIsSet(Ind, y,EN_FAHS))) {
+                        IndSet(Ind, y,EN_FAHS);
                         FahsPush(FAHS, y, NDG_MAX - F[y]);
                     }
                 }
@@ -660,15 +666,16 @@ int32_t lwshedtopo_lwshedtopo(struct xvimage *image, int32_t connex)
 #undef F_NAME
 #define F_NAME "lwshedtopo_lwshedtopo"
 {
-    register int32_t i;      /* index muet */
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    register index_t i;      /* index muet */
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);      /* l'image de depart */
     Fahs * FAHS;                    /* la file d'attente hierarchique */
-    int32_t *CM, *newCM;               /* etat d'un pixel */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
+    index_t *CM, *newCM;               /* etat d'un pixel */
     ctree * CT;                   /* resultat : l'arbre des composantes */
 
     FAHS = CreeFahsVide(N);
@@ -679,29 +686,42 @@ int32_t lwshedtopo_lwshedtopo(struct xvimage *image, int32_t connex)
     if ((connex == 4) || (connex == 8)) {
         if (!ComponentTree(F, rs, N, connex, &CT, &CM)) {
             fprintf(stderr, "%s() : ComponentTree failed\n", F_NAME);
+            FahsTermine(FAHS);
             return 0;
         }
     } else if ((connex == 6) || (connex == 18) || (connex == 26)) {
         if (!ComponentTree3d(F, rs, ps, N, connex, &CT, &CM)) {
             fprintf(stderr, "%s() : ComponentTree failed\n", F_NAME);
+            FahsTermine(FAHS);
             return 0;
         }
     } else {
         fprintf(stderr, "%s() : bad value for connex : %d\n", F_NAME, connex);
+        FahsTermine(FAHS);
         return 0;
     }
 #ifndef OLDVERSION
-    newCM = (int32_t *)calloc(CT->nbnodes, sizeof(int32_t));
+    newCM = (index_t *)calloc(CT->nbnodes, sizeof(index_t));
     if (newCM == NULL) {
         fprintf(stderr, "%s : malloc failed\n", F_NAME);
+        FahsTermine(FAHS);
+        ComponentTreeFree(CT);
+        free(CM);
         return 0;
     }
     compressTree(CT, CM, newCM, N);
     free(newCM);
 #endif
 
-    IndicsInit(N);
-    Watershed(image, connex, FAHS, CM, CT);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        FahsTermine(FAHS);
+        ComponentTreeFree(CT);
+        free(CM);
+        return(0);
+    }
+    Watershed(image, connex, FAHS, Ind, CM, CT);
     for (i = 0; i < N; i++) {
         F[i] = CT->tabnodes[CM[i]].data;
     }
@@ -710,7 +730,7 @@ int32_t lwshedtopo_lwshedtopo(struct xvimage *image, int32_t connex)
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahsTermine(FAHS);
     ComponentTreeFree(CT);
     free(CM);
@@ -718,19 +738,19 @@ int32_t lwshedtopo_lwshedtopo(struct xvimage *image, int32_t connex)
 } /* lwshedtopo_lwshedtopo() */
 
 /* ==================================== */
-static void Reconstruction(struct xvimage *g, struct xvimage *f, int32_t *CM, ctree * CT)
+static void Reconstruction(struct xvimage *g, struct xvimage *f, index_t *CM, ctree * CT)
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "Reconstruction"
 {
     uint8_t *F = UCHARDATA(f);
     uint8_t *G = UCHARDATA(g);
-    int32_t rs = rowsize(f);      /* taille ligne */
-    int32_t cs = colsize(f);      /* taille colonne */
-    int32_t ds = depth(f);        /* nb plans */
-    int32_t ps = rs * cs;         /* taille plan */
-    int32_t N = ps * ds;          /* taille image */
-    int32_t i, c, d;
+    index_t rs = rowsize(f);      /* taille ligne */
+    index_t cs = colsize(f);      /* taille colonne */
+    index_t ds = depth(f);        /* nb plans */
+    index_t ps = rs * cs;         /* taille plan */
+    index_t N = ps * ds;          /* taille image */
+    index_t i, c, d;
 
     for (i = 0; i < N; i++) {
         if (G[i] >= F[i]) {
@@ -774,11 +794,11 @@ int32_t lwshedtopo_lreconsdilat(
 #undef F_NAME
 #define F_NAME "lwshedtopo_lreconsdilat"
     uint8_t *F = UCHARDATA(f);
-    int32_t rs = rowsize(f);      /* taille ligne */
-    int32_t cs = colsize(f);      /* taille colonne */
-    int32_t ds = depth(f);        /* nb plans */
-    int32_t N = rs * cs * ds;
-    int32_t *CM;     // component mapping
+    index_t rs = rowsize(f);      /* taille ligne */
+    index_t cs = colsize(f);      /* taille colonne */
+    index_t ds = depth(f);        /* nb plans */
+    index_t N = rs * cs * ds;
+    index_t *CM;     // component mapping
     ctree * CT;  // component tree
 
     if ((rowsize(g) != rs) || (colsize(g) != cs) || (depth(g) != ds)) {
@@ -808,11 +828,12 @@ int32_t lreconseros(
 {
 #undef F_NAME
 #define F_NAME "lreconseros"
-    int32_t ret, i;
-    int32_t rs = rowsize(f);      /* taille ligne */
-    int32_t cs = colsize(f);      /* taille colonne */
-    int32_t ds = depth(f);        /* nb plans */
-    int32_t N = rs * cs * ds;
+    int32_t ret;
+    index_t i;
+    index_t rs = rowsize(f);      /* taille ligne */
+    index_t cs = colsize(f);      /* taille colonne */
+    index_t ds = depth(f);        /* nb plans */
+    index_t N = rs * cs * ds;
     uint8_t *F = UCHARDATA(f);
     uint8_t *G = UCHARDATA(g);
     if ((rowsize(g) != rs) || (colsize(g) != cs) || (depth(g) != ds)) {
@@ -834,8 +855,8 @@ int32_t lreconseros(
 } /* lreconseros() */
 
 
-static void reconsTree(ctree *CT, int32_t *CM, int32_t *newCM, int32_t N, uint8_t *G) {
-    int32_t d, c, e, i;
+static void reconsTree(ctree *CT, index_t *CM, index_t *newCM, index_t N, uint8_t *G) {
+    index_t d, c, e, i;
 
 #ifdef _DEBUG_
     printf("Reconstruction - Marquage\n");
@@ -920,10 +941,10 @@ static void reconsTree(ctree *CT, int32_t *CM, int32_t *newCM, int32_t N, uint8_
     }
 }
 
-static void compressTree(ctree *CT, int32_t *CM, int32_t *newCM, int32_t N) {
+static void compressTree(ctree *CT, index_t *CM, index_t *newCM, index_t N) {
     // Compress the component tree
     // suppress all nodes that have only one son
-    int32_t i, d, c, e, f;
+    index_t i, d, c, e, f;
 
     //ComponentTreePrint(CT);
     for (d = 0; d < CT->nbnodes; d++) {
@@ -946,7 +967,7 @@ static void compressTree(ctree *CT, int32_t *CM, int32_t *newCM, int32_t N) {
                     }
 #ifdef PARANO
                     if (sc != NULL)
-                        if (sc->son != e) printf("Compress Erreur %d != %d\n", sc->son, e);
+                        if (sc->son != e) printf("Compress Erreur %d != %d\n", (int32_t)sc->son, (int32_t)e);
 #endif
                     CT->tabnodes[e].father = f;
                     CT->tabnodes[c].nbsons = -3;
@@ -1014,16 +1035,17 @@ int32_t lwshedtopobin_classic(struct xvimage *image, struct xvimage *marqueur, i
 #undef F_NAME
 #define F_NAME "lwshedtopobin_classic"
 {
-    register int32_t i, x;      /* index muet */
-    int32_t rs = rowsize(image);      /* taille ligne */
-    int32_t cs = colsize(image);      /* taille colonne */
-    int32_t ds = depth(image);        /* nb plans */
-    int32_t ps = rs * cs;             /* taille plan */
-    int32_t N = ps * ds;              /* taille image */
+    register index_t i, x;      /* index muet */
+    index_t rs = rowsize(image);      /* taille ligne */
+    index_t cs = colsize(image);      /* taille colonne */
+    index_t ds = depth(image);        /* nb plans */
+    index_t ps = rs * cs;             /* taille plan */
+    index_t N = ps * ds;              /* taille image */
     uint8_t *F = UCHARDATA(image);
     uint8_t *G = UCHARDATA(marqueur);
     Fahs * FAHS;                    /* la file d'attente hierarchique */
-    int32_t *CM, *newCM;              /* etat d'un pixel */
+    IndicsCtx *Ind;                   /* les indicateurs (propres a cet appel) */
+    index_t *CM, *newCM;              /* etat d'un pixel */
     ctree * CT;                   /* resultat : l'arbre des composantes */
 
     if ((datatype(image) != VFF_TYP_1_BYTE) || (datatype(marqueur) != VFF_TYP_1_BYTE)) {
@@ -1042,7 +1064,12 @@ int32_t lwshedtopobin_classic(struct xvimage *image, struct xvimage *marqueur, i
         return 0;
     }
 
-    IndicsInit(N);
+    Ind = CreeIndics(N);
+    if (Ind == NULL) {
+        fprintf(stderr, "%s : CreeIndics failed\n", F_NAME);
+        FahsTermine(FAHS);
+        return(0);
+    }
     // imposition des maxima
     for (i = 0; i < N; i++) {
         if (G[i]) {
@@ -1056,15 +1083,21 @@ int32_t lwshedtopobin_classic(struct xvimage *image, struct xvimage *marqueur, i
     if ((connex == 4) || (connex == 8)) {
         if (!ComponentTree(F, rs, N, connex, &CT, &CM)) {
             fprintf(stderr, "%s() : ComponentTree failed\n", F_NAME);
+            IndicsCtxTermine(Ind);
+            FahsTermine(FAHS);
             return 0;
         }
     } else if ((connex == 6) || (connex == 18) || (connex == 26)) {
         if (!ComponentTree3d(F, rs, ps, N, connex, &CT, &CM)) {
             fprintf(stderr, "%s() : ComponentTree failed\n", F_NAME);
+            IndicsCtxTermine(Ind);
+            FahsTermine(FAHS);
             return 0;
         }
     } else {
         fprintf(stderr, "%s() : bad value for connex : %d\n", F_NAME, connex);
+        IndicsCtxTermine(Ind);
+        FahsTermine(FAHS);
         return 0;
     }
 
@@ -1082,25 +1115,33 @@ int32_t lwshedtopobin_classic(struct xvimage *image, struct xvimage *marqueur, i
     if ((connex == 4) || (connex == 8)) {
         if (!ComponentTree(G, rs, N, connex, &CT, &CM)) {
             fprintf(stderr, "%s() : ComponentTree failed\n", F_NAME);
+            IndicsCtxTermine(Ind);
+            FahsTermine(FAHS);
             return 0;
         }
     } else {
         if (!ComponentTree3d(G, rs, ps, N, connex, &CT, &CM)) {
             fprintf(stderr, "%s() : ComponentTree failed\n", F_NAME);
+            IndicsCtxTermine(Ind);
+            FahsTermine(FAHS);
             return 0;
         }
     }
 
-    Watershed(marqueur, connex, FAHS, CM, CT);
+    Watershed(marqueur, connex, FAHS, Ind, CM, CT);
 #endif // #ifdef OLDVERSIONBIN
 
 #ifndef OLDVERSIONBIN
 #ifdef _DEBUG_
     printf("Reconstruction - par arbre\n");
 #endif
-    newCM = (int32_t *)calloc(CT->nbnodes, sizeof(int32_t));
+    newCM = (index_t *)calloc(CT->nbnodes, sizeof(index_t));
     if (newCM == NULL) {
         fprintf(stderr, "%s : malloc failed\n", F_NAME);
+        IndicsCtxTermine(Ind);
+        FahsTermine(FAHS);
+        ComponentTreeFree(CT);
+        free(CM);
         return 0;
     }
     reconsTree(CT, CM, newCM, N, G);
@@ -1122,7 +1163,7 @@ int32_t lwshedtopobin_classic(struct xvimage *image, struct xvimage *marqueur, i
     }
     */
 
-    Watershed(image, connex, FAHS, CM, CT);
+    Watershed(image, connex, FAHS, Ind, CM, CT);
 #endif // ifndef OLDVERSIONBIN
 
 #ifdef _DEBUG_
@@ -1144,7 +1185,7 @@ int32_t lwshedtopobin_classic(struct xvimage *image, struct xvimage *marqueur, i
     /* UN PEU DE MENAGE                                 */
     /* ================================================ */
 
-    IndicsTermine();
+    IndicsCtxTermine(Ind);
     FahsTermine(FAHS);
     ComponentTreeFree(CT);
     free(CM);
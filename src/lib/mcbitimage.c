@@ -0,0 +1,595 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Librairie mcbitimage :
+
+   images binaires compactees (un bit par pixel, 64 pixels par mot de
+   64 bits) et operateurs morphologiques sur ces images.
+
+   La dilatation d'une ligne par une ligne de l'element structurant est
+   une suite de decalages de mots et de OU logiques, qui traitent 64 pixels
+   a la fois. Les points de l'e.s. sont regroupes par ligne (dy,dz), et
+   chaque ligne de l'e.s. est decomposee en segments [a, a+L-1] : la
+   dilatation par un segment de longueur L est obtenue par doublements
+   successifs (log2(L) decalages), puis decalee de a.
+
+   Les boucles internes portent sur des tableaux de mots contigus, sans
+   dependance entre iterations, et sont vectorisables par le compilateur.
+   Les lignes de l'image resultat sont reparties entre les threads
+   (mcthreads).
+
+   Conventions (identiques a celles de ldilateros_ldilatbin et
+   ldilateros_lerosbin) :
+   dilatation : D(q) = 1 ssi il existe m dans M tel que q - (m - c) soit
+                dans X ; les points hors de l'image sont hors de X.
+   erosion    : dual de la dilatation, E = non D(non X) ; les points hors
+                de l'image sont dans X.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <mcutil.h>
+#include <mcthreads.h>
+#include <mcbitimage.h>
+
+typedef struct {
+    uint64_t *S;                     /* image source */
+    uint64_t *D;                     /* image resultat */
+    index_t cs, ds, wpr;
+    index_t nw;                      /* nombre de mots d'un tableau de travail */
+    uint64_t lastmask;               /* bits valides du dernier mot d'une ligne */
+    int32_t ng;                      /* nombre de lignes de l'e.s. */
+    int32_t *gdy, *gdz;              /* decalages des lignes de l'e.s. */
+    int32_t *gfirst;                 /* segments de la ligne g : gfirst[g] a gfirst[g+1]-1 */
+    int32_t *sa, *sl;                /* segments : decalage de depart et longueur */
+    uint64_t *work;                  /* tableaux de travail des threads */
+    int32_t nbands;
+} mcbit_job;
+
+/* ==================================== */
+static uint64_t mcbit_lastmask(index_t rs)
+/* ==================================== */
+{
+    int32_t r = (int32_t)(rs & 63);
+    return r ? (((uint64_t)1 << r) - 1) : ~(uint64_t)0;
+} /* mcbit_lastmask() */
+
+/* ==================================== */
+mcbitimage * mcbit_allocimage(index_t rs, index_t cs, index_t ds)
+/* ==================================== */
+#undef F_NAME
+#define F_NAME "mcbit_allocimage"
+{
+    mcbitimage *b = (mcbitimage *)malloc(sizeof(mcbitimage));
+    if (b == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return NULL;
+    }
+    b->rs = rs;
+    b->cs = cs;
+    b->ds = ds;
+    b->wpr = (rs + 63) / 64;
+    b->data = (uint64_t *)calloc(b->wpr * cs * ds + 1, sizeof(uint64_t));
+    if (b->data == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(b);
+        return NULL;
+    }
+    return b;
+} /* mcbit_allocimage() */
+
+/* ==================================== */
+void mcbit_freeimage(mcbitimage *b)
+/* ==================================== */
+{
+    if (b == NULL) {
+        return;
+    }
+    free(b->data);
+    free(b);
+} /* mcbit_freeimage() */
+
+/* ==================================== */
+mcbitimage * mcbit_pack(struct xvimage *f)
+/* ==================================== */
+/* image compactee : bit a 1 pour les points non nuls de f */
+#undef F_NAME
+#define F_NAME "mcbit_pack"
+{
+    index_t rs = rowsize(f), cs = colsize(f), ds = depth(f);
+    index_t l, i, x, xmax;
+    uint8_t *F = UCHARDATA(f);
+    uint64_t *B, w;
+    mcbitimage *b;
+
+    ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
+    b = mcbit_allocimage(rs, cs, ds);
+    if (b == NULL) {
+        return NULL;
+    }
+    for (l = 0; l < cs * ds; l++, F += rs) {
+        B = b->data + l * b->wpr;
+        for (i = 0; i < b->wpr; i++) {
+            xmax = mcmin(rs - 64 * i, 64);
+            w = 0;
+            for (x = 0; x < xmax; x++) {
+                w |= (uint64_t)(F[64 * i + x] != 0) << x;
+            }
+            B[i] = w;
+        }
+    }
+    return b;
+} /* mcbit_pack() */
+
+/* ==================================== */
+int32_t mcbit_unpack(mcbitimage *b, struct xvimage *f)
+/* ==================================== */
+/* f recoit l'image b : NDG_MAX pour les bits a 1, NDG_MIN sinon */
+#undef F_NAME
+#define F_NAME "mcbit_unpack"
+{
+    index_t rs = b->rs, l, i, x, xmax;
+    uint8_t *F = UCHARDATA(f);
+    uint64_t *B, w;
+
+    ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
+    if ((rowsize(f) != b->rs) || (colsize(f) != b->cs) || (depth(f) != b->ds)) {
+        fprintf(stderr, "%s: incompatible image sizes\n", F_NAME);
+        return 0;
+    }
+    for (l = 0; l < b->cs * b->ds; l++, F += rs) {
+        B = b->data + l * b->wpr;
+        for (i = 0; i < b->wpr; i++) {
+            xmax = mcmin(rs - 64 * i, 64);
+            w = B[i];
+            for (x = 0; x < xmax; x++) {
+                F[64 * i + x] = ((w >> x) & 1) ? NDG_MAX : NDG_MIN;
+            }
+        }
+    }
+    return 1;
+} /* mcbit_unpack() */
+
+/* ==================================== */
+int32_t mcbit_unpackmin(mcbitimage *b, struct xvimage *f)
+/* ==================================== */
+/* met a NDG_MIN les points de f dont le bit est nul, les autres sont inchanges */
+#undef F_NAME
+#define F_NAME "mcbit_unpackmin"
+{
+    index_t rs = b->rs, l, i, x, xmax;
+    uint8_t *F = UCHARDATA(f);
+    uint64_t *B, w;
+
+    ACCEPTED_TYPES1(f, VFF_TYP_1_BYTE);
+    if ((rowsize(f) != b->rs) || (colsize(f) != b->cs) || (depth(f) != b->ds)) {
+        fprintf(stderr, "%s: incompatible image sizes\n", F_NAME);
+        return 0;
+    }
+    for (l = 0; l < b->cs * b->ds; l++, F += rs) {
+        B = b->data + l * b->wpr;
+        for (i = 0; i < b->wpr; i++) {
+            xmax = mcmin(rs - 64 * i, 64);
+            w = B[i];
+            if (w == ~(uint64_t)0) {
+                continue;
+            }
+            for (x = 0; x < xmax; x++) {
+                if (!((w >> x) & 1)) {
+                    F[64 * i + x] = NDG_MIN;
+                }
+            }
+        }
+    }
+    return 1;
+} /* mcbit_unpackmin() */
+
+/* ==================================== */
+int32_t mcbit_isbinary(struct xvimage *f)
+/* ==================================== */
+/* retourne 1 si f est une image d'octets ne contenant que NDG_MIN et NDG_MAX */
+{
+    index_t i, N = rowsize(f) * colsize(f) * depth(f) * nbands(f);
+    uint8_t *F;
+
+    if (datatype(f) != VFF_TYP_1_BYTE) {
+        return 0;
+    }
+    F = UCHARDATA(f);
+    for (i = 0; i < N; i++) {
+        if ((F[i] != NDG_MIN) && (F[i] != NDG_MAX)) {
+            return 0;
+        }
+    }
+    return 1;
+} /* mcbit_isbinary() */
+
+/* ==================================== */
+void mcbit_inverse(mcbitimage *b)
+/* ==================================== */
+/* complementaire dans l'image */
+{
+    index_t l, i, wpr = b->wpr;
+    uint64_t lastmask = mcbit_lastmask(b->rs), *B;
+
+    for (l = 0; l < b->cs * b->ds; l++) {
+        B = b->data + l * wpr;
+        for (i = 0; i < wpr; i++) {
+            B[i] = ~B[i];
+        }
+        B[wpr - 1] &= lastmask;
+    }
+} /* mcbit_inverse() */
+
+/* ==================================== */
+void mcbit_and(mcbitimage *b, mcbitimage *c)
+/* ==================================== */
+/* b = b inter c (images de memes dimensions) */
+{
+    index_t i, n = b->wpr * b->cs * b->ds;
+    uint64_t *B = b->data, *C = c->data;
+
+    for (i = 0; i < n; i++) {
+        B[i] &= C[i];
+    }
+} /* mcbit_and() */
+
+/* ==================================== */
+static void mcbit_orshift(uint64_t *out, index_t wpr, uint64_t *v, index_t nv, index_t s)
+/* ==================================== */
+/* out(x) |= v(x - s), pour 0 <= x < 64 * wpr ; v a nv >= wpr mots */
+{
+    index_t i, q;
+    int32_t r;
+
+    if (s >= 0) {
+        q = s >> 6;
+        r = (int32_t)(s & 63);
+        if (q >= wpr) {
+            return;
+        }
+        if (r == 0) {
+            for (i = q; i < wpr; i++) {
+                out[i] |= v[i - q];
+            }
+        } else {
+            out[q] |= v[0] << r;
+            for (i = q + 1; i < wpr; i++) {
+                out[i] |= (v[i - q] << r) | (v[i - q - 1] >> (64 - r));
+            }
+        }
+    } else {
+        q = (-s) >> 6;
+        r = (int32_t)((-s) & 63);
+        if (r == 0) {
+            for (i = 0; (i < wpr) && (i + q < nv); i++) {
+                out[i] |= v[i + q];
+            }
+        } else {
+            for (i = 0; (i < wpr) && (i + q + 1 < nv); i++) {
+                out[i] |= (v[i + q] >> r) | (v[i + q + 1] << (64 - r));
+            }
+            if ((i < wpr) && (i + q < nv)) {
+                out[i] |= v[i + q] >> r;
+            }
+        }
+    }
+} /* mcbit_orshift() */
+
+/* ==================================== */
+static void mcbit_orshl(uint64_t *v, index_t nv, index_t s)
+/* ==================================== */
+/* v(x) |= v(x - s) sur place, s > 0 */
+{
+    index_t i, q = s >> 6;
+    int32_t r = (int32_t)(s & 63);
+
+    if (q >= nv) {
+        return;
+    }
+    if (r == 0) {
+        for (i = nv - 1; i >= q; i--) {
+            v[i] |= v[i - q];
+        }
+    } else {
+        for (i = nv - 1; i > q; i--) {
+            v[i] |= (v[i - q] << r) | (v[i - q - 1] >> (64 - r));
+        }
+        v[q] |= v[0] << r;
+    }
+} /* mcbit_orshl() */
+
+/* ==================================== */
+static void mcbit_segment(uint64_t *v, index_t nv, int32_t L)
+/* ==================================== */
+/* v(x) = OU des v(x - k), 0 <= k < L, par doublements */
+{
+    int32_t c = 1;
+
+    while (2 * c <= L) {
+        mcbit_orshl(v, nv, c);
+        c *= 2;
+    }
+    if (c < L) {
+        mcbit_orshl(v, nv, L - c);
+    }
+} /* mcbit_segment() */
+
+/* ==================================== */
+static void mcbit_dilat_band(void *arg, int32_t band)
+/* ==================================== */
+{
+    mcbit_job *J = (mcbit_job *)arg;
+    index_t first, last, l, y, z, sy, sz, i;
+    index_t wpr = J->wpr, nw = J->nw;
+    uint64_t *v = J->work + (index_t)band * nw;
+    uint64_t *out, *src;
+    int32_t g, s;
+
+    mcthreads_band(J->cs * J->ds, J->nbands, band, &first, &last);
+    for (l = first; l < last; l++) {
+        y = l % J->cs;
+        z = l / J->cs;
+        out = J->D + l * wpr;
+        memset(out, 0, wpr * sizeof(uint64_t));
+        for (g = 0; g < J->ng; g++) {
+            sy = y - J->gdy[g];
+            sz = z - J->gdz[g];
+            if ((sy < 0) || (sy >= J->cs) || (sz < 0) || (sz >= J->ds)) {
+                continue;
+            }
+            src = J->S + (sz * J->cs + sy) * wpr;
+            for (s = J->gfirst[g]; s < J->gfirst[g + 1]; s++) {
+                if (J->sl[s] == 1) {
+                    mcbit_orshift(out, wpr, src, wpr, J->sa[s]);
+                } else {
+                    memcpy(v, src, wpr * sizeof(uint64_t));
+                    for (i = wpr; i < nw; i++) {
+                        v[i] = 0;
+                    }
+                    mcbit_segment(v, nw, J->sl[s]);
+                    mcbit_orshift(out, wpr, v, nw, J->sa[s]);
+                }
+            }
+        }
+        out[wpr - 1] &= J->lastmask;
+    }
+} /* mcbit_dilat_band() */
+
+/* ==================================== */
+static int mcbit_cmpoffset(const void *a, const void *b)
+/* ==================================== */
+/* ordre (dz, dy, dx) */
+{
+    const int32_t *u = (const int32_t *)a, *w = (const int32_t *)b;
+    if (u[2] != w[2]) {
+        return (u[2] < w[2]) ? -1 : 1;
+    }
+    if (u[1] != w[1]) {
+        return (u[1] < w[1]) ? -1 : 1;
+    }
+    if (u[0] != w[0]) {
+        return (u[0] < w[0]) ? -1 : 1;
+    }
+    return 0;
+} /* mcbit_cmpoffset() */
+
+/* ==================================== */
+int32_t mcbit_dilat(mcbitimage *b, int32_t nptb, int32_t *tab_es_x, int32_t *tab_es_y,
+                    int32_t *tab_es_z, int32_t xc, int32_t yc, int32_t zc)
+/* ==================================== */
+/*
+   Dilatation de b (sur place) par l'element structurant de nptb points
+   (tab_es_x[k], tab_es_y[k], tab_es_z[k]) d'origine (xc, yc, zc).
+   tab_es_z peut etre NULL (e.s. plan).
+*/
+#undef F_NAME
+#define F_NAME "mcbit_dilat"
+{
+    mcbit_job J;
+    int32_t *off, k, n, g, s, L, Lmax;
+    uint64_t *D;
+
+    J.wpr = b->wpr;
+    J.cs = b->cs;
+    J.ds = b->ds;
+    J.lastmask = mcbit_lastmask(b->rs);
+    D = (uint64_t *)calloc(b->wpr * b->cs * b->ds + 1, sizeof(uint64_t));
+    off = (int32_t *)malloc((3 * (index_t)nptb + 1) * sizeof(int32_t));
+    J.gdy = (int32_t *)malloc((4 * (index_t)nptb + 3) * sizeof(int32_t));
+    J.sa = (int32_t *)malloc((2 * (index_t)nptb + 1) * sizeof(int32_t));
+    if ((D == NULL) || (off == NULL) || (J.gdy == NULL) || (J.sa == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(D);
+        free(off);
+        free(J.gdy);
+        free(J.sa);
+        return 0;
+    }
+    J.gdz = J.gdy + nptb + 1;
+    J.gfirst = J.gdz + nptb + 1;
+    J.sl = J.sa + nptb;
+
+    /* points de l'e.s. tries par lignes, sans doublons */
+    for (k = 0; k < nptb; k++) {
+        off[3 * k] = tab_es_x[k] - xc;
+        off[3 * k + 1] = tab_es_y[k] - yc;
+        off[3 * k + 2] = tab_es_z ? tab_es_z[k] - zc : 0;
+    }
+    qsort(off, nptb, 3 * sizeof(int32_t), mcbit_cmpoffset);
+    for (k = n = 0; k < nptb; k++) {
+        if ((n == 0) || mcbit_cmpoffset(off + 3 * k, off + 3 * (n - 1))) {
+            off[3 * n] = off[3 * k];
+            off[3 * n + 1] = off[3 * k + 1];
+            off[3 * n + 2] = off[3 * k + 2];
+            n++;
+        }
+    }
+
+    /* decomposition en lignes et en segments */
+    g = s = -1;
+    Lmax = 1;
+    for (k = 0; k < n; k++) {
+        if ((g < 0) || (off[3 * k + 1] != J.gdy[g]) || (off[3 * k + 2] != J.gdz[g])) {
+            g++;
+            J.gdy[g] = off[3 * k + 1];
+            J.gdz[g] = off[3 * k + 2];
+            J.gfirst[g] = ++s;
+            J.sa[s] = off[3 * k];
+            J.sl[s] = 1;
+        } else if (off[3 * k] == J.sa[s] + J.sl[s]) {
+            J.sl[s]++;
+        } else {
+            ++s;
+            J.sa[s] = off[3 * k];
+            J.sl[s] = 1;
+        }
+    }
+    J.ng = g + 1;
+    J.gfirst[J.ng] = s + 1;
+    for (k = 0; k <= s; k++) {
+        L = J.sl[k];
+        Lmax = mcmax(Lmax, L);
+    }
+    free(off);
+
+    /* le tableau de travail contient les bits x < 64 * wpr + Lmax */
+    J.nw = b->wpr + (Lmax + 63) / 64;
+    J.nbands = mcthreads_nbands(b->cs * b->ds);
+    J.work = (uint64_t *)malloc((index_t)J.nbands * J.nw * sizeof(uint64_t));
+    if (J.work == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(D);
+        free(J.gdy);
+        free(J.sa);
+        return 0;
+    }
+    J.S = b->data;
+    J.D = D;
+    mcthreads_run(J.nbands, mcbit_dilat_band, &J);
+
+    free(b->data);
+    b->data = D;
+    free(J.work);
+    free(J.gdy);
+    free(J.sa);
+    return 1;
+} /* mcbit_dilat() */
+
+/* ==================================== */
+int32_t mcbit_eros(mcbitimage *b, int32_t nptb, int32_t *tab_es_x, int32_t *tab_es_y,
+                   int32_t *tab_es_z, int32_t xc, int32_t yc, int32_t zc)
+/* ==================================== */
+/*
+   Erosion de b (sur place), duale de mcbit_dilat : E(q) = 1 ssi
+   q - (m - c) est dans X pour tout point m de l'e.s. dans l'image.
+*/
+{
+    int32_t ret;
+
+    mcbit_inverse(b);
+    ret = mcbit_dilat(b, nptb, tab_es_x, tab_es_y, tab_es_z, xc, yc, zc);
+    mcbit_inverse(b);
+    return ret;
+} /* mcbit_eros() */
+
+/* ==================================== */
+static int32_t mcbit_erosmask(mcbitimage *b, struct xvimage *m, int32_t xc, int32_t yc, int32_t zc)
+/* ==================================== */
+/* erosion de b par l'e.s. represente par le masque m, d'origine (xc, yc, zc) */
+#undef F_NAME
+#define F_NAME "mcbit_erosmask"
+{
+    index_t rsm = rowsize(m), csm = colsize(m), dsm = depth(m);
+    index_t i, j, k, N = rsm * csm * dsm;
+    uint8_t *M = UCHARDATA(m);
+    int32_t *tab, nptb = 0, ret;
+
+    tab = (int32_t *)malloc((3 * N + 1) * sizeof(int32_t));
+    if (tab == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    for (k = 0; k < dsm; k++) {
+        for (j = 0; j < csm; j++) {
+            for (i = 0; i < rsm; i++) {
+                if (M[(k * csm + j) * rsm + i]) {
+                    tab[nptb] = (int32_t)i;
+                    tab[N + nptb] = (int32_t)j;
+                    tab[2 * N + nptb] = (int32_t)k;
+                    nptb++;
+                }
+            }
+        }
+    }
+    ret = mcbit_eros(b, nptb, tab, tab + N, tab + 2 * N, xc, yc, zc);
+    free(tab);
+    return ret;
+} /* mcbit_erosmask() */
+
+/* ==================================== */
+int32_t mcbit_hitormiss(mcbitimage *b, struct xvimage *m1, int32_t x1, int32_t y1, int32_t z1,
+                        struct xvimage *m2, int32_t x2, int32_t y2, int32_t z2)
+/* ==================================== */
+/*
+   Transformation en tout ou rien de b (sur place) :
+   Y = (X - E1) inter (Xb - E2), ou '-' est l'erosion (mcbit_eros) et Xb
+   le complementaire de X. Pour une image binaire, le resultat est celui
+   de ldilateros_leros et leros3d.
+*/
+#undef F_NAME
+#define F_NAME "mcbit_hitormiss"
+{
+    mcbitimage *c;
+
+    c = mcbit_allocimage(b->rs, b->cs, b->ds);
+    if (c == NULL) {
+        return 0;
+    }
+    memcpy(c->data, b->data, b->wpr * b->cs * b->ds * sizeof(uint64_t));
+    mcbit_inverse(c);
+    if (!mcbit_erosmask(b, m1, x1, y1, z1) || !mcbit_erosmask(c, m2, x2, y2, z2)) {
+        mcbit_freeimage(c);
+        return 0;
+    }
+    mcbit_and(b, c);
+    mcbit_freeimage(c);
+    return 1;
+} /* mcbit_hitormiss() */
@@ -80,7 +80,7 @@ knowledge of the CeCILL license and that you accept its terms.
 */
 
 /* ==================================== */
-int32_t voisin(index_t i, int32_t k, index_t rs, index_t nb)
+index_t voisin(index_t i, int32_t k, index_t rs, index_t nb)
 /* i : index du point dans l'image */
 /* k : direction du voisin */
 /* rs : taille d'une rangee */
@@ -146,7 +146,7 @@ int32_t voisin(index_t i, int32_t k, index_t rs, index_t nb)
 } // voisin()
 
 /* ==================================== */
-int32_t voisin2(index_t i, int32_t k, index_t rs, index_t nb)
+index_t voisin2(index_t i, int32_t k, index_t rs, index_t nb)
 /* i : index du point dans l'image */
 /* k : index du voisin (24 possibilités - voisinage étendu) */
 /* rs : taille d'une rangee */
@@ -382,7 +382,7 @@ int32_t bord3d(index_t i, index_t rs, index_t ps, index_t nb)
 }
 
 /* ==================================== */
-int32_t voisin6(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
+index_t voisin6(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 /* i : index du point dans l'image */
 /* k : direction du voisin */
 /* rs : taille d'une rangee */
@@ -437,7 +437,7 @@ int32_t voisin6(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 }
 
 /* ==================================== */
-int32_t voisin26(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
+index_t voisin26(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 /* i : index du point dans l'image */
 /* k : direction du voisin */
 /* rs : taille d'une rangee */
@@ -615,7 +615,7 @@ int32_t voisin26(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 }
 
 /* ==================================== */
-int32_t voisin18(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
+index_t voisin18(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 /* i : index du point dans l'image */
 /* k : direction du voisin */
 /* rs : taille d'une rangee */
@@ -745,7 +745,7 @@ int32_t voisin18(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 } // voisin18()
 
 /* ==================================== */
-int32_t voisin12(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
+index_t voisin12(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 /* 18-voisin mais pas 6-voisin */
 /* i : index du point dans l'image */
 /* k : direction du voisin */
@@ -952,7 +952,7 @@ int32_t voisins26(index_t i, index_t j, index_t rs, index_t ps)
 } // voisins26()
 
 /* ==================================== */
-int32_t voisin5(index_t i, int32_t k, index_t rs, index_t nb)
+index_t voisin5(index_t i, int32_t k, index_t rs, index_t nb)
 /* i : index du point dans l'image */
 /* k : direction du voisin */
 /* rs : taille d'une rangee */
@@ -1033,7 +1033,7 @@ int32_t voisin5(index_t i, int32_t k, index_t rs, index_t nb)
 /* renvoie l'index du voisin si il      */
 /* appartient a gamma b sinon renvoie   */
 /* -1                                   */
-int32_t voisin6b(index_t i, int32_t k, index_t rs, index_t nb, index_t par)
+index_t voisin6b(index_t i, int32_t k, index_t rs, index_t nb, index_t par)
 /* i : index du point dans l'image */
 /* k : direction du voisin */
 /* rs : taille d'une rangee */
@@ -1060,7 +1060,7 @@ int32_t voisin6b(index_t i, int32_t k, index_t rs, index_t nb, index_t par)
 /*      2 X 5       */
 /*      * 3 4       */
 
-int32_t voisinNOSE(index_t i, int32_t k, index_t rs, index_t nb) {
+index_t voisinNOSE(index_t i, int32_t k, index_t rs, index_t nb) {
     switch(k) {
     case 0:
         if (i >= rs) {
@@ -1106,7 +1106,7 @@ int32_t voisinNOSE(index_t i, int32_t k, index_t rs, index_t nb) {
 /*      * 0 5      */
 /*      1 X 4      */
 /*      2 3 *      */
-int32_t voisinNESO(index_t i, int32_t k, index_t rs, index_t nb) {
+index_t voisinNESO(index_t i, int32_t k, index_t rs, index_t nb) {
     switch(k) {
     case 4:
         if (i % rs != rs - 1) {
@@ -1158,7 +1158,7 @@ int32_t voisinNESO(index_t i, int32_t k, index_t rs, index_t nb) {
 /* eviter de recalculer les coords du   */
 /* point courannt                       */
 
-int32_t voisin14b(index_t i, int32_t k, index_t rs, index_t ps, index_t N) {
+index_t voisin14b(index_t i, int32_t k, index_t rs, index_t ps, index_t N) {
     index_t px, py, pz;
     px = (i%rs)%2;
     py = (i/ps)%2;
@@ -1182,7 +1182,7 @@ int32_t voisin14b(index_t i, int32_t k, index_t rs, index_t ps, index_t N) {
    d'AVANT vers l'ARRIERE.
    les voisin sont numérotés suivant cet ordre
 */
-int32_t voisinONAV(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
+index_t voisinONAV(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
 #undef F_NAME
 #define F_NAME "voisinONAV"
 {
@@ -1279,7 +1279,7 @@ int32_t voisinONAV(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
     }
 }
 
-int32_t  voisinENAR(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
+index_t voisinENAR(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
 #undef F_NAME
 #define F_NAME "voisinENAR"
 {
@@ -1376,7 +1376,7 @@ int32_t  voisinENAR(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
     }
 }
 
-int32_t voisinENAV(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
+index_t voisinENAV(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
 #undef F_NAME
 #define F_NAME "voisinENAV"
 {
@@ -1473,7 +1473,7 @@ int32_t voisinENAV(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
     }
 }
 
-int32_t voisinONAR(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
+index_t voisinONAR(index_t i, int32_t k, index_t rs, index_t ps, index_t N )
 #undef F_NAME
 #define F_NAME "voisinONAR"
 {
@@ -1649,7 +1649,7 @@ int32_t sont18voisins(index_t p, index_t q, index_t rs, index_t ps)
 }
 
 /* ==================================== */
-int32_t voisin125(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
+index_t voisin125(index_t i, int32_t k, index_t rs, index_t ps, index_t N)
 /* i : index du point dans l'image */
 /* k : index du voisin (entre 0 et 124) */
 /* rs : taille d'une rangee */
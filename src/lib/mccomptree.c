@@ -40,14 +40,16 @@ knowledge of the CeCILL license and that you accept its terms.
   Michel Couprie - septembre 2003
   Michel Couprie - aout 2004 : 3D
   Michel Couprie - septembre 2005 : area
+  2026 : construction via le max-tree parallele (mcmaxtree)
 */
 
 #include <stdio.h>
 #include <stdint.h>
 #include <sys/types.h>
 #include <stdlib.h>
-#include <mcunionfind.h>
 #include <mccodimage.h>
+#include <mcimage.h>
+#include <mcmaxtree.h>
 #include <mccomptree.h>
 
 #define MAXTREE
@@ -57,7 +59,7 @@ knowledge of the CeCILL license and that you accept its terms.
 //#define DEBUG
 
 /* ==================================== */
-int32_t * linsortimageup(uint8_t *F, int32_t N)
+index_t * linsortimageup(uint8_t *F, index_t N)
 /* ==================================== */
 /*
   Tri par denombrement - cf. Cormen & al., "Introduction a l'algorithmique"
@@ -70,8 +72,8 @@ int32_t * linsortimageup(uint8_t *F, int32_t N)
 #undef F_NAME
 #define F_NAME "linsortimageup"
 {
-    int32_t i, j, k, H[256];
-    int32_t *T = (int32_t *)calloc(1,N * sizeof(int32_t));
+    index_t i, j, k, H[256];
+    index_t *T = (index_t *)calloc(1,N * sizeof(index_t));
     if (T == NULL) {
         fprintf(stderr, "%s() : malloc failed for T\n", F_NAME);
         return NULL;
@@ -99,7 +101,7 @@ int32_t * linsortimageup(uint8_t *F, int32_t N)
 } /* linsortimageup() */
 
 /* ==================================== */
-int32_t * linsortimagedown(uint8_t *F, int32_t N)
+index_t * linsortimagedown(uint8_t *F, index_t N)
 /* ==================================== */
 /*
   Tri par denombrement - cf. Cormen & al., "Introduction a l'algorithmique"
@@ -112,8 +114,8 @@ int32_t * linsortimagedown(uint8_t *F, int32_t N)
 #undef F_NAME
 #define F_NAME "linsortimagedown"
 {
-    int32_t i, j, k, H[256];
-    int32_t *T = (int32_t *)calloc(1,N * sizeof(int32_t));
+    index_t i, j, k, H[256];
+    index_t *T = (index_t *)calloc(1,N * sizeof(index_t));
     if (T == NULL) {
         fprintf(stderr, "%s() : malloc failed for T\n", F_NAME);
         return NULL;
@@ -141,7 +143,7 @@ int32_t * linsortimagedown(uint8_t *F, int32_t N)
 } /* linsortimagedown() */
 
 /* ==================================== */
-void addson(ctree *CT, int32_t node, int32_t nodeaux)
+void addson(ctree *CT, index_t node, index_t nodeaux)
 /* ==================================== */
 // add nodeaux to the lists of sons of node
 // operation done in constant time
@@ -150,7 +152,7 @@ void addson(ctree *CT, int32_t node, int32_t nodeaux)
 {
     soncell * newson = NULL;
 #ifdef DEBUGADDSON
-    printf("addson: %d %d\n", node, nodeaux);
+    printf("addson: %d %d\n", (int32_t)node, (int32_t)nodeaux);
 #endif
     if (CT->nbsoncells >= CT->nbnodes) {
         fprintf(stderr, "%s : fatal error : maximum nb of cells exceeded\n", F_NAME);
@@ -183,7 +185,7 @@ void addson(ctree *CT, int32_t node, int32_t nodeaux)
 } // addson()
 
 /* ==================================== */
-void mergenodes(ctree *CT, int32_t node, int32_t nodeaux)
+void mergenodes(ctree *CT, index_t node, index_t nodeaux)
 /* ==================================== */
 // add the sons of nodeaux to the lists of sons of node,
 // and mark nodeaux as deleted - operation done in constant time
@@ -198,7 +200,7 @@ void mergenodes(ctree *CT, int32_t node, int32_t nodeaux)
             for (nodeauxson = CT->tabnodes[nodeaux].sonlist; nodeauxson != NULL;
                     nodeauxson = nodeauxson->next) {
                 if (nodeson->son == nodeauxson->son) {
-                    fprintf(stderr, "%s : error : son already in list (%d)\n", F_NAME, nodeson->son);
+                    fprintf(stderr, "%s : error : son already in list (%d)\n", F_NAME, (int32_t)nodeson->son);
                     return;
                 }
             }
@@ -223,7 +225,7 @@ void mergenodes(ctree *CT, int32_t node, int32_t nodeaux)
 } // mergenodes()
 
 /* ==================================== */
-ctree * ComponentTreeAlloc(int32_t N)
+ctree * ComponentTreeAlloc(index_t N)
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "ComponentTreeAlloc"
@@ -257,22 +259,40 @@ void ComponentTreeFree(ctree * CT)
 void mccomptree_ComponentTreePrint(ctree * CT)
 /* ==================================== */
 {
-    int32_t i;
+    index_t i;
     soncell * s = NULL;
+#ifdef MC_64_BITS
+    printf("root = %ld ; nbnodes: %ld ; nbleafs: %ld ; nbsoncells: %ld\n", CT->root, CT->nbnodes, CT->nbleafs, CT->nbsoncells);
+#else
     printf("root = %d ; nbnodes: %d ; nbleafs: %d ; nbsoncells: %d\n", CT->root, CT->nbnodes, CT->nbleafs, CT->nbsoncells);
+#endif
     for (i = 0; i < CT->nbnodes; i++) {
         if (CT->tabnodes[i].nbsons != -1) {
+#ifdef MC_64_BITS
+#ifdef ATTRIB_VOL
+            printf("node: %ld ; level %d ; nbsons: %ld ; father: %ld ; area: %ld ; vol: %ld ; ",
+                   i, CT->tabnodes[i].data, CT->tabnodes[i].nbsons, CT->tabnodes[i].father, CT->tabnodes[i].area, CT->tabnodes[i].vol);
+#else
+            printf("node: %ld ; level %d ; nbsons: %ld ; father: %ld ; ",
+                   i, CT->tabnodes[i].data, CT->tabnodes[i].nbsons, CT->tabnodes[i].father);
+#endif
+#else
 #ifdef ATTRIB_VOL
             printf("node: %d ; level %d ; nbsons: %d ; father: %d ; area: %d ; vol: %d ; ",
                    i, CT->tabnodes[i].data, CT->tabnodes[i].nbsons, CT->tabnodes[i].father, CT->tabnodes[i].area, CT->tabnodes[i].vol);
 #else
             printf("node: %d ; level %d ; nbsons: %d ; father: %d ; ",
                    i, CT->tabnodes[i].data, CT->tabnodes[i].nbsons, CT->tabnodes[i].father);
+#endif
 #endif
             if (CT->tabnodes[i].nbsons > 0) {
                 printf("sons: ");
                 for (s = CT->tabnodes[i].sonlist; s != NULL; s = s->next) {
+#ifdef MC_64_BITS
+                    printf("%ld  ", s->son);
+#else
                     printf("%d  ", s->son);
+#endif
                 }
             }
             printf("\n");
@@ -282,7 +302,7 @@ void mccomptree_ComponentTreePrint(ctree * CT)
 
 #ifdef ATTRIB_AREA
 /* ==================================== */
-int32_t ComputeArea(ctree * CT, int32_t node, int32_t *na1)
+index_t ComputeArea(ctree * CT, index_t node, index_t *na1)
 /* ==================================== */
 /*
    Calcule la surface de chacune des composantes, a partir de
@@ -295,7 +315,7 @@ int32_t ComputeArea(ctree * CT, int32_t node, int32_t *na1)
 #define F_NAME "ComputeArea"
 {
     soncell * s = NULL;
-    int32_t son;
+    index_t son;
     na1[node] = CT->tabnodes[node].area;
     if (CT->tabnodes[node].nbsons == 0) {
         return na1[node];
@@ -315,7 +335,7 @@ int32_t ComputeArea(ctree * CT, int32_t node, int32_t *na1)
 
 #ifdef ATTRIB_VOL
 /* ==================================== */
-int32_t ComputeVol(ctree * CT, int32_t node, int32_t *na1)
+index_t ComputeVol(ctree * CT, index_t node, index_t *na1)
 /* ==================================== */
 /*
    Calcule la surface de chacune des composantes, a partir de
@@ -328,7 +348,7 @@ int32_t ComputeVol(ctree * CT, int32_t node, int32_t *na1)
 #define F_NAME "ComputeVol"
 {
     soncell * s = NULL;
-    int32_t son, fth;
+    index_t son, fth;
     na1[node] = CT->tabnodes[node].area;
     fth = CT->tabnodes[node].father;
     if (fth != -1) {
@@ -353,468 +373,162 @@ int32_t ComputeVol(ctree * CT, int32_t node, int32_t *na1)
 #endif
 
 /* ==================================== */
-int32_t ComponentTree( uint8_t *F, int32_t rs, int32_t N, int32_t connex, // inputs
-                       ctree **CompTree, // output
-                       int32_t **CompMap     // output
-                     )
+static int32_t ComponentTreeFromMaxtree(uint8_t *F, index_t rs, index_t cs, index_t ds, int32_t connex, // inputs
+                                        ctree **CompTree, // output
+                                        index_t **CompMap     // output
+                                       )
 /* ==================================== */
+/*
+  Construit l'arbre des composantes a partir du max-tree (min-tree si
+  MAXTREE n'est pas defini) calcule par mcmaxtree_build (construction
+  parallele par tuiles). Les sommets sont les pixels canoniques du
+  max-tree ; les autres pixels sont marques comme sommets supprimes
+  (nbsons = -1). L'ordre S du max-tree (chaque pere avant ses fils)
+  permet de calculer surfaces et volumes sans recursion.
+*/
 #undef F_NAME
-#define F_NAME "ComponentTree"
+#define F_NAME "ComponentTreeFromMaxtree"
 {
     ctree * CT = NULL;
-    int32_t * CM = NULL;
-    int32_t * S = NULL;
-    int32_t i, k, p, q, incr_vois, tmp;
-    int32_t numbernodes = N;
-    int32_t * SubtreeRoot = NULL;
-    int32_t currentSubtree;
-    int32_t currentNode;
-    int32_t neighbSubtree;
-    int32_t neighbNode;
-    Tarjan *T1 = NULL, *T2 = NULL;
-    soncell *sc = NULL;
-    int32_t son;
-
-    CT = ComponentTreeAlloc(N);
-    if (CT == NULL) {
-        fprintf(stderr, "%s() : ComponentTreeAlloc failed\n", F_NAME);
-        return 0;
-    }
-    CM = (int32_t *)calloc(1,N * sizeof(int32_t));
-    if (CM == NULL) {
-        fprintf(stderr, "%s() : malloc failed for CM\n", F_NAME);
-        return 0;
-    }
-    SubtreeRoot = (int32_t *)calloc(1,N * sizeof(int32_t));
-    if (SubtreeRoot == NULL) {
-        fprintf(stderr, "%s() : malloc failed for SubtreeRoot\n", F_NAME);
+    index_t * CM = NULL;
+    struct xvimage *image;
+    mcmaxtree *T;
+    index_t N = rs * cs * ds, i, p, q, k;
+    soncell *sc;
+
+    image = allocheader(NULL, rs, cs, ds, VFF_TYP_1_BYTE);
+    if (image == NULL) {
+        fprintf(stderr, "%s() : allocheader failed\n", F_NAME);
         return 0;
     }
+    image->image_data = (void *)F;
 #ifdef MAXTREE
-    S = linsortimagedown(F, N);
+    T = mcmaxtree_build(image, connex, 1);
 #else
-    S = linsortimageup(F, N);
+    T = mcmaxtree_build(image, connex, 0);
 #endif
-    if (S == NULL) {
-        fprintf(stderr, "%s() : linsortimage failed\n", F_NAME);
+    free(image);
+    if (T == NULL) {
+        fprintf(stderr, "%s() : mcmaxtree_build failed\n", F_NAME);
         return 0;
     }
-    T1 = CreeTarjan(N);
-    T2 = CreeTarjan(N);
-    if ((T1 == NULL) || (T2 == NULL)) {
-        fprintf(stderr, "%s() : CreeTarjan failed\n", F_NAME);
+    CT = ComponentTreeAlloc(N);
+    if (CT == NULL) {
+        fprintf(stderr, "%s() : ComponentTreeAlloc failed\n", F_NAME);
+        mcmaxtree_free(T);
         return 0;
     }
-    switch (connex) {
-    case 4:
-        incr_vois = 2;
-        break;
-    case 8:
-        incr_vois = 1;
-        break;
-    } /* switch (connex) */
-
-    for (i = 0; i < N; i++) {
-        TarjanMakeSet(T1, i);
-        TarjanMakeSet(T2, i);
-        SubtreeRoot[i] = i;
-        CT->tabnodes[i].nbsons = 0;
-        CT->tabnodes[i].data = F[i];
-        CT->tabnodes[i].father = -1;
-#ifdef ATTRIB_AREA
-        CT->tabnodes[i].area = 1;
-#endif
+    CM = (index_t *)malloc(N * sizeof(index_t));
+    if (CM == NULL) {
+        fprintf(stderr, "%s() : malloc failed for CM\n", F_NAME);
+        ComponentTreeFree(CT);
+        mcmaxtree_free(T);
+        return 0;
     }
 
-    for (i = 0; i < N; i++) {
-        p = S[i];  // pixel courant, dans l'ordre croissant
-#ifdef DEBUG
-        printf("pixel %d ; valeur %d\n", p, F[p]);
+    for (p = 0; p < N; p++) {
+        q = T->parent[p];
+        CT->tabnodes[p].data = F[p];
+        if ((q == p) || (F[q] != F[p])) { // pixel canonique : sommet de l'arbre
+            CM[p] = p;
+            CT->tabnodes[p].nbsons = 0;
+            CT->tabnodes[p].father = (q == p) ? -1 : q;
+        } else {
+            CM[p] = q;
+            CT->tabnodes[p].nbsons = -1;
+            CT->tabnodes[p].father = -1;
+        }
+#ifdef ATTRIB_AREA
+        CT->tabnodes[p].area = 1;
 #endif
-        currentSubtree = TarjanFind(T1, p);
-        currentNode = TarjanFind(T2, SubtreeRoot[currentSubtree]);
-#ifdef DEBUG
-        printf("currentSubtree %d ; currentNode %d\n", currentSubtree, currentNode);
+#ifdef ATTRIB_VOL
+        CT->tabnodes[p].vol = 0;
 #endif
+    }
+    CT->root = T->S[0];
 
-        for (k = 0; k < 8; k += incr_vois) {
-            q = voisin(p, k, rs, N);
-#ifdef MAXTREE
-            if ((q != -1) && (F[q] >= F[p]))
-#else
-            if ((q != -1) && (F[q] <= F[p]))
-#endif
-            {
-#ifdef DEBUG
-                printf("  neighbor %d ; valeur %d\n", q, F[q]);
-#endif
-                neighbSubtree = TarjanFind(T1, q);
-                neighbNode = TarjanFind(T2, SubtreeRoot[neighbSubtree]);
-#ifdef DEBUG
-                printf("  neighbSubtree %d ; neighbNode %d\n", neighbSubtree, neighbNode);
-#endif
-                if (currentNode != neighbNode) {
-                    if (CT->tabnodes[currentNode].data == CT->tabnodes[neighbNode].data) {
-                        // merge the nodes
-                        numbernodes -= 1;
-                        tmp = TarjanLink(T2, neighbNode, currentNode);
-#ifdef PARANO
-                        if ((tmp != currentNode) && (tmp != neighbNode)) {
-                            printf("%s : choix inattendu pour le representant", F_NAME);
-                        }
-#endif
-                        if (tmp == currentNode) {
-                            mergenodes(CT, currentNode, neighbNode);
-                        } else {
-                            mergenodes(CT, neighbNode, currentNode);
-                        }
-#ifdef DEBUG
-                        printf("  mergenodes: %d %d\n", currentNode, neighbNode);
-#endif
+    // parcours des pixels dans l'ordre inverse de S : les fils d'un sommet
+    // sont traites avant lui
+    for (i = N - 1; i > 0; i--) {
+        p = T->S[i];
+        q = T->parent[p];
 #ifdef ATTRIB_AREA
-                        CT->tabnodes[tmp].area = CT->tabnodes[currentNode].area + CT->tabnodes[neighbNode].area;
-#endif
-                        currentNode = tmp;
-                    } else {
-                        // add neighbNode as a new son of currentNode
-                        addson(CT, currentNode, neighbNode);
-#ifdef DEBUG
-                        printf("  addson: %d %d\n", currentNode, neighbNode);
+        CT->tabnodes[q].area += CT->tabnodes[p].area;
 #endif
-                    }
-                    currentSubtree = TarjanLink(T1, neighbSubtree, currentSubtree);
-                    SubtreeRoot[currentSubtree] = currentNode;
-                } // endif
-            } // if ((q != -1) && (F[q] <= F[p]))
-        } // for (k = 0; k < 8; k += incr_vois)
-    } // for (i = 0; i < N; i++)
-
-    CT->root = SubtreeRoot[TarjanFind(T1, TarjanFind(T2, 0))];
-    for (i = 0; i < N; i++) {
-        CM[i] = TarjanFind(T2, i);
-    }
-    for (i = 0; i < N; i++) { // construction de la relation "father"
-        if (CT->tabnodes[i].nbsons > 0) {
-            for (sc = CT->tabnodes[i].sonlist; sc != NULL; sc = sc->next) {
-                son = sc->son;
-                CT->tabnodes[son].father = i;
+        if (CM[p] == p) {
+#ifdef ATTRIB_VOL
+            CT->tabnodes[p].vol += CT->tabnodes[p].area * (F[p] - F[q]);
+            CT->tabnodes[q].vol += CT->tabnodes[p].vol;
+#endif
+            sc = &(CT->tabsoncells[CT->nbsoncells]);
+            CT->nbsoncells += 1;
+            sc->son = p;
+            sc->next = CT->tabnodes[q].sonlist;
+            if (CT->tabnodes[q].nbsons == 0) {
+                CT->tabnodes[q].lastson = sc;
             }
+            CT->tabnodes[q].sonlist = sc;
+            CT->tabnodes[q].nbsons += 1;
         }
     }
+#ifdef ATTRIB_VOL
+    CT->tabnodes[CT->root].vol += CT->tabnodes[CT->root].area;
+#endif
+    mcmaxtree_free(T);
 
     k = 0;
-    for (i = 0; i < N; i++) {
-        if (CT->tabnodes[i].nbsons == 0) {
+    for (p = 0; p < N; p++) {
+        if (CT->tabnodes[p].nbsons == 0) {
             k++;
         }
     }
     CT->nbleafs = k;
 #ifdef VERBOSE
-    printf("nombre de feuilles = %d\n", CT->nbleafs);
-#endif
-
-    TarjanTermine(T1);
-    TarjanTermine(T2);
-
-#ifdef ATTRIB_AREA
-    {
-        int32_t *area = (int32_t *)malloc(N * sizeof(int32_t));
-        if (area == NULL) {
-            fprintf(stderr, "%s() : malloc failed\n", F_NAME);
-            return 0;
-        }
-        ComputeArea(CT, CT->root, area);
-        for (i = 0; i < N; i++) {
-            CT->tabnodes[i].area = area[i];
-        }
-
-#ifdef ATTRIB_VOL
-        ComputeVol(CT, CT->root, area);
-
-        for (i = 0; i < N; i++) {
-            CT->tabnodes[i].vol = area[i];
-        }
-#endif
-
-        free(area);
-    }
+    printf("nombre de feuilles = %d\n", (int32_t)CT->nbleafs);
 #endif
 
     *CompTree = CT;
     *CompMap = CM;
-    free(S);
-    free(SubtreeRoot);
     return 1;
+} // ComponentTreeFromMaxtree()
+
+/* ==================================== */
+int32_t ComponentTree( uint8_t *F, index_t rs, index_t N, int32_t connex, // inputs
+                       ctree **CompTree, // output
+                       index_t **CompMap     // output
+                     )
+/* ==================================== */
+#undef F_NAME
+#define F_NAME "ComponentTree"
+{
+    if ((connex != 4) && (connex != 8)) {
+        fprintf(stderr, "%s() : bad value for connex : %d\n", F_NAME, connex);
+        return 0;
+    }
+    return ComponentTreeFromMaxtree(F, rs, N / rs, 1, connex, CompTree, CompMap);
 } // ComponentTree()
 
 /* ==================================== */
-int32_t ComponentTree3d( uint8_t *F, int32_t rs, int32_t ps, int32_t N, int32_t connex, // inputs
+int32_t ComponentTree3d( uint8_t *F, index_t rs, index_t ps, index_t N, int32_t connex, // inputs
                          ctree **CompTree, // output
-                         int32_t **CompMap     // output
+                         index_t **CompMap     // output
                        )
 /* ==================================== */
 #undef F_NAME
 #define F_NAME "ComponentTree3d"
 {
-    ctree * CT = NULL;
-    int32_t * CM = NULL;
-    int32_t * S = NULL;
-    int32_t i, k, p, q, tmp;
-    int32_t numbernodes = N;
-    int32_t * SubtreeRoot = NULL;
-    int32_t currentSubtree;
-    int32_t currentNode;
-    int32_t neighbSubtree;
-    int32_t neighbNode;
-    Tarjan *T1 = NULL, *T2 = NULL;
-    soncell *sc = NULL;
-    int32_t son;
-
-    CT = ComponentTreeAlloc(N);
-    if (CT == NULL) {
-        fprintf(stderr, "%s() : ComponentTreeAlloc failed\n", F_NAME);
-        return 0;
-    }
-    CM = (int32_t *)calloc(1,N * sizeof(int32_t));
-    if (CM == NULL) {
-        fprintf(stderr, "%s() : malloc failed for CM\n", F_NAME);
-        return 0;
-    }
-    SubtreeRoot = (int32_t *)calloc(1,N * sizeof(int32_t));
-    if (SubtreeRoot == NULL) {
-        fprintf(stderr, "%s() : malloc failed for SubtreeRoot\n", F_NAME);
-        return 0;
-    }
-#ifdef MAXTREE
-    S = linsortimagedown(F, N);
-#else
-    S = linsortimageup(F, N);
-#endif
-    if (S == NULL) {
-        fprintf(stderr, "%s() : linsortimage failed\n", F_NAME);
-        return 0;
-    }
-    T1 = CreeTarjan(N);
-    T2 = CreeTarjan(N);
-    if ((T1 == NULL) || (T2 == NULL)) {
-        fprintf(stderr, "%s() : CreeTarjan failed\n", F_NAME);
-        return 0;
-    }
-
-    for (i = 0; i < N; i++) {
-        TarjanMakeSet(T1, i);
-        TarjanMakeSet(T2, i);
-        SubtreeRoot[i] = i;
-        CT->tabnodes[i].nbsons = 0;
-        CT->tabnodes[i].data = F[i];
-        CT->tabnodes[i].father = -1;
-#ifdef ATTRIB_AREA
-        CT->tabnodes[i].area = 1;
-#endif
-    }
-
-    if (connex == 6) {
-        for (i = 0; i < N; i++) {
-            p = S[i];  // pixel courant, dans l'ordre croissant
-            currentSubtree = TarjanFind(T1, p);
-            currentNode = TarjanFind(T2, SubtreeRoot[currentSubtree]);
-            for (k = 0; k <= 10; k += 2) {
-                q = voisin6(p, k, rs, ps, N);
-#ifdef MAXTREE
-                if ((q != -1) && (F[q] >= F[p]))
-#else
-                if ((q != -1) && (F[q] <= F[p]))
-#endif
-                {
-                    neighbSubtree = TarjanFind(T1, q);
-                    neighbNode = TarjanFind(T2, SubtreeRoot[neighbSubtree]);
-                    if (currentNode != neighbNode) {
-                        if (CT->tabnodes[currentNode].data == CT->tabnodes[neighbNode].data) {
-                            // merge the nodes
-                            numbernodes -= 1;
-                            tmp = TarjanLink(T2, neighbNode, currentNode);
-#ifdef PARANO
-                            if ((tmp != currentNode) && (tmp != neighbNode)) {
-                                printf("%s : choix inattendu pour le representant", F_NAME);
-                            }
-#endif
-                            if (tmp == currentNode) {
-                                mergenodes(CT, currentNode, neighbNode);
-                            } else {
-                                mergenodes(CT, neighbNode, currentNode);
-                            }
-#ifdef ATTRIB_AREA
-                            CT->tabnodes[tmp].area = CT->tabnodes[currentNode].area + CT->tabnodes[neighbNode].area;
-#endif
-                            currentNode = tmp;
-                        } else {
-                            // add neighbNode as a new son of currentNode
-                            addson(CT, currentNode, neighbNode);
-                        }
-                        currentSubtree = TarjanLink(T1, neighbSubtree, currentSubtree);
-                        SubtreeRoot[currentSubtree] = currentNode;
-                    } // endif
-                } // if ((q != -1) && (F[q] <= F[p]))
-            } // for (k = 0; k < 8; k += incr_vois)
-        } // for (i = 0; i < N; i++)
-    } // if (connex == 6)
-    else if (connex == 18) {
-        for (i = 0; i < N; i++) {
-            p = S[i];  // pixel courant, dans l'ordre croissant
-            currentSubtree = TarjanFind(T1, p);
-            currentNode = TarjanFind(T2, SubtreeRoot[currentSubtree]);
-            for (k = 0; k < 18; k++) {
-                q = voisin18(p, k, rs, ps, N);
-#ifdef MAXTREE
-                if ((q != -1) && (F[q] >= F[p]))
-#else
-                if ((q != -1) && (F[q] <= F[p]))
-#endif
-                {
-                    neighbSubtree = TarjanFind(T1, q);
-                    neighbNode = TarjanFind(T2, SubtreeRoot[neighbSubtree]);
-                    if (currentNode != neighbNode) {
-                        if (CT->tabnodes[currentNode].data == CT->tabnodes[neighbNode].data) {
-                            // merge the nodes
-                            numbernodes -= 1;
-                            tmp = TarjanLink(T2, neighbNode, currentNode);
-#ifdef PARANO
-                            if ((tmp != currentNode) && (tmp != neighbNode)) {
-                                printf("%s : choix inattendu pour le representant", F_NAME);
-                            }
-#endif
-                            if (tmp == currentNode) {
-                                mergenodes(CT, currentNode, neighbNode);
-                            } else {
-                                mergenodes(CT, neighbNode, currentNode);
-                            }
-#ifdef ATTRIB_AREA
-                            CT->tabnodes[tmp].area = CT->tabnodes[currentNode].area + CT->tabnodes[neighbNode].area;
-#endif
-                            currentNode = tmp;
-                        } else {
-                            // add neighbNode as a new son of currentNode
-                            addson(CT, currentNode, neighbNode);
-                        }
-                        currentSubtree = TarjanLink(T1, neighbSubtree, currentSubtree);
-                        SubtreeRoot[currentSubtree] = currentNode;
-                    } // endif
-                } // if ((q != -1) && (F[q] <= F[p]))
-            } // for (k = 0; k < 8; k += incr_vois)
-        } // for (i = 0; i < N; i++)
-    } // if (connex == 18)
-    else if (connex == 26) {
-        for (i = 0; i < N; i++) {
-            p = S[i];  // pixel courant, dans l'ordre croissant
-            currentSubtree = TarjanFind(T1, p);
-            currentNode = TarjanFind(T2, SubtreeRoot[currentSubtree]);
-            for (k = 0; k < 26; k++) {
-                q = voisin26(p, k, rs, ps, N);
-#ifdef MAXTREE
-                if ((q != -1) && (F[q] >= F[p]))
-#else
-                if ((q != -1) && (F[q] <= F[p]))
-#endif
-                {
-                    neighbSubtree = TarjanFind(T1, q);
-                    neighbNode = TarjanFind(T2, SubtreeRoot[neighbSubtree]);
-                    if (currentNode != neighbNode) {
-                        if (CT->tabnodes[currentNode].data == CT->tabnodes[neighbNode].data) {
-                            // merge the nodes
-                            numbernodes -= 1;
-                            tmp = TarjanLink(T2, neighbNode, currentNode);
-#ifdef PARANO
-                            if ((tmp != currentNode) && (tmp != neighbNode)) {
-                                printf("%s : choix inattendu pour le representant", F_NAME);
-                            }
-#endif
-                            if (tmp == currentNode) {
-                                mergenodes(CT, currentNode, neighbNode);
-                            } else {
-                                mergenodes(CT, neighbNode, currentNode);
-                            }
-#ifdef ATTRIB_AREA
-                            CT->tabnodes[tmp].area = CT->tabnodes[currentNode].area + CT->tabnodes[neighbNode].area;
-#endif
-                            currentNode = tmp;
-                        } else {
-                            // add neighbNode as a new son of currentNode
-                            addson(CT, currentNode, neighbNode);
-                        }
-                        currentSubtree = TarjanLink(T1, neighbSubtree, currentSubtree);
-                        SubtreeRoot[currentSubtree] = currentNode;
-                    } // endif
-                } // if ((q != -1) && (F[q] <= F[p]))
-            } // for (k = 0; k < 8; k += incr_vois)
-        } // for (i = 0; i < N; i++)
-    } // if (connex == 26)
-    else {
+    if ((connex != 6) && (connex != 18) && (connex != 26)) {
         fprintf(stderr, "%s() : bad value for connex : %d\n", F_NAME, connex);
         return 0;
     }
-
-    CT->root = SubtreeRoot[TarjanFind(T1, TarjanFind(T2, 0))];
-    for (i = 0; i < N; i++) {
-        CM[i] = TarjanFind(T2, i);
-    }
-    for (i = 0; i < N; i++) { // construction de la relation "father"
-        if (CT->tabnodes[i].nbsons > 0) {
-            for (sc = CT->tabnodes[i].sonlist; sc != NULL; sc = sc->next) {
-                son = sc->son;
-                CT->tabnodes[son].father = i;
-            }
-        }
-    }
-
-    k = 0;
-    for (i = 0; i < N; i++) {
-        if (CT->tabnodes[i].nbsons == 0) {
-            k++;
-        }
-    }
-    CT->nbleafs = k;
-#ifdef VERBOSE
-    printf("nombre de feuilles = %d\n", CT->nbleafs);
-#endif
-
-    TarjanTermine(T1);
-    TarjanTermine(T2);
-
-#ifdef ATTRIB_AREA
-    {
-        int32_t *area = (int32_t *)malloc(N * sizeof(int32_t));
-        if (area == NULL) {
-            fprintf(stderr, "%s() : malloc failed\n", F_NAME);
-            return 0;
-        }
-        ComputeArea(CT, CT->root, area);
-        for (i = 0; i < N; i++) {
-            CT->tabnodes[i].area = area[i];
-        }
-
-#ifdef ATTRIB_VOL
-        ComputeVol(CT, CT->root, area);
-        for (i = 0; i < N; i++) {
-            CT->tabnodes[i].vol = area[i];
-        }
-#endif
-
-        free(area);
-    }
-#endif
-
-    *CompTree = CT;
-    *CompMap = CM;
-    free(S);
-    free(SubtreeRoot);
-    return 1;
+    return ComponentTreeFromMaxtree(F, rs, ps / rs, N / ps, connex, CompTree, CompMap);
 } // ComponentTree3d()
 
 #ifdef TESTSORT
 int32_t main() {
     uint8_t F[20] = {25, 10, 1, 1, 0, 0, 1, 3, 5, 3, 2, 3, 4, 5, 7, 10, 11, 6, 3, 3};
     int32_t i;
-    int32_t *T = linsortimagedown((uint8_t *)F, 20);
+    index_t *T = linsortimagedown((uint8_t *)F, 20);
     for (i = 0; i < 20; i++) printf("F[T[%d]] = %d\n", i, F[T[i]]);
     free(T);
     T = linsortimageup((uint8_t *)F, 20);
@@ -860,7 +574,7 @@ int32_t main() {
     };
     int32_t i, rs = 3, cs = 5;
     ctree * CT = NULL;
-    int32_t * CM = NULL;
+    index_t * CM = NULL;
 
     ComponentTree(F, rs, rs*cs, 4, &CT, &CM);
     printf("component tree:\n");
@@ -868,7 +582,7 @@ int32_t main() {
     printf("component mapping:\n");
     for (i = 0; i < rs*cs; i++) {
         if (i % rs == 0) printf("\n");
-        printf("%3d ", CM[i]);
+        printf("%3d ", (int32_t)CM[i]);
     } /* for i */
     printf("\n");
 
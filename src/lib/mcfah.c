@@ -38,6 +38,7 @@ knowledge of the CeCILL license and that you accept its terms.
    fonctions pour la gestion d'une file d'attente hierarchique
 
    Michel Couprie 1996
+   Update 2026 : niveaux stockes dans des blocs contigus, niveaux sur 32 bits
 */
 
 /* un point d'une image F est reperee par son index */
@@ -55,20 +56,109 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <stdint.h>
 #include <sys/types.h>
 #include <stdlib.h>
+#include <string.h>
 #include <mcfah.h>
 
 /* #define TESTFah */
 /* #define VERBOSE */
 
+#define FAH_BASBITS 16
+#define FAH_BASMASK ((uint32_t)0xffff)
+#define FAH_NBLOCS  ((uint32_t)1 << FAH_BASBITS)
+#define FAH_CAPMIN  16
+
+/* ==================================== */
+static void FahBlocAgrandit(
+    FahBloc * B)
+/* ==================================== */
+/* bloc plein : on double sa taille */
+{
+    index_t i, cap = B->Cap ? 2 * B->Cap : FAH_CAPMIN;
+    index_t * T = (index_t *)malloc(cap * sizeof(index_t));
+    if (T == NULL) {
+        fprintf(stderr, "FahPush() : malloc failed\n");
+        exit(1);
+    }
+    for (i = 0; i < B->Nb; i++) {
+        T[i] = B->T[(B->Out + i) & (B->Cap - 1)];
+    }
+    free(B->T);
+    B->T = T;
+    B->Cap = cap;
+    B->Out = 0;
+} /* FahBlocAgrandit() */
+
+/* ==================================== */
+static inline void FahBlocPush(
+    FahBloc * B,
+    index_t V)
+/* ==================================== */
+{
+    if (B->Nb == B->Cap) {
+        FahBlocAgrandit(B);
+    }
+    B->T[(B->Out + B->Nb) & (B->Cap - 1)] = V;
+    B->Nb++;
+} /* FahBlocPush() */
+
+/* ==================================== */
+static inline index_t FahBlocPop(
+    FahBloc * B)
+/* ==================================== */
+{
+    index_t V = B->T[B->Out];
+    B->Out = (B->Out + 1) & (B->Cap - 1);
+    B->Nb--;
+    return V;
+} /* FahBlocPop() */
+
+/* ==================================== */
+static FahBloc * FahBlocsAgrandit(
+    FahBloc ** tab,
+    uint32_t * nb,
+    uint32_t i)
+/* ==================================== */
+/* agrandit le tableau *tab pour qu'il contienne le bloc i */
+{
+    uint32_t n = *nb ? *nb : FAH_CAPMIN;
+    FahBloc * t;
+    while (n <= i) {
+        n *= 2;
+    }
+    if (n > FAH_NBLOCS) {
+        n = FAH_NBLOCS;
+    }
+    t = (FahBloc *)realloc(*tab, n * sizeof(FahBloc));
+    if (t == NULL) {
+        fprintf(stderr, "FahPush() : malloc failed\n");
+        exit(1);
+    }
+    memset(t + *nb, 0, (n - *nb) * sizeof(FahBloc));
+    *tab = t;
+    *nb = n;
+    return &(t[i]);
+} /* FahBlocsAgrandit() */
+
+/* ==================================== */
+static inline FahBloc * FahBlocs(
+    FahBloc ** tab,
+    uint32_t * nb,
+    uint32_t i)
+/* ==================================== */
+/* retourne le bloc i du tableau *tab, en agrandissant celui-ci si besoin */
+{
+    if (i >= *nb) {
+        return FahBlocsAgrandit(tab, nb, i);
+    }
+    return &((*tab)[i]);
+} /* FahBlocs() */
+
 /* ==================================== */
 Fah * CreeFahVide(
     index_t taillemax)
 /* ==================================== */
 {
-    index_t i;
-    Fah * L = (Fah *)calloc(1,4 * sizeof(index_t) +
-                            (NPRIO+4)*sizeof(FahElt *) +
-                            taillemax*sizeof(FahElt));
+    Fah * L = (Fah *)calloc(1, sizeof(Fah));
     if (L == NULL) {
         fprintf(stderr, "CreeFahVide() : malloc failed\n");
         return NULL;
@@ -77,17 +167,6 @@ Fah * CreeFahVide(
     L->Util = 0;
     L->Maxutil = 0;
     L->Niv = 0;
-    for (i = 0; i < taillemax - 1; i++) {
-        L->Elts[i].Next = &(L->Elts[i + 1]);
-    }
-    L->Elts[taillemax - 1].Next = NULL;
-    L->Libre = &(L->Elts[0]);
-    for (i = 0; i < NPRIO; i++) {
-        L->Tete[i] = NULL;
-    }
-    L->Queue = NULL;
-    L->QueueUrg = NULL;
-    L->TeteUrg = NULL;
     return L;
 } /* CreeFahVide() */
 
@@ -95,21 +174,21 @@ Fah * CreeFahVide(
 void FahFlush(
     Fah * L)
 /* ==================================== */
+/* vide la fah ; les blocs alloues sont conserves */
 {
-    index_t i;
+    uint32_t i;
     L->Niv = 0;
     L->Util = 0;
-    for (i = 0; i < L->Max - 1; i++) {
-        L->Elts[i].Next = &(L->Elts[i + 1]);
+    L->Haut = 0;
+    L->UtilBas = 0;
+    L->UtilHaut = 0;
+    L->Urg.Nb = L->Urg.Out = 0;
+    for (i = 0; i < L->NbBas; i++) {
+        L->FahBas[i].Nb = L->FahBas[i].Out = 0;
     }
-    L->Elts[L->Max - 1].Next = NULL;
-    L->Libre = &(L->Elts[0]);
-    for (i = 0; i < NPRIO; i++) {
-        L->Tete[i] = NULL;
+    for (i = 0; i < L->NbHaut; i++) {
+        L->FahHaut[i].Nb = L->FahHaut[i].Out = 0;
     }
-    L->Queue = NULL;
-    L->QueueUrg = NULL;
-    L->TeteUrg = NULL;
 } /* FahFlush() */
 
 /* ==================================== */
@@ -117,7 +196,7 @@ int32_t FahVide(
     Fah * L)
 /* ==================================== */
 {
-    return ((L->QueueUrg == NULL) && (L->Queue == NULL));
+    return ((L->Urg.Nb == 0) && (L->UtilBas == 0) && (L->UtilHaut == 0));
 } /* FahVide() */
 
 /* ==================================== */
@@ -125,7 +204,7 @@ int32_t FahVideUrg(
     Fah * L)
 /* ==================================== */
 {
-    return (L->QueueUrg == NULL);
+    return (L->Urg.Nb == 0);
 } /* FahVideUrg() */
 
 /* ==================================== */
@@ -134,8 +213,25 @@ int32_t FahVideNiveau(
     int32_t niv)
 /* ==================================== */
 {
-    printf("FahVideNiveau: pas de sens avec la version impure de mcfah\n");
-    exit(0);
+    uint32_t n = (uint32_t)niv, h = n >> FAH_BASBITS;
+    index_t i;
+    FahBloc * B;
+    if ((L->UtilBas == 0) && (L->UtilHaut == 0)) {
+        return 1;
+    }
+    if (h == L->Haut) {
+        return ((n & FAH_BASMASK) >= L->NbBas) || (L->FahBas[n & FAH_BASMASK].Nb == 0);
+    }
+    if ((h < L->Haut) || (h >= L->NbHaut)) {
+        return 1;
+    }
+    B = &(L->FahHaut[h]);
+    for (i = 1; i < B->Nb; i += 2) {
+        if ((uint32_t)B->T[(B->Out + i) & (B->Cap - 1)] == n) {
+            return 0;
+        }
+    }
+    return 1;
 } /* FahVideNiveau() */
 
 /* ==================================== */
@@ -143,50 +239,86 @@ int32_t FahNiveau(
     Fah * L)
 /* ==================================== */
 {
-    if ((L->QueueUrg == NULL) && (L->Queue == NULL)) {
+    if (FahVide(L)) {
         fprintf(stderr, "erreur Fah vide\n");
         exit(1);
     }
-    return L->Niv;
+    return (int32_t)L->Niv;
 } /* FahNiveau() */
 
+/* ==================================== */
+uint32_t FahNiveauU32(
+    Fah * L)
+/* ==================================== */
+{
+    if (FahVide(L)) {
+        fprintf(stderr, "erreur Fah vide\n");
+        exit(1);
+    }
+    return L->Niv;
+} /* FahNiveauU32() */
+
+/* ==================================== */
+static void FahNiveauSuivant(
+    Fah * L)
+/* ==================================== */
+/* le niveau courant vient d'etre vide : recherche du niveau suivant */
+{
+    uint32_t i;
+    index_t n;
+    FahBloc * B;
+    if (L->UtilBas == 0) {
+        if (L->UtilHaut == 0) {
+            return;
+        }
+        /* passage au bloc de second rang suivant et redistribution de
+           ses points dans les blocs de niveaux (dans l'ordre d'arrivee) */
+        for (i = L->Haut + 1; L->FahHaut[i].Nb == 0; i++) ;
+        L->Haut = i;
+        B = &(L->FahHaut[i]);
+        n = B->Nb / 2;
+        L->UtilHaut -= n;
+        L->UtilBas = n;
+        L->Niv = (i << FAH_BASBITS) | FAH_BASMASK;
+        while (B->Nb > 0) {
+            index_t Po = FahBlocPop(B);
+            uint32_t Ni = (uint32_t)FahBlocPop(B);
+            FahBlocPush(FahBlocs(&(L->FahBas), &(L->NbBas), Ni & FAH_BASMASK), Po);
+            if (Ni < L->Niv) {
+                L->Niv = Ni;
+            }
+        }
+        B->Out = 0;
+        return;
+    }
+    for (i = (L->Niv & FAH_BASMASK) + 1; L->FahBas[i].Nb == 0; i++) ;
+    L->Niv = (L->Haut << FAH_BASBITS) | i;
+} /* FahNiveauSuivant() */
+
 /* ==================================== */
 index_t FahPop(
     Fah * L)
 /* ==================================== */
 {
     index_t V;
-    FahElt * FE = NULL;
-    if ((L->QueueUrg == NULL) && (L->Queue == NULL)) {
+    FahBloc * B;
+    if (FahVide(L)) {
         fprintf(stderr, "erreur Fah vide\n");
         exit(1);
     }
 
     L->Util--;
-    if (L->QueueUrg != NULL) {
-        V = L->QueueUrg->Point;
-        FE = L->QueueUrg->Next;
-        L->QueueUrg->Next = L->Libre;
-        L->Libre = L->QueueUrg;
-        L->QueueUrg = FE;
-        if (L->QueueUrg == NULL) {
-            L->TeteUrg = NULL;
-        }
-        return V;
+    if (L->Urg.Nb != 0) {
+        return FahBlocPop(&(L->Urg));
     }
 
-    if (L->Queue == L->Tete[L->Niv]) { /* on se prepare a effacer le dernier */
-        /* element du niveau courant: il faut */
-        L->Tete[L->Niv] = NULL;        /* annuler le pointeur de tete */
-        do {
-            (L->Niv)++; /* et incrementer le niveau */
-        } while ((L->Niv < NPRIO) && (L->Tete[L->Niv] == NULL));
+    B = &(L->FahBas[L->Niv & FAH_BASMASK]);
+    V = FahBlocPop(B);
+    L->UtilBas--;
+    if (B->Nb == 0) { /* on vient de prelever le dernier element du niveau */
+        B->Out = 0;
+        FahNiveauSuivant(L);
     }
-    V = L->Queue->Point;
-    FE = L->Queue->Next;
-    L->Queue->Next = L->Libre;
-    L->Libre = L->Queue;
-    L->Queue = FE;
     return V;
 } /* FahPop() */
 
@@ -195,86 +327,64 @@ index_t FahFirst(
     Fah * L)
 /* ==================================== */
 {
-    if ((L->QueueUrg == NULL) && (L->Queue == NULL)) {
+    if (FahVide(L)) {
         fprintf(stderr, "erreur Fah vide\n");
         exit(1);
     }
 
-    if (L->QueueUrg != NULL) {
-        return L->QueueUrg->Point;
+    if (L->Urg.Nb != 0) {
+        return L->Urg.T[L->Urg.Out];
     }
-    return L->Queue->Point;
+    return L->FahBas[L->Niv & FAH_BASMASK].T[L->FahBas[L->Niv & FAH_BASMASK].Out];
 } /* FahFirst() */
 
 /* ==================================== */
-void FahPush(
+void FahPushU32(
     Fah * L,
     index_t Po,
-    int32_t Ni)
+    uint32_t Ni)
 /* ==================================== */
 {
-    if (L->Libre == NULL) {
+    uint32_t h = Ni >> FAH_BASBITS;
+    if (L->Util >= L->Max) {
         fprintf(stderr, "erreur Fah pleine\n");
         exit(1);
     }
-    if (Ni >= NPRIO) {
-        fprintf(stderr, "erreur niveau = %d; max autorise = %d\n", Ni, NPRIO-1);
-        exit(1);
-    }
 
     L->Util++;
     if (L->Util > L->Maxutil) {
         L->Maxutil = L->Util;
     }
-    if (L->Queue == NULL) {  /* insertion dans une Fah vide */
-        L->Queue = L->Libre;
-        L->Libre = L->Libre->Next;
-        L->Queue->Point = Po;
+    if ((L->UtilBas == 0) && (L->UtilHaut == 0)) { /* insertion dans une Fah vide */
         L->Niv = Ni;
-        L->Queue->Next = NULL;
-        L->Tete[Ni] = L->Queue;
-    } /* if Fah Vide */
-    else if (Ni < L->Niv) {       /* si niveau depasse alors liste d'urgence */
-        if (L->QueueUrg == NULL) {  /* insertion dans une liste d'urgence vide */
-            L->QueueUrg = L->Libre;
-            L->Libre = L->Libre->Next;
-            L->QueueUrg->Point = Po;
-            L->QueueUrg->Next = NULL;
-            L->TeteUrg = L->QueueUrg;
-        } /* if L->QueueUrg */
-        else {
-            FahElt * FE = L->TeteUrg->Next;
-            L->TeteUrg->Next = L->Libre;
-            L->Libre = L->Libre->Next;
-            L->TeteUrg = L->TeteUrg->Next;
-            L->TeteUrg->Next = FE;
-            L->TeteUrg->Point = Po;
-        }
-    } /* fin traitement des cas d'urgence */
-    else if (L->Tete[Ni] != NULL) { /* insertion dans la liste de niveau Ni */
-        FahElt * FE = L->Tete[Ni]->Next;
-        L->Tete[Ni]->Next = L->Libre;
-        L->Libre = L->Libre->Next;
-        L->Tete[Ni] = L->Tete[Ni]->Next;
-        L->Tete[Ni]->Next = FE;
-        L->Tete[Ni]->Point = Po;
-    } else { /* (L->Tete[Ni] == NULL) */
-        FahElt * FE = NULL;
-        int32_t NiPrec = Ni;
-        while ((NiPrec >= 0) && (L->Tete[NiPrec] == NULL)) {
-            NiPrec--;
-        }
-        if (NiPrec < 0) {
-            fprintf(stderr, "erreur Fah pas de niveau precedent\n");
-            exit(1);
-        }
-        L->Tete[Ni] = L->Libre;
-        L->Libre = L->Libre->Next;
-        L->Tete[Ni]->Point = Po;
-        FE = L->Tete[NiPrec]->Next;
-        L->Tete[NiPrec]->Next = L->Tete[Ni];
-        L->Tete[Ni]->Next = FE;
+        L->Haut = h;
+        FahBlocPush(FahBlocs(&(L->FahBas), &(L->NbBas), Ni & FAH_BASMASK), Po);
+        L->UtilBas++;
+    } else if (Ni < L->Niv) { /* si niveau depasse alors liste d'urgence */
+        FahBlocPush(&(L->Urg), Po);
+    } else if (h == L->Haut) { /* insertion dans le bloc du niveau Ni */
+        FahBlocPush(FahBlocs(&(L->FahBas), &(L->NbBas), Ni & FAH_BASMASK), Po);
+        L->UtilBas++;
+    } else { /* insertion dans le bloc de second rang de Ni */
+        FahBloc * B = FahBlocs(&(L->FahHaut), &(L->NbHaut), h);
+        FahBlocPush(B, Po);
+        FahBlocPush(B, (index_t)Ni);
+        L->UtilHaut++;
     }
+} /* FahPushU32() */
+
+/* ==================================== */
+void FahPush(
+    Fah * L,
+    index_t Po,
+    int32_t Ni)
+/* ==================================== */
+{
+    if (Ni < 0) {
+        fprintf(stderr, "erreur niveau = %d; niveau negatif\n", Ni);
+        exit(1);
+    }
+    FahPushU32(L, Po, (uint32_t)Ni);
 } /* FahPush() */
 
 /* ==================================== */
@@ -282,52 +392,65 @@ void FahTermine(
     Fah * L)
 /* ==================================== */
 {
+    uint32_t i;
 #ifdef VERBOSE
     printf("Fah: taux d'utilisation: %g\n", (double)L->Maxutil / (double)L->Max);
 #endif
+    free(L->Urg.T);
+    for (i = 0; i < L->NbBas; i++) {
+        free(L->FahBas[i].T);
+    }
+    for (i = 0; i < L->NbHaut; i++) {
+        free(L->FahHaut[i].T);
+    }
+    free(L->FahBas);
+    free(L->FahHaut);
     free(L);
 } /* FahTermine() */
 
+/* ==================================== */
+static void FahBlocPrint(
+    FahBloc * B,
+    int32_t pas)
+/* ==================================== */
+{
+    index_t i;
+    for (i = 0; i < B->Nb; i += pas) {
+#ifdef MC_64_BITS
+        printf("%ld ", B->T[(B->Out + i) & (B->Cap - 1)]);
+#else
+        printf("%d ", B->T[(B->Out + i) & (B->Cap - 1)]);
+#endif
+    }
+} /* FahBlocPrint() */
+
 /* ==================================== */
 void FahPrint(
     Fah * L)
 /* ==================================== */
 {
-    int32_t i;
-    FahElt * FE = NULL;
+    uint32_t i;
     if (FahVide(L)) {
         printf("[]\n");
         return;
     }
-    FE = L->QueueUrg;
-    if (FE != NULL) {
+    if (L->Urg.Nb != 0) {
         printf("Urg [ ");
-        for (; FE != NULL; FE = FE->Next) {
-#ifdef MC_64_BITS
-            printf("%ld ", FE->Point);
-        }
-#else
-            printf("%d ", FE->Point);
-#endif
+        FahBlocPrint(&(L->Urg), 1);
         printf(" ]\n");
     }
-    FE = L->Queue;
-    for (i = L->Niv; i < NPRIO; i++) {
-        if (L->Tete[i] != NULL) {
-            printf("%d [ ", i);
-            for (; FE != L->Tete[i]; FE = FE->Next) {
-#ifdef MC_64_BITS
-                printf("%ld ", FE->Point);
-            }
-#else
-                printf("%d ", FE->Point);
-#endif
-#ifdef MC_64_BITS
-            printf("%ld ]\n", FE->Point);
-#else
-            printf("%d ]\n", FE->Point);
-#endif
-            FE = FE->Next;
+    for (i = 0; i < L->NbBas; i++) {
+        if (L->FahBas[i].Nb != 0) {
+            printf("%u [ ", (L->Haut << FAH_BASBITS) | i);
+            FahBlocPrint(&(L->FahBas[i]), 1);
+            printf("]\n");
+        }
+    }
+    for (i = L->Haut + 1; i < L->NbHaut; i++) {
+        if (L->FahHaut[i].Nb != 0) {
+            printf("%u.. [ ", i << FAH_BASBITS);
+            FahBlocPrint(&(L->FahHaut[i]), 2);
+            printf("]\n");
         }
     }
 } /* FahPrint() */
@@ -0,0 +1,860 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Librairie mcfft :
+
+   transformee de Fourier discrete rapide (FFT) 1D et 2D, pour des tailles
+   quelconques, reentrante.
+
+   La taille n est decomposee en facteurs 4, 2, 3, 5 et autres facteurs
+   premiers. Chaque etage est un papillon de Cooley-Tukey (decimation
+   temporelle, hors place) ; les facteurs de rotation sont calcules une
+   fois pour toutes a la creation du plan. Si n possede un facteur premier
+   superieur a MCFFT_MAXRADIX, la transformee est calculee par
+   l'algorithme de Bluestein (chirp-z) : produit de convolution de taille
+   m >= 2n-1 (facteurs premiers 2, 3 et 5), calcule par FFT.
+
+   Un plan reel (mcfft_creeplanreel) calcule la transformee d'un signal
+   reel de taille n paire par une transformee complexe de taille n/2
+   (echantillons pairs en partie reelle, impairs en partie imaginaire),
+   suivie d'une recombinaison. Seuls les n/2+1 premiers coefficients sont
+   produits, les autres s'en deduisant par symetrie hermitienne.
+
+   Conventions :
+   directe :  X(k) = sum_j x(j) exp(-2 i pi jk / n)
+   inverse :  x(j) = 1/n sum_k X(k) exp(2 i pi jk / n)
+
+   Les plans ne sont pas modifies par les transformees et peuvent etre
+   partages entre threads. Les fonctions 2D repartissent les lignes, puis
+   les colonnes, entre les threads de mcthreads.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <mcutil.h>
+#include <mcthreads.h>
+#include <mcfft.h>
+
+#define MCFFT_PI 3.1415926535897932
+#define MCFFT_BLOC 16 /* nombre de colonnes transformees ensemble */
+
+/* ==================================== */
+static dcomplex mcfft_cmul(dcomplex a, dcomplex b)
+/* ==================================== */
+{
+    dcomplex r;
+    r.re = a.re * b.re - a.im * b.im;
+    r.im = a.re * b.im + a.im * b.re;
+    return r;
+} /* mcfft_cmul() */
+
+/* ==================================== */
+static void mcfft_twiddles(dcomplex *tw, int32_t n, int32_t nb)
+/* ==================================== */
+/* tw[k] = exp(-2 i pi k / n), 0 <= k < nb */
+{
+    int32_t k;
+    for (k = 0; k < nb; k++) {
+        double a = -2.0 * MCFFT_PI * (double)k / (double)n;
+        tw[k].re = cos(a);
+        tw[k].im = sin(a);
+    }
+} /* mcfft_twiddles() */
+
+/* ==================================== */
+static int32_t mcfft_factor(int32_t n, int32_t *fact)
+/* ==================================== */
+/*
+  decompose n en facteurs (4 d'abord, puis 2, 3, 5, ...) ; retourne le
+  plus grand facteur
+*/
+{
+    int32_t p = 4, pmax = 1, nf = 0;
+    double s = floor(sqrt((double)n));
+    do {
+        while (n % p) {
+            switch (p) {
+            case 4:
+                p = 2;
+                break;
+            case 2:
+                p = 3;
+                break;
+            default:
+                p += 2;
+                break;
+            }
+            if (p > s) {
+                p = n;
+            }
+        }
+        n /= p;
+        fact[2 * nf] = p;
+        fact[2 * nf + 1] = n;
+        nf++;
+        pmax = mcmax(pmax, p);
+    } while (n > 1);
+    return pmax;
+} /* mcfft_factor() */
+
+/* ==================================== */
+mcfft_plan * mcfft_creeplan(int32_t n)
+/* ==================================== */
+#undef F_NAME
+#define F_NAME "mcfft_creeplan"
+{
+    mcfft_plan *p;
+    dcomplex *work;
+    int32_t k;
+
+    if (n < 1) {
+        fprintf(stderr, "%s: bad size %d\n", F_NAME, n);
+        return NULL;
+    }
+    p = (mcfft_plan *)calloc(1, sizeof(mcfft_plan));
+    if (p == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return NULL;
+    }
+    p->n = n;
+    if ((n == 1) || (mcfft_factor(n, p->fact) <= MCFFT_MAXRADIX)) {
+        p->tw = (dcomplex *)malloc(n * sizeof(dcomplex));
+        if (p->tw == NULL) {
+            goto fail;
+        }
+        mcfft_twiddles(p->tw, n, n);
+        if (n == 1) {
+            p->fact[0] = 1;
+            p->fact[1] = 1;
+        }
+        return p;
+    }
+
+    /* Bluestein */
+    p->m = mcfft_goodsize(2 * n - 1);
+    p->bw = (dcomplex *)malloc(n * sizeof(dcomplex));
+    p->bB = (dcomplex *)calloc(p->m, sizeof(dcomplex));
+    p->sub = mcfft_creeplan(p->m);
+    if ((p->bw == NULL) || (p->bB == NULL) || (p->sub == NULL)) {
+        goto fail;
+    }
+    for (k = 0; k < n; k++) {
+        /* k^2 mod 2n pour garder la precision */
+        double a = -MCFFT_PI * (double)(((int64_t)k * k) % (2 * (int64_t)n)) / (double)n;
+        p->bw[k].re = cos(a);
+        p->bw[k].im = sin(a);
+    }
+    p->bB[0].re = p->bw[0].re / p->m;
+    p->bB[0].im = -p->bw[0].im / p->m;
+    for (k = 1; k < n; k++) {
+        p->bB[k].re = p->bB[p->m - k].re = p->bw[k].re / p->m;
+        p->bB[k].im = p->bB[p->m - k].im = -p->bw[k].im / p->m;
+    }
+    work = (dcomplex *)malloc(mcfft_worksize(p->sub) * sizeof(dcomplex));
+    if (work == NULL) {
+        goto fail;
+    }
+    mcfft(p->sub, p->bB, MCFFT_FORWARD, work);
+    free(work);
+    return p;
+
+fail:
+    fprintf(stderr, "%s: malloc failed\n", F_NAME);
+    mcfft_termineplan(p);
+    return NULL;
+} /* mcfft_creeplan() */
+
+/* ==================================== */
+mcfft_plan * mcfft_creeplanreel(int32_t n)
+/* ==================================== */
+#undef F_NAME
+#define F_NAME "mcfft_creeplanreel"
+{
+    mcfft_plan *p;
+
+    if (n < 1) {
+        fprintf(stderr, "%s: bad size %d\n", F_NAME, n);
+        return NULL;
+    }
+    p = (mcfft_plan *)calloc(1, sizeof(mcfft_plan));
+    if (p == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return NULL;
+    }
+    p->n = n;
+    p->real = 1;
+    if (n % 2) {
+        p->half = mcfft_creeplan(n);
+    } else {
+        p->half = mcfft_creeplan(n / 2);
+        p->rtw = (dcomplex *)malloc((n / 2 + 1) * sizeof(dcomplex));
+        if (p->rtw != NULL) {
+            mcfft_twiddles(p->rtw, n, n / 2 + 1);
+        }
+    }
+    if ((p->half == NULL) || ((n % 2 == 0) && (p->rtw == NULL))) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        mcfft_termineplan(p);
+        return NULL;
+    }
+    return p;
+} /* mcfft_creeplanreel() */
+
+/* ==================================== */
+void mcfft_termineplan(mcfft_plan *p)
+/* ==================================== */
+{
+    if (p == NULL) {
+        return;
+    }
+    free(p->tw);
+    free(p->bw);
+    free(p->bB);
+    mcfft_termineplan(p->sub);
+    mcfft_termineplan(p->half);
+    free(p->rtw);
+    free(p);
+} /* mcfft_termineplan() */
+
+/* ==================================== */
+index_t mcfft_worksize(mcfft_plan *p)
+/* ==================================== */
+/* taille (en dcomplex) du tableau de travail d'une transformee */
+{
+    if (p->real) {
+        return p->half->n + mcfft_worksize(p->half);
+    }
+    if (p->m) {
+        return (index_t)p->m + mcfft_worksize(p->sub);
+    }
+    return p->n;
+} /* mcfft_worksize() */
+
+/* ==================================== */
+int32_t mcfft_goodsize(int32_t n)
+/* ==================================== */
+/* plus petit entier >= n dont les seuls facteurs premiers sont 2, 3 et 5 */
+{
+    int32_t m;
+    for (;; n++) {
+        m = n;
+        while (m % 2 == 0) {
+            m /= 2;
+        }
+        while (m % 3 == 0) {
+            m /= 3;
+        }
+        while (m % 5 == 0) {
+            m /= 5;
+        }
+        if (m == 1) {
+            return n;
+        }
+    }
+} /* mcfft_goodsize() */
+
+/* ==================================== */
+/* papillons (transformee directe)      */
+/* ==================================== */
+
+static void mcfft_bfly2(dcomplex *F, index_t fstride, const mcfft_plan *p, int32_t m)
+{
+    dcomplex *F2 = F + m, t;
+    int32_t k;
+    for (k = 0; k < m; k++) {
+        t = mcfft_cmul(F2[k], p->tw[k * fstride]);
+        F2[k].re = F[k].re - t.re;
+        F2[k].im = F[k].im - t.im;
+        F[k].re += t.re;
+        F[k].im += t.im;
+    }
+} /* mcfft_bfly2() */
+
+static void mcfft_bfly3(dcomplex *F, index_t fstride, const mcfft_plan *p, int32_t m)
+{
+    dcomplex s0, s1, s2, s3;
+    double epi3 = p->tw[fstride * m].im;
+    int32_t k;
+    for (k = 0; k < m; k++) {
+        s1 = mcfft_cmul(F[k + m], p->tw[k * fstride]);
+        s2 = mcfft_cmul(F[k + 2 * m], p->tw[2 * k * fstride]);
+        s3.re = s1.re + s2.re;
+        s3.im = s1.im + s2.im;
+        s0.re = (s1.re - s2.re) * epi3;
+        s0.im = (s1.im - s2.im) * epi3;
+        F[k + m].re = F[k].re - 0.5 * s3.re;
+        F[k + m].im = F[k].im - 0.5 * s3.im;
+        F[k].re += s3.re;
+        F[k].im += s3.im;
+        F[k + 2 * m].re = F[k + m].re + s0.im;
+        F[k + 2 * m].im = F[k + m].im - s0.re;
+        F[k + m].re -= s0.im;
+        F[k + m].im += s0.re;
+    }
+} /* mcfft_bfly3() */
+
+static void mcfft_bfly4(dcomplex *F, index_t fstride, const mcfft_plan *p, int32_t m)
+{
+    dcomplex s0, s1, s2, s3, s4, s5;
+    int32_t k;
+    for (k = 0; k < m; k++) {
+        s0 = mcfft_cmul(F[k + m], p->tw[k * fstride]);
+        s1 = mcfft_cmul(F[k + 2 * m], p->tw[2 * k * fstride]);
+        s2 = mcfft_cmul(F[k + 3 * m], p->tw[3 * k * fstride]);
+        s5.re = F[k].re - s1.re;
+        s5.im = F[k].im - s1.im;
+        F[k].re += s1.re;
+        F[k].im += s1.im;
+        s3.re = s0.re + s2.re;
+        s3.im = s0.im + s2.im;
+        s4.re = s0.re - s2.re;
+        s4.im = s0.im - s2.im;
+        F[k + 2 * m].re = F[k].re - s3.re;
+        F[k + 2 * m].im = F[k].im - s3.im;
+        F[k].re += s3.re;
+        F[k].im += s3.im;
+        F[k + m].re = s5.re + s4.im;
+        F[k + m].im = s5.im - s4.re;
+        F[k + 3 * m].re = s5.re - s4.im;
+        F[k + 3 * m].im = s5.im + s4.re;
+    }
+} /* mcfft_bfly4() */
+
+static void mcfft_bfly5(dcomplex *F, index_t fstride, const mcfft_plan *p, int32_t m)
+{
+    dcomplex s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12;
+    dcomplex ya = p->tw[fstride * m], yb = p->tw[2 * fstride * m];
+    dcomplex *F0 = F, *F1 = F + m, *F2 = F + 2 * m, *F3 = F + 3 * m, *F4 = F + 4 * m;
+    int32_t u;
+    for (u = 0; u < m; u++) {
+        s0 = F0[u];
+        s1 = mcfft_cmul(F1[u], p->tw[u * fstride]);
+        s2 = mcfft_cmul(F2[u], p->tw[2 * u * fstride]);
+        s3 = mcfft_cmul(F3[u], p->tw[3 * u * fstride]);
+        s4 = mcfft_cmul(F4[u], p->tw[4 * u * fstride]);
+        s7.re = s1.re + s4.re;
+        s7.im = s1.im + s4.im;
+        s10.re = s1.re - s4.re;
+        s10.im = s1.im - s4.im;
+        s8.re = s2.re + s3.re;
+        s8.im = s2.im + s3.im;
+        s9.re = s2.re - s3.re;
+        s9.im = s2.im - s3.im;
+        F0[u].re += s7.re + s8.re;
+        F0[u].im += s7.im + s8.im;
+        s5.re = s0.re + s7.re * ya.re + s8.re * yb.re;
+        s5.im = s0.im + s7.im * ya.re + s8.im * yb.re;
+        s6.re = s10.im * ya.im + s9.im * yb.im;
+        s6.im = -s10.re * ya.im - s9.re * yb.im;
+        F1[u].re = s5.re - s6.re;
+        F1[u].im = s5.im - s6.im;
+        F4[u].re = s5.re + s6.re;
+        F4[u].im = s5.im + s6.im;
+        s11.re = s0.re + s7.re * yb.re + s8.re * ya.re;
+        s11.im = s0.im + s7.im * yb.re + s8.im * ya.re;
+        s12.re = -s10.im * yb.im + s9.im * ya.im;
+        s12.im = s10.re * yb.im - s9.re * ya.im;
+        F2[u].re = s11.re + s12.re;
+        F2[u].im = s11.im + s12.im;
+        F3[u].re = s11.re - s12.re;
+        F3[u].im = s11.im - s12.im;
+    }
+} /* mcfft_bfly5() */
+
+static void mcfft_bflygen(dcomplex *F, index_t fstride, const mcfft_plan *p, int32_t m, int32_t r)
+/*
+  radix r premier impair : rotation des entrees puis DFT de taille r, en
+  regroupant les termes q et r-q (r(r-1)/2 produits reels par sortie)
+*/
+{
+    dcomplex s[MCFFT_MAXRADIX], a[MCFFT_MAXRADIX], rt[MCFFT_MAXRADIX], R, I;
+    int32_t u, q, k, j, h = r / 2;
+    for (q = 0; q < r; q++) {
+        rt[q] = p->tw[q * fstride * m]; /* racines r-iemes de l'unite */
+    }
+    for (u = 0; u < m; u++) {
+        s[0] = F[u];
+        for (q = 1; q < r; q++) {
+            s[q] = mcfft_cmul(F[u + q * m], p->tw[q * u * fstride]);
+        }
+        R = s[0];
+        for (q = 1; q <= h; q++) {
+            a[q].re = s[q].re + s[r - q].re; /* partie paire */
+            a[q].im = s[q].im + s[r - q].im;
+            a[r - q].re = s[q].re - s[r - q].re; /* partie impaire */
+            a[r - q].im = s[q].im - s[r - q].im;
+            R.re += a[q].re;
+            R.im += a[q].im;
+        }
+        F[u] = R;
+        for (k = 1; k <= h; k++) {
+            R = s[0];
+            I.re = I.im = 0.0;
+            for (q = 1, j = k; q <= h; q++) {
+                R.re += a[q].re * rt[j].re;
+                R.im += a[q].im * rt[j].re;
+                I.re += a[r - q].re * rt[j].im;
+                I.im += a[r - q].im * rt[j].im;
+                j += k;
+                if (j >= r) {
+                    j -= r;
+                }
+            }
+            F[u + k * m].re = R.re - I.im;
+            F[u + k * m].im = R.im + I.re;
+            F[u + (r - k) * m].re = R.re + I.im;
+            F[u + (r - k) * m].im = R.im - I.re;
+        }
+    }
+} /* mcfft_bflygen() */
+
+/* ==================================== */
+static void mcfft_work(dcomplex *F, const dcomplex *f, index_t fstride,
+                       const int32_t *fact, const mcfft_plan *p)
+/* ==================================== */
+/* transformee directe de f (pas fstride) dans F, par etages successifs */
+{
+    dcomplex *F0 = F, *Fend;
+    int32_t r = *fact++;              /* radix */
+    int32_t m = *fact++;              /* taille restante */
+
+    Fend = F + (index_t)r * m;
+    if (m == 1) {
+        do {
+            *F = *f;
+            f += fstride;
+        } while (++F != Fend);
+    } else {
+        do {
+            mcfft_work(F, f, fstride * r, fact, p);
+            f += fstride;
+        } while ((F += m) != Fend);
+    }
+    F = F0;
+    switch (r) {
+    case 1:
+        break;
+    case 2:
+        mcfft_bfly2(F, fstride, p, m);
+        break;
+    case 3:
+        mcfft_bfly3(F, fstride, p, m);
+        break;
+    case 4:
+        mcfft_bfly4(F, fstride, p, m);
+        break;
+    case 5:
+        mcfft_bfly5(F, fstride, p, m);
+        break;
+    default:
+        mcfft_bflygen(F, fstride, p, m, r);
+        break;
+    }
+} /* mcfft_work() */
+
+/* ==================================== */
+static void mcfft_forward(mcfft_plan *p, dcomplex *x, dcomplex *work)
+/* ==================================== */
+{
+    index_t k, n = p->n;
+    if (p->m == 0) {
+        for (k = 0; k < n; k++) {
+            work[k] = x[k];
+        }
+        mcfft_work(x, work, 1, p->fact, p);
+    } else {
+        /* Bluestein : X(k) = bw(k) . ((x.bw) * conj(bw))(k) */
+        dcomplex *a = work;
+        for (k = 0; k < n; k++) {
+            a[k] = mcfft_cmul(x[k], p->bw[k]);
+        }
+        for (; k < p->m; k++) {
+            a[k].re = a[k].im = 0.0;
+        }
+        mcfft_forward(p->sub, a, work + p->m);
+        for (k = 0; k < p->m; k++) {
+            a[k] = mcfft_cmul(a[k], p->bB[k]);
+            a[k].im = -a[k].im; /* transformee inverse par conjugaison */
+        }
+        mcfft_forward(p->sub, a, work + p->m);
+        for (k = 0; k < n; k++) {
+            a[k].im = -a[k].im;
+            x[k] = mcfft_cmul(a[k], p->bw[k]);
+        }
+    }
+} /* mcfft_forward() */
+
+/* ==================================== */
+int32_t mcfft(mcfft_plan *p, dcomplex *x, int32_t dir, dcomplex *work)
+/* ==================================== */
+/*
+  transformee (dir = MCFFT_FORWARD) ou transformee inverse (MCFFT_INVERSE)
+  de x, en place. work : tableau de mcfft_worksize(p) elements, ou NULL
+  (alloue puis libere par la fonction).
+*/
+#undef F_NAME
+#define F_NAME "mcfft"
+{
+    dcomplex *w = work;
+    index_t k, n = p->n;
+    double s;
+
+    if (w == NULL) {
+        w = (dcomplex *)malloc(mcfft_worksize(p) * sizeof(dcomplex));
+        if (w == NULL) {
+            fprintf(stderr, "%s: malloc failed\n", F_NAME);
+            return 0;
+        }
+    }
+    if (dir == MCFFT_FORWARD) {
+        mcfft_forward(p, x, w);
+    } else {
+        /* inverse(x) = conj(directe(conj(x))) / n */
+        for (k = 0; k < n; k++) {
+            x[k].im = -x[k].im;
+        }
+        mcfft_forward(p, x, w);
+        s = 1.0 / (double)n;
+        for (k = 0; k < n; k++) {
+            x[k].re *= s;
+            x[k].im *= -s;
+        }
+    }
+    if (work == NULL) {
+        free(w);
+    }
+    return 1;
+} /* mcfft() */
+
+/* ==================================== */
+int32_t mcfft_r2c(mcfft_plan *p, double *x, dcomplex *X, dcomplex *work)
+/* ==================================== */
+/*
+  transformee directe du signal reel x (n elements) : X recoit les
+  coefficients 0 .. n/2 (n/2+1 elements). p : plan reel.
+*/
+#undef F_NAME
+#define F_NAME "mcfft_r2c"
+{
+    dcomplex *w = work, *z, A, B, D, E;
+    index_t k, h;
+
+    if (w == NULL) {
+        w = (dcomplex *)malloc(mcfft_worksize(p) * sizeof(dcomplex));
+        if (w == NULL) {
+            fprintf(stderr, "%s: malloc failed\n", F_NAME);
+            return 0;
+        }
+    }
+    z = w;
+    if (p->n % 2) {
+        for (k = 0; k < p->n; k++) {
+            z[k].re = x[k];
+            z[k].im = 0.0;
+        }
+        mcfft_forward(p->half, z, w + p->n);
+        for (k = 0; k <= p->n / 2; k++) {
+            X[k] = z[k];
+        }
+    } else {
+        h = p->n / 2;
+        for (k = 0; k < h; k++) {
+            z[k].re = x[2 * k];
+            z[k].im = x[2 * k + 1];
+        }
+        mcfft_forward(p->half, z, w + h);
+        for (k = 0; k <= h; k++) {
+            A = z[k % h];
+            B = z[(h - k) % h];
+            B.im = -B.im;
+            /* E : TF des points pairs, D : TF des points impairs */
+            E.re = 0.5 * (A.re + B.re);
+            E.im = 0.5 * (A.im + B.im);
+            D.re = 0.5 * (A.im - B.im);
+            D.im = -0.5 * (A.re - B.re);
+            D = mcfft_cmul(D, p->rtw[k]);
+            X[k].re = E.re + D.re;
+            X[k].im = E.im + D.im;
+        }
+    }
+    if (work == NULL) {
+        free(w);
+    }
+    return 1;
+} /* mcfft_r2c() */
+
+/* ==================================== */
+int32_t mcfft_c2r(mcfft_plan *p, dcomplex *X, double *x, dcomplex *work)
+/* ==================================== */
+/*
+  transformee inverse du spectre hermitien X (coefficients 0 .. n/2) :
+  x recoit le signal reel (n elements). p : plan reel.
+*/
+#undef F_NAME
+#define F_NAME "mcfft_c2r"
+{
+    dcomplex *w = work, *z, A, B, D, E, W;
+    index_t k, h, n = p->n;
+    double s;
+
+    if (w == NULL) {
+        w = (dcomplex *)malloc(mcfft_worksize(p) * sizeof(dcomplex));
+        if (w == NULL) {
+            fprintf(stderr, "%s: malloc failed\n", F_NAME);
+            return 0;
+        }
+    }
+    z = w;
+    if (n % 2) {
+        /* spectre complet par symetrie hermitienne, puis inverse par conjugaison */
+        for (k = 0; k <= n / 2; k++) {
+            z[k].re = X[k].re;
+            z[k].im = -X[k].im;
+        }
+        for (; k < n; k++) {
+            z[k] = X[n - k];
+        }
+        mcfft_forward(p->half, z, w + n);
+        s = 1.0 / (double)n;
+        for (k = 0; k < n; k++) {
+            x[k] = z[k].re * s;
+        }
+    } else {
+        h = n / 2;
+        for (k = 0; k < h; k++) {
+            A = X[k];
+            B = X[h - k];
+            B.im = -B.im;
+            E.re = 0.5 * (A.re + B.re);
+            E.im = 0.5 * (A.im + B.im);
+            D.re = 0.5 * (A.re - B.re);
+            D.im = 0.5 * (A.im - B.im);
+            W = p->rtw[k];
+            W.im = -W.im;
+            D = mcfft_cmul(D, W);
+            /* z = E + i D, conjugue pour la transformee inverse */
+            z[k].re = E.re - D.im;
+            z[k].im = -(E.im + D.re);
+        }
+        mcfft_forward(p->half, z, w + h);
+        s = 1.0 / (double)h;
+        for (k = 0; k < h; k++) {
+            x[2 * k] = z[k].re * s;
+            x[2 * k + 1] = -z[k].im * s;
+        }
+    }
+    if (work == NULL) {
+        free(w);
+    }
+    return 1;
+} /* mcfft_c2r() */
+
+/* ==================================== */
+/* transformees 2D                      */
+/* ==================================== */
+
+typedef struct {
+    dcomplex *a;                     /* tableau complexe (cs lignes de rsa elements) */
+    float *r;                        /* image reelle (cs lignes de rs elements) */
+    int32_t rs, cs, rsa;
+    int32_t dir;
+    mcfft_plan *p;
+    int32_t nbands;
+    int32_t err;
+} mcfft2d_job;
+
+/* ==================================== */
+static void mcfft2d_rows(void *arg, int32_t band)
+/* ==================================== */
+{
+    mcfft2d_job *J = (mcfft2d_job *)arg;
+    index_t first, last, y, x;
+    dcomplex *w;
+    double *l = NULL;
+
+    mcthreads_band(J->cs, J->nbands, band, &first, &last);
+    w = (dcomplex *)malloc(mcfft_worksize(J->p) * sizeof(dcomplex));
+    if (J->r != NULL) {
+        l = (double *)malloc(J->rs * sizeof(double));
+    }
+    if ((w == NULL) || ((J->r != NULL) && (l == NULL))) {
+        J->err = 1;
+        free(w);
+        free(l);
+        return;
+    }
+    for (y = first; y < last; y++) {
+        if (J->r == NULL) {
+            mcfft(J->p, J->a + y * J->rsa, J->dir, w);
+        } else if (J->dir == MCFFT_FORWARD) {
+            for (x = 0; x < J->rs; x++) {
+                l[x] = J->r[y * J->rs + x];
+            }
+            mcfft_r2c(J->p, l, J->a + y * J->rsa, w);
+        } else {
+            mcfft_c2r(J->p, J->a + y * J->rsa, l, w);
+            for (x = 0; x < J->rs; x++) {
+                J->r[y * J->rs + x] = (float)l[x];
+            }
+        }
+    }
+    free(w);
+    free(l);
+} /* mcfft2d_rows() */
+
+/* ==================================== */
+static void mcfft2d_cols(void *arg, int32_t band)
+/* ==================================== */
+/* les colonnes sont traitees par blocs de MCFFT_BLOC (acces memoire contigus) */
+{
+    mcfft2d_job *J = (mcfft2d_job *)arg;
+    index_t first, last, y, x, x0, nb, b;
+    dcomplex *w, *c;
+
+    mcthreads_band(J->rsa, J->nbands, band, &first, &last);
+    c = (dcomplex *)malloc((MCFFT_BLOC * J->cs + mcfft_worksize(J->p)) * sizeof(dcomplex));
+    if (c == NULL) {
+        J->err = 1;
+        return;
+    }
+    w = c + MCFFT_BLOC * J->cs;
+    for (x0 = first; x0 < last; x0 += MCFFT_BLOC) {
+        nb = mcmin(MCFFT_BLOC, last - x0);
+        for (y = 0; y < J->cs; y++) {
+            for (b = 0, x = x0; b < nb; b++, x++) {
+                c[b * J->cs + y] = J->a[y * J->rsa + x];
+            }
+        }
+        for (b = 0; b < nb; b++) {
+            mcfft(J->p, c + b * J->cs, J->dir, w);
+        }
+        for (y = 0; y < J->cs; y++) {
+            for (b = 0, x = x0; b < nb; b++, x++) {
+                J->a[y * J->rsa + x] = c[b * J->cs + y];
+            }
+        }
+    }
+    free(c);
+} /* mcfft2d_cols() */
+
+/* ==================================== */
+static int32_t mcfft2d_pass(mcfft2d_job *J, int32_t cols)
+/* ==================================== */
+{
+    int32_t n = cols ? J->cs : J->rs;
+    J->p = (J->r != NULL) && !cols ? mcfft_creeplanreel(n) : mcfft_creeplan(n);
+    if (J->p == NULL) {
+        return 0;
+    }
+    J->err = 0;
+    J->nbands = mcthreads_nbands(cols ? J->rsa : J->cs);
+    mcthreads_run(J->nbands, cols ? mcfft2d_cols : mcfft2d_rows, J);
+    mcfft_termineplan(J->p);
+    return !J->err;
+} /* mcfft2d_pass() */
+
+/* ==================================== */
+int32_t mcfft2d(dcomplex *a, int32_t rs, int32_t cs, int32_t dir)
+/* ==================================== */
+/* transformee 2D en place de a (cs lignes de rs elements) */
+#undef F_NAME
+#define F_NAME "mcfft2d"
+{
+    mcfft2d_job J;
+    J.a = a;
+    J.r = NULL;
+    J.rs = J.rsa = rs;
+    J.cs = cs;
+    J.dir = dir;
+    if (!mcfft2d_pass(&J, 0) || !mcfft2d_pass(&J, 1)) {
+        fprintf(stderr, "%s: failed\n", F_NAME);
+        return 0;
+    }
+    return 1;
+} /* mcfft2d() */
+
+/* ==================================== */
+int32_t mcfft2d_r2c(float *in, int32_t rs, int32_t cs, dcomplex *out)
+/* ==================================== */
+/*
+  transformee 2D directe de l'image reelle in (cs lignes de rs elements) :
+  out recoit cs lignes de rs/2+1 coefficients (les autres s'en deduisent
+  par symetrie hermitienne).
+*/
+#undef F_NAME
+#define F_NAME "mcfft2d_r2c"
+{
+    mcfft2d_job J;
+    J.a = out;
+    J.r = in;
+    J.rs = rs;
+    J.rsa = rs / 2 + 1;
+    J.cs = cs;
+    J.dir = MCFFT_FORWARD;
+    if (!mcfft2d_pass(&J, 0) || !mcfft2d_pass(&J, 1)) {
+        fprintf(stderr, "%s: failed\n", F_NAME);
+        return 0;
+    }
+    return 1;
+} /* mcfft2d_r2c() */
+
+/* ==================================== */
+int32_t mcfft2d_c2r(dcomplex *in, int32_t rs, int32_t cs, float *out)
+/* ==================================== */
+/*
+  transformee 2D inverse de in (cs lignes de rs/2+1 coefficients, detruit)
+  : out recoit l'image reelle (cs lignes de rs elements).
+*/
+#undef F_NAME
+#define F_NAME "mcfft2d_c2r"
+{
+    mcfft2d_job J;
+    J.a = in;
+    J.r = out;
+    J.rs = rs;
+    J.rsa = rs / 2 + 1;
+    J.cs = cs;
+    J.dir = MCFFT_INVERSE;
+    if (!mcfft2d_pass(&J, 1) || !mcfft2d_pass(&J, 0)) {
+        fprintf(stderr, "%s: failed\n", F_NAME);
+        return 0;
+    }
+    return 1;
+} /* mcfft2d_c2r() */
@@ -42,6 +42,7 @@ knowledge of the CeCILL license and that you accept its terms.
       février 2005 : LCA (non efficace)
       juillet-août 2009 : CircuitsNiveaux, BellmanSC, Forêts...
       octobre 2012 : ldrawgraph
+      octobre 2026 : tas binaire pour Dijkstra, graphes compacts (CSR)
 */
 
 #include <stdio.h>
@@ -1115,23 +1116,6 @@ static boolean * EnsembleVide(int32_t n)
     return Ca;
 } /* EnsembleVide() */
 
-/* ====================================================================== */
-/*! \fn int32_t * ListeVide(int32_t n)
-    \param n (entrée) : taille max de la liste.
-    \return un tableau de \b n entiers
-    \brief alloue et initialise un tableau de \b n entiers
-*/
-static int32_t * ListeVide(int32_t n)
-/* ====================================================================== */
-{
-    int32_t *Ca = (int32_t *)calloc(n, sizeof(int32_t));
-    if (Ca == NULL) {
-        fprintf(stderr, "ListeVide : calloc failed\n");
-        exit(0);
-    }
-    return Ca;
-} /* ListeVide() */
-
 /* ====================================================================== */
 /*! \fn int32_t Degre(graphe * g, int32_t s)
     \param g (entrée) : un graphe
@@ -1985,6 +1969,114 @@ void DistRoot(graphe * g, int32_t r)
 /* ====================================================================== */
 /* ====================================================================== */
 
+/* ====================================================================== */
+/* Tas binaire de sommets (file de priorite pour Dijkstra et DijkstraCSR).
+   Les valeurs des sommets sont lues dans le tableau val ; pos permet de
+   retrouver un sommet deja present dans le tas lorsque sa valeur diminue. */
+/* ====================================================================== */
+
+#define TAS_ABSENT -1
+#define TAS_EXTRAIT -2
+
+typedef struct {
+    int32_t n;            /* nombre de sommets dans le tas */
+    int32_t *tas;         /* tas[0] : sommet de valeur minimale */
+    int32_t *pos;         /* position dans tas, ou TAS_ABSENT, TAS_EXTRAIT */
+    TYP_VSOM *val;        /* valeurs des sommets */
+} TasSommets;
+
+/* ====================================================================== */
+static TasSommets * TasCree(int32_t nsom, TYP_VSOM *val)
+/* ====================================================================== */
+#undef F_NAME
+#define F_NAME "TasCree"
+{
+    TasSommets * T;
+    int32_t i;
+
+    T = (TasSommets *)malloc(sizeof(TasSommets));
+    if (T == NULL) {
+        fprintf(stderr, "%s : malloc failed\n", F_NAME);
+        exit(0);
+    }
+    T->tas = (int32_t *)malloc(nsom * sizeof(int32_t));
+    T->pos = (int32_t *)malloc(nsom * sizeof(int32_t));
+    if ((T->tas == NULL) || (T->pos == NULL)) {
+        fprintf(stderr, "%s : malloc failed\n", F_NAME);
+        exit(0);
+    }
+    for (i = 0; i < nsom; i++) {
+        T->pos[i] = TAS_ABSENT;
+    }
+    T->n = 0;
+    T->val = val;
+    return T;
+} /* TasCree() */
+
+/* ====================================================================== */
+static void TasTermine(TasSommets * T)
+/* ====================================================================== */
+{
+    free(T->tas);
+    free(T->pos);
+    free(T);
+} /* TasTermine() */
+
+/* ====================================================================== */
+static void TasMonte(TasSommets * T, int32_t s)
+/* ====================================================================== */
+/* insere le sommet s, ou le replace apres diminution de sa valeur */
+{
+    int32_t i = T->pos[s], j;
+    TYP_VSOM v = T->val[s];
+
+    if (i < 0) {
+        i = T->n++;
+    }
+    while (i > 0) {
+        j = (i - 1) / 2;
+        if (T->val[T->tas[j]] <= v) {
+            break;
+        }
+        T->tas[i] = T->tas[j];
+        T->pos[T->tas[i]] = i;
+        i = j;
+    }
+    T->tas[i] = s;
+    T->pos[s] = i;
+} /* TasMonte() */
+
+/* ====================================================================== */
+static int32_t TasPopMin(TasSommets * T)
+/* ====================================================================== */
+/* retire et retourne un sommet de valeur minimale */
+{
+    int32_t s = T->tas[0], x, i, j;
+    TYP_VSOM v;
+
+    T->pos[s] = TAS_EXTRAIT;
+    T->n--;
+    if (T->n > 0) {
+        x = T->tas[T->n];
+        v = T->val[x];
+        i = 0;
+        while ((j = 2 * i + 1) < T->n) {
+            if ((j + 1 < T->n) && (T->val[T->tas[j + 1]] < T->val[T->tas[j]])) {
+                j++;
+            }
+            if (v <= T->val[T->tas[j]]) {
+                break;
+            }
+            T->tas[i] = T->tas[j];
+            T->pos[T->tas[i]] = i;
+            i = j;
+        }
+        T->tas[i] = x;
+        T->pos[x] = i;
+    }
+    return s;
+} /* TasPopMin() */
+
 /* ====================================================================== */
 /* \fn void Dijkstra1(graphe * g, int32_t i)
     \param g (entrée) : un graphe pondéré. La pondération de chaque arc doit
@@ -2047,66 +2139,42 @@ void Dijkstra1(graphe * g, int32_t i)
 */
 void Dijkstra(graphe * g, int32_t i)
 /* ====================================================================== */
+/* le sommet de valeur minimale est extrait d'un tas binaire :
+   complexite O((n + m) log n) */
 #undef F_NAME
 #define F_NAME "Dijkstra"
 {
     int32_t n = g->nsom;
-    boolean * S = EnsembleVide(n);
-    boolean * TT = EnsembleVide(n);
     int32_t k, x, y;
     pcell p;
-    TYP_VSOM vmin;
-    int32_t *T = ListeVide(n);
-    int32_t tx, ty, tt = 0;
+    TYP_VSOM v;
+    TasSommets * T;
 
     if ((i >= n) || (i < 0)) {
         fprintf(stderr, "%s: bad vertex index: %d\n", F_NAME, i);
         exit(0);
     }
 
-    S[i] = TRUE;
-    TT[i] = TRUE;
     for (k = 0; k < n; k++) {
         g->v_sommets[k] = MAX_VSOM;
     }
     g->v_sommets[i] = 0;
-    x = i;
-    do {
+    T = TasCree(n, g->v_sommets);
+    TasMonte(T, i);
+    while (T->n > 0) {
+        x = TasPopMin(T);
         for (p = g->gamma[x]; p != NULL; p = p->next) {
             /* pour tout y successeur de x */
             y = p->som;
-            if (!S[y]) {
-                g->v_sommets[y] = mcmin((g->v_sommets[y]),(g->v_sommets[x]+p->v_arc));
-                if (!TT[y]) {
-                    TT[y] = TRUE;
-                    T[tt] = y; // insere y dans T
-                    tt++;
-                }
-            } // if (!S[y])
-        } // for p
-
-        // extraire un sommet x de T de valeur g->v_sommets minimale
-        tx = 0;
-        x = T[0];
-        vmin = g->v_sommets[x];
-        for (ty = 1; ty < tt; ty++) {
-            y = T[ty];
-            if (g->v_sommets[y] <= vmin) {
-                x = y;
-                tx = ty;
-                vmin = g->v_sommets[y];
+            v = g->v_sommets[x] + p->v_arc;
+            if ((T->pos[y] != TAS_EXTRAIT) && (v < g->v_sommets[y])) {
+                g->v_sommets[y] = v;
+                TasMonte(T, y);
             }
-        }
-        S[x] = TRUE;
-        for (; tx < tt - 1; tx++) {
-            T[tx] = T[tx + 1]; // retire x de T
-        }
-        tt--;
-    } while (tt > 0);
+        } // for p
+    } // while (T->n > 0)
 
-    free(T);
-    free(S);
-    free(TT);
+    TasTermine(T);
 
 } /* Dijkstra() */
 
@@ -2284,6 +2352,369 @@ graphe * PCCna(graphe * g, int32_t d, int32_t a)
     return pcc;
 } /* PCCna() */
 
+/* ====================================================================== */
+/* ====================================================================== */
+/* GRAPHES COMPACTS (CSR) */
+/* ====================================================================== */
+/* ====================================================================== */
+
+/*
+   La représentation graphecsr (voir mcgraphe.h) range les successeurs de
+   tous les sommets dans un seul tableau : elle occupe 12 octets par arc
+   (contre 24 pour les cellules de la représentation gamma, plus les
+   tableaux tete, queue et v_arcs), et se parcourt séquentiellement.
+   Elle permet de traiter des graphes issus d'images de plusieurs millions
+   de pixels.
+*/
+
+/* ====================================================================== */
+/*! \fn graphecsr * InitGrapheCSR(int32_t nsom, index_t narc)
+    \param nsom (entrée) : nombre de sommets.
+    \param narc (entrée) : nombre d'arcs.
+    \return un graphe compact.
+    \brief alloue la mémoire nécessaire pour représenter un graphe compact
+    à \b nsom sommets et \b narc arcs (le tableau deb est à remplir).
+*/
+graphecsr * InitGrapheCSR(int32_t nsom, index_t narc)
+/* ====================================================================== */
+#undef F_NAME
+#define F_NAME "InitGrapheCSR"
+{
+    graphecsr * g = NULL;
+    int32_t i;
+
+    g = (graphecsr *)malloc(sizeof(graphecsr));
+    if (g == NULL) {
+        fprintf(stderr, "%s : malloc failed\n", F_NAME);
+        exit(0);
+    }
+    g->nsom = nsom;
+    g->narc = narc;
+    g->deb = (index_t *)malloc((nsom + 1) * sizeof(index_t));
+    g->succ = (int32_t *)malloc(mcmax(narc, 1) * sizeof(int32_t));
+    g->v_arcs = (TYP_VARC *)malloc(mcmax(narc, 1) * sizeof(TYP_VARC));
+    g->v_sommets = (TYP_VSOM *)calloc(nsom, sizeof(TYP_VSOM));
+    g->pred = (int32_t *)malloc(nsom * sizeof(int32_t));
+    if ((g->deb == NULL) || (g->succ == NULL) || (g->v_arcs == NULL) ||
+        (g->v_sommets == NULL) || (g->pred == NULL)) {
+        fprintf(stderr, "%s : malloc failed\n", F_NAME);
+        exit(0);
+    }
+    for (i = 0; i < nsom; i++) {
+        g->pred[i] = -1;
+    }
+    return g;
+} /* InitGrapheCSR() */
+
+/* ====================================================================== */
+/*! \fn void TermineGrapheCSR(graphecsr * g)
+    \param g (entrée) : un graphe compact.
+    \brief libère la mémoire occupée par le graphe compact \b g.
+*/
+void TermineGrapheCSR(graphecsr * g)
+/* ====================================================================== */
+{
+    free(g->deb);
+    free(g->succ);
+    free(g->v_arcs);
+    free(g->v_sommets);
+    free(g->pred);
+    free(g);
+} /* TermineGrapheCSR() */
+
+/* ====================================================================== */
+/*! \fn graphecsr * Graphe2CSR(graphe * g)
+    \param g (entrée) : un graphe (représenté par son application gamma).
+    \return un graphe compact.
+    \brief construit la représentation compacte du graphe \b g. L'ordre des
+    successeurs de chaque sommet est celui des listes gamma. Les valeurs des
+    arcs et des sommets sont recopiées.
+*/
+graphecsr * Graphe2CSR(graphe * g)
+/* ====================================================================== */
+{
+    int32_t s, n = g->nsom;
+    index_t k, narc = 0;
+    graphecsr * c;
+    pcell p;
+
+    for (s = 0; s < n; s++) {
+        for (p = g->gamma[s]; p != NULL; p = p->next) {
+            narc++;
+        }
+    }
+    c = InitGrapheCSR(n, narc);
+    k = 0;
+    for (s = 0; s < n; s++) {
+        c->deb[s] = k;
+        for (p = g->gamma[s]; p != NULL; p = p->next) {
+            c->succ[k] = p->som;
+            c->v_arcs[k] = p->v_arc;
+            k++;
+        }
+        c->v_sommets[s] = g->v_sommets[s];
+    }
+    c->deb[n] = k;
+    return c;
+} /* Graphe2CSR() */
+
+/* ====================================================================== */
+static TYP_VARC PoidsArc(uint8_t a, uint8_t b, int32_t mode)
+/* ====================================================================== */
+{
+    switch (mode) {
+    case SP_MIN:
+        return mcmin((TYP_VARC)a, (TYP_VARC)b);
+    case SP_MAX:
+        return mcmax((TYP_VARC)a, (TYP_VARC)b);
+    default:
+        return ((TYP_VARC)a + (TYP_VARC)b) / 2;
+    }
+} /* PoidsArc() */
+
+/* ====================================================================== */
+/*! \fn graphecsr * Image2GrapheCSR(struct xvimage *image, int32_t mode, int32_t connex)
+    \param image (entrée) : structure image (byte)
+    \param mode (entrée) : SP_MIN, SP_MAX ou SP_AVG
+    \param connex (entrée) : relation d'adjacence (4 ou 8 en 2D, 6, 18 ou 26 en 3D)
+    \return un graphe compact.
+    \brief construit directement, sous forme compacte, le graphe pondéré
+    décrit pour Image2Graphe : mêmes arcs, mêmes poids (en 4-connexité, le
+    poids est le carré de la valeur W(P,Q)) et, en 2D, même ordre des
+    successeurs. En 3D, le poids est W(P,Q).
+*/
+graphecsr * Image2GrapheCSR(struct xvimage *image, int32_t mode, int32_t connex)
+/* ====================================================================== */
+#undef F_NAME
+#define F_NAME "Image2GrapheCSR"
+{
+    /* voisins dans l'ordre des listes gamma construites par Image2Graphe */
+    static const int32_t dx4[4] = {0, 1, -1, 0}, dy4[4] = {1, 0, 0, -1};
+    static const int32_t dx8[8] = {-1, 1, 1, 0, 1, -1, 0, -1};
+    static const int32_t dy8[8] = {1, -1, 1, 1, 0, 0, -1, -1};
+    int32_t dx[26], dy[26], dz[26];
+    int32_t rs, cs, ds, ps, N, nv, k, x, y, z, p, q;
+    index_t a, narc;
+    uint8_t *F;
+    graphecsr * g;
+    TYP_VARC v;
+
+    if (datatype(image) != VFF_TYP_1_BYTE) {
+        fprintf(stderr, "%s: bad data type (only byte is available)\n", F_NAME);
+        return NULL;
+    }
+    rs = rowsize(image);
+    cs = colsize(image);
+    ds = depth(image);
+    ps = rs * cs;
+    N = ps * ds;
+    F = UCHARDATA(image);
+
+    nv = 0;
+    if ((ds == 1) && ((connex == 4) || (connex == 8))) {
+        for (k = 0; k < connex; k++) {
+            dx[k] = (connex == 4) ? dx4[k] : dx8[k];
+            dy[k] = (connex == 4) ? dy4[k] : dy8[k];
+            dz[k] = 0;
+        }
+        nv = connex;
+    } else if ((ds > 1) && ((connex == 6) || (connex == 18) || (connex == 26))) {
+        for (z = -1; z <= 1; z++) {
+            for (y = -1; y <= 1; y++) {
+                for (x = -1; x <= 1; x++) {
+                    k = abs(x) + abs(y) + abs(z);
+                    if ((k == 0) || ((connex == 6) && (k > 1)) || ((connex == 18) && (k > 2))) {
+                        continue;
+                    }
+                    dx[nv] = x;
+                    dy[nv] = y;
+                    dz[nv] = z;
+                    nv++;
+                }
+            }
+        }
+    } else {
+        fprintf(stderr, "%s: bad connex %d\n", F_NAME, connex);
+        return NULL;
+    }
+
+#define VOISIN_DANS_IMAGE(x,y,z,k) \
+    (((x)+dx[k] >= 0) && ((x)+dx[k] < rs) && ((y)+dy[k] >= 0) && ((y)+dy[k] < cs) && \
+     ((z)+dz[k] >= 0) && ((z)+dz[k] < ds))
+
+    narc = 0;
+    for (z = 0; z < ds; z++) {
+        for (y = 0; y < cs; y++) {
+            for (x = 0; x < rs; x++) {
+                for (k = 0; k < nv; k++) {
+                    if (VOISIN_DANS_IMAGE(x, y, z, k)) {
+                        narc++;
+                    }
+                }
+            }
+        }
+    }
+
+    g = InitGrapheCSR(N, narc);
+    a = 0;
+    for (z = 0; z < ds; z++) {
+        for (y = 0; y < cs; y++) {
+            for (x = 0; x < rs; x++) {
+                p = z * ps + y * rs + x;
+                g->deb[p] = a;
+                for (k = 0; k < nv; k++) {
+                    if (VOISIN_DANS_IMAGE(x, y, z, k)) {
+                        q = p + dz[k] * ps + dy[k] * rs + dx[k];
+                        v = PoidsArc(F[p], F[q], mode);
+                        g->succ[a] = q;
+                        g->v_arcs[a] = (connex == 4) ? v * v : v;
+                        a++;
+                    }
+                }
+            }
+        }
+    }
+    g->deb[N] = a;
+#undef VOISIN_DANS_IMAGE
+
+    return g;
+} /* Image2GrapheCSR() */
+
+/* ====================================================================== */
+/*! \fn void DijkstraCSR(graphecsr * g, int32_t i)
+    \param g (entrée) : un graphe compact pondéré (poids positifs ou nuls)
+    \param i (entrée) : un sommet de \b g
+    \brief calcule, pour chaque sommet x de g, la longueur d'un plus court
+           chemin de i vers x (MAX_VSOM si x n'est pas atteint), stockée dans
+           le champ \b v_sommets de \b g, ainsi que le prédécesseur de x sur
+           ce chemin (champ \b pred). Le sommet de valeur minimale est extrait
+           d'un tas binaire : complexité O((n + m) log n).
+*/
+void DijkstraCSR(graphecsr * g, int32_t i)
+/* ====================================================================== */
+#undef F_NAME
+#define F_NAME "DijkstraCSR"
+{
+    int32_t n = g->nsom;
+    int32_t k, x, y;
+    index_t a;
+    TYP_VSOM v;
+    TasSommets * T;
+
+    if ((i >= n) || (i < 0)) {
+        fprintf(stderr, "%s: bad vertex index: %d\n", F_NAME, i);
+        exit(0);
+    }
+
+    for (k = 0; k < n; k++) {
+        g->v_sommets[k] = MAX_VSOM;
+        g->pred[k] = -1;
+    }
+    g->v_sommets[i] = 0;
+    T = TasCree(n, g->v_sommets);
+    TasMonte(T, i);
+    while (T->n > 0) {
+        x = TasPopMin(T);
+        for (a = g->deb[x]; a < g->deb[x + 1]; a++) {
+            /* pour tout y successeur de x */
+            y = g->succ[a];
+            v = g->v_sommets[x] + g->v_arcs[a];
+            if ((T->pos[y] != TAS_EXTRAIT) && (v < g->v_sommets[y])) {
+                g->v_sommets[y] = v;
+                g->pred[y] = x;
+                TasMonte(T, y);
+            }
+        } // for a
+    } // while (T->n > 0)
+
+    TasTermine(T);
+} /* DijkstraCSR() */
+
+/* ====================================================================== */
+/*! \fn void LeeCSR(graphecsr * g, int32_t i)
+    \param g (entrée) : un graphe compact
+    \param i (entrée) : un sommet de \b g
+    \brief calcule, pour chaque sommet x de g, la longueur (nombre d'arcs)
+           d'un plus court chemin de i vers x (-1 si x n'est pas atteint),
+           stockée dans le champ \b v_sommets de \b g, ainsi que le
+           prédécesseur de x sur ce chemin (champ \b pred).
+*/
+void LeeCSR(graphecsr * g, int32_t i)
+/* ====================================================================== */
+#undef F_NAME
+#define F_NAME "LeeCSR"
+{
+    int32_t k, s, n = g->nsom;
+    index_t a;
+    Fifo * T;
+
+    if ((i >= n) || (i < 0)) {
+        fprintf(stderr, "%s: bad vertex index: %d\n", F_NAME, i);
+        exit(0);
+    }
+    T = CreeFifoVide(n);
+    for (k = 0; k < n; k++) {
+        g->v_sommets[k] = -1;
+        g->pred[k] = -1;
+    }
+    g->v_sommets[i] = 0;
+    FifoPush(T, i);
+
+    while (!FifoVide(T)) {
+        i = FifoPop(T);
+        for (a = g->deb[i]; a < g->deb[i + 1]; a++) {
+            /* pour tout s successeur de i */
+            s = g->succ[a];
+            if (g->v_sommets[s] == -1) {
+                g->v_sommets[s] = g->v_sommets[i] + 1;
+                g->pred[s] = i;
+                FifoPush(T, s);
+            }
+        } // for a
+    } // while (!FifoVide(T))
+
+    FifoTermine(T);
+} /* LeeCSR() */
+
+/* ====================================================================== */
+/*! \fn int32_t * PCCCSR(graphecsr * g, int32_t d, int32_t a, int32_t *n)
+    \param g (entrée) : un graphe compact, dont les champs \b v_sommets et
+            \b pred ont été calculés par DijkstraCSR(g, d) ou LeeCSR(g, d)
+    \param d (entrée) : un sommet (départ)
+    \param a (entrée) : un sommet (arrivée)
+    \param n (sortie) : le nombre de sommets du chemin
+    \return un plus court chemin de \b d vers \b a dans \b g, sous la forme
+    d'un tableau (alloué) de \b n sommets allant de \b d à \b a, ou NULL s'il
+    n'existe pas de chemin de \b d vers \b a
+    \brief retourne un plus court chemin de \b d vers \b a dans \b g
+*/
+int32_t * PCCCSR(graphecsr * g, int32_t d, int32_t a, int32_t *n)
+/* ====================================================================== */
+#undef F_NAME
+#define F_NAME "PCCCSR"
+{
+    int32_t x, k, *chemin;
+
+    k = 1;
+    for (x = a; (x != d) && (x != -1); x = g->pred[x]) {
+        k++;
+    }
+    if (x == -1) {
+        fprintf(stderr, "%s: no path from %d to %d\n", F_NAME, d, a);
+        return NULL;
+    }
+    chemin = (int32_t *)malloc(k * sizeof(int32_t));
+    if (chemin == NULL) {
+        fprintf(stderr, "%s : malloc failed\n", F_NAME);
+        return NULL;
+    }
+    *n = k;
+    for (x = a; k > 0; x = g->pred[x]) {
+        chemin[--k] = x;
+    }
+    return chemin;
+} /* PCCCSR() */
+
 /* ====================================================================== */
 /* ====================================================================== */
 /* GRAPHES SANS CIRCUIT (GSC) */
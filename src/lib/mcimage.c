@@ -60,6 +60,9 @@ knowledge of the CeCILL license and that you accept its terms.
 			  les images 2D à 3 bandes sont traitées
 			  par writeimage comme des images couleurs
    MC Update juillet 2011 : fonctions writelist2, writelist3
+   Update 2026 : lecture par projection memoire (mmap) des fichiers bruts
+                 dont la disposition sur disque est celle de la memoire
+                 (readimagemap, ou readimage si PINK_MMAP est defini)
 */
 
 #include <stdio.h>
@@ -84,6 +87,13 @@ knowledge of the CeCILL license and that you accept its terms.
 #include <ctype.h>
 #include <assert.h>
 
+#ifdef UNIXIO
+#  include <sys/mman.h>
+#  ifdef HAVE_PTHREAD
+#    include <pthread.h>
+#  endif
+#endif
+
 
 #ifdef HAVE_TIFF_LIB
 #  include "liarp.h"
@@ -105,6 +115,146 @@ knowledge of the CeCILL license and that you accept its terms.
 // define the following to print a warning when allocating huge image (>=2Gb)
 #define WARN_HUGE
 
+#ifdef UNIXIO
+/* ============================================================ */
+/* images projetees en memoire (mmap)                           */
+/* ============================================================ */
+/*
+   Les donnees d'une image lue par projection pointent dans une
+   projection privee (MAP_PRIVATE) du fichier : les pages ne sont lues
+   qu'a la demande et une ecriture dans l'image provoque une copie de la
+   page (copy-on-write), le fichier n'est jamais modifie.
+   Chaque projection est enregistree dans une liste afin que freeimage
+   puisse la liberer par munmap, et qu'une ecriture dans le fichier
+   d'origine (qui le tronque) ne puisse pas invalider les donnees : dans
+   ce cas l'image est d'abord recopiee en memoire (mcimage_detach).
+*/
+
+typedef struct mcimage_map {
+    struct xvimage *image;
+    void *base;               /* debut de la projection (debut du fichier) */
+    size_t len;               /* longueur de la projection */
+    dev_t dev;                /* identification du fichier projete */
+    ino_t ino;
+    struct mcimage_map *next;
+} mcimage_map;
+
+static mcimage_map *mcimage_maps = NULL;
+
+#ifdef HAVE_PTHREAD
+static pthread_mutex_t mcimage_maps_lock = PTHREAD_MUTEX_INITIALIZER;
+#  define MCIMAGE_MAPS_LOCK() pthread_mutex_lock(&mcimage_maps_lock)
+#  define MCIMAGE_MAPS_UNLOCK() pthread_mutex_unlock(&mcimage_maps_lock)
+#else
+#  define MCIMAGE_MAPS_LOCK()
+#  define MCIMAGE_MAPS_UNLOCK()
+#endif
+
+/* ==================================== */
+static int32_t mcimage_mapfile(struct xvimage *image, FILE *fd, off_t offset, size_t len)
+/* ==================================== */
+/* projette les len octets situes a la position offset de fd et y fait
+   pointer image->image_data. Retourne 0 (sans message) si la projection
+   n'est pas possible, l'appelant se rabat alors sur la lecture. */
+{
+    struct stat st;
+    mcimage_map *m;
+    void *base;
+    int fdn = fileno(fd);
+
+    if ((len == 0) || (fstat(fdn, &st) != 0) || !S_ISREG(st.st_mode)) return 0;
+    if ((off_t)(offset + len) > st.st_size) return 0;
+    m = (mcimage_map *)malloc(sizeof(mcimage_map));
+    if (m == NULL) return 0;
+    base = mmap(NULL, offset + len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fdn, 0);
+    if (base == MAP_FAILED) {
+        free(m);
+        return 0;
+    }
+    m->image = image;
+    m->base = base;
+    m->len = offset + len;
+    m->dev = st.st_dev;
+    m->ino = st.st_ino;
+    image->image_data = (void *)((char *)base + offset);
+    MCIMAGE_MAPS_LOCK();
+    m->next = mcimage_maps;
+    mcimage_maps = m;
+    MCIMAGE_MAPS_UNLOCK();
+    return 1;
+} /* mcimage_mapfile() */
+
+/* ==================================== */
+static mcimage_map * mcimage_unregister(struct xvimage *image)
+/* ==================================== */
+/* retire image de la liste des projections ; retourne l'entree, ou NULL
+   si l'image n'est pas projetee */
+{
+    mcimage_map *m, **pm;
+
+    if (mcimage_maps == NULL) return NULL;
+    MCIMAGE_MAPS_LOCK();
+    for (pm = &mcimage_maps; (m = *pm) != NULL; pm = &m->next)
+        if (m->image == image) {
+            *pm = m->next;
+            break;
+        }
+    MCIMAGE_MAPS_UNLOCK();
+    return m;
+} /* mcimage_unregister() */
+
+/* ==================================== */
+static void mcimage_detach(char *filename)
+/* ==================================== */
+/* recopie en memoire les images projetees depuis le fichier filename,
+   avant que celui-ci ne soit reecrit */
+{
+    struct stat st;
+    mcimage_map *m, **pm;
+    char *data;
+    size_t offset;
+
+    if (mcimage_maps == NULL) return;
+    if (stat(filename, &st) != 0) return;
+    MCIMAGE_MAPS_LOCK();
+    pm = &mcimage_maps;
+    while ((m = *pm) != NULL) {
+        if ((m->dev != st.st_dev) || (m->ino != st.st_ino)) {
+            pm = &m->next;
+            continue;
+        }
+        offset = (char *)m->image->image_data - (char *)m->base;
+        data = (char *)malloc(m->len - offset);
+        if (data == NULL) {
+            fprintf(stderr, "mcimage_detach: malloc failed (%s remains mapped)\n", filename);
+            pm = &m->next;
+            continue;
+        }
+        memcpy(data, m->image->image_data, m->len - offset);
+        m->image->image_data = (void *)data;
+        munmap(m->base, m->len);
+        *pm = m->next;
+        free(m);
+    }
+    MCIMAGE_MAPS_UNLOCK();
+} /* mcimage_detach() */
+
+/* ==================================== */
+int32_t ismappedimage(struct xvimage *image)
+/* ==================================== */
+{
+    mcimage_map *m;
+    if (mcimage_maps == NULL) return 0;
+    MCIMAGE_MAPS_LOCK();
+    for (m = mcimage_maps; m != NULL; m = m->next)
+        if (m->image == image) break;
+    MCIMAGE_MAPS_UNLOCK();
+    return (m != NULL);
+} /* ismappedimage() */
+#else /* NOT UNIXIO */
+int32_t ismappedimage(struct xvimage *image) { return 0; }
+#endif /* NOT UNIXIO */
+
 // Fopen strategy
 FILE* pink_fopen_read( char * filename ) {
 # ifdef UNIXIO
@@ -121,6 +271,7 @@ FILE* pink_fopen_read( char * filename ) {
 
 FILE* pink_fopen_write( char * filename ) {
 # ifdef UNIXIO
+    mcimage_detach(filename);
     return fopen( filename, "w" );
 # else /* NOT UNIXIO */
 #   ifdef DOSIO
@@ -548,9 +699,18 @@ int32_t showheader(char * name)
 void freeimage(struct xvimage *image)
 /* ==================================== */
 {
+#ifdef UNIXIO
+    mcimage_map *m;
+#endif
     if (image->name != NULL) {
         free(image->name);
     }
+#ifdef UNIXIO
+    if ((m = mcimage_unregister(image)) != NULL) {
+        munmap(m->base, m->len);
+        free(m);
+    } else
+#endif
     free(image->image_data);
     free(image);
 }
@@ -2037,6 +2197,9 @@ void writetiffimage(struct xvimage * image, const char *filename)
     int    slice, datasize = 0;
     IMAGE *tiffimage=NULL;
 
+#ifdef UNIXIO
+    mcimage_detach((char *)filename);
+#endif
     tiffimage = (IMAGE*)malloc(sizeof(IMAGE));
 
     tiffimage->nx = image->row_size;
@@ -2142,8 +2305,12 @@ void writetiffimage(struct xvimage * image, const char *filename)
 //HAVE_TIFF_LIB
 
 /* ==================================== */
-struct xvimage * readimage( const char *filename )
+static struct xvimage * readimage1( const char *filename, int32_t map )
 /* ==================================== */
+/* map : si non nul, les fichiers bruts dont la disposition correspond a
+   celle de la memoire (byte 1 bande ou multibande, int32_t, float, double,
+   complex, avec donnees alignees) sont projetes en memoire au lieu d'etre
+   lus (voir mcimage_mapfile) */
 #undef F_NAME
 #define F_NAME "readimage"
 {
@@ -2154,6 +2321,7 @@ struct xvimage * readimage( const char *filename )
     int32_t ascii, color;
     int32_t typepixel;
     int32_t c, ndgmax;
+    int32_t mappable = 0;
     double xdim=1.0, ydim=1.0, zdim=1.0;
     char *read;
     char tag;
@@ -2320,8 +2488,38 @@ struct xvimage * readimage( const char *filename )
             fprintf(stderr,"%s: invalid image format: P%c\n", F_NAME, tag);
             return NULL;
         } /* switch */
+        mappable = !ascii && !color && (typepixel != VFF_TYP_2_BYTE);
 
 readdata:
+#     ifdef UNIXIO
+        if (map && mappable) {
+            /* les donnees brutes commencent a la position courante */
+            off_t offset = ftello(fd);
+            size_t es = (typepixel == VFF_TYP_1_BYTE) ? 1 :
+                        (typepixel == VFF_TYP_DOUBLE) ? sizeof(double) : sizeof(float);
+            size_t len = (size_t)rs * cs * ds * nb * es;
+            if (typepixel == VFF_TYP_COMPLEX) len = len + len;
+            if ((offset >= 0) && ((offset % es) == 0)) {
+                image = allocheader(NULL, rs, cs, ds, typepixel);
+                if (image == NULL) {
+                    fprintf(stderr,"%s: alloc failed\n", F_NAME);
+                    return(NULL);
+                }
+                tsize(image) = 1;
+                nbands(image) = nb;
+                image->xmin = image->ymin = image->zmin = 0;
+                image->xmax = image->ymax = image->zmax = 0;
+                if (mcimage_mapfile(image, fd, offset, len)) {
+                    image->xdim = xdim;
+                    image->ydim = ydim;
+                    image->zdim = zdim;
+                    fclose(fd);
+                    return image;
+                }
+                freeimage(image);
+            }
+        } /* sinon : lecture classique */
+#     endif /* UNIXIO */
         image = allocmultimage(NULL, rs, cs, ds, 1, nb, typepixel);
         if (image == NULL) {
             fprintf(stderr,"%s: alloc failed\n", F_NAME);
@@ -2486,8 +2684,29 @@ readdata:
     fclose(fd);
 
     return image;
+} /* readimage1() */
+
+/* ==================================== */
+struct xvimage * readimage( const char *filename )
+/* ==================================== */
+/* si la variable d'environnement PINK_MMAP est definie (et differente de
+   "0"), se comporte comme readimagemap */
+{
+    static int32_t map = -1;
+    if (map == -1) {
+        char *env = getenv("PINK_MMAP");
+        map = ((env != NULL) && (env[0] != '\0') && (strcmp(env, "0") != 0));
+    }
+    return readimage1(filename, map);
 } /* readimage() */
 
+/* ==================================== */
+struct xvimage * readimagemap( const char *filename )
+/* ==================================== */
+{
+    return readimage1(filename, 1);
+} /* readimagemap() */
+
 /* ==================================== */
 struct xvimage * readheader(char *filename)
 /* ==================================== */
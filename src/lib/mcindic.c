@@ -39,6 +39,9 @@ knowledge of the CeCILL license and that you accept its terms.
 /* gestion d'un indicateur binaire compact */
 /* M. Couprie novembre 1999 */
 
+/* Update 2026 : contextes IndicsCtx (reentrants), en complement */
+/* du tableau global Indics */
+
 /*
 #define TESTINDIC
 */
@@ -95,6 +98,57 @@ void IndicsTermine()
     free(Indics);
 }
 
+/* ==================================== */
+static IndicsCtx * CreeIndicsCtx(index_t Size, int32_t Onebit)
+/* ==================================== */
+{
+    IndicsCtx * I;
+    index_t n = Onebit ? (Size-1)/8 + 1 : Size;
+    I = (IndicsCtx *)malloc(sizeof(IndicsCtx));
+    if (I == NULL) return NULL;
+    I->Tab = (Indicstype *)calloc(n, sizeof(Indicstype));
+    if (I->Tab == NULL) {
+        free(I);
+        return NULL;
+    }
+    I->Size = Size;
+    I->Onebit = Onebit;
+    return I;
+}
+
+/* ==================================== */
+IndicsCtx * CreeIndics(index_t Size)
+/* ==================================== */
+/* 8 indicateurs par point ; retourne NULL en cas d'echec */
+{
+    return CreeIndicsCtx(Size, 0);
+}
+
+/* ==================================== */
+IndicsCtx * CreeIndics1bit(index_t Size)
+/* ==================================== */
+/* un indicateur par point (1 bit) ; retourne NULL en cas d'echec */
+{
+    return CreeIndicsCtx(Size, 1);
+}
+
+/* ==================================== */
+void IndicsCtxReInit(IndicsCtx * I)
+/* ==================================== */
+{
+    index_t n = I->Onebit ? (I->Size-1)/8 + 1 : I->Size;
+    memset(I->Tab, 0, n * sizeof(Indicstype));
+}
+
+/* ==================================== */
+void IndicsCtxTermine(IndicsCtx * I)
+/* ==================================== */
+{
+    if (I == NULL) return;
+    free(I->Tab);
+    free(I);
+}
+
 #ifdef TESTINDIC
 void main() {
     IndicsInit(3);
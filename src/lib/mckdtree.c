@@ -0,0 +1,363 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Librairie mckdtree :
+
+   arbre k-d statique pour la recherche du plus proche voisin dans un
+   ensemble fixe de points de R^dim (dim <= KD_MAXDIM).
+
+   L'arbre est construit une fois pour toutes en O(m log m) : a chaque
+   niveau, le sous-ensemble est coupe en deux selon son axe de plus grande
+   etendue, au rang median (selection de Hoare, sans tri). Les sous-arbres
+   d'au plus KD_FEUILLE points sont parcourus exhaustivement.
+
+   La recherche est exacte : la distance retournee est egale, au bit pres,
+   a celle d'une recherche exhaustive calculant (y1-x1)^2 + (y2-x2)^2 [+
+   (y3-x3)^2] dans cet ordre. Un voisin "suppose" (typiquement, le plus
+   proche voisin trouve lors d'une requete precedente pour un point
+   voisin) peut etre fourni : il sert de premier majorant et reduit
+   d'autant l'exploration.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <math.h>
+#include <mckdtree.h>
+
+typedef struct {
+    const KdArbre *A;
+    const double *x; /* point requete */
+    double best;     /* carre de la distance au meilleur candidat */
+    int32_t rbest;   /* rang du meilleur candidat (ou -1) */
+} KdRequete;
+
+/* ==================================== */
+static double kd_dist(const double *x, const double *y, int32_t dim)
+/* ==================================== */
+{
+    double d = 0.0, t;
+    int32_t k;
+    for (k = 0; k < dim; k++) {
+        t = y[k] - x[k];
+        d += t * t;
+    }
+    return d;
+} // kd_dist()
+
+/* ==================================== */
+static void kd_selection(const double *P, int32_t dim, int32_t a,
+                         int32_t *ind, int32_t l, int32_t r, int32_t k)
+/* ==================================== */
+// place en ind[k] l'element de rang k (coordonnee a) de ind[l..r],
+// les elements de ind[l..k[ (resp. ind]k..r]) etant <= (resp. >=)
+{
+    int32_t i, j, tmp;
+    double piv;
+    while (r > l) {
+        piv = P[ind[k] * dim + a];
+        i = l;
+        j = r;
+        while (i <= j) {
+            while (P[ind[i] * dim + a] < piv) {
+                i++;
+            }
+            while (P[ind[j] * dim + a] > piv) {
+                j--;
+            }
+            if (i <= j) {
+                tmp = ind[i];
+                ind[i] = ind[j];
+                ind[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) {
+            r = j;
+        } else if (k >= i) {
+            l = i;
+        } else {
+            break;
+        }
+    }
+} // kd_selection()
+
+/* ==================================== */
+static void kd_construit(KdArbre *A, const double *P, int32_t *ind,
+                         int32_t lo, int32_t hi)
+/* ==================================== */
+{
+    int32_t dim = A->dim, mid, a, k, r;
+    double vmin[KD_MAXDIM], vmax[KD_MAXDIM], v, e, emax;
+
+    while (hi - lo > KD_FEUILLE) {
+        for (k = 0; k < dim; k++) {
+            vmin[k] = vmax[k] = P[ind[lo] * dim + k];
+        }
+        for (r = lo + 1; r < hi; r++) {
+            for (k = 0; k < dim; k++) {
+                v = P[ind[r] * dim + k];
+                if (v < vmin[k]) {
+                    vmin[k] = v;
+                } else if (v > vmax[k]) {
+                    vmax[k] = v;
+                }
+            }
+        }
+        a = 0;
+        emax = vmax[0] - vmin[0];
+        for (k = 1; k < dim; k++) {
+            e = vmax[k] - vmin[k];
+            if (e > emax) {
+                emax = e;
+                a = k;
+            }
+        }
+        mid = (lo + hi) / 2;
+        kd_selection(P, dim, a, ind, lo, hi - 1, mid);
+        A->Axe[mid] = (uint8_t)a;
+        kd_construit(A, P, ind, lo, mid);
+        lo = mid + 1; // le sous-arbre droit est traite par la boucle
+    }
+} // kd_construit()
+
+/* ==================================== */
+KdArbre *KdCree(double *P, int32_t m, int32_t dim)
+/* ==================================== */
+/*! \fn KdArbre *KdCree(double *P, int32_t m, int32_t dim)
+    \param P (entrée) : matrice m * dim contenant les points
+    \param m (entrée) : nombre de points
+    \param dim (entrée) : dimension de l'espace (1 <= dim <= KD_MAXDIM)
+    \return arbre k-d sur les points de P, ou NULL en cas d'echec
+    \brief construit un arbre k-d sur les points de P. Les coordonnees sont
+       recopiees : P peut etre modifie ou libere ensuite.
+*/
+{
+    KdArbre *A;
+    int32_t r, k;
+#undef F_NAME
+#define F_NAME "KdCree"
+
+    if ((dim < 1) || (dim > KD_MAXDIM) || (m < 0)) {
+        fprintf(stderr, "%s: bad parameters\n", F_NAME);
+        return NULL;
+    }
+    A = (KdArbre *)calloc(1, sizeof(KdArbre));
+    if (A == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return NULL;
+    }
+    A->dim = dim;
+    A->m = m;
+    A->Pts = (double *)malloc((m * dim + 1) * sizeof(double));
+    A->Axe = (uint8_t *)calloc(m + 1, sizeof(uint8_t));
+    A->Ind = (int32_t *)malloc((m + 1) * sizeof(int32_t));
+    A->Rang = (int32_t *)malloc((m + 1) * sizeof(int32_t));
+    if ((A->Pts == NULL) || (A->Axe == NULL) || (A->Ind == NULL) ||
+            (A->Rang == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        KdTermine(A);
+        return NULL;
+    }
+
+    for (r = 0; r < m; r++) {
+        A->Ind[r] = r;
+    }
+    kd_construit(A, P, A->Ind, 0, m);
+    for (r = 0; r < m; r++) {
+        A->Rang[A->Ind[r]] = r;
+        for (k = 0; k < dim; k++) {
+            A->Pts[r * dim + k] = P[A->Ind[r] * dim + k];
+        }
+    }
+    return A;
+} // KdCree()
+
+/* ==================================== */
+void KdTermine(KdArbre *A)
+/* ==================================== */
+{
+    if (A == NULL) {
+        return;
+    }
+    free(A->Pts);
+    free(A->Axe);
+    free(A->Ind);
+    free(A->Rang);
+    free(A);
+} // KdTermine()
+
+/* ==================================== */
+KdArbre *KdCreeVoisins(double *Y, int32_t m, int32_t dim, int32_t n,
+                       int32_t **proche)
+/* ==================================== */
+/*! \fn KdArbre *KdCreeVoisins(double *Y, int32_t m, int32_t dim, int32_t n, int32_t **proche)
+    \param Y (entrée) : matrice m * dim contenant les points de l'arbre
+    \param m (entrée) : nombre de points de Y
+    \param dim (entrée) : dimension de l'espace
+    \param n (entrée) : nombre de points requete
+    \param proche (sortie) : tableau de n voisins supposes, initialises a -1
+       (NULL en cas d'echec)
+    \return arbre k-d sur Y, ou NULL en cas d'echec : l'appelant se rabat
+       alors sur une recherche exhaustive
+    \brief prepare les requetes de plus proche voisin de n points dans Y
+       (voir KdSommeDistances).
+*/
+{
+    KdArbre *A;
+    int32_t i;
+    A = KdCree(Y, m, dim);
+    *proche = (int32_t *)malloc((n + 1) * sizeof(int32_t));
+    if ((A == NULL) || (*proche == NULL)) {
+        KdTermine(A);
+        free(*proche);
+        *proche = NULL;
+        return NULL;
+    }
+    for (i = 0; i < n; i++) {
+        (*proche)[i] = -1;
+    }
+    return A;
+} // KdCreeVoisins()
+
+/* ==================================== */
+void KdTermineVoisins(KdArbre *A, int32_t *proche)
+/* ==================================== */
+{
+    KdTermine(A);
+    free(proche);
+} // KdTermineVoisins()
+
+/* ==================================== */
+static void kd_cherche(KdRequete *R, int32_t lo, int32_t hi)
+/* ==================================== */
+{
+    const KdArbre *A = R->A;
+    int32_t dim = A->dim, mid, r;
+    const double *p;
+    double d, t;
+
+    if (hi - lo <= KD_FEUILLE) {
+        for (r = lo; r < hi; r++) {
+            d = kd_dist(R->x, A->Pts + r * dim, dim);
+            if (d < R->best) {
+                R->best = d;
+                R->rbest = r;
+            }
+        }
+        return;
+    }
+
+    mid = (lo + hi) / 2;
+    p = A->Pts + mid * dim;
+    d = kd_dist(R->x, p, dim);
+    if (d < R->best) {
+        R->best = d;
+        R->rbest = mid;
+    }
+    // tout point q de l'autre cote verifie |x[a]-q[a]| >= |x[a]-p[a]|, donc
+    // (arrondis compris) dist(x,q) >= t*t : l'elagage ne perd aucun minimum
+    t = R->x[A->Axe[mid]] - p[A->Axe[mid]];
+    if (t <= 0.0) {
+        kd_cherche(R, lo, mid);
+        if (t * t < R->best) {
+            kd_cherche(R, mid + 1, hi);
+        }
+    } else {
+        kd_cherche(R, mid + 1, hi);
+        if (t * t < R->best) {
+            kd_cherche(R, lo, mid);
+        }
+    }
+} // kd_cherche()
+
+/* ==================================== */
+double KdPlusProche(KdArbre *A, double *x, int32_t *j)
+/* ==================================== */
+/*! \fn double KdPlusProche(KdArbre *A, double *x, int32_t *j)
+    \param A (entrée) : arbre k-d
+    \param x (entrée) : point requete (A->dim coordonnees)
+    \param j (entrée/sortie) : en entrée, si j != NULL et 0 <= *j < A->m,
+       indice d'un voisin suppose ; en sortie, indice (dans le tableau
+       d'origine) du plus proche voisin de x, -1 si l'arbre est vide
+    \return carre de la distance de x au plus proche point de l'arbre
+       (HUGE_VAL si l'arbre est vide)
+    \brief recherche exacte du plus proche voisin de x.
+*/
+{
+    KdRequete R;
+    R.A = A;
+    R.x = x;
+    R.best = HUGE_VAL;
+    R.rbest = -1;
+    if ((j != NULL) && (*j >= 0) && (*j < A->m)) {
+        R.rbest = A->Rang[*j];
+        R.best = kd_dist(x, A->Pts + R.rbest * A->dim, A->dim);
+    }
+    kd_cherche(&R, 0, A->m);
+    if (j != NULL) {
+        *j = (R.rbest < 0) ? -1 : A->Ind[R.rbest];
+    }
+    return R.best;
+} // KdPlusProche()
+
+/* ==================================== */
+double KdSommeDistances(KdArbre *A, double *X, int32_t n, int32_t *proche)
+/* ==================================== */
+/*! \fn double KdSommeDistances(KdArbre *A, double *X, int32_t n, int32_t *proche)
+    \param A (entrée) : arbre k-d sur un ensemble Y
+    \param X (entrée) : matrice n * A->dim contenant un ensemble de points
+    \param n (entrée) : nombre de points dans X
+    \param proche (entrée/sortie) : si non NULL, tableau de n indices de
+       voisins supposes (-1 : aucun), mis a jour avec les plus proches voisins
+    \return somme, pour les points de X, des carres des distances a Y
+    \brief calcule la somme des carres des distances des points de X a
+       l'ensemble Y, dans l'ordre des points de X (le resultat est identique
+       a celui d'une recherche exhaustive).
+*/
+{
+    double delta = 0.0;
+    int32_t i, j;
+    for (i = 0; i < n; i++) {
+        j = (proche != NULL) ? proche[i] : -1;
+        delta += KdPlusProche(A, X + i * A->dim, &j);
+        if (proche != NULL) {
+            proche[i] = j;
+        }
+    }
+    return delta;
+} // KdSommeDistances()
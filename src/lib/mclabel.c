@@ -0,0 +1,427 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Librairie mclabel :
+
+   etiquetage en composantes connexes par union-find, en deux passes :
+   composantes des points non nuls, plateaux et extrema regionaux d'une
+   image 2d (4, 8) ou 3d (6, 18, 26) d'octets ou d'entiers longs.
+
+   L'image d'etiquettes sert de foret de peres (indices de pixels) : le
+   representant d'une composante est son premier point dans l'ordre
+   raster, et le pere d'un point est toujours d'indice inferieur ou egal
+   au sien. La derniere passe, dans l'ordre raster, remplace donc chaque
+   pere par l'etiquette definitive sans recherche de racine.
+
+   La premiere passe est faite en parallele par bandes (lignes en 2d,
+   plans en 3d, voir mcthreads), chaque bande ignorant les voisins
+   situes dans la bande precedente ; les composantes sont ensuite
+   fusionnees le long des frontieres entre bandes. En 2d, pour les
+   composantes et les plateaux, le voisinage anterieur est examine selon
+   un arbre de decision (Wu, Otoo, Suzuki - SAUF) qui evite la plupart
+   des unions.
+
+   Les etiquettes sont celles de llabelbin, llabelplateaux et
+   llabelextrema : numerotation dans l'ordre raster du premier point
+   de chaque composante (ou extremum).
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mccodimage.h>
+#include <mcutil.h>
+#include <mcthreads.h>
+#include <mclabel.h>
+
+#define MCLABEL_MAXVOIS 13 /* nombre max de voisins anterieurs (26-connexite) */
+
+typedef struct {
+    uint8_t *F;          /* image d'octets ... */
+    int32_t *FL;         /* ... ou d'entiers longs */
+    int32_t *L;          /* peres, puis etiquettes */
+    uint8_t *NE;         /* modes MIN, MAX : le point n'est pas dans un extremum */
+    index_t rs, cs, ds, ps, N;
+    int32_t mode;
+    int32_t arbre;       /* 0 : voisinage generique ; 4 ou 8 : arbre de decision 2d */
+    int32_t nv;          /* nombre de voisins anterieurs */
+    int32_t dx[MCLABEL_MAXVOIS], dy[MCLABEL_MAXVOIS], dz[MCLABEL_MAXVOIS];
+    index_t off[MCLABEL_MAXVOIS];
+    int32_t nbands;
+    int32_t plans;       /* 1 : bandes de plans ; 0 : bandes de lignes */
+} mclabel_job;
+
+#define VAL(J, i) ((J)->F ? (int32_t)(J)->F[i] : (J)->FL[i])
+
+/* ==================================== */
+static int32_t lab_find(int32_t *L, int32_t x)
+/* ==================================== */
+{
+    while (L[x] != x) {
+        L[x] = L[L[x]]; // compression par division
+        x = L[x];
+    }
+    return x;
+}
+
+/* ==================================== */
+static int32_t lab_union(int32_t *L, int32_t a, int32_t b)
+/* ==================================== */
+/* le representant de l'union est celui de plus petit indice */
+{
+    a = lab_find(L, a);
+    b = lab_find(L, b);
+    if (a < b) {
+        L[b] = a;
+        return a;
+    }
+    L[a] = b;
+    return b;
+}
+
+/* ==================================== */
+static void lab_voisinage(mclabel_job *J, int32_t connex)
+/* ==================================== */
+/* voisins anterieurs (dans l'ordre raster) d'un point */
+{
+    int32_t dx, dy, dz, d;
+    J->nv = 0;
+    for (dz = -1; dz <= 0; dz++) {
+        for (dy = -1; dy <= 1; dy++) {
+            for (dx = -1; dx <= 1; dx++) {
+                if ((dz == 0) && ((dy > 0) || ((dy == 0) && (dx >= 0)))) {
+                    continue; // point courant et suivants
+                }
+                d = mcabs(dx) + mcabs(dy) + mcabs(dz);
+                if (((connex == 4) && ((dz != 0) || (d > 1))) ||
+                    ((connex == 8) && (dz != 0)) ||
+                    ((connex == 6) && (d > 1)) ||
+                    ((connex == 18) && (d > 2))) {
+                    continue;
+                }
+                J->dx[J->nv] = dx;
+                J->dy[J->nv] = dy;
+                J->dz[J->nv] = dz;
+                J->off[J->nv] = dz * J->ps + dy * J->rs + dx;
+                J->nv++;
+            }
+        }
+    }
+} // lab_voisinage()
+
+/* ==================================== */
+static void lab_voisins(mclabel_job *J, index_t i, index_t x, index_t y, index_t z,
+                        index_t lo, index_t hi)
+/* ==================================== */
+/* traite les voisins anterieurs j de i tels que lo <= j < hi : union des
+   voisins equivalents, marquage des points non extrema */
+{
+    int32_t k, vi, vj, *L = J->L;
+    index_t j, xx, yy, zz;
+
+    vi = VAL(J, i);
+    for (k = 0; k < J->nv; k++) {
+        xx = x + J->dx[k];
+        yy = y + J->dy[k];
+        zz = z + J->dz[k];
+        if ((xx < 0) || (xx >= J->rs) || (yy < 0) || (yy >= J->cs) || (zz < 0)) {
+            continue;
+        }
+        j = i + J->off[k];
+        if ((j < lo) || (j >= hi)) {
+            continue;
+        }
+        vj = VAL(J, j);
+        if (J->mode == MCLABEL_BIN) {
+            if (vj) {
+                lab_union(L, (int32_t)i, (int32_t)j);
+            }
+        } else if (vj == vi) {
+            lab_union(L, (int32_t)i, (int32_t)j);
+        } else if (J->mode == MCLABEL_MIN) {
+            J->NE[(vj < vi) ? i : j] = 1;
+        } else if (J->mode == MCLABEL_MAX) {
+            J->NE[(vj > vi) ? i : j] = 1;
+        }
+    }
+} // lab_voisins()
+
+/* ==================================== */
+static void lab_ligne_arbre(mclabel_job *J, index_t i0, int32_t haut)
+/* ==================================== */
+/* ligne de points i0 .. i0+rs-1, en 4 ou 8 connexite, modes BIN et PLA ;
+   haut : la ligne precedente est dans la bande. Voisins : a (haut-gauche),
+   b (haut), c (haut-droite), d (gauche). Si b est equivalent au point
+   courant, a, c et d le sont a b et ont deja ete reunis a lui. */
+{
+    int32_t *L = J->L, i, v, qa, qb, qc, qd;
+    index_t x, rs = J->rs;
+    int32_t bin = (J->mode == MCLABEL_BIN);
+
+#define EQ(j) (bin ? (VAL(J, j) != 0) : (VAL(J, j) == v))
+    for (x = 0; x < rs; x++) {
+        i = (int32_t)(i0 + x);
+        v = VAL(J, i);
+        if (bin && !v) {
+            L[i] = -1;
+            continue;
+        }
+        qb = haut && EQ(i - rs);
+        qd = (x > 0) && EQ(i - 1);
+        if (J->arbre == 4) {
+            if (qb && qd) {
+                L[i] = lab_union(L, i - (int32_t)rs, i - 1);
+            } else if (qb) {
+                L[i] = L[i - rs];
+            } else if (qd) {
+                L[i] = L[i - 1];
+            } else {
+                L[i] = i;
+            }
+            continue;
+        }
+        if (qb) {
+            L[i] = L[i - rs];
+            continue;
+        }
+        qc = haut && (x < rs - 1) && EQ(i - rs + 1);
+        qa = haut && (x > 0) && EQ(i - rs - 1);
+        if (qc) {
+            if (qa) {
+                L[i] = lab_union(L, i - (int32_t)rs + 1, i - (int32_t)rs - 1);
+            } else if (qd) {
+                L[i] = lab_union(L, i - (int32_t)rs + 1, i - 1);
+            } else {
+                L[i] = L[i - rs + 1];
+            }
+        } else if (qa) {
+            L[i] = L[i - rs - 1];
+        } else if (qd) {
+            L[i] = L[i - 1];
+        } else {
+            L[i] = i;
+        }
+    }
+#undef EQ
+} // lab_ligne_arbre()
+
+/* ==================================== */
+static void lab_bande(void *arg, int32_t band)
+/* ==================================== */
+{
+    mclabel_job *J = (mclabel_job *)arg;
+    index_t first, last, u, x, y, z, i, s;
+
+    mcthreads_band(J->plans ? J->ds : J->cs, J->nbands, band, &first, &last);
+    s = first * (J->plans ? J->ps : J->rs); // premier point de la bande
+    for (u = first; u < last; u++) {
+        if (J->arbre) { // 2d : u est une ligne
+            lab_ligne_arbre(J, u * J->rs, u > first);
+            continue;
+        }
+        for (z = (J->plans ? u : 0); z < (J->plans ? u + 1 : J->ds); z++) {
+            for (y = (J->plans ? 0 : u); y < (J->plans ? J->cs : u + 1); y++) {
+                for (x = 0; x < J->rs; x++) {
+                    i = z * J->ps + y * J->rs + x;
+                    if ((J->mode == MCLABEL_BIN) && (VAL(J, i) == 0)) {
+                        J->L[i] = -1;
+                        continue;
+                    }
+                    J->L[i] = (int32_t)i;
+                    lab_voisins(J, i, x, y, z, s, J->N);
+                }
+            }
+        }
+    }
+} // lab_bande()
+
+/* ==================================== */
+static void lab_frontiere(mclabel_job *J, int32_t band)
+/* ==================================== */
+/* fusion a travers la frontiere entre la bande band-1 et la bande band */
+{
+    index_t first, last, x, y, z, i, s;
+
+    mcthreads_band(J->plans ? J->ds : J->cs, J->nbands, band, &first, &last);
+    if (first == last) {
+        return;
+    }
+    s = first * (J->plans ? J->ps : J->rs);
+    for (z = (J->plans ? first : 0); z < (J->plans ? first + 1 : J->ds); z++) {
+        for (y = (J->plans ? 0 : first); y < (J->plans ? J->cs : first + 1); y++) {
+            for (x = 0; x < J->rs; x++) {
+                i = z * J->ps + y * J->rs + x;
+                if (J->L[i] < 0) {
+                    continue;
+                }
+                lab_voisins(J, i, x, y, z, 0, s);
+            }
+        }
+    }
+} // lab_frontiere()
+
+/* ==================================== */
+int32_t mclabel_possible(struct xvimage *img, int32_t connex)
+/* ==================================== */
+/*! \fn int32_t mclabel_possible(struct xvimage *img, int32_t connex)
+    \return 1 si mclabel traite ce type d'image et cette connexite, 0 sinon
+*/
+{
+    if ((datatype(img) != VFF_TYP_1_BYTE) && (datatype(img) != VFF_TYP_4_BYTE)) {
+        return 0;
+    }
+    if ((connex == 4) || (connex == 8)) {
+        return (depth(img) == 1);
+    }
+    return ((connex == 6) || (connex == 18) || (connex == 26));
+} // mclabel_possible()
+
+/* ==================================== */
+int32_t mclabel(struct xvimage *img, int32_t connex, int32_t mode,
+                struct xvimage *lab, int32_t *nlabels)
+/* ==================================== */
+/*! \fn int32_t mclabel(struct xvimage *img, int32_t connex, int32_t mode, struct xvimage *lab, int32_t *nlabels)
+    \param img (entrée) : image 2d ou 3d, octets ou entiers longs
+    \param connex (entrée) : 4, 8 (2d) ou 6, 18, 26
+    \param mode (entrée) : MCLABEL_BIN, MCLABEL_PLA, MCLABEL_MIN ou MCLABEL_MAX
+    \param lab (sortie) : image d'etiquettes (entiers longs, memes dimensions)
+    \param nlabels (sortie) : comme llabelbin (BIN), llabelplateaux (PLA)
+       ou llabelextrema (MIN, MAX)
+    \return 1 si succes, 0 sinon
+    \brief etiquetage des composantes connexes par union-find.
+*/
+{
+    mclabel_job J;
+    index_t i;
+    int32_t n, k, p, *L, *map;
+    uint8_t *E;
+#undef F_NAME
+#define F_NAME "mclabel"
+
+    if (!mclabel_possible(img, connex)) {
+        fprintf(stderr, "%s: bad data type or connexity\n", F_NAME);
+        return 0;
+    }
+    if ((datatype(lab) != VFF_TYP_4_BYTE) || (rowsize(lab) != rowsize(img)) ||
+        (colsize(lab) != colsize(img)) || (depth(lab) != depth(img))) {
+        fprintf(stderr, "%s: incompatible label image\n", F_NAME);
+        return 0;
+    }
+
+    memset(&J, 0, sizeof(J));
+    J.rs = rowsize(img);
+    J.cs = colsize(img);
+    J.ds = depth(img);
+    J.ps = J.rs * J.cs;
+    J.N = J.ps * J.ds;
+    if (J.N > INT32_MAX) {
+        fprintf(stderr, "%s: image too large\n", F_NAME);
+        return 0;
+    }
+    if (datatype(img) == VFF_TYP_1_BYTE) {
+        J.F = UCHARDATA(img);
+    } else {
+        J.FL = SLONGDATA(img);
+    }
+    J.L = L = SLONGDATA(lab);
+    J.mode = mode;
+    if ((mode == MCLABEL_MIN) || (mode == MCLABEL_MAX)) {
+        J.NE = (uint8_t *)calloc(J.N + 1, 1);
+        if (J.NE == NULL) {
+            fprintf(stderr, "%s: malloc failed\n", F_NAME);
+            return 0;
+        }
+    }
+    lab_voisinage(&J, connex);
+    J.plans = (J.ds > 1);
+    J.arbre = ((J.ds == 1) && ((connex == 4) || (connex == 8)) &&
+               ((mode == MCLABEL_BIN) || (mode == MCLABEL_PLA))) ? connex : 0;
+    J.nbands = mcthreads_nbands(J.plans ? J.ds : J.cs);
+
+    /* premiere passe, par bandes */
+    mcthreads_run(J.nbands, lab_bande, &J);
+    for (k = 1; k < J.nbands; k++) {
+        lab_frontiere(&J, k);
+    }
+
+    /* etiquettes definitives : le pere p d'un point i verifie p <= i */
+    n = 0;
+    for (i = 0; i < J.N; i++) {
+        p = L[i];
+        if (p < 0) {
+            L[i] = 0;
+        } else if (p == i) {
+            L[i] = ++n;
+        } else {
+            L[i] = L[p];
+        }
+    }
+
+    if (J.NE == NULL) {
+        *nlabels = (mode == MCLABEL_BIN) ? n + 1 : n;
+        return 1;
+    }
+
+    /* extrema : une composante est ecartee si l'un de ses points a un
+       voisin plus bas (MIN) ou plus haut (MAX) */
+    E = (uint8_t *)calloc(n + 1, 1);
+    map = (int32_t *)malloc((n + 1) * sizeof(int32_t));
+    if ((E == NULL) || (map == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(J.NE);
+        free(E);
+        free(map);
+        return 0;
+    }
+    for (i = 0; i < J.N; i++) {
+        if (J.NE[i]) {
+            E[L[i]] = 1;
+        }
+    }
+    map[0] = 0;
+    for (k = 1, p = 0; k <= n; k++) {
+        map[k] = E[k] ? 0 : ++p;
+    }
+    for (i = 0; i < J.N; i++) {
+        L[i] = map[L[i]];
+    }
+    *nlabels = p + 1;
+    free(J.NE);
+    free(E);
+    free(map);
+    return 1;
+} // mclabel()
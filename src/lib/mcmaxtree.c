@@ -0,0 +1,1094 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Librairie mcmaxtree :
+
+   construction de l'arbre des composantes (max-tree ou min-tree) d'une
+   image 2d ou 3d de type quelconque (byte, int16 non signe, int32, float),
+   et filtres connexes bases sur les attributs surface, hauteur et volume.
+
+   Les pixels sont tries par niveaux croissants par un tri par
+   denombrement (byte, int16) ou par un tri par base a deux passes de
+   16 bits (int32, float : la valeur est d'abord transformee en une cle
+   entiere non signee de meme ordre). L'arbre est ensuite construit par
+   union-find avec compression de chemins et union par rang, en traitant
+   les pixels par niveaux decroissants (algorithme de Berger, Geraud,
+   Levillain, Widynski et Baillard, ICIP 2007). Tous les index sont de type index_t (64 bits
+   en mode MC_64_BITS) : le nombre de pixels et de composantes n'est
+   limite que par la memoire (4 tableaux de N index_t et N octets pendant
+   la construction, 2 tableaux de N index_t pour l'arbre).
+
+   Attributs (pour une composante c, de niveau h(c), de pere c') :
+     surface : nombre de pixels de c ;
+     hauteur : max { F(x), x dans c } - h(c') - q ;
+     volume  : somme { F(x) - h(c) + q, x dans c } pour les images entieres,
+               somme { F(x) - h(c'), x dans c } pour les images flottantes ;
+   avec q = 1 (quantum de niveau) pour les images entieres, q = 0 pour les
+   images flottantes. Pour les images byte, ces definitions coincident
+   avec celles de lattrib.h (algorithme de Salembier). Pour un min-tree,
+   les niveaux sont pris en ordre inverse (F remplace par -F).
+
+   Filtrage : chaque pixel prend la valeur de la plus petite composante
+   qui le contient et dont l'attribut est superieur ou egal au seuil (regle
+   directe ; elle coincide avec les regles min et max pour ces attributs
+   croissants). La racine est toujours conservee.
+
+   Segmentation (mcmaxtree_segment, mcmaxtree_selnb) : memes regles que
+   FiltreVolRec, MaximiseSegmentation, la boucle de selection de lvolselnb
+   et RecupereSegmentation (lattrib.h), sur l'arbre mcmaxtree. Le resultat
+   est binaire (NDG_MAX pour les pixels des feuilles de l'arbre filtre,
+   NDG_MIN ailleurs). Pour la selection, les composantes d'attributs egaux
+   sont eliminees dans l'ordre de leur plus petit pixel (et non dans un
+   ordre aleatoire) : le resultat ne depend pas du nombre de threads.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <mcutil.h>
+#include <mcthreads.h>
+#include <mcmaxtree.h>
+
+/* etats des composantes pour la segmentation */
+#define MCMAXTREE_FILTRE  0x01
+#define MCMAXTREE_FEUILLE 0x02
+#define MCMAXTREE_FUSION  0x04
+#define MCMAXTREE_BLANC   0x08
+
+/* ==================================== */
+static inline uint32_t mcmaxtree_key(void *F, int32_t type, index_t i)
+/* ==================================== */
+/* cle entiere non signee, croissante avec la valeur du pixel i */
+{
+    uint32_t u;
+    switch (type) {
+    case VFF_TYP_1_BYTE:
+        return ((uint8_t *)F)[i];
+    case VFF_TYP_2_BYTE:
+        return ((uint16_t *)F)[i];
+    case VFF_TYP_4_BYTE:
+        return (uint32_t)((int32_t *)F)[i] ^ 0x80000000U;
+    default: /* VFF_TYP_FLOAT */
+        memcpy(&u, (float *)F + i, sizeof(uint32_t));
+        return (u & 0x80000000U) ? ~u : (u | 0x80000000U);
+    }
+} /* mcmaxtree_key() */
+
+/* ==================================== */
+static inline double mcmaxtree_val(void *F, int32_t type, index_t i)
+/* ==================================== */
+{
+    switch (type) {
+    case VFF_TYP_1_BYTE:
+        return (double)((uint8_t *)F)[i];
+    case VFF_TYP_2_BYTE:
+        return (double)((uint16_t *)F)[i];
+    case VFF_TYP_4_BYTE:
+        return (double)((int32_t *)F)[i];
+    default: /* VFF_TYP_FLOAT */
+        return (double)((float *)F)[i];
+    }
+} /* mcmaxtree_val() */
+
+/* ==================================== */
+static int32_t mcmaxtree_keybits(int32_t type)
+/* ==================================== */
+{
+    switch (type) {
+    case VFF_TYP_1_BYTE:
+        return 8;
+    case VFF_TYP_2_BYTE:
+        return 16;
+    default:
+        return 32;
+    }
+} /* mcmaxtree_keybits() */
+
+/* contexte de construction, partage par les taches (mcthreads) */
+typedef struct {
+    void *F;                       /* donnees de l'image */
+    int32_t type;                  /* type des pixels */
+    uint32_t inv;                  /* masque d'inversion des cles (min-tree) */
+    int32_t nbits;                 /* nombre de bits des cles */
+    index_t rs, cs, ds, ps, N;
+    int32_t dim3;                  /* 1 si connexite 3d */
+    int32_t nv;                    /* nombre de voisins */
+    int32_t dx[26], dy[26], dz[26];
+    index_t off[26];
+    index_t *S, *parent, *zpar, *repr, *tmp;
+    uint8_t *rank;
+    int32_t ntiles;                /* nombre de tuiles */
+    index_t nplanes;               /* nombre de plans (z) ou de lignes (y) */
+    index_t planesize;             /* taille d'un plan ou d'une ligne */
+    int32_t step;                  /* fusion : etape courante */
+    index_t *H;                    /* tri parallele : histogrammes des tuiles */
+    index_t *src, *dst;            /* tri parallele : passe courante */
+    int32_t shift;                 /* tri parallele : decalage du chiffre */
+    index_t *bound;                /* partition : bornes des tranches de S */
+    int32_t error;
+} mcmaxtree_ctx;
+
+#define MCMAXTREE_KEY(C,p) (mcmaxtree_key((C)->F, (C)->type, p) ^ (C)->inv)
+
+/* ==================================== */
+static void mcmaxtree_tilebounds(mcmaxtree_ctx *C, int32_t t, index_t *first, index_t *last)
+/* ==================================== */
+/* pixels [*first, *last[ de la tuile t (tranche de plans ou de lignes) */
+{
+    index_t pf, pl;
+    mcthreads_band(C->nplanes, C->ntiles, t, &pf, &pl);
+    *first = pf * C->planesize;
+    *last = pl * C->planesize;
+} /* mcmaxtree_tilebounds() */
+
+/* ==================================== */
+static int32_t mcmaxtree_sort(mcmaxtree_ctx *C, index_t first, index_t last)
+/* ==================================== */
+/*
+  Range dans S[first..last[ les pixels first..last-1 par cles croissantes
+  (decroissantes pour un min-tree). Tri stable par denombrement sur des
+  chiffres d'au plus 16 bits : une passe pour les cles de 8 ou 16 bits,
+  deux passes (chiffre de poids faible, puis de poids fort, via tmp) pour
+  les cles de 32 bits.
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_sort"
+{
+    int32_t digbits = mcmin(C->nbits, 16);
+    index_t nbuckets = (index_t)1 << digbits;
+    uint32_t digmask = (uint32_t)(nbuckets - 1);
+    index_t *H, i, c, t;
+    int32_t pass, npass = C->nbits / digbits, shift;
+    index_t *src, *dst;
+
+    H = (index_t *)malloc(nbuckets * sizeof(index_t));
+    if (H == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    for (pass = 0; pass < npass; pass++) {
+        shift = pass * digbits;
+        src = (pass == 0) ? NULL : ((npass - pass) % 2 ? C->tmp : C->S);
+        dst = ((npass - pass) % 2) ? C->S : C->tmp;
+        memset(H, 0, nbuckets * sizeof(index_t));
+        for (i = first; i < last; i++) {
+            H[(MCMAXTREE_KEY(C, i) >> shift) & digmask]++;
+        }
+        for (c = first, i = 0; i < nbuckets; i++) {
+            t = H[i];
+            H[i] = c;
+            c += t;
+        }
+        if (src == NULL) {
+            for (i = first; i < last; i++) {
+                dst[H[(MCMAXTREE_KEY(C, i) >> shift) & digmask]++] = i;
+            }
+        } else {
+            for (i = first; i < last; i++) {
+                t = src[i];
+                dst[H[(MCMAXTREE_KEY(C, t) >> shift) & digmask]++] = t;
+            }
+        }
+    }
+    free(H);
+    return 1;
+} /* mcmaxtree_sort() */
+
+/* ==================================== */
+static inline index_t mcmaxtree_findroot(index_t *zpar, index_t x)
+/* ==================================== */
+{
+    index_t r = x, t;
+    while (zpar[r] != r) {
+        r = zpar[r];
+    }
+    while (zpar[x] != r) {
+        t = zpar[x];
+        zpar[x] = r;
+        x = t;
+    }
+    return r;
+} /* mcmaxtree_findroot() */
+
+/* ==================================== */
+static void mcmaxtree_tile(void *arg, int32_t t)
+/* ==================================== */
+/*
+  Arbre de la tuile t : tri des pixels de la tuile, union-find par niveaux
+  decroissants (croissants pour un min-tree) restreint aux voisins situes
+  dans la tuile, puis canonisation.
+  L'union se fait par rang : zpar est la foret de l'union-find, repr[r] le
+  pixel de l'arbre associe a la racine r de l'union-find.
+*/
+{
+    mcmaxtree_ctx *C = (mcmaxtree_ctx *)arg;
+    index_t rs = C->rs, cs = C->cs, ds = C->ds, ps = C->ps;
+    index_t *S = C->S, *parent = C->parent, *zpar = C->zpar, *repr = C->repr;
+    uint8_t *rank = C->rank;
+    index_t first, last, i, p, q, r, zp, x, y, z;
+    int32_t k, interior;
+
+    mcmaxtree_tilebounds(C, t, &first, &last);
+    if (first >= last) {
+        return;
+    }
+    if (!mcmaxtree_sort(C, first, last)) {
+        C->error = 1;
+        return;
+    }
+    for (i = first; i < last; i++) {
+        zpar[i] = -1;
+    }
+    for (i = last - 1; i >= first; i--) {
+        p = S[i];
+        parent[p] = zpar[p] = repr[p] = zp = p;
+        z = p / ps;
+        y = (p - z * ps) / rs;
+        x = p - z * ps - y * rs;
+        interior = (x > 0) && (x < rs - 1) && (y > 0) && (y < cs - 1) &&
+                   (!C->dim3 || ((z > 0) && (z < ds - 1)));
+        for (k = 0; k < C->nv; k++) {
+            if (!interior && ((x + C->dx[k] < 0) || (x + C->dx[k] >= rs) || (y + C->dy[k] < 0) ||
+                              (y + C->dy[k] >= cs) || (z + C->dz[k] < 0) || (z + C->dz[k] >= ds))) {
+                continue;
+            }
+            q = p + C->off[k];
+            if ((q < first) || (q >= last) || (zpar[q] == -1)) {
+                continue;
+            }
+            r = mcmaxtree_findroot(zpar, q);
+            if (r != zp) {
+                parent[repr[r]] = p;
+                if (rank[zp] < rank[r]) {
+                    q = zp;
+                    zp = r;
+                    r = q;
+                }
+                zpar[r] = zp;
+                repr[zp] = p;
+                if (rank[zp] == rank[r]) {
+                    rank[zp]++;
+                }
+            }
+        }
+    }
+
+    /* canonisation : parent[p] devient le pixel canonique de la composante */
+    for (i = first; i < last; i++) {
+        p = S[i];
+        q = parent[p];
+        if (MCMAXTREE_KEY(C, parent[q]) == MCMAXTREE_KEY(C, q)) {
+            parent[p] = parent[q];
+        }
+    }
+} /* mcmaxtree_tile() */
+
+/* ==================================== */
+static inline index_t mcmaxtree_levroot(mcmaxtree_ctx *C, index_t x)
+/* ==================================== */
+/* pixel canonique de la composante de niveau qui contient x */
+{
+    index_t *parent = C->parent;
+    uint32_t kx = MCMAXTREE_KEY(C, x);
+    while ((parent[x] != x) && (MCMAXTREE_KEY(C, parent[x]) == kx)) {
+        x = parent[x];
+    }
+    return x;
+} /* mcmaxtree_levroot() */
+
+/* ==================================== */
+static void mcmaxtree_connect(mcmaxtree_ctx *C, index_t p, index_t q)
+/* ==================================== */
+/*
+  Fusionne les arbres contenant les pixels voisins p et q : les branches
+  qui menent de p et de q a leurs racines sont entrelacees par niveaux
+  decroissants (Wilkinson, Gao, Hesselink, Jonker et Meijster, IEEE PAMI
+  2008).
+*/
+{
+    index_t *parent = C->parent;
+    index_t x, y, z;
+
+    x = mcmaxtree_levroot(C, p);
+    y = mcmaxtree_levroot(C, q);
+    if (MCMAXTREE_KEY(C, x) < MCMAXTREE_KEY(C, y)) {
+        z = x;
+        x = y;
+        y = z;
+    }
+    while ((x != y) && (y != -1)) {
+        z = (parent[x] == x) ? -1 : mcmaxtree_levroot(C, parent[x]);
+        if ((z != -1) && (MCMAXTREE_KEY(C, z) >= MCMAXTREE_KEY(C, y))) {
+            x = z;
+        } else {
+            parent[x] = y;
+            x = y;
+            y = z;
+        }
+    }
+} /* mcmaxtree_connect() */
+
+/* ==================================== */
+static void mcmaxtree_merge(void *arg, int32_t j)
+/* ==================================== */
+/*
+  Etape C->step de la fusion : relie les arbres des groupes de tuiles
+  [g, g+step[ et [g+step, g+2*step[, avec g = 2*step*j, le long de leur
+  frontiere commune.
+*/
+{
+    mcmaxtree_ctx *C = (mcmaxtree_ctx *)arg;
+    index_t rs = C->rs, cs = C->cs, ps = C->ps;
+    index_t first, last, p, x, y, z;
+    int32_t g = 2 * C->step * j, k;
+
+    mcmaxtree_tilebounds(C, g + C->step, &first, &last);
+    for (p = first - C->planesize; p < first; p++) {
+        z = p / ps;
+        y = (p - z * ps) / rs;
+        x = p - z * ps - y * rs;
+        for (k = 0; k < C->nv; k++) {
+            if ((C->ds > 1) ? (C->dz[k] != 1) : ((C->dz[k] != 0) || (C->dy[k] != 1))) {
+                continue;
+            }
+            if ((x + C->dx[k] < 0) || (x + C->dx[k] >= rs) || (y + C->dy[k] < 0) ||
+                    (y + C->dy[k] >= cs)) {
+                continue;
+            }
+            mcmaxtree_connect(C, p, p + C->off[k]);
+        }
+    }
+} /* mcmaxtree_merge() */
+
+/* ==================================== */
+static void mcmaxtree_canon(void *arg, int32_t t)
+/* ==================================== */
+/* canonisation globale apres fusion ; le resultat est range dans zpar */
+{
+    mcmaxtree_ctx *C = (mcmaxtree_ctx *)arg;
+    index_t *parent = C->parent, first, last, p;
+
+    mcmaxtree_tilebounds(C, t, &first, &last);
+    for (p = first; p < last; p++) {
+        if (parent[p] == p) {
+            C->zpar[p] = p;
+        } else if (MCMAXTREE_KEY(C, parent[p]) == MCMAXTREE_KEY(C, p)) {
+            C->zpar[p] = mcmaxtree_levroot(C, p);
+        } else {
+            C->zpar[p] = mcmaxtree_levroot(C, parent[p]);
+        }
+    }
+} /* mcmaxtree_canon() */
+
+/* ==================================== */
+static void mcmaxtree_psorthisto(void *arg, int32_t t)
+/* ==================================== */
+{
+    mcmaxtree_ctx *C = (mcmaxtree_ctx *)arg;
+    index_t nbuckets = (index_t)1 << mcmin(C->nbits, 16);
+    uint32_t digmask = (uint32_t)(nbuckets - 1);
+    index_t *H = C->H + t * nbuckets, first, last, i;
+
+    mcmaxtree_tilebounds(C, t, &first, &last);
+    memset(H, 0, nbuckets * sizeof(index_t));
+    for (i = first; i < last; i++) {
+        H[(MCMAXTREE_KEY(C, C->src ? C->src[i] : i) >> C->shift) & digmask]++;
+    }
+} /* mcmaxtree_psorthisto() */
+
+/* ==================================== */
+static void mcmaxtree_psortscatter(void *arg, int32_t t)
+/* ==================================== */
+{
+    mcmaxtree_ctx *C = (mcmaxtree_ctx *)arg;
+    index_t nbuckets = (index_t)1 << mcmin(C->nbits, 16);
+    uint32_t digmask = (uint32_t)(nbuckets - 1);
+    index_t *H = C->H + t * nbuckets, first, last, i, p;
+
+    mcmaxtree_tilebounds(C, t, &first, &last);
+    for (i = first; i < last; i++) {
+        p = C->src ? C->src[i] : i;
+        C->dst[H[(MCMAXTREE_KEY(C, p) >> C->shift) & digmask]++] = p;
+    }
+} /* mcmaxtree_psortscatter() */
+
+/* ==================================== */
+static int32_t mcmaxtree_psort(mcmaxtree_ctx *C)
+/* ==================================== */
+/*
+  Tri global de tous les pixels dans S (meme principe que mcmaxtree_sort),
+  reparti entre les tuiles : histogrammes par tuile, sommes prefixes, puis
+  placement des pixels de chaque tuile.
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_psort"
+{
+    int32_t digbits = mcmin(C->nbits, 16);
+    index_t nbuckets = (index_t)1 << digbits, b, c, h;
+    int32_t pass, npass = C->nbits / digbits, t;
+
+    C->H = (index_t *)malloc(C->ntiles * nbuckets * sizeof(index_t));
+    if (C->H == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return 0;
+    }
+    for (pass = 0; pass < npass; pass++) {
+        C->shift = pass * digbits;
+        C->src = (pass == 0) ? NULL : ((npass - pass) % 2 ? C->tmp : C->S);
+        C->dst = ((npass - pass) % 2) ? C->S : C->tmp;
+        mcthreads_run(C->ntiles, mcmaxtree_psorthisto, C);
+        for (c = 0, b = 0; b < nbuckets; b++) {
+            for (t = 0; t < C->ntiles; t++) {
+                h = C->H[t * nbuckets + b];
+                C->H[t * nbuckets + b] = c;
+                c += h;
+            }
+        }
+        mcthreads_run(C->ntiles, mcmaxtree_psortscatter, C);
+    }
+    free(C->H);
+    C->H = NULL;
+    return 1;
+} /* mcmaxtree_psort() */
+
+/* ==================================== */
+static void mcmaxtree_partition(void *arg, int32_t t)
+/* ==================================== */
+/*
+  Dans chaque suite de pixels de meme niveau de S[bound[t]..bound[t+1][,
+  place les pixels canoniques avant les autres (ordre stable), de sorte
+  que le pere de chaque pixel le precede dans S.
+*/
+{
+    mcmaxtree_ctx *C = (mcmaxtree_ctx *)arg;
+    index_t *S = C->S, *parent = C->parent, *tmp = C->tmp;
+    index_t a, b, i, n, m, p, last = C->bound[t + 1];
+    uint32_t k;
+
+    for (a = C->bound[t]; a < last; a = b) {
+        k = MCMAXTREE_KEY(C, S[a]);
+        for (b = a + 1; (b < last) && (MCMAXTREE_KEY(C, S[b]) == k); b++) ;
+        for (n = a, m = a, i = a; i < b; i++) {
+            p = S[i];
+            if ((parent[p] == p) || (MCMAXTREE_KEY(C, parent[p]) != k)) {
+                S[n++] = p;
+            } else {
+                tmp[m++] = p;
+            }
+        }
+        for (i = a; i < m; i++) {
+            S[n++] = tmp[i];
+        }
+    }
+} /* mcmaxtree_partition() */
+
+/* ==================================== */
+mcmaxtree * mcmaxtree_build(struct xvimage *image, int32_t connex, int32_t maxtree)
+/* ==================================== */
+/*
+  Construit le max-tree (maxtree = 1) ou le min-tree (maxtree = 0) de
+  l'image, pour la connexite connex (4 ou 8 en 2d, 6, 18 ou 26 en 2d ou 3d).
+
+  Avec plusieurs threads, l'image est decoupee en tuiles (tranches de
+  plans en 3d, de lignes en 2d) dont les arbres sont construits en
+  parallele, puis fusionnes deux a deux le long des frontieres (log2 du
+  nombre de tuiles etapes, elles-memes paralleles). Le resultat represente
+  le meme arbre que la construction sequentielle (seul le choix des pixels
+  canoniques peut differer).
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_build"
+{
+    mcmaxtree_ctx C;
+    int32_t l1max, t;
+    index_t x, y, z, *swap;
+    mcmaxtree *T;
+
+    memset(&C, 0, sizeof(C));
+    C.F = (void *)(image->image_data);
+    C.type = datatype(image);
+    C.rs = rowsize(image);
+    C.cs = colsize(image);
+    C.ds = depth(image);
+    C.ps = C.rs * C.cs;
+    C.N = C.ps * C.ds;
+    if ((C.type != VFF_TYP_1_BYTE) && (C.type != VFF_TYP_2_BYTE) &&
+            (C.type != VFF_TYP_4_BYTE) && (C.type != VFF_TYP_FLOAT)) {
+        fprintf(stderr, "%s: bad image type\n", F_NAME);
+        return NULL;
+    }
+    C.nbits = mcmaxtree_keybits(C.type);
+    C.inv = maxtree ? 0 : (uint32_t)(((uint64_t)1 << C.nbits) - 1);
+    switch (connex) {
+    case 4:
+        l1max = 1;
+        C.dim3 = 0;
+        break;
+    case 8:
+        l1max = 2;
+        C.dim3 = 0;
+        break;
+    case 6:
+        l1max = 1;
+        C.dim3 = 1;
+        break;
+    case 18:
+        l1max = 2;
+        C.dim3 = 1;
+        break;
+    case 26:
+        l1max = 3;
+        C.dim3 = 1;
+        break;
+    default:
+        fprintf(stderr, "%s: bad connexity: %d\n", F_NAME, connex);
+        return NULL;
+    }
+    if (!C.dim3 && (C.ds > 1)) {
+        fprintf(stderr, "%s: connexity %d requires a 2d image\n", F_NAME, connex);
+        return NULL;
+    }
+    for (z = -C.dim3; z <= C.dim3; z++) {
+        for (y = -1; y <= 1; y++) {
+            for (x = -1; x <= 1; x++) {
+                int32_t l1 = (int32_t)(mcabs(x) + mcabs(y) + mcabs(z));
+                if ((l1 > 0) && (l1 <= l1max)) {
+                    C.dx[C.nv] = (int32_t)x;
+                    C.dy[C.nv] = (int32_t)y;
+                    C.dz[C.nv] = (int32_t)z;
+                    C.off[C.nv] = z * C.ps + y * C.rs + x;
+                    C.nv++;
+                }
+            }
+        }
+    }
+    C.nplanes = (C.ds > 1) ? C.ds : C.cs;
+    C.planesize = (C.ds > 1) ? C.ps : C.rs;
+    C.ntiles = (int32_t)mcmin((index_t)mcthreads_nthreads(), C.nplanes);
+
+    T = (mcmaxtree *)malloc(sizeof(mcmaxtree));
+    C.S = (index_t *)malloc(C.N * sizeof(index_t));
+    C.parent = (index_t *)malloc(C.N * sizeof(index_t));
+    C.zpar = (index_t *)malloc(C.N * sizeof(index_t));
+    C.repr = (index_t *)malloc(C.N * sizeof(index_t));
+    C.rank = (uint8_t *)calloc(C.N, sizeof(uint8_t));
+    if ((T == NULL) || (C.S == NULL) || (C.parent == NULL) || (C.zpar == NULL) ||
+            (C.repr == NULL) || (C.rank == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        goto fail;
+    }
+    T->N = C.N;
+    T->maxtree = maxtree;
+
+    /* arbres des tuiles (repr sert de tableau de travail pour le tri) */
+    C.tmp = C.repr;
+    mcthreads_run(C.ntiles, mcmaxtree_tile, &C);
+    free(C.repr);
+    free(C.rank);
+    C.repr = NULL;
+    C.rank = NULL;
+    if (C.error) {
+        goto fail;
+    }
+
+    if (C.ntiles > 1) {
+        /* fusion des arbres des tuiles */
+        for (C.step = 1; C.step < C.ntiles; C.step *= 2) {
+            mcthreads_run((C.ntiles - C.step - 1) / (2 * C.step) + 1, mcmaxtree_merge, &C);
+        }
+        /* canonisation globale, tri global, puis pixels canoniques en tete
+           de chaque niveau */
+        mcthreads_run(C.ntiles, mcmaxtree_canon, &C);
+        swap = C.parent;
+        C.parent = C.zpar;
+        C.zpar = swap;
+        C.tmp = C.zpar;
+        if (!mcmaxtree_psort(&C)) {
+            goto fail;
+        }
+        C.bound = (index_t *)malloc((C.ntiles + 1) * sizeof(index_t));
+        if (C.bound == NULL) {
+            fprintf(stderr, "%s: malloc failed\n", F_NAME);
+            goto fail;
+        }
+        for (t = 0; t <= C.ntiles; t++) {
+            x = (C.N * t) / C.ntiles;
+            if (t > 0) {
+                x = mcmax(x, C.bound[t - 1]);
+            }
+            while ((x > 0) && (x < C.N) &&
+                    (MCMAXTREE_KEY(&C, C.S[x]) == MCMAXTREE_KEY(&C, C.S[x - 1]))) {
+                x++;
+            }
+            C.bound[t] = x;
+        }
+        mcthreads_run(C.ntiles, mcmaxtree_partition, &C);
+        free(C.bound);
+    }
+    free(C.zpar);
+    T->S = C.S;
+    T->parent = C.parent;
+    return T;
+
+fail:
+    free(T);
+    free(C.S);
+    free(C.parent);
+    free(C.zpar);
+    free(C.repr);
+    free(C.rank);
+    return NULL;
+} /* mcmaxtree_build() */
+
+/* ==================================== */
+void mcmaxtree_free(mcmaxtree *T)
+/* ==================================== */
+{
+    if (T == NULL) {
+        return;
+    }
+    free(T->S);
+    free(T->parent);
+    free(T);
+} /* mcmaxtree_free() */
+
+/* ==================================== */
+double * mcmaxtree_attribute(mcmaxtree *T, struct xvimage *image, int32_t attribute)
+/* ==================================== */
+/*
+  Calcule l'attribut (MCMAXTREE_AREA, MCMAXTREE_HEIGHT ou MCMAXTREE_VOL)
+  des composantes de l'arbre T, construit sur image. Le tableau resultat
+  (N doubles, a liberer par l'appelant) n'a de sens qu'aux pixels
+  canoniques ; l'attribut de la racine est HUGE_VAL.
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_attribute"
+{
+    index_t N = T->N, *S = T->S, *parent = T->parent, i, p, q;
+    int32_t type = datatype(image);
+    void *F = (void *)(image->image_data);
+    double sgn = T->maxtree ? 1.0 : -1.0;
+    double quantum = (type == VFF_TYP_FLOAT) ? 0.0 : 1.0;
+    double *A, *area = NULL, d;
+
+    A = (double *)malloc(N * sizeof(double));
+    if (A == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return NULL;
+    }
+    switch (attribute) {
+    case MCMAXTREE_AREA:
+        for (i = 0; i < N; i++) {
+            A[i] = 1.0;
+        }
+        for (i = N - 1; i > 0; i--) {
+            p = S[i];
+            A[parent[p]] += A[p];
+        }
+        break;
+    case MCMAXTREE_HEIGHT:
+        for (i = 0; i < N; i++) {
+            A[i] = sgn * mcmaxtree_val(F, type, i);
+        }
+        for (i = N - 1; i > 0; i--) {
+            p = S[i];
+            q = parent[p];
+            A[q] = mcmax(A[q], A[p]);
+        }
+        for (i = 1; i < N; i++) {
+            p = S[i];
+            A[p] = A[p] - sgn * mcmaxtree_val(F, type, parent[p]) - quantum;
+        }
+        break;
+    case MCMAXTREE_VOL:
+        area = (double *)malloc(N * sizeof(double));
+        if (area == NULL) {
+            fprintf(stderr, "%s: malloc failed\n", F_NAME);
+            free(A);
+            return NULL;
+        }
+        for (i = 0; i < N; i++) {
+            A[i] = quantum;
+            area[i] = 1.0;
+        }
+        for (i = N - 1; i > 0; i--) {
+            p = S[i];
+            q = parent[p];
+            d = sgn * (mcmaxtree_val(F, type, p) - mcmaxtree_val(F, type, q));
+            A[q] += A[p] + area[p] * d;
+            area[q] += area[p];
+        }
+        if (type == VFF_TYP_FLOAT) {
+            for (i = 1; i < N; i++) {
+                p = S[i];
+                A[p] += area[p] * sgn * (mcmaxtree_val(F, type, p) - mcmaxtree_val(F, type, parent[p]));
+            }
+        }
+        free(area);
+        break;
+    default:
+        fprintf(stderr, "%s: bad attribute: %d\n", F_NAME, attribute);
+        free(A);
+        return NULL;
+    }
+    A[S[0]] = HUGE_VAL;
+    return A;
+} /* mcmaxtree_attribute() */
+
+/* ==================================== */
+int32_t mcmaxtree_filter(mcmaxtree *T, struct xvimage *image, double *attr, double seuil)
+/* ==================================== */
+/*
+  Remplace la valeur de chaque pixel par le niveau de la plus petite
+  composante qui le contient et dont l'attribut est >= seuil.
+  Le tableau attr (cf. mcmaxtree_attribute) est detruit.
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_filter"
+{
+    index_t N = T->N, *S = T->S, *parent = T->parent, i, p, q;
+    int32_t type = datatype(image);
+    void *F = (void *)(image->image_data);
+
+    /* attr[p] recoit la valeur filtree de p ; le pere est traite avant p */
+    for (i = 0; i < N; i++) {
+        p = S[i];
+        q = parent[p];
+        if (((p == q) || (mcmaxtree_key(F, type, p) != mcmaxtree_key(F, type, q))) &&
+                (attr[p] >= seuil)) {
+            attr[p] = mcmaxtree_val(F, type, p);
+        } else {
+            attr[p] = attr[q];
+        }
+    }
+    switch (type) {
+    case VFF_TYP_1_BYTE:
+        for (i = 0; i < N; i++) {
+            ((uint8_t *)F)[i] = (uint8_t)attr[i];
+        }
+        break;
+    case VFF_TYP_2_BYTE:
+        for (i = 0; i < N; i++) {
+            ((uint16_t *)F)[i] = (uint16_t)attr[i];
+        }
+        break;
+    case VFF_TYP_4_BYTE:
+        for (i = 0; i < N; i++) {
+            ((int32_t *)F)[i] = (int32_t)attr[i];
+        }
+        break;
+    case VFF_TYP_FLOAT:
+        for (i = 0; i < N; i++) {
+            ((float *)F)[i] = (float)attr[i];
+        }
+        break;
+    default:
+        fprintf(stderr, "%s: bad image type\n", F_NAME);
+        return 0;
+    }
+    return 1;
+} /* mcmaxtree_filter() */
+
+/* ==================================== */
+static inline int32_t mcmaxtree_canonique(mcmaxtree *T, void *F, int32_t type, index_t p)
+/* ==================================== */
+{
+    index_t q = T->parent[p];
+    return (p == q) || (mcmaxtree_key(F, type, p) != mcmaxtree_key(F, type, q));
+} /* mcmaxtree_canonique() */
+
+/* ==================================== */
+static void mcmaxtree_binarise(mcmaxtree *T, struct xvimage *image, uint8_t *M)
+/* ==================================== */
+/*
+  Ecrit dans image le resultat d'une segmentation : M[p] & MCMAXTREE_BLANC
+  pour les pixels canoniques p, herite du pere pour les autres. Le pere
+  est traite avant p.
+*/
+{
+    index_t N = T->N, *S = T->S, *parent = T->parent, i, p;
+    int32_t type = datatype(image);
+    void *F = (void *)(image->image_data);
+    double v;
+
+    for (i = 0; i < N; i++) {
+        p = S[i];
+        if (!mcmaxtree_canonique(T, F, type, p)) {
+            M[p] = (uint8_t)((M[p] & ~MCMAXTREE_BLANC) | (M[parent[p]] & MCMAXTREE_BLANC));
+        }
+    }
+    for (i = 0; i < N; i++) {
+        v = (M[i] & MCMAXTREE_BLANC) ? NDG_MAX : NDG_MIN;
+        switch (type) {
+        case VFF_TYP_1_BYTE:
+            ((uint8_t *)F)[i] = (uint8_t)v;
+            break;
+        case VFF_TYP_2_BYTE:
+            ((uint16_t *)F)[i] = (uint16_t)v;
+            break;
+        case VFF_TYP_4_BYTE:
+            ((int32_t *)F)[i] = (int32_t)v;
+            break;
+        default: /* VFF_TYP_FLOAT */
+            ((float *)F)[i] = (float)v;
+            break;
+        }
+    }
+} /* mcmaxtree_binarise() */
+
+/* ==================================== */
+int32_t mcmaxtree_segment(mcmaxtree *T, struct xvimage *image, double *attr, double seuil,
+                          int32_t maximise)
+/* ==================================== */
+/*
+  Segmentation : les composantes dont l'attribut est < seuil sont
+  eliminees, les feuilles de l'arbre restant sont mises a NDG_MAX, le
+  reste a NDG_MIN. Si maximise, chaque feuille est etendue vers la racine
+  tant que son pere n'a pas d'autre fils conserve (MaximiseSegmentation).
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_segment"
+{
+    index_t N = T->N, *S = T->S, *parent = T->parent, i, p, q;
+    int32_t type = datatype(image);
+    void *F = (void *)(image->image_data);
+    index_t *R;     /* somme des resultats de MaximiseSegmentation des fils */
+    uint8_t *M;
+    index_t r;
+
+    R = (index_t *)calloc(N, sizeof(index_t));
+    M = (uint8_t *)calloc(N, sizeof(uint8_t));
+    if ((R == NULL) || (M == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(R);
+        free(M);
+        return 0;
+    }
+
+    /* des feuilles vers la racine */
+    for (i = N - 1; i >= 0; i--) {
+        p = S[i];
+        if (!mcmaxtree_canonique(T, F, type, p)) {
+            continue;
+        }
+        if (attr[p] < seuil) {
+            M[p] = MCMAXTREE_FILTRE;
+            r = 0;
+        } else if (R[p] == 0) {
+            M[p] = MCMAXTREE_FEUILLE;
+            r = 1;
+        } else if (maximise && (R[p] == 1)) {
+            M[p] = MCMAXTREE_FEUILLE | MCMAXTREE_FUSION;
+            r = 1;
+        } else {
+            r = 1 + R[p];
+        }
+        if (i > 0) {
+            R[parent[p]] += r;
+        }
+    }
+    free(R);
+
+    /* de la racine vers les feuilles : un fils conserve d'une composante
+       MCMAXTREE_FUSION est absorbe par son pere */
+    for (i = 0; i < N; i++) {
+        p = S[i];
+        if (!mcmaxtree_canonique(T, F, type, p)) {
+            continue;
+        }
+        q = parent[p];
+        if ((i > 0) && ((M[p] & MCMAXTREE_FILTRE) || (M[q] & MCMAXTREE_FUSION))) {
+            M[p] |= (M[q] & MCMAXTREE_BLANC);
+        } else if (M[p] & MCMAXTREE_FEUILLE) {
+            M[p] |= MCMAXTREE_BLANC;
+        }
+    }
+    mcmaxtree_binarise(T, image, M);
+    free(M);
+    return 1;
+} /* mcmaxtree_segment() */
+
+typedef struct {
+    double a;       /* attribut */
+    index_t m;      /* plus petit pixel de la composante */
+    index_t p;      /* pixel canonique */
+} mcmaxtree_comp;
+
+/* ==================================== */
+static int mcmaxtree_compare(const void *x, const void *y)
+/* ==================================== */
+{
+    const mcmaxtree_comp *u = (const mcmaxtree_comp *)x, *v = (const mcmaxtree_comp *)y;
+    if (u->a != v->a) {
+        return (u->a < v->a) ? -1 : 1;
+    }
+    return (u->m < v->m) ? -1 : ((u->m > v->m) ? 1 : 0);
+} /* mcmaxtree_compare() */
+
+/* ==================================== */
+int32_t mcmaxtree_selnb(mcmaxtree *T, struct xvimage *image, double *attr, index_t nb)
+/* ==================================== */
+/*
+  Selection de nb composantes : les feuilles sont eliminees par attribut
+  croissant tant que l'arbre a plus de nb feuilles ; les feuilles restantes
+  sont mises a NDG_MAX, le reste a NDG_MIN.
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_selnb"
+{
+    index_t N = T->N, *S = T->S, *parent = T->parent, i, p, q, k, nbcomp = 0, nbfeuilles = 0;
+    int32_t type = datatype(image);
+    void *F = (void *)(image->image_data);
+    index_t *NF;    /* plus petit pixel, puis nombre de fils non elimines */
+    uint8_t *M;
+    mcmaxtree_comp *C;
+
+    NF = (index_t *)calloc(N, sizeof(index_t));
+    M = (uint8_t *)calloc(N, sizeof(uint8_t));
+    if ((NF == NULL) || (M == NULL)) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(NF);
+        free(M);
+        return 0;
+    }
+    for (i = 0; i < N; i++) {
+        NF[i] = i;
+    }
+    for (i = N - 1; i > 0; i--) {
+        p = S[i];
+        q = parent[p];
+        if (NF[p] < NF[q]) {
+            NF[q] = NF[p];
+        }
+        if (mcmaxtree_canonique(T, F, type, p)) {
+            nbcomp++;
+        }
+    }
+    C = (mcmaxtree_comp *)malloc((nbcomp + 1) * sizeof(mcmaxtree_comp));
+    if (C == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        free(NF);
+        free(M);
+        return 0;
+    }
+    for (i = 1, k = 0; i < N; i++) {
+        p = S[i];
+        if (mcmaxtree_canonique(T, F, type, p)) {
+            C[k].a = attr[p];
+            C[k].m = NF[p];
+            C[k].p = p;
+            k++;
+        }
+    }
+    memset(NF, 0, N * sizeof(index_t));
+    for (k = 0; k < nbcomp; k++) {
+        NF[parent[C[k].p]]++;
+    }
+    for (i = 0; i < N; i++) {
+        p = S[i];
+        if (mcmaxtree_canonique(T, F, type, p) && (NF[p] == 0)) {
+            nbfeuilles++;
+        }
+    }
+    qsort(C, (size_t)nbcomp, sizeof(mcmaxtree_comp), mcmaxtree_compare);
+
+    /* un fils a toujours un attribut strictement inferieur a celui de son
+       pere : les feuilles sont eliminees avant leurs ancetres */
+    for (k = 0; (nbfeuilles > nb) && (k < nbcomp); k++) {
+        p = C[k].p;
+        if (NF[p] != 0) {
+            continue;
+        }
+        M[p] = MCMAXTREE_FILTRE;
+        q = parent[p];
+        NF[q]--;
+        if (NF[q] != 0) {
+            nbfeuilles--;
+        }
+    }
+    free(C);
+
+    for (i = 0; i < N; i++) {
+        p = S[i];
+        if (!mcmaxtree_canonique(T, F, type, p)) {
+            continue;
+        }
+        if (M[p] & MCMAXTREE_FILTRE) {
+            M[p] |= (M[parent[p]] & MCMAXTREE_BLANC);
+        } else if (NF[p] == 0) {
+            M[p] |= MCMAXTREE_BLANC;
+        }
+    }
+    free(NF);
+    mcmaxtree_binarise(T, image, M);
+    free(M);
+    return 1;
+} /* mcmaxtree_selnb() */
+
+/* ==================================== */
+int32_t mcmaxtree_attributefilter(struct xvimage *image, int32_t connex, int32_t maxtree,
+                                  int32_t attribute, double seuil)
+/* ==================================== */
+/*
+  Filtre connexe : supprime les composantes des coupes superieures
+  (maxtree = 1) ou inferieures (maxtree = 0) dont l'attribut est < seuil.
+*/
+#undef F_NAME
+#define F_NAME "mcmaxtree_attributefilter"
+{
+    mcmaxtree *T;
+    double *A;
+    int32_t ret;
+
+    T = mcmaxtree_build(image, connex, maxtree);
+    if (T == NULL) {
+        fprintf(stderr, "%s: mcmaxtree_build failed\n", F_NAME);
+        return 0;
+    }
+    A = mcmaxtree_attribute(T, image, attribute);
+    if (A == NULL) {
+        mcmaxtree_free(T);
+        return 0;
+    }
+    ret = mcmaxtree_filter(T, image, A, seuil);
+    free(A);
+    mcmaxtree_free(T);
+    return ret;
+} /* mcmaxtree_attributefilter() */
@@ -0,0 +1,273 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Librairie mctables :
+
+   acces aux tables precalculees volumineuses (tables indexees par les
+   configurations du 26-voisinage, de 4 a 64 Mo).
+
+   Une table est cherchee, dans l'ordre :
+   - dans le repertoire $PINK/src/tables (si PINK est defini),
+   - dans le repertoire cache : $PINK_CACHE, ou a defaut
+     $XDG_CACHE_HOME/pink, $HOME/.cache/pink.
+   Le fichier trouve est projete en memoire en lecture seule et en mode
+   partage : les pages ne sont lues qu'a la demande, et sont communes a
+   tous les processus qui utilisent la table (cache des pages du systeme).
+   Un fichier n'est utilise que s'il appartient a l'utilisateur (ou a
+   root) et n'est modifiable ni par le groupe ni par les autres : un
+   fichier depose ou modifie par un tiers fausserait silencieusement les
+   resultats (et sa troncature pendant la projection provoquerait SIGBUS).
+
+   Si la table n'est trouvee nulle part et qu'un generateur est fourni,
+   elle est calculee puis enregistree dans le repertoire cache (fichier
+   temporaire renomme ensuite, afin qu'un processus concurrent ne voie
+   jamais une table incomplete). Le calcul n'a donc lieu qu'une fois.
+   Sans repertoire cache (ni PINK_CACHE, ni XDG_CACHE_HOME, ni HOME), la
+   table est calculee en memoire a chaque execution : elle n'est jamais
+   enregistree dans un repertoire partage comme /tmp.
+
+   Les tables retournees ne doivent pas etre modifiees ; elles sont
+   liberees par mctables_release.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef UNIXIO
+#  include <unistd.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#endif
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <mcutil.h>
+#include <mctables.h>
+
+//#define VERBOSE
+
+#define MCTABLES_PATHLEN 1024
+
+/* ==================================== */
+static int32_t mctables_cachedir(char *dir)
+/* ==================================== */
+/* repertoire cache des tables, cree si besoin ; retourne 0 s'il n'y en a pas */
+{
+    char *s;
+
+#ifdef UNIXIO
+    if (((s = getenv("PINK_CACHE")) != NULL) && *s) {
+        snprintf(dir, MCTABLES_PATHLEN, "%s", s);
+    } else if (((s = getenv("XDG_CACHE_HOME")) != NULL) && *s) {
+        snprintf(dir, MCTABLES_PATHLEN, "%s/pink", s);
+    } else if (((s = getenv("HOME")) != NULL) && *s) {
+        snprintf(dir, MCTABLES_PATHLEN, "%s/.cache", s);
+        (void)mkdir(dir, 0755);
+        snprintf(dir, MCTABLES_PATHLEN, "%s/.cache/pink", s);
+    } else {
+        dir[0] = '\0';
+        return 0;
+    }
+    (void)mkdir(dir, 0755);
+#else
+    if (((s = getenv("PINK_CACHE")) != NULL) && *s) {
+        snprintf(dir, MCTABLES_PATHLEN, "%s", s);
+    } else if (((s = getenv("TEMP")) != NULL) && *s) {
+        snprintf(dir, MCTABLES_PATHLEN, "%s", s);
+    } else {
+        snprintf(dir, MCTABLES_PATHLEN, ".");
+    }
+#endif
+    return 1;
+} /* mctables_cachedir() */
+
+/* ==================================== */
+static uint8_t * mctables_map(const char *path, index_t size)
+/* ==================================== */
+/* projection (ou lecture) du fichier path s'il existe et a la bonne taille */
+{
+#ifdef UNIXIO
+    struct stat st;
+    void *p;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || ((index_t)st.st_size != size) ||
+            ((st.st_uid != getuid()) && (st.st_uid != 0)) ||
+            (st.st_mode & (S_IWGRP | S_IWOTH))) {
+#ifdef VERBOSE
+        fprintf(stderr, "mctables_map: %s ignored (size, owner or permissions)\n", path);
+#endif
+        close(fd);
+        return NULL;
+    }
+    p = mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    return (p == MAP_FAILED) ? NULL : (uint8_t *)p;
+#else
+    FILE *fd = fopen(path, "rb");
+    uint8_t *p;
+
+    if (fd == NULL) {
+        return NULL;
+    }
+    p = (uint8_t *)malloc((size_t)size);
+    if ((p != NULL) && ((index_t)fread(p, 1, (size_t)size, fd) != size)) {
+        free(p);
+        p = NULL;
+    }
+    fclose(fd);
+    return p;
+#endif
+} /* mctables_map() */
+
+/* ==================================== */
+static void mctables_save(const char *dir, const char *name, uint8_t *tab, index_t size)
+/* ==================================== */
+/* enregistre la table dans le repertoire cache ; un echec n'est pas une erreur */
+{
+    char tmp[MCTABLES_PATHLEN], path[MCTABLES_PATHLEN];
+    FILE *fd;
+    int32_t ok;
+
+    if ((snprintf(path, MCTABLES_PATHLEN, "%s/%s", dir, name) >= MCTABLES_PATHLEN) ||
+            (snprintf(tmp, MCTABLES_PATHLEN, "%s/%s.XXXXXX", dir, name) >= MCTABLES_PATHLEN)) {
+        return;
+    }
+#ifdef UNIXIO
+    {
+        int fdn = mkstemp(tmp);
+        if (fdn < 0) {
+            return;
+        }
+        (void)fchmod(fdn, 0644);
+        fd = fdopen(fdn, "wb");
+        if (fd == NULL) {
+            close(fdn);
+            unlink(tmp);
+            return;
+        }
+    }
+#else
+    fd = fopen(tmp, "wb");
+    if (fd == NULL) {
+        return;
+    }
+#endif
+    ok = ((index_t)fwrite(tab, 1, (size_t)size, fd) == size);
+    ok = (fclose(fd) == 0) && ok;
+    if (!ok || (rename(tmp, path) != 0)) {
+        remove(tmp);
+    }
+#ifdef VERBOSE
+    else {
+        fprintf(stderr, "mctables_save: %s written\n", path);
+    }
+#endif
+} /* mctables_save() */
+
+/* ==================================== */
+uint8_t * mctables_load(const char *name, index_t size, mctables_generator gen)
+/* ==================================== */
+/*
+   Retourne la table name de size octets (voir l'en-tete), ou NULL si elle
+   est introuvable et que gen est NULL.
+*/
+#undef F_NAME
+#define F_NAME "mctables_load"
+{
+    char path[MCTABLES_PATHLEN], dir[MCTABLES_PATHLEN];
+    char *pink = getenv("PINK");
+    uint8_t *tab;
+    int32_t cache;
+
+    if ((pink != NULL) &&
+            (snprintf(path, MCTABLES_PATHLEN, "%s/src/tables/%s", pink, name) < MCTABLES_PATHLEN) &&
+            ((tab = mctables_map(path, size)) != NULL)) {
+        return tab;
+    }
+    cache = mctables_cachedir(dir);
+    if (cache && (snprintf(path, MCTABLES_PATHLEN, "%s/%s", dir, name) < MCTABLES_PATHLEN) &&
+            ((tab = mctables_map(path, size)) != NULL)) {
+        return tab;
+    }
+    if (gen == NULL) {
+        fprintf(stderr, "%s: table %s not found in $PINK/src/tables nor in the cache directory\n", F_NAME, name);
+        return NULL;
+    }
+
+#ifdef VERBOSE
+    fprintf(stderr, "%s: generating table %s\n", F_NAME, name);
+#endif
+#ifdef UNIXIO
+    tab = (uint8_t *)mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((void *)tab == MAP_FAILED) {
+        tab = NULL;
+    }
+#else
+    tab = (uint8_t *)malloc((size_t)size);
+#endif
+    if (tab == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", F_NAME);
+        return NULL;
+    }
+    gen(tab, size);
+    if (cache) {
+        mctables_save(dir, name, tab, size);
+    }
+#ifdef UNIXIO
+    (void)mprotect(tab, (size_t)size, PROT_READ);
+#endif
+    return tab;
+} /* mctables_load() */
+
+/* ==================================== */
+void mctables_release(uint8_t *tab, index_t size)
+/* ==================================== */
+{
+    if (tab == NULL) {
+        return;
+    }
+#ifdef UNIXIO
+    munmap(tab, (size_t)size);
+#else
+    (void)size;
+    free(tab);
+#endif
+} /* mctables_release() */
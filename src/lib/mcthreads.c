@@ -0,0 +1,249 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*
+   Librairie mcthreads :
+
+   reserve de threads (thread pool) pour l'execution parallele de taches
+   independantes. mcthreads_run(ntasks, f, arg) appelle f(arg, t) pour
+   t = 0 .. ntasks-1, les taches etant reparties dynamiquement entre les
+   threads de la reserve et le thread appelant. Le retour de mcthreads_run
+   fait office de barriere.
+
+   Le nombre de threads est lu dans la variable d'environnement
+   PINK_NUM_THREADS, a defaut c'est le nombre de processeurs en ligne.
+   Il peut etre modifie par mcthreads_setnthreads (1 : execution
+   sequentielle).
+
+   Si la reserve est deja occupee (appel imbrique, ou appel concurrent
+   depuis un autre thread), les taches sont executees sequentiellement
+   par le thread appelant. Sans pthreads (HAVE_PTHREAD non defini),
+   l'execution est toujours sequentielle.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <mcutil.h>
+#include <mcthreads.h>
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+static int32_t mcthreads_n = 0; /* 0 : non initialise */
+
+#ifdef HAVE_PTHREAD
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t pool_busy = PTHREAD_MUTEX_INITIALIZER; /* un seul job a la fois */
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER; /* protege les champs job_* */
+static pthread_cond_t pool_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+static int32_t pool_nworkers = 0;   /* threads crees */
+static uint32_t pool_generation = 0; /* numero du job courant (jamais 0 apres le 1er job) */
+static mcthreads_task job_f;
+static void *job_arg;
+static int32_t job_ntasks;
+static int32_t job_next;             /* prochaine tache a distribuer */
+static int32_t job_nworkers;         /* threads de la reserve participant au job */
+static int32_t job_pending;          /* threads de la reserve n'ayant pas fini */
+static MC_THREAD_LOCAL int32_t in_worker = 0;
+#endif
+
+/* ==================================== */
+static void mcthreads_init(void)
+/* ==================================== */
+{
+    char *s = getenv("PINK_NUM_THREADS");
+    int32_t n = 1;
+    if (s != NULL) {
+        n = atoi(s);
+    }
+#if defined(HAVE_PTHREAD) && defined(_SC_NPROCESSORS_ONLN)
+    else {
+        n = (int32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+#endif
+    if (n < 1) {
+        n = 1;
+    }
+    if (n > MCTHREADS_MAX) {
+        n = MCTHREADS_MAX;
+    }
+    mcthreads_n = n;
+} /* mcthreads_init() */
+
+/* ==================================== */
+int32_t mcthreads_nthreads(void)
+/* ==================================== */
+// retourne le nombre de threads utilises par mcthreads_run
+{
+#ifdef HAVE_PTHREAD
+    pthread_once(&pool_once, mcthreads_init);
+#else
+    if (mcthreads_n == 0) {
+        mcthreads_init();
+    }
+#endif
+    return mcthreads_n;
+} /* mcthreads_nthreads() */
+
+/* ==================================== */
+void mcthreads_setnthreads(int32_t n)
+/* ==================================== */
+// fixe le nombre de threads (n <= 0 : valeur par defaut)
+{
+    mcthreads_nthreads();
+    if (n <= 0) {
+        mcthreads_init();
+        return;
+    }
+    if (n > MCTHREADS_MAX) {
+        n = MCTHREADS_MAX;
+    }
+    mcthreads_n = n;
+} /* mcthreads_setnthreads() */
+
+#ifdef HAVE_PTHREAD
+/* ==================================== */
+static void *mcthreads_worker(void *arg)
+/* ==================================== */
+{
+    int32_t id = (int32_t)(intptr_t)arg;
+    uint32_t seen = 0;
+    int32_t t;
+
+    in_worker = 1;
+    pthread_mutex_lock(&pool_lock);
+    for (;;) {
+        while (pool_generation == seen) {
+            pthread_cond_wait(&pool_work, &pool_lock);
+        }
+        seen = pool_generation;
+        if (id < job_nworkers) {
+            while (job_next < job_ntasks) {
+                t = job_next++;
+                pthread_mutex_unlock(&pool_lock);
+                job_f(job_arg, t);
+                pthread_mutex_lock(&pool_lock);
+            }
+        }
+        job_pending--;
+        if (job_pending == 0) {
+            pthread_cond_signal(&pool_done);
+        }
+    }
+    return NULL;
+} /* mcthreads_worker() */
+#endif
+
+/* ==================================== */
+void mcthreads_run(int32_t ntasks, mcthreads_task f, void *arg)
+/* ==================================== */
+// execute f(arg, t) pour t = 0 .. ntasks-1 et attend la fin de toutes les taches
+#undef F_NAME
+#define F_NAME "mcthreads_run"
+{
+    int32_t t, n = mcthreads_nthreads();
+#ifdef HAVE_PTHREAD
+    pthread_t th;
+
+    if ((n > 1) && (ntasks > 1) && !in_worker && (pthread_mutex_trylock(&pool_busy) == 0)) {
+        pthread_mutex_lock(&pool_lock);
+        while (pool_nworkers < n - 1) {
+            if (pthread_create(&th, NULL, mcthreads_worker, (void *)(intptr_t)pool_nworkers) != 0) {
+                fprintf(stderr, "%s: warning: pthread_create failed\n", F_NAME);
+                break;
+            }
+            pthread_detach(th);
+            pool_nworkers++;
+        }
+        job_f = f;
+        job_arg = arg;
+        job_ntasks = ntasks;
+        job_next = 0;
+        job_nworkers = mcmin(n - 1, pool_nworkers);
+        job_pending = pool_nworkers;
+        if (++pool_generation == 0) {
+            pool_generation = 1;
+        }
+        pthread_cond_broadcast(&pool_work);
+        while (job_next < job_ntasks) {
+            t = job_next++;
+            pthread_mutex_unlock(&pool_lock);
+            f(arg, t);
+            pthread_mutex_lock(&pool_lock);
+        }
+        while (job_pending > 0) {
+            pthread_cond_wait(&pool_done, &pool_lock);
+        }
+        pthread_mutex_unlock(&pool_lock);
+        pthread_mutex_unlock(&pool_busy);
+        return;
+    }
+#endif
+    (void)n;
+    for (t = 0; t < ntasks; t++) {
+        f(arg, t);
+    }
+} /* mcthreads_run() */
+
+/* ==================================== */
+int32_t mcthreads_nbands(index_t n)
+/* ==================================== */
+// nombre de bandes (de lignes, de plans...) pour decouper n unites
+{
+    index_t nb = 4 * (index_t)mcthreads_nthreads();
+    if (mcthreads_nthreads() == 1) {
+        nb = 1;
+    }
+    if (nb > n) {
+        nb = n;
+    }
+    if (nb < 1) {
+        nb = 1;
+    }
+    return (int32_t)nb;
+} /* mcthreads_nbands() */
+
+/* ==================================== */
+void mcthreads_band(index_t n, int32_t nbands, int32_t band,
+                    index_t *first, index_t *last)
+/* ==================================== */
+// bornes [*first, *last[ de la bande numero band parmi nbands sur [0, n[
+{
+    *first = (n * band) / nbands;
+    *last = (n * (band + 1)) / nbands;
+} /* mcthreads_band() */
@@ -49,6 +49,7 @@ Michel Couprie 1998-2007
 Update nov. 2006 : modif mctopo3d_geodesic_neighborhood pour compatibilité 64 bits
 Update nov. 2007 : modif mctopo3d_nbcomp pour compatibilité 64 bits
 Update sep. 2009 : ajout des tests is_on_frame()
+Update 2026 : globales privees propres a chaque thread (MC_THREAD_LOCAL)
 */
 
 #include <stdint.h>
@@ -61,16 +62,18 @@ Update sep. 2009 : ajout des tests is_on_frame()
 #include <mcutil.h>
 #include <mccodimage.h>
 #include <mctopo3d.h>
+#include <mcthreads.h>
 
 //#define DEBUG
 //#define DEBUG_mctopo3d_tsao_fu_nonend
 
-/* globales privees */
-static Lifo * LIFO_topo3d1 = NULL;
-static Lifo * LIFO_topo3d2 = NULL;
-static voxel cube_topo3d[27];
-static voxel cubec_topo3d[27];
-static voxel cubep_topo3d[27];
+/* globales privees, propres a chaque thread : chaque thread qui utilise
+   les fonctions de ce module doit appeler mctopo3d_init_topo3d() */
+static MC_THREAD_LOCAL Lifo * LIFO_topo3d1 = NULL;
+static MC_THREAD_LOCAL Lifo * LIFO_topo3d2 = NULL;
+static MC_THREAD_LOCAL voxel cube_topo3d[27];
+static MC_THREAD_LOCAL voxel cubec_topo3d[27];
+static MC_THREAD_LOCAL voxel cubep_topo3d[27];
 
 static int32_t is_on_frame(index_t p, index_t rs, index_t ps, index_t N) {
     if ((p < ps) || (p >= N - ps) ||            /* premier ou dernier plan */
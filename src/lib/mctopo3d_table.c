@@ -52,6 +52,14 @@ Vol. 15, pp. 1003-1011, 1994.
 Michel Couprie 2006
 
 MC update jan. 2011: connectivity numbers
+
+Update 2026: les tables ne sont plus lues par malloc/fread depuis
+$PINK/src/tables, mais projetees en memoire partagee par mctables_load.
+Si elles sont absentes, elles sont calculees (une fois pour toutes, le
+resultat etant enregistre dans le repertoire cache de mctables) a partir
+de la definition des nombres de connexite : T26 est le nombre de
+26-composantes de X inter N26*(x), T6b le nombre de 6-composantes de
+Xb inter N18(x) 6-adjacentes a x ; x est 26-simple ssi T26 = T6b = 1.
 */
 
 #include <stdint.h>
@@ -62,11 +70,15 @@ MC update jan. 2011: connectivity numbers
 #include <mcutil.h>
 #include <mccodimage.h>
 #include <mctopo3d.h>
+#include <mcthreads.h>
+#include <mctables.h>
 
 //#define VERBOSE
 
 #define TABSIMP26NAME "TabSimple26.dat"
+#define TABSIMP26SIZE (1<<23) /* 2^26 / 8 */
 #define TABCN26NAME "TabCN26.dat"
+#define TABCN26SIZE (1<<26)
 
 static voxel cube_topo3d[27];
 static voxel cubec_topo3d[27];
@@ -78,6 +90,161 @@ static uint8_t *table_mctopo3d_table_CN26 = NULL;
 #define CN26(x) (table_mctopo3d_table_CN26[x]>>4)
 #define CN6b(x) (table_mctopo3d_table_CN26[x]&0xf)
 
+/* voisins de x, dans l'ordre de voisin26 : (dx, dy, dz) */
+static const int32_t mctopo3d_table_vois[26][3] = {
+    { 1,  0,  1}, { 1, -1,  1}, { 0, -1,  1}, {-1, -1,  1}, {-1,  0,  1},
+    {-1,  1,  1}, { 0,  1,  1}, { 1,  1,  1}, { 0,  0,  1},
+    { 1,  0,  0}, { 1, -1,  0}, { 0, -1,  0}, {-1, -1,  0}, {-1,  0,  0},
+    {-1,  1,  0}, { 0,  1,  0}, { 1,  1,  0},
+    { 1,  0, -1}, { 1, -1, -1}, { 0, -1, -1}, {-1, -1, -1}, {-1,  0, -1},
+    {-1,  1, -1}, { 0,  1, -1}, { 1,  1, -1}, { 0,  0, -1}
+};
+
+/* position du bit de poids faible (suite de De Bruijn) */
+static const int32_t mctopo3d_table_debruijn[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+#define LOWBIT(w) mctopo3d_table_debruijn[((uint32_t)(((w) & (0U - (w))) * 0x077CB531U)) >> 27]
+
+typedef struct {
+    uint32_t adj26[26];              /* 26-voisins dans N26*(x) */
+    uint32_t adj6[26];               /* 6-voisins dans N18(x) */
+    uint32_t n18, n6;                /* points de N18*(x), de N6(x) */
+    uint8_t *tab;
+    index_t size;
+    int32_t nbands;
+} mctopo3d_table_gen;
+
+/* ========================================== */
+static void mctopo3d_table_geninit(mctopo3d_table_gen *G)
+/* ========================================== */
+{
+    int32_t k, l, d, dinf, c;
+
+    G->n18 = G->n6 = 0;
+    for (k = 0; k < 26; k++) {
+        G->adj26[k] = G->adj6[k] = 0;
+        d = abs(mctopo3d_table_vois[k][0]) + abs(mctopo3d_table_vois[k][1]) +
+            abs(mctopo3d_table_vois[k][2]);
+        if (d <= 2) {
+            G->n18 |= (uint32_t)1 << k;
+        }
+        if (d == 1) {
+            G->n6 |= (uint32_t)1 << k;
+        }
+    }
+    for (k = 0; k < 26; k++) {
+        for (l = 0; l < 26; l++) {
+            if (l == k) {
+                continue;
+            }
+            d = dinf = 0;
+            for (c = 0; c < 3; c++) {
+                int32_t e = abs(mctopo3d_table_vois[k][c] - mctopo3d_table_vois[l][c]);
+                d += e;
+                dinf = mcmax(dinf, e);
+            }
+            if (dinf == 1) {
+                G->adj26[k] |= (uint32_t)1 << l;
+            }
+            if ((d == 1) && (G->n18 & ((uint32_t)1 << k)) && (G->n18 & ((uint32_t)1 << l))) {
+                G->adj6[k] |= (uint32_t)1 << l;
+            }
+        }
+    }
+} /* mctopo3d_table_geninit() */
+
+/* ========================================== */
+static int32_t mctopo3d_table_ncomp(uint32_t set, uint32_t seeds, const uint32_t *adj)
+/* ========================================== */
+/* nombre de composantes de set (pour la relation adj) contenant un point de seeds */
+{
+    uint32_t comp, front, add;
+    int32_t n = 0;
+
+    seeds &= set;
+    while (seeds) {
+        comp = front = seeds & (0U - seeds);
+        while (front) {
+            add = adj[LOWBIT(front)] & set & ~comp;
+            front &= front - 1;
+            comp |= add;
+            front |= add;
+        }
+        set &= ~comp;
+        seeds &= ~comp;
+        n++;
+    }
+    return n;
+} /* mctopo3d_table_ncomp() */
+
+/* ========================================== */
+static void mctopo3d_table_gensimple26_band(void *arg, int32_t band)
+/* ========================================== */
+{
+    mctopo3d_table_gen *G = (mctopo3d_table_gen *)arg;
+    index_t first, last, i;
+    uint32_t m;
+    int32_t b;
+    uint8_t v;
+
+    mcthreads_band(G->size, G->nbands, band, &first, &last);
+    for (i = first; i < last; i++) {
+        v = 0;
+        for (b = 0; b < 8; b++) {
+            m = (uint32_t)(8 * i + b);
+            if ((mctopo3d_table_ncomp(m, m, G->adj26) == 1) &&
+                    (mctopo3d_table_ncomp(~m & G->n18, G->n6, G->adj6) == 1)) {
+                v |= (uint8_t)(1 << b);
+            }
+        }
+        G->tab[i] = v;
+    }
+} /* mctopo3d_table_gensimple26_band() */
+
+/* ========================================== */
+static void mctopo3d_table_gensimple26(uint8_t *tab, index_t size)
+/* ========================================== */
+/* bit m de la table : la configuration m est 26-simple */
+{
+    mctopo3d_table_gen G;
+    mctopo3d_table_geninit(&G);
+    G.tab = tab;
+    G.size = size;
+    G.nbands = mcthreads_nbands(size / 4096);
+    mcthreads_run(G.nbands, mctopo3d_table_gensimple26_band, &G);
+} /* mctopo3d_table_gensimple26() */
+
+/* ========================================== */
+static void mctopo3d_table_genCN26_band(void *arg, int32_t band)
+/* ========================================== */
+{
+    mctopo3d_table_gen *G = (mctopo3d_table_gen *)arg;
+    index_t first, last, i;
+    uint32_t m;
+
+    mcthreads_band(G->size, G->nbands, band, &first, &last);
+    for (i = first; i < last; i++) {
+        m = (uint32_t)i;
+        G->tab[i] = (uint8_t)((mctopo3d_table_ncomp(m, m, G->adj26) << 4) |
+                              mctopo3d_table_ncomp(~m & G->n18, G->n6, G->adj6));
+    }
+} /* mctopo3d_table_genCN26_band() */
+
+/* ========================================== */
+static void mctopo3d_table_genCN26(uint8_t *tab, index_t size)
+/* ========================================== */
+/* octet m de la table : T26 (4 bits de poids fort) et T6b de la configuration m */
+{
+    mctopo3d_table_gen G;
+    mctopo3d_table_geninit(&G);
+    G.tab = tab;
+    G.size = size;
+    G.nbands = mcthreads_nbands(size / 4096);
+    mcthreads_run(G.nbands, mctopo3d_table_genCN26_band, &G);
+} /* mctopo3d_table_genCN26() */
+
 /* ========================================== */
 void mctopo3d_table_init_topo3d()
 /* ========================================== */
@@ -85,28 +252,11 @@ void mctopo3d_table_init_topo3d()
 #define F_NAME "mctopo3d_table_init_topo3d"
 {
     if (table_mctopo3d_table_simple26 == NULL) {
-        char tablefilename[128];
-        int32_t tablesize, ret;
-        FILE * fd = NULL;
-
-        tablesize = 1<<23; // 2^26 / 8
-        table_mctopo3d_table_simple26 = (uint8_t *)malloc(tablesize);
+        table_mctopo3d_table_simple26 = mctables_load(TABSIMP26NAME, TABSIMP26SIZE, mctopo3d_table_gensimple26);
         if (table_mctopo3d_table_simple26 == NULL) {
-            fprintf(stderr, "%s: malloc failed\n", F_NAME);
-            exit(1);
-        }
-        sprintf(tablefilename, "%s/src/tables/%s", getenv("PINK"), TABSIMP26NAME);
-        fd = fopen (tablefilename, "r");
-        if (fd == NULL) {
-            fprintf(stderr, "%s: error while opening table\n", F_NAME);
-            exit(1);
-        }
-        ret = fread(table_mctopo3d_table_simple26, sizeof(uint8_t), tablesize, fd);
-        if (ret != tablesize) {
-            fprintf(stderr,"%s : fread failed : %d asked ; %d read\n", F_NAME, tablesize, ret);
+            fprintf(stderr, "%s: table %s not available\n", F_NAME, TABSIMP26NAME);
             exit(1);
         }
-        fclose(fd);
 #ifdef VERBOSE
         printf("%s: %s loaded\n", F_NAME, TABSIMP26NAME);
 #endif
@@ -117,7 +267,7 @@ void mctopo3d_table_init_topo3d()
 void mctopo3d_table_termine_topo3d()
 /* ========================================== */
 {
-    free(table_mctopo3d_table_simple26);
+    mctables_release(table_mctopo3d_table_simple26, TABSIMP26SIZE);
     table_mctopo3d_table_simple26 = NULL;
 } /* mctopo3d_table_termine_topo3d() */
 
@@ -127,32 +277,15 @@ void mctopo3d_table_init_topoCN3d()
 #undef F_NAME
 #define F_NAME "mctopo3d_table_init_topoCN3d"
 {
-    char tablefilename[128];
-    int32_t tablesize, ret;
-    FILE * fd = NULL;
-
     if (table_mctopo3d_table_CN26 != NULL) {
         fprintf(stderr, "%s: table_mctopo3d_table_CN26 already loaded\n", F_NAME);
         exit(1);
     }
-    tablesize = 1<<26;
-    table_mctopo3d_table_CN26 = (uint8_t *)malloc(tablesize);
+    table_mctopo3d_table_CN26 = mctables_load(TABCN26NAME, TABCN26SIZE, mctopo3d_table_genCN26);
     if (table_mctopo3d_table_CN26 == NULL) {
-        fprintf(stderr, "%s: malloc failed\n", F_NAME);
-        exit(1);
-    }
-    sprintf(tablefilename, "%s/src/tables/%s", getenv("PINK"), TABCN26NAME);
-    fd = fopen (tablefilename, "r");
-    if (fd == NULL) {
-        fprintf(stderr, "%s: error while opening table\n", F_NAME);
-        exit(1);
-    }
-    ret = fread(table_mctopo3d_table_CN26, sizeof(uint8_t), tablesize, fd);
-    if (ret != tablesize) {
-        fprintf(stderr,"%s : fread failed : %d asked ; %d read\n", F_NAME, tablesize, ret);
+        fprintf(stderr, "%s: table %s not available\n", F_NAME, TABCN26NAME);
         exit(1);
     }
-    fclose(fd);
 #ifdef VERBOSE
     printf("%s: %s loaded\n", F_NAME, TABCN26NAME);
 #endif
@@ -162,7 +295,7 @@ void mctopo3d_table_init_topoCN3d()
 void mctopo3d_table_termine_topoCN3d()
 /* ========================================== */
 {
-    free(table_mctopo3d_table_CN26);
+    mctables_release(table_mctopo3d_table_CN26, TABCN26SIZE);
     table_mctopo3d_table_CN26 = NULL;
 } /* mctopo3d_table_termine_topoCN3d() */
 
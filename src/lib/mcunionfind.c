@@ -50,6 +50,7 @@ ATTENTION : L'opération de Link n'a de sens que si elle agit sur des représent
 #include <sys/types.h>
 #include <stdlib.h>
 #include <mcutil.h>
+#include <mccodimage.h>
 #include <mcunionfind.h>
 
 /*
@@ -57,9 +58,9 @@ ATTENTION : L'opération de Link n'a de sens que si elle agit sur des représent
 */
 
 /* ==================================== */
-Tarjan * CreeTarjan(int32_t taille)
+Tarjan * CreeTarjan(index_t taille)
 /* ==================================== */
-/*! \fn Tarjan * CreeTarjan(int32_t taille)
+/*! \fn Tarjan * CreeTarjan(index_t taille)
     \param taille : nombre total d'éléments
     \return pointeur sur une structure Tarjan
     \brief crée une structure pour la fusion d'ensemble
@@ -69,12 +70,12 @@ Tarjan * CreeTarjan(int32_t taille)
 #define F_NAME "CreeTarjan"
 {
     Tarjan * T = (Tarjan *)calloc(1,sizeof(Tarjan));
-    T->Size = taille;
     if (T == NULL) {
         fprintf(stderr, "%s : malloc failed for T\n", F_NAME);
         return(NULL);
     }
-    T->Fth = (int32_t *)calloc(1,taille * sizeof(int32_t));
+    T->Size = taille;
+    T->Fth = (index_t *)calloc(1,taille * sizeof(index_t));
     if (T->Fth == NULL) {
         fprintf(stderr, "%s : malloc failed for T->Fth\n", F_NAME);
         return(NULL);
@@ -108,7 +109,7 @@ void TarjanInit(Tarjan * T)
     \brief initialise la structure (crée les singletons)
 */
 {
-    int32_t i;
+    index_t i;
     for (i = 0; i < T->Size; i++) {
         TarjanMakeSet(T, i);
     }
@@ -122,16 +123,20 @@ void TarjanPrint(Tarjan * T)
     \brief affiche la structure
 */
 {
-    int32_t i;
+    index_t i;
     for (i = 0; i < T->Size; i++) {
+#ifdef MC_64_BITS
+        printf("%ld: Rank = %d ; Fth = %ld\n", i, T->Rank[i], T->Fth[i]);
+#else
         printf("%d: Rank = %d ; Fth = %d\n", i, T->Rank[i], T->Fth[i]);
+#endif
     }
 } //TarjanPrint()
 
 /* ==================================== */
-void TarjanMakeSet(Tarjan * T, int32_t x)
+void TarjanMakeSet(Tarjan * T, index_t x)
 /* ==================================== */
-/*! \fn void TarjanMakeSet(Tarjan * T, int32_t x)
+/*! \fn void TarjanMakeSet(Tarjan * T, index_t x)
     \param T: une structure Tarjan
     \param x: un élément
     \brief ajoute le singleton {x} à la famille d'ensembles
@@ -142,9 +147,9 @@ void TarjanMakeSet(Tarjan * T, int32_t x)
 } //TarjanMakeSet()
 
 /* ==================================== */
-int32_t TarjanFind(Tarjan * T, int32_t x)
+index_t TarjanFind(Tarjan * T, index_t x)
 /* ==================================== */
-/*! \fn int32_t TarjanFind(Tarjan * T, int32_t x)
+/*! \fn index_t TarjanFind(Tarjan * T, index_t x)
     \param T: une structure Tarjan
     \param x: un élément
     \return un représentant
@@ -159,9 +164,9 @@ int32_t TarjanFind(Tarjan * T, int32_t x)
 } //TarjanFind()
 
 /* ==================================== */
-int32_t TarjanLink(Tarjan * T, int32_t x, int32_t y)
+index_t TarjanLink(Tarjan * T, index_t x, index_t y)
 /* ==================================== */
-/*! \fn int32_t TarjanLink(Tarjan * T, int32_t x, int32_t y)
+/*! \fn index_t TarjanLink(Tarjan * T, index_t x, index_t y)
     \param T: une structure Tarjan
     \param x, y: deux représentants
     \return un représentant
@@ -170,7 +175,7 @@ int32_t TarjanLink(Tarjan * T, int32_t x, int32_t y)
 */
 {
     if (T->Rank[x] > T->Rank[y]) {
-        int32_t tmp = x;
+        index_t tmp = x;
         x = y;
         y = tmp;
     }
@@ -182,9 +187,9 @@ int32_t TarjanLink(Tarjan * T, int32_t x, int32_t y)
 } //TarjanLink()
 
 /* ==================================== */
-int32_t TarjanLinkSafe(Tarjan * T, int32_t x, int32_t y)
+index_t TarjanLinkSafe(Tarjan * T, index_t x, index_t y)
 /* ==================================== */
-/*! \fn int32_t TarjanLinkSafe(Tarjan * T, int32_t x, int32_t y)
+/*! \fn index_t TarjanLinkSafe(Tarjan * T, index_t x, index_t y)
     \param T: une structure Tarjan
     \param x, y: deux éléments
     \return un représentant
@@ -194,7 +199,7 @@ int32_t TarjanLinkSafe(Tarjan * T, int32_t x, int32_t y)
     x = TarjanFind(T, x);
     y = TarjanFind(T, y);
     if (T->Rank[x] > T->Rank[y]) {
-        int32_t tmp = x;
+        index_t tmp = x;
         x = y;
         y = tmp;
     }
@@ -45,8 +45,10 @@ as argument (LuM)
 Area closing with connexity <B>connex</B> and area <B>area</B>.
 Deletes the components of the lower cross-sections
 which have an area not higher than <B>area</B>.
+For float images, the cross-sections are taken at every level present in the
+image; unlike height and volume, the area does not depend on the level step.
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
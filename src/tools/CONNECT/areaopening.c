@@ -45,8 +45,10 @@ as argument (LuM)
 Area opening with connexity <B>connex</B> and area <B>area</B>.
 Deletes the components of the upper cross-sections
 which have an area not higher than <B>area</B>.
+For float images, the cross-sections are taken at every level present in the
+image; unlike height and volume, the area does not depend on the level step.
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
@@ -60,6 +62,10 @@ which have an area not higher than <B>area</B>.
 %TEST areaopening %IMAGES/3dbyte/gray/g3a.pgm 6 20 %RESULTS/areaopening_g3a_6_20.pgm
 %TEST areaopening %IMAGES/3dbyte/gray/g3a.pgm 18 20 %RESULTS/areaopening_g3a_18_20.pgm
 %TEST areaopening %IMAGES/3dbyte/gray/g3a.pgm 26 20 %RESULTS/areaopening_g3a_26_20.pgm
+%TEST areaopening %IMAGES/2dlong/l2fish1.pgm 4 20 %RESULTS/areaopening_l2fish1_4_20.pgm
+%TEST areaopening %IMAGES/2dfloat/f2fish1.pgm 8 20 %RESULTS/areaopening_f2fish1_8_20.pgm
+%TEST areaopening %IMAGES/3dlong/l3a.pgm 6 20 %RESULTS/areaopening_l3a_6_20.pgm
+%TEST areaopening %IMAGES/3dfloat/f3a.pgm 26 20 %RESULTS/areaopening_f3a_26_20.pgm
 */
 
 #include <stdio.h>
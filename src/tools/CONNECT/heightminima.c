@@ -40,8 +40,10 @@ knowledge of the CeCILL license and that you accept its terms.
 
 <B>Description:</B>
 h-minima with connexity <B>connex</B> and depth <B>height</B>.
+For float images, the depth of a component is measured from the level
+of its parent component, without the unit level step used for integer images.
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
@@ -42,7 +42,7 @@ knowledge of the CeCILL license and that you accept its terms.
 The argument \b connex selects the connectivity (4, 8 in 2D; 6, 18, 26 in 3D).
 The argument <B><fgd|bgd|min|max|pla></B> selects the kind of flat zone
 to be labeled:
-\li \b fgd selects foreground components for a binary image
+\li \b fgd selects foreground components for a binary image (for an int32_t image, all nonzero pixels)
 \li \b bgd selects background components for a binary image
 \li \b min selects regional minima
 \li \b max selects regional maxima
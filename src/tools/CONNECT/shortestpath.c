@@ -40,7 +40,8 @@ knowledge of the CeCILL license and that you accept its terms.
 
 <B>Description:</B>
 A weighted graph G = (V,E) is defined with V = set of pixels of \b in.pgm
-and E = {(P,Q) in VxV ; P and Q are \b connex- adjacent}.
+and E = {(P,Q) in VxV ; P and Q are \b connex- adjacent}
+(\b connex = 4 or 8 in 2D, 6, 18 or 26 in 3D).
 Let F(P) be the value of pixel P in the image \b in.pgm.
 A weight W(P,Q) is assigned to each edge, according to the value of \b mode:
 
@@ -52,6 +53,11 @@ This operator finds a shortest path from (\b S1, \b S2) to (\b D1, \b D2)
 in this graph. The result is given as a list of vertices (pixels)
 in \b out.lst.
 
+With 4-connectivity, the weight of an edge is the square of W(P,Q).
+The graph is stored in compact (CSR) form and the shortest path is
+computed by Dijkstra's algorithm with a binary heap, which makes the
+operator usable on full-resolution images.
+
 <B>Types supported:</B> byte 2D, byte 3D
 
 <B>Category:</B> connect
@@ -76,9 +82,8 @@ int main(int argc, char **argv)
     int32_t connex, mode, S1, S2, S3, D1, D2, D3;
     int32_t debut, fin;
     int32_t rs, cs, ds, ps;
-    graphe * G = NULL;
-    int32_t n, y, x;
-    pcell p;
+    graphecsr * G = NULL;
+    int32_t n, i, x, *chemin;
     FILE *fd = NULL;
 
     if ((argc != 9) && (argc != 11)) {
@@ -121,7 +126,7 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    if (argc == 10) {
+    if (argc == 11) {
         S1 = atoi(argv[4]);
         S2 = atoi(argv[5]);
         S3 = atoi(argv[6]);
@@ -139,11 +144,18 @@ int main(int argc, char **argv)
         fin = D2*rs + D1;
     }
 
-    G = Image2Graphe(image, mode, connex);
-
-    Dijkstra(G, fin);
+    G = Image2GrapheCSR(image, mode, connex);
+    if (G == NULL) {
+        fprintf(stderr, "%s: function Image2GrapheCSR failed\n", argv[0]);
+        exit(1);
+    }
 
-    //  AfficheSuccesseurs(G);
+    DijkstraCSR(G, debut);
+    chemin = PCCCSR(G, debut, fin, &n);
+    if (chemin == NULL) {
+        fprintf(stderr, "%s: no shortest path found\n", argv[0]);
+        exit(1);
+    }
 
     fd = fopen(argv[argc - 1],"w");
     if (!fd) {
@@ -151,43 +163,24 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    x = debut;
-    n = 1; // pour le point debut
-    while (x != fin) {
-        for (p = G->gamma[x]; p != NULL; p = p->next) {
-            /* pour tout y voisin de x */
-            y = p->som;
-            if ((G->v_sommets[x]-G->v_sommets[y]) == p->v_arc) {
-                n++;
-                x = y;
-                break;
-            }
-        } // for p
-        if (p == NULL) {
-            fprintf(stderr, "%s: no shortest path found\n", argv[0]);
-            exit(1);
+    if (ds == 1) {
+        fprintf(fd, "b %d\n", n);
+        for (i = 0; i < n; i++) {
+            x = chemin[i];
+            fprintf(fd, "%d %d\n", x%rs, x/rs);
+        }
+    } else {
+        fprintf(fd, "B %d\n", n);
+        for (i = 0; i < n; i++) {
+            x = chemin[i];
+            fprintf(fd, "%d %d %d\n", x%rs, (x%ps)/rs, x/ps);
         }
-    }
-
-    fprintf(fd, "b %d\n", n);
-
-    x = debut;
-    fprintf(fd, "%d %d\n", x%rs, x/rs);
-    while (x != fin) {
-        for (p = G->gamma[x]; p != NULL; p = p->next) {
-            /* pour tout y voisin de x */
-            y = p->som;
-            if ((G->v_sommets[x]-G->v_sommets[y]) == p->v_arc) {
-                fprintf(fd, "%d %d\n", y%rs, y/rs);
-                x = y;
-                break;
-            }
-        } // for p
     }
 
     fclose(fd);
     freeimage(image);
-    TermineGraphe(G);
+    TermineGrapheCSR(G);
+    free(chemin);
 
     return 0;
 } /* main */
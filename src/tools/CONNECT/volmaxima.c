@@ -40,8 +40,10 @@ knowledge of the CeCILL license and that you accept its terms.
 
 <B>Description:</B>
 Volume-based filtering with connexity <B>connex</B> and volume <B>vol</B>.
+For float images, the volume of a component is measured from the level
+of its parent component, without the unit level step used for integer images.
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
@@ -55,6 +57,10 @@ Volume-based filtering with connexity <B>connex</B> and volume <B>vol</B>.
 %TEST volmaxima %IMAGES/3dbyte/gray/g3a.pgm 6 20 %RESULTS/volmaxima_g3a_6_20.pgm
 %TEST volmaxima %IMAGES/3dbyte/gray/g3a.pgm 18 20 %RESULTS/volmaxima_g3a_18_20.pgm
 %TEST volmaxima %IMAGES/3dbyte/gray/g3a.pgm 26 20 %RESULTS/volmaxima_g3a_26_20.pgm
+%TEST volmaxima %IMAGES/2dlong/l2fish1.pgm 4 20 %RESULTS/volmaxima_l2fish1_4_20.pgm
+%TEST volmaxima %IMAGES/2dfloat/f2fish1.pgm 8 20 %RESULTS/volmaxima_f2fish1_8_20.pgm
+%TEST volmaxima %IMAGES/3dlong/l3a.pgm 6 20 %RESULTS/volmaxima_l3a_6_20.pgm
+%TEST volmaxima %IMAGES/3dfloat/f3a.pgm 26 20 %RESULTS/volmaxima_f3a_26_20.pgm
 */
 
 #include <stdio.h>
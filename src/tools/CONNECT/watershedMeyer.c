@@ -48,7 +48,10 @@ indicates the region of interest on which the operation is performed.
 The parameter <B>connex</B> gives the adjacency relation (4,8 in 2D; 6,18,26 in 3D)
 for the makers.
 
-<B>Types supported:</B> byte 2d, byte 3d
+The image <B>in</B> is flooded without requantization: for short, long
+and float images, the result has the type of <B>in</B> (values 0 and 255).
+
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
@@ -48,8 +48,10 @@ The parameter <B>connex</B> gives the adjacency relation (4,8 in 2D; 6,18,26 in
 for the makers.
 
 The result is a binary image.
+The image <B>in</B> is flooded without requantization: for short, long
+and float images, the result has the type of <B>in</B> (values 0 and 255).
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
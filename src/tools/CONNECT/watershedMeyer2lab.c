@@ -59,7 +59,7 @@ of more than two regions be labelled by n+1.
 Thus, from any label L > n+1, one can recover the labels of the two
 regions i,j in contact by doing: i = L%(n+1); j = L/(n+1).
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
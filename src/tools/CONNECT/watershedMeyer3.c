@@ -47,7 +47,7 @@ indicates the region of interest on which the operation is performed.
 The parameter <B>connex</B> gives the adjacency relation (4,8 in 2D; 6,18,26 in 3D)
 for the makers.
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
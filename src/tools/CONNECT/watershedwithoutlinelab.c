@@ -52,7 +52,7 @@ The image out is a label image (int32_t)
 
 This version does not create any line to separate the catchment basins.
 
-<B>Types supported:</B> byte 2d, byte 3d
+<B>Types supported:</B> byte 2d, byte 3d, short 2d, short 3d, long 2d, long 3d, float 2d, float 3d
 
 <B>Category:</B> connect
 \ingroup connect
@@ -0,0 +1,119 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*! \file pipeline.c
+
+\brief executes a chain of operators in a single process
+
+<B>Usage:</B> pipeline script.txt [arg1 ... argn]
+
+<B>Description:</B>
+Executes the operators listed in \b script.txt, one instruction per line
+(or separated by ';'), '#' starting a comment:
+
+\verbatim
+res = operator arg1 arg2 ...
+write res file.pgm
+\endverbatim
+
+The intermediate images stay in memory: there is no intermediate file,
+each image is freed after its last use, and an operator that modifies its
+first argument works in place when this argument is not used afterwards.
+In the script, $1 ... $n are replaced by \b arg1 ... \b argn.
+The available operators are listed by the usage message.
+
+Example (morphological gradient, see gradmorph.sh):
+\verbatim
+f = read $1
+d = dilation f $2
+e = erosion f $2
+g = sub d e
+write g $3
+\endverbatim
+run with: pipeline gradmorph.txt in.pgm elstruct.pgm out.pgm
+
+<B>Types supported:</B> those of the operators
+
+<B>Category:</B> convert
+\ingroup convert
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <lpipeline.h>
+
+/* =============================================================== */
+int main(int argc, char **argv)
+/* =============================================================== */
+{
+    FILE *fd;
+    char *script;
+    long size;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s script.txt [arg1 ... argn]\n", argv[0]);
+        fprintf(stderr, "operators:\n");
+        lpipeline_listops(stderr);
+        exit(1);
+    }
+
+    fd = fopen(argv[1], "r");
+    if (fd == NULL) {
+        fprintf(stderr, "%s: cannot open file: %s\n", argv[0], argv[1]);
+        exit(1);
+    }
+    fseek(fd, 0, SEEK_END);
+    size = ftell(fd);
+    fseek(fd, 0, SEEK_SET);
+    script = (char *)malloc(size + 1);
+    if (script == NULL) {
+        fprintf(stderr, "%s: malloc failed\n", argv[0]);
+        exit(1);
+    }
+    size = (long)fread(script, 1, size, fd);
+    script[size] = '\0';
+    fclose(fd);
+
+    if (! lpipeline(script, argc - 2, argv + 2)) {
+        fprintf(stderr, "%s: function lpipeline failed\n", argv[0]);
+        exit(1);
+    }
+
+    free(script);
+    return 0;
+} /* main */
@@ -0,0 +1,112 @@
+/*
+Copyright ESIEE (2026)
+
+m.couprie@esiee.fr
+
+This software is an image processing library whose purpose is to be
+used primarily for research and teaching.
+
+This software is governed by the CeCILL  license under French law and
+abiding by the rules of distribution of free software. You can  use,
+modify and/ or redistribute the software under the terms of the CeCILL
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability.
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or
+data to be ensured and,  more generally, to use and operate it in the
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL license and that you accept its terms.
+*/
+/*! \file streamop.c
+
+\brief applies a local operator to a volume too large to fit in memory
+
+<B>Usage:</B> streamop in.pgm nplanes operator [arg1 ... argn] out.pgm
+
+<B>Description:</B>
+Applies \b operator to the raw volume \b in.pgm (byte, int32_t or float)
+without loading it entirely: the volume is read by slabs of \b nplanes
+planes, each slab being extended by the halo of planes required by the
+operator, and the central planes of the result are written to \b out.pgm
+as soon as they are computed. The memory used is bounded by the size of
+a slab (plus the working memory of the operator), not by the size of the
+volume.
+
+The available operators are listed by the usage message:
+\li dilatbin3d, eros3d: binary dilation (ldilatbin3d), erosion (leros3d)
+by the structuring element \b se.pgm (origin given in the file, see readse);
+\li convol3: 3x3 convolution (lconvol3), applied plane by plane;
+\li seuil: threshold (lseuil, lseuil3), the result is a byte image;
+\li deriche3d: Deriche filters (lderiche3d, llisseurrec3d, see deriche3d);
+\li add, sub, min, max, mult, diff, xor: pixelwise operations with a second
+volume \b in2.pgm, which must have the same size and type as \b in.pgm;
+\li inverse, addconst, scale: pixelwise operations (for int32_t and float
+volumes, inverse needs the maximum of the whole volume: it is computed by a
+first reading pass).
+
+For every operator except deriche3d, the result is identical to the one
+obtained by the corresponding in-memory operator. The Deriche filters are
+recursive (infinite support): the halo is set to 12/alpha planes, which
+makes the error on the central planes negligible (about 1e-4 relatively to
+the range of the image, at most one grey level for byte images).
+
+The result is written to a temporary file in the directory of \b out.pgm,
+which is renamed to \b out.pgm on success and removed on failure: \b out.pgm
+may thus be \b in.pgm or \b in2.pgm.
+
+Example:
+\verbatim
+streamop scan.pgm 64 seuil 100 bin.pgm
+streamop bin.pgm 64 dilatbin3d boule5.pgm bin_d.pgm
+\endverbatim
+
+<B>Types supported:</B> byte 3d, int32_t 3d, float 3d (depending on the operator)
+
+<B>Category:</B> convert
+\ingroup convert
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <stdlib.h>
+#include <mccodimage.h>
+#include <mcimage.h>
+#include <lstream.h>
+
+/* =============================================================== */
+int main(int argc, char **argv)
+/* =============================================================== */
+{
+    index_t nplans;
+
+    if (argc < 5) {
+        fprintf(stderr, "usage: %s in.pgm nplanes operator [arg1 ... argn] out.pgm\n", argv[0]);
+        fprintf(stderr, "operators:\n");
+        lstream_listops(stderr);
+        exit(1);
+    }
+
+    nplans = (index_t)atol(argv[2]);
+    if (! lstream(argv[1], argv[argc-1], nplans, argv[3], argc - 5, argv + 4)) {
+        fprintf(stderr, "%s: function lstream failed\n", argv[0]);
+        exit(1);
+    }
+
+    return 0;
+} /* main */
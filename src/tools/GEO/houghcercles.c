@@ -34,16 +34,32 @@ knowledge of the CeCILL license and that you accept its terms.
 */
 /* \file houghcercles.c
 
-\brief
+\brief Hough transform for circles
 
-<B>Usage:</B>
+<B>Usage:</B> houghcercles f.pgm rayonmin pasrayon nbpas [seuil [g.pgm]] out
 
 <B>Description:</B>
+Hough transform for the detection of circles whose radius is in
+rayonmin, rayonmin + pasrayon, ... rayonmin + (nbpas-1) * pasrayon.
+The non-null points of \b f (typically, contour points) vote with their
+grey level for the centers located at each radius.
+
+Without \b seuil, \b out is the accumulator: a 3D image with one plane per
+radius, normalized so that a complete white circle scores 255.
+
+With \b seuil, \b out is a list (type N) of the detected circles: the
+local maxima (3x3x3 neighborhood in x, y, radius) of the accumulator whose
+score is at least \b seuil, one line "x y rayon score" per circle. The
+accumulator planes are not all kept in memory. If \b g.pgm is given, each
+contour point only votes in the direction (both senses) of the gradient of
+\b g at this point.
+
+The radii are processed in parallel (see PINK_NUM_THREADS).
 
 <B>Types supported:</B> byte 2D
 
-<B>Category:</B>
-\ingroup
+<B>Category:</B> geo
+\ingroup geo
 
 \author Michel Couprie
 */
@@ -63,14 +79,17 @@ int main(int argc, char **argv)
 /* =============================================================== */
 {
     struct xvimage * image = NULL;
+    struct xvimage * grad = NULL;
     struct xvimage * accu = NULL;
     int32_t rayonmin;
     int32_t pasrayon;
     int32_t nbpas;
-    int32_t rs, cs;
+    int32_t rs, cs, i, n;
+    houghcercle *C;
+    FILE *fd = NULL;
 
-    if (argc != 6) {
-        fprintf(stderr, "usage: %s f.pgm rayonmin pasrayon nbpas accu.pgm \n", argv[0]);
+    if ((argc < 6) || (argc > 8)) {
+        fprintf(stderr, "usage: %s f.pgm rayonmin pasrayon nbpas [seuil [g.pgm]] out \n", argv[0]);
         exit(1);
     }
 
@@ -86,19 +105,53 @@ int main(int argc, char **argv)
     pasrayon = atoi(argv[3]);
     nbpas = atoi(argv[4]);
 
-    accu = allocimage(NULL, rs, cs, nbpas, VFF_TYP_1_BYTE);
-    if (accu == NULL) {
-        fprintf(stderr,"%s : allocimage failed\n", argv[0]);
+    if (argc == 6) {
+        accu = allocimage(NULL, rs, cs, nbpas, VFF_TYP_1_BYTE);
+        if (accu == NULL) {
+            fprintf(stderr,"%s : allocimage failed\n", argv[0]);
+            exit(1);
+        }
+
+        if (! lhoughcercles(image, rayonmin, pasrayon, nbpas, accu)) {
+            fprintf(stderr, "%s: function lhoughcercles failed\n", argv[0]);
+            exit(1);
+        }
+
+        writeimage(accu, argv[argc-1]);
+        freeimage(accu);
+        freeimage(image);
+        return 0;
+    }
+
+    if (argc == 8) {
+        grad = readimage(argv[6]);
+        if (grad == NULL) {
+            fprintf(stderr, "%s: readimage failed\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    C = lhoughcercles_pics(image, grad, rayonmin, pasrayon, nbpas, atof(argv[5]), &n);
+    if (C == NULL) {
+        fprintf(stderr, "%s: function lhoughcercles_pics failed\n", argv[0]);
         exit(1);
     }
 
-    if (! lhoughcercles(image, rayonmin, pasrayon, nbpas, accu)) {
-        fprintf(stderr, "%s: function lhoughcercles failed\n", argv[0]);
+    fd = fopen(argv[argc-1], "w");
+    if (!fd) {
+        fprintf(stderr, "%s: cannot open file: %s\n", argv[0], argv[argc-1]);
         exit(1);
     }
+    fprintf(fd, "N %d\n", n);
+    for (i = 0; i < n; i++) {
+        fprintf(fd, "%d %d %d %g\n", C[i].x, C[i].y, C[i].rayon, C[i].score);
+    }
+    fclose(fd);
 
-    writeimage(accu, argv[5]);
+    free(C);
     freeimage(image);
-    freeimage(accu);
+    if (grad) {
+        freeimage(grad);
+    }
     return 0;
 } /* main */
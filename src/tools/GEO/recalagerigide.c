@@ -77,6 +77,11 @@ In 3d, the parameters are:
 \li ty : parameter for the translation in direction y
 \li tz : parameter for the translation in direction z
 
+Note: in 2d, all the points of Y are translated to bring its barycenter
+to the origin. Earlier versions translated only the first n points of Y
+(n: number of points of X), so 2d results differ from those versions
+when X has fewer points than Y.
+
 <B>Types supported:</B> byte 2d, byte 3d
 
 <B>Category:</B> geo
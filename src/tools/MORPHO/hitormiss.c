@@ -42,6 +42,8 @@ knowledge of the CeCILL license and that you accept its terms.
 Let X be the input set, E1, E2 be the two structuring elements, the result Y is given by:<br>
 Y = (X - E1) inter (Xb - E2)<br>
 where '-' denotes the erosion operator, and 'Xb' denotes the complementary of X.
+Binary byte images (values 0 and 255 only) are processed in bit-packed form,
+64 pixels per machine word.
 
 <B>Types supported:</B> byte 2d, byte 3d, int32_t 2d, long3d
 
@@ -61,6 +63,7 @@ where '-' denotes the erosion operator, and 'Xb' denotes the complementary of X.
 #include <ldilateros.h>
 #include <ldilateros3d.h>
 #include <larith.h>
+#include <mcbitimage.h>
 
 /* =============================================================== */
 int main(int argc, char **argv)
@@ -86,6 +89,23 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    if (mcbit_isbinary(image) && (datatype(elem1) == VFF_TYP_1_BYTE) &&
+            (datatype(elem2) == VFF_TYP_1_BYTE)) {
+        /* image binaire : calcul sur l'image compactee */
+        mcbitimage *b = mcbit_pack(image);
+        if ((b == NULL) || !mcbit_hitormiss(b, elem1, x1, y1, z1, elem2, x2, y2, z2) ||
+                !mcbit_unpack(b, image)) {
+            fprintf(stderr, "%s: function mcbit_hitormiss failed\n", argv[0]);
+            exit(1);
+        }
+        mcbit_freeimage(b);
+        writeimage(image, argv[argc-1]);
+        freeimage(image);
+        freeimage(elem1);
+        freeimage(elem2);
+        return 0;
+    }
+
     tmp = copyimage(image);
     linverse(tmp);
     if (depth(image) == 1) {
@@ -36,7 +36,7 @@ knowledge of the CeCILL license and that you accept its terms.
 
 \brief convolution
 
-<B>Usage:</B> convol in.pgm kernel.pgm [mode] out.pgm
+<B>Usage:</B> convol in.pgm kernel.pgm [mode [tol]] out.pgm
 
 <B>Description:</B>
 Convolution of \b in.pgm by <B>kernel.pgm</B>.
@@ -50,6 +50,21 @@ Depending on the value given for the (optional) parameter <B>mode</B>:
       The image \b in.pgm is considered as null out of its support.
 \li   <B>mode</B> = 3 : convolution using the FFT.
       The boundary of image \b in.pgm is extended outside its support.
+\li   <B>mode</B> = 4 : the kernel is decomposed (SVD) into a sum of
+      separable kernels, each one applied by a row pass and a column pass.
+      The image \b in.pgm is considered as null out of its support.
+\li   <B>mode</B> = 5 : same as 4, the boundary of image \b in.pgm is extended outside its support.
+\li   <B>mode</B> = 6 : convolution using the FFT on blocks of the image (overlap-add).
+      The image \b in.pgm is considered as null out of its support.
+\li   <B>mode</B> = 7 : same as 6, the boundary of image \b in.pgm is extended outside its support.
+\li   <B>mode</B> = 8 : automatic choice of the fastest method among the above ones.
+      The image \b in.pgm is considered as null out of its support.
+\li   <B>mode</B> = 9 : same as 8, the boundary of image \b in.pgm is extended outside its support.
+
+For modes 4 and 5, the optional parameter <B>tol</B> (>= 0, default 1e-6) is the
+admitted relative error (Frobenius norm) between the kernel and its
+separable decomposition: a larger value gives a faster, low-rank
+approximation for nearly separable kernels.
 
 <B>Types supported:</B> byte 2d, int32_t 2d, float 2d
 
@@ -59,7 +74,9 @@ Depending on the value given for the (optional) parameter <B>mode</B>:
 \warning
 Naive convolution algorithm is in O(|in|*|kernel|).
 For large kernels, use FFT version which is in
-O(n log n) where n = max(|in|,|kernel|)
+O(n log n) where n = max(|in|,|kernel|).
+A kernel of rank r (r = 1 for a separable kernel) is processed by
+modes 4 and 5 in O(|in|*r*(kernel width + kernel height)).
 
 \author Michel Couprie
 */
@@ -79,9 +96,10 @@ int main(int argc, char **argv)
     struct xvimage * image = NULL;
     struct xvimage * mask = NULL;
     int32_t mode = 0;
+    double tol = -1.0;
 
-    if ((argc != 4) && (argc != 5)) {
-        fprintf(stderr, "usage: %s in.pgm kernel.pgm [mode] out.pgm \n", argv[0]);
+    if ((argc < 4) || (argc > 6)) {
+        fprintf(stderr, "usage: %s in.pgm kernel.pgm [mode [tol]] out.pgm \n", argv[0]);
         exit(1);
     }
 
@@ -92,9 +110,20 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    if (argc == 5) {
+    if (argc >= 5) {
         mode = atoi(argv[3]);
     }
+    if (argc == 6) {
+        tol = atof(argv[4]);
+        if ((mode != 4) && (mode != 5)) {
+            fprintf(stderr, "%s: tol is only meaningful for modes 4 and 5\n", argv[0]);
+            exit(1);
+        }
+        if (tol < 0.0) {
+            fprintf(stderr, "%s: tol must be >= 0\n", argv[0]);
+            exit(1);
+        }
+    }
 
     if (! convertfloat(&mask)) {
         fprintf(stderr, "%s: function convertfloat failed\n", argv[0]);
@@ -106,7 +135,12 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    if (! lconvol(image, mask, mode)) {
+    if (tol >= 0.0) {
+        if (! lconvolsep(image, mask, mode - 4, tol)) {
+            fprintf(stderr, "%s: function lconvolsep failed\n", argv[0]);
+            exit(1);
+        }
+    } else if (! lconvol(image, mask, mode)) {
         fprintf(stderr, "%s: function lconvol failed\n", argv[0]);
         exit(1);
     }
@@ -51,7 +51,7 @@ The arguments are described as follows:
 \b in.pgm specifies the input image, which must be of data type COMPLEX.
 
 \b out.pgm output image, which will be an image of data type COMPLEX.
-If row size or column size of in.pgm is not an integral power of 2, then input data is padded and dimensions of out.pgm may be different from those of in.pgm .
+Row size and column size of in.pgm may be arbitrary (no padding is done).
 
 \b dir (optional)
 specifies the FFT direction.  A \b dir of 0 (default) will result in a forward FFT,
@@ -65,7 +65,7 @@ Index them as
 
 f(x,y):    0 <= x <= m - 1,  0 <= y <= n - 1
 
-F(u,v):    -m/2 <= u <= m/2 - 1,  -n/2 <= v <= n/2 - 1
+F(u,v):    -m/2 <= u <= (m-1)/2,  -n/2 <= v <= (n-1)/2 (F(u,v) is stored at column u + m/2, row v + n/2)
 
 Then the forward and inverse transforms are related as follows.
 
@@ -75,7 +75,7 @@ F(u,v) = \sum_{x=0}^{m-1} \sum_{y=0}^{n-1} f(x,y) \exp{-2\pi i (ux/m + vy/n)}
 
 Inverse:
 
-f(x,y) = 1/(mn) \sum_{u=-m/2}^{m/2-1} \sum_{v=-n/2}^{n/2-1} F(u,v) \exp{2\pi i (ux/m + vy/n)}
+f(x,y) = 1/(mn) \sum_{u=-m/2}^{(m-1)/2} \sum_{v=-n/2}^{(n-1)/2} F(u,v) \exp{2\pi i (ux/m + vy/n)}
 
 Therefore, the transforms have these properties:
 
@@ -99,7 +99,6 @@ Therefore, the transforms have these properties:
 #include <assert.h>
 #include <mccodimage.h>
 #include <mcimage.h>
-#include <lcrop.h>
 #include <lfft.h>
 
 #define VERBOSE
@@ -109,9 +108,7 @@ int main(int argc, char **argv)
 /* =============================================================== */
 {
     struct xvimage * image = NULL;
-    struct xvimage * image2 = NULL;
     int32_t dir = 0;
-    int32_t rs, cs, cs2, rs2;
 
     if ((argc != 3) && (argc != 4)) {
         fprintf(stderr, "usage: %s in.pgm [dir] out.pgm \n", argv[0]);
@@ -123,8 +120,6 @@ int main(int argc, char **argv)
         fprintf(stderr, "%s: readimage failed\n", argv[0]);
         exit(1);
     }
-    rs = rowsize(image);
-    cs = colsize(image);
 
     if ((datatype(image) != VFF_TYP_COMPLEX) || (depth(image) != 1)) {
         fprintf(stderr,"%s: input image type must be complex 2D\n", argv[0]);
@@ -135,28 +130,6 @@ int main(int argc, char **argv)
         dir = atoi(argv[2]);
     }
 
-    rs2 = cs2 = 1;
-    while (rs2 < rs) {
-        rs2 = rs2 << 1;
-    }
-    while (cs2 < cs) {
-        cs2 = cs2 << 1;
-    }
-    if ((rs2 != rs) || (cs2 != cs)) {
-        image2 = allocimage(NULL, rs2, cs2, 1, VFF_TYP_COMPLEX);
-        assert(image2 != NULL);
-        image2->xdim = image->xdim;
-        image2->ydim = image->ydim;
-        image2->zdim = image->zdim;
-        razimage(image2);
-        if (!linsert(image, image2, 0, 0, 0)) {
-            fprintf(stderr, "%s: function linsert failed\n", argv[0]);
-            exit(1);
-        }
-        freeimage(image);
-        image = image2;
-    }
-
     if (! lfft(image, dir)) {
         fprintf(stderr, "%s: function lfft failed\n", argv[0]);
         exit(1);